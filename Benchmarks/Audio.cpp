@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <benchmark/benchmark.h>
+#include <Audio/SoundBuffer.hpp>
+#include <Audio/SoundStream.hpp>
+#include <Audio/Voice.hpp>
+#include <Audio/VoiceManager.hpp>
+#include <Maths/Maths.hpp>
+
+#if defined(ACID_BUILD_MACOS)
+#include <OpenAL/al.h>
+#include <OpenAL/alc.h>
+#else
+#include <al.h>
+#include <alc.h>
+#include <alext.h>
+#endif
+
+#if defined(ACID_BUILD_LINUX)
+#include <malloc.h>
+#endif
+
+using namespace acid;
+
+static constexpr uint32_t SampleRate = 44100;
+static constexpr uint32_t TickRate = 60;
+
+/**
+ * Creates a second of a mono tone, without an engine the buffer keeps its samples for the software mixer.
+ * @return The sound buffer.
+ */
+static std::shared_ptr<SoundBuffer> CreateTone()
+{
+	std::vector<int16_t> samples(SampleRate);
+
+	for (std::size_t i = 0; i < samples.size(); i++)
+	{
+		samples[i] = static_cast<int16_t>(8192.0f * std::sin(2.0f * Maths::Pi * 440.0f * static_cast<float>(i) / SampleRate));
+	}
+
+	return std::make_shared<SoundBuffer>(std::move(samples), 1, static_cast<int32_t>(SampleRate));
+}
+
+/**
+ * Ticks looping emitters scattered around a moving listener through the offline voice manager, mixing each tick as a device would.
+ * Half the emitters move each tick. The real counter is the voices that had a source after the last tick.
+ * @param state The benchmark state, the arguments are the emitter count and the most voices heard at once.
+ */
+static void VoiceManagerTick(benchmark::State &state)
+{
+	VoiceManager manager(VoiceManager::Mode::Offline, static_cast<uint32_t>(state.range(1)));
+	auto buffer = CreateTone();
+	std::vector<std::unique_ptr<Voice>> voices;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		auto &voice = voices.emplace_back(std::make_unique<Voice>(&manager, buffer));
+		voice->SetPosition(Vector3f(Maths::Random(-100.0f, 100.0f), 0.0f, Maths::Random(-100.0f, 100.0f)));
+		voice->Play(true);
+	}
+
+	auto delta = Time::Seconds(1.0f / TickRate);
+	std::vector<float> output(2 * SampleRate / TickRate);
+	uint32_t tick = 0;
+
+	for (auto _ : state)
+	{
+		for (std::size_t i = tick % 2; i < voices.size(); i += 2)
+		{
+			voices[i]->SetPosition(voices[i]->GetPosition() + Vector3f(0.1f, 0.0f, 0.0f));
+		}
+
+		auto angle = static_cast<float>(tick) * 0.01f;
+		manager.SetListener(Vector3f(std::sin(angle), 0.0f, std::cos(angle)) * 20.0f, Vector3f(std::cos(angle), 0.0f, -std::sin(angle)));
+		manager.Update(delta);
+		manager.Mix(output.data(), SampleRate / TickRate, SampleRate);
+		benchmark::DoNotOptimize(output.data());
+		tick++;
+	}
+
+	state.counters["real"] = static_cast<double>(manager.GetRealCount());
+}
+BENCHMARK(VoiceManagerTick)->ArgNames({"emitters", "voices"})->Args({50, 32})->Args({500, 32})->Args({500, 500})->Unit(benchmark::kMillisecond);
+
+#if defined(ALC_SOFT_loopback)
+/**
+ * A OpenAL Soft loopback device, sources play into a buffer rendered on demand instead of to a sound card.
+ */
+class LoopbackDevice
+{
+public:
+	LoopbackDevice() :
+		m_device(nullptr),
+		m_context(nullptr),
+		m_renderSamples(nullptr),
+		m_source(0)
+	{
+		if (alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback") == ALC_FALSE)
+		{
+			return;
+		}
+
+		auto openDevice = reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT"));
+		m_renderSamples = reinterpret_cast<LPALCRENDERSAMPLESSOFT>(alcGetProcAddress(nullptr, "alcRenderSamplesSOFT"));
+		m_device = openDevice(nullptr);
+
+		if (m_device == nullptr)
+		{
+			return;
+		}
+
+		ALCint attributes[] = {
+			ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT, ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT, ALC_FREQUENCY, static_cast<ALCint>(SampleRate), 0
+		};
+		m_context = alcCreateContext(m_device, attributes);
+		alcMakeContextCurrent(m_context);
+		alGenSources(1, &m_source);
+	}
+
+	~LoopbackDevice()
+	{
+		if (m_source != 0)
+		{
+			alDeleteSources(1, &m_source);
+		}
+
+		alcMakeContextCurrent(nullptr);
+
+		if (m_context != nullptr)
+		{
+			alcDestroyContext(m_context);
+		}
+
+		if (m_device != nullptr)
+		{
+			alcCloseDevice(m_device);
+		}
+	}
+
+	bool IsOpen() const { return m_context != nullptr; }
+
+	const ALuint &GetSource() const { return m_source; }
+
+	/**
+	 * Renders frames of the mix.
+	 * @param frames The number of frames.
+	 * @return If any rendered sample is not silent.
+	 */
+	bool Render(const uint32_t &frames)
+	{
+		m_output.resize(2 * frames);
+		m_renderSamples(m_device, m_output.data(), static_cast<ALCsizei>(frames));
+		return std::any_of(m_output.begin(), m_output.end(), [](const int16_t &sample)
+		{
+			return sample != 0;
+		});
+	}
+
+	/**
+	 * Renders until a sample is heard, a second at most.
+	 * @return If a sample was heard.
+	 */
+	bool RenderFirstSample()
+	{
+		for (uint32_t frames = 0; frames < SampleRate; frames += 64)
+		{
+			if (Render(64))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+private:
+	ALCdevice *m_device;
+	ALCcontext *m_context;
+	LPALCRENDERSAMPLESSOFT m_renderSamples;
+	ALuint m_source;
+	std::vector<int16_t> m_output;
+};
+
+/**
+ * A stereo 16 bit WAV file of a tone in the temporary directory, removed when destroyed.
+ */
+class BenchmarkWav
+{
+public:
+	BenchmarkWav(const std::string &name, const uint32_t &seconds) :
+		m_path((std::filesystem::temp_directory_path() / name).string())
+	{
+		auto write = [](std::ofstream &stream, const uint32_t &value, const std::size_t &size)
+		{
+			for (std::size_t i = 0; i < size; i++)
+			{
+				stream.put(static_cast<char>(value >> (8 * i)));
+			}
+		};
+
+		uint32_t dataSize = seconds * SampleRate * 2 * sizeof(int16_t);
+		std::ofstream stream(m_path, std::ios::binary);
+		stream.write("RIFF", 4);
+		write(stream, 36 + dataSize, 4);
+		stream.write("WAVEfmt ", 8);
+		write(stream, 16, 4);
+		write(stream, 1, 2);
+		write(stream, 2, 2);
+		write(stream, SampleRate, 4);
+		write(stream, SampleRate * 2 * sizeof(int16_t), 4);
+		write(stream, 2 * sizeof(int16_t), 2);
+		write(stream, 16, 2);
+		stream.write("data", 4);
+		write(stream, dataSize, 4);
+
+		// One second of the tone is repeated, 440 Hz fits a second exactly.
+		std::vector<int16_t> second(2 * SampleRate);
+
+		for (uint32_t i = 0; i < SampleRate; i++)
+		{
+			second[2 * i] = second[2 * i + 1] = static_cast<int16_t>(8192.0f * std::sin(2.0f * Maths::Pi * 440.0f * static_cast<float>(i) / SampleRate));
+		}
+
+		for (uint32_t i = 0; i < seconds; i++)
+		{
+			stream.write(reinterpret_cast<const char *>(second.data()), static_cast<std::streamsize>(second.size() * sizeof(int16_t)));
+		}
+	}
+
+	~BenchmarkWav()
+	{
+		std::filesystem::remove(m_path);
+	}
+
+	const std::string &GetPath() const { return m_path; }
+
+private:
+	std::string m_path;
+};
+
+/**
+ * Gets the bytes allocated on the heap, OpenAL Soft keeps its copy of buffer data on the heap too.
+ * @return The heap bytes in use, or 0 where this can't be read.
+ */
+static std::size_t GetHeapInUse()
+{
+#if defined(ACID_BUILD_LINUX)
+	auto info = mallinfo2();
+	return info.uordblks + info.hblkhd;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Times from opening a long file as a stream to its first sample being rendered on a loopback device,
+ * then plays two more seconds so the peak heap covers the buffers rotating through the source.
+ * The peakMB counter is the most heap in use while playing, over what was in use before the stream was opened.
+ * @param state The benchmark state, the argument is the length of the file in seconds.
+ */
+static void SoundStreamFirstSample(benchmark::State &state)
+{
+	LoopbackDevice device;
+
+	if (!device.IsOpen())
+	{
+		state.SkipWithError("OpenAL Soft loopback device could not be opened");
+		return;
+	}
+
+	BenchmarkWav wav("AcidSoundStream.wav", static_cast<uint32_t>(state.range(0)));
+	std::size_t peak = 0;
+
+	for (auto _ : state)
+	{
+		auto heap = GetHeapInUse();
+		auto start = std::chrono::steady_clock::now();
+		SoundStream stream(wav.GetPath());
+		stream.Play(device.GetSource(), false);
+
+		if (!device.RenderFirstSample())
+		{
+			state.SkipWithError("The stream was not heard");
+			return;
+		}
+
+		state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+		for (uint32_t tick = 0; tick < 2 * TickRate; tick++)
+		{
+			device.Render(SampleRate / TickRate);
+			stream.Update();
+			peak = std::max(peak, GetHeapInUse() - heap);
+		}
+	}
+
+	state.counters["peakMB"] = static_cast<double>(peak) / (1024.0 * 1024.0);
+}
+BENCHMARK(SoundStreamFirstSample)->Arg(600)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Times loading the same file whole into a buffer to its first sample being rendered, as sounds were played before streaming.
+ * The samples and OpenAL's copy of them are both held while the buffer is filled, as they are when a sound buffer is uploaded.
+ * @param state The benchmark state, the argument is the length of the file in seconds.
+ */
+static void SoundBufferFirstSample(benchmark::State &state)
+{
+	LoopbackDevice device;
+
+	if (!device.IsOpen())
+	{
+		state.SkipWithError("OpenAL Soft loopback device could not be opened");
+		return;
+	}
+
+	BenchmarkWav wav("AcidSoundBuffer.wav", static_cast<uint32_t>(state.range(0)));
+	std::size_t peak = 0;
+
+	for (auto _ : state)
+	{
+		auto heap = GetHeapInUse();
+		auto start = std::chrono::steady_clock::now();
+
+		// Without an engine the sound buffer keeps its samples rather than uploading them.
+		SoundBuffer soundBuffer(wav.GetPath());
+		const auto &samples = soundBuffer.GetSamples();
+		ALuint buffer;
+		alGenBuffers(1, &buffer);
+		alBufferData(buffer, AL_FORMAT_STEREO16, samples.data(), static_cast<ALsizei>(samples.size() * sizeof(int16_t)), soundBuffer.GetSampleRate());
+		peak = std::max(peak, GetHeapInUse() - heap);
+
+		alSourcei(device.GetSource(), AL_BUFFER, static_cast<ALint>(buffer));
+		alSourcePlay(device.GetSource());
+		auto heard = device.RenderFirstSample();
+		state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+		alSourceStop(device.GetSource());
+		alSourcei(device.GetSource(), AL_BUFFER, 0);
+		alDeleteBuffers(1, &buffer);
+
+		if (!heard)
+		{
+			state.SkipWithError("The buffer was not heard");
+			return;
+		}
+	}
+
+	state.counters["peakMB"] = static_cast<double>(peak) / (1024.0 * 1024.0);
+}
+BENCHMARK(SoundBufferFirstSample)->Arg(600)->UseManualTime()->Unit(benchmark::kMillisecond);
+#endif
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <thread>
+#include <Helpers/Delegate.hpp>
+
+using namespace acid;
+
+/**
+ * The previous delegate, functions are kept in std::function and every invoke locks.
+ */
+template<typename TReturnType, typename... TArgs>
+class LockedDelegate
+{
+public:
+	void Add(std::function<TReturnType(TArgs ...)> &&function)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_functionList.emplace_back(std::move(function));
+	}
+
+	auto Invoke(TArgs ... args)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if constexpr (std::is_void_v<TReturnType>)
+		{
+			for (const auto &function : m_functionList)
+			{
+				function(args...);
+			}
+		}
+		else
+		{
+			std::vector<TReturnType> returnValues;
+
+			for (const auto &function : m_functionList)
+			{
+				returnValues.emplace_back(function(args...));
+			}
+
+			return returnValues;
+		}
+	}
+
+private:
+	std::mutex m_mutex;
+	std::vector<std::function<TReturnType(TArgs ...)>> m_functionList;
+};
+
+/**
+ * The engine always runs worker threads, glibc skips atomic instructions in mutexes until a process starts its first thread.
+ */
+static void StartThread()
+{
+	static std::once_flag started;
+	std::call_once(started, []()
+	{
+		std::thread([]() {}).join();
+	});
+}
+
+/**
+ * Invokes an input event with a number of subscribers, each capturing its owner like the input classes do.
+ */
+template<typename T>
+static void InvokeVoid(benchmark::State &state)
+{
+	StartThread();
+	T delegate;
+	std::vector<float> values(static_cast<std::size_t>(state.range(0)));
+
+	for (auto &value : values)
+	{
+		delegate.Add([&value](float amount)
+		{
+			value += amount;
+		});
+	}
+
+	for (auto _ : state)
+	{
+		delegate.Invoke(0.016f);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void DelegateInvoke(benchmark::State &state)
+{
+	InvokeVoid<Delegate<void(float)>>(state);
+}
+BENCHMARK(DelegateInvoke)->Range(1, 64);
+
+static void LockedDelegateInvoke(benchmark::State &state)
+{
+	InvokeVoid<LockedDelegate<void, float>>(state);
+}
+BENCHMARK(LockedDelegateInvoke)->Range(1, 64);
+
+/**
+ * Invokes a delegate with a return value, the locked delegate collects every result into a vector.
+ */
+template<typename T>
+static void InvokeReturn(benchmark::State &state)
+{
+	StartThread();
+	T delegate;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		delegate.Add([i](int value)
+		{
+			return value + static_cast<int>(i);
+		});
+	}
+
+	for (auto _ : state)
+	{
+		auto result = delegate.Invoke(1);
+		benchmark::DoNotOptimize(result);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void DelegateInvokeReturn(benchmark::State &state)
+{
+	InvokeReturn<Delegate<int(int)>>(state);
+}
+BENCHMARK(DelegateInvokeReturn)->Range(1, 64);
+
+static void LockedDelegateInvokeReturn(benchmark::State &state)
+{
+	InvokeReturn<LockedDelegate<int, int>>(state);
+}
+BENCHMARK(LockedDelegateInvokeReturn)->Range(1, 64);
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include <Maths/Colour.hpp>
+#include <Scenes/EntityPrefab.hpp>
+#include <Scenes/SceneStructure.hpp>
+
+using namespace acid;
+
+/**
+ * A component with a few values decoded from a prefab, like a gameplay behaviour.
+ */
+class BenchmarkEnemy :
+	public Component
+{
+public:
+	void Decode(const Metadata &metadata) override
+	{
+		metadata.GetChild("Name", m_name);
+		metadata.GetChild("Health", m_health);
+		metadata.GetChild("Speed", m_speed);
+		metadata.GetChild("Offset", m_offset);
+	}
+
+	std::string m_name;
+	float m_health = 0.0f;
+	float m_speed = 0.0f;
+	Vector3f m_offset;
+};
+
+class BenchmarkAppearance :
+	public Component
+{
+public:
+	void Decode(const Metadata &metadata) override
+	{
+		metadata.GetChild("Colour", m_colour);
+		metadata.GetChild("Scale", m_scale);
+		metadata.GetChild("Tags", m_tags);
+	}
+
+	Colour m_colour;
+	Vector3f m_scale;
+	std::vector<std::string> m_tags;
+};
+
+/**
+ * Fills a prefab with the benchmark components, the file does not exist so the prefab starts empty.
+ * @param prefab The prefab to fill.
+ */
+static void FillPrefab(EntityPrefab &prefab)
+{
+	auto enemy = prefab.GetParent()->AddChild(new Metadata("BenchmarkEnemy"));
+	enemy->SetChild<std::string>("Name", "Grunt");
+	enemy->SetChild("Health", 100.0f);
+	enemy->SetChild("Speed", 3.5f);
+	enemy->SetChild("Offset", Vector3f(0.0f, 1.0f, 0.0f));
+	auto appearance = prefab.GetParent()->AddChild(new Metadata("BenchmarkAppearance"));
+	appearance->SetChild("Colour", Colour(0.8f, 0.2f, 0.1f));
+	appearance->SetChild("Scale", Vector3f(1.0f, 1.25f, 1.0f));
+	appearance->SetChild("Tags", std::vector<std::string>{ "enemy", "shadow" });
+}
+
+static std::vector<Transform> SpawnTransforms(const int64_t &count)
+{
+	std::vector<Transform> transforms;
+
+	for (int64_t i = 0; i < count; i++)
+	{
+		transforms.emplace_back(Vector3f(static_cast<float>(i), 0.0f, 0.0f));
+	}
+
+	return transforms;
+}
+
+/**
+ * Spawns a wave of entities decoding the prefab metadata for every entity, as entities created from a filename did.
+ */
+static void PrefabDecode(benchmark::State &state)
+{
+	ComponentRegister componentRegister;
+	componentRegister.Add<BenchmarkEnemy>("BenchmarkEnemy");
+	componentRegister.Add<BenchmarkAppearance>("BenchmarkAppearance");
+	EntityPrefab prefab("Benchmark.json");
+	FillPrefab(prefab);
+	auto transforms = SpawnTransforms(state.range(0));
+	SceneStructure structure;
+
+	for (auto _ : state)
+	{
+		for (const auto &transform : transforms)
+		{
+			auto entity = structure.CreateEntity(transform);
+
+			for (const auto &child : prefab.GetParent()->GetChildren())
+			{
+				auto component = componentRegister.Create(child->GetName());
+				component->Decode(*child);
+				entity->AddComponent(component);
+			}
+		}
+
+		structure.Clear();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PrefabDecode)->Range(64, 4096);
+
+/**
+ * Spawns a wave of entities from the compiled prefab, components are copied from templates decoded once.
+ */
+static void PrefabInstantiate(benchmark::State &state)
+{
+	ComponentRegister componentRegister;
+	componentRegister.Add<BenchmarkEnemy>("BenchmarkEnemy");
+	componentRegister.Add<BenchmarkAppearance>("BenchmarkAppearance");
+	EntityPrefab prefab("Benchmark.json");
+	FillPrefab(prefab);
+	prefab.Compile(componentRegister);
+	auto transforms = SpawnTransforms(state.range(0));
+	SceneStructure structure;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(structure.Instantiate(prefab, transforms));
+		structure.Clear();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PrefabInstantiate)->Range(64, 4096);
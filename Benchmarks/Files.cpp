@@ -0,0 +1,251 @@
+#include <condition_variable>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <benchmark/benchmark.h>
+#include <Files/Archive.hpp>
+#include <Files/FileSystem.hpp>
+#include <Files/FileWatcher.hpp>
+
+using namespace acid;
+
+/**
+ * A tree of small text files in the temporary directory, a hundred files to each directory, removed when destroyed.
+ */
+class BenchmarkTree
+{
+public:
+	BenchmarkTree(const std::string &name, const int64_t &count, const std::size_t &fileSize = 0) :
+		m_path((std::filesystem::temp_directory_path() / name).string())
+	{
+		std::filesystem::remove_all(m_path);
+		std::filesystem::create_directories(m_path);
+
+		for (int64_t i = 0; i < count; i++)
+		{
+			auto directory = m_path + FileSystem::Separator + "Directory" + String::To(i / 100);
+
+			if (i % 100 == 0)
+			{
+				std::filesystem::create_directories(directory);
+			}
+
+			auto &file = m_files.emplace_back(directory + FileSystem::Separator + "File" + String::To(i % 100) + ".txt");
+			std::ofstream stream(file);
+			stream << "File " << i;
+
+			for (std::size_t written = 0; written < fileSize; written += 32)
+			{
+				stream << "\nLine " << written << " of file " << i;
+			}
+		}
+	}
+
+	~BenchmarkTree()
+	{
+		std::filesystem::remove_all(m_path);
+	}
+
+	const std::string &GetPath() const { return m_path; }
+
+	const std::vector<std::string> &GetFiles() const { return m_files; }
+
+	/**
+	 * Gets the file paths relative to the tree, as they are packed in a archive.
+	 * @return The relative paths.
+	 */
+	std::vector<std::string> GetRelativeFiles() const
+	{
+		std::vector<std::string> files;
+
+		for (const auto &file : m_files)
+		{
+			files.emplace_back(file.substr(m_path.size() + 1));
+		}
+
+		return files;
+	}
+
+private:
+	std::string m_path;
+	std::vector<std::string> m_files;
+};
+
+/**
+ * Times from creating a file to the watcher sending it, with no debounce so only detection is measured.
+ * Files are created rather than modified, the polling fallback compares modified times in whole seconds.
+ */
+static void FileWatcherLatency(benchmark::State &state)
+{
+	BenchmarkTree tree("AcidFileWatcherLatency", state.range(0));
+	auto created = tree.GetPath() + FileSystem::Separator + "Directory0" + FileSystem::Separator + "Created";
+	FileWatcher watcher(tree.GetPath(), Time::Milliseconds(10), Time::Zero);
+
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::string changedPath;
+	watcher.OnChange().Add([&](std::string path, FileWatcher::Status status)
+	{
+		// The write to the last file may still be sent as a modification.
+		if (status != FileWatcher::Status::Created)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		changedPath = std::move(path);
+		changed.notify_one();
+	});
+
+	int64_t i = 0;
+
+	for (auto _ : state)
+	{
+		auto file = created + String::To(i++) + ".txt";
+		std::unique_lock<std::mutex> lock(mutex);
+		auto start = std::chrono::steady_clock::now();
+		std::ofstream(file) << "Created";
+		changed.wait(lock, [&]()
+		{
+			return changedPath == file;
+		});
+		state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+}
+BENCHMARK(FileWatcherLatency)->Arg(1000)->Arg(10000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+/**
+ * Measures the processor time a watcher with the default delay uses while nothing changes, as a fraction of one core.
+ */
+static void FileWatcherIdle(benchmark::State &state)
+{
+	BenchmarkTree tree("AcidFileWatcherIdle", state.range(0));
+	FileWatcher watcher(tree.GetPath());
+	double cpu = 0.0;
+	double wall = 0.0;
+
+	for (auto _ : state)
+	{
+		// Only the watcher thread runs while this thread sleeps.
+		auto startCpu = std::clock();
+		auto start = std::chrono::steady_clock::now();
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+		auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		cpu += static_cast<double>(std::clock() - startCpu) / CLOCKS_PER_SEC;
+		wall += elapsed;
+		state.SetIterationTime(elapsed);
+	}
+
+	state.counters["CpuUsage"] = cpu / wall;
+}
+BENCHMARK(FileWatcherIdle)->Arg(1000)->Arg(10000)->Iterations(5)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Scans the tree as the polling fallback does every delay, reading the modified time of every file.
+ */
+static void FileWatcherPollScan(benchmark::State &state)
+{
+	BenchmarkTree tree("AcidFileWatcherPollScan", state.range(0));
+
+	for (auto _ : state)
+	{
+		for (const auto &file : FileSystem::FilesInPath(tree.GetPath()))
+		{
+			benchmark::DoNotOptimize(FileSystem::LastModified(file));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(FileWatcherPollScan)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Sums the bytes of a loaded file, so every benchmark reads the whole contents.
+ */
+static uint32_t Checksum(const char *data, const std::size_t &size)
+{
+	uint32_t sum = 0;
+
+	for (std::size_t i = 0; i < size; i++)
+	{
+		sum += static_cast<uint8_t>(data[i]);
+	}
+
+	return sum;
+}
+
+/**
+ * Loads every loose file by opening and copying it, as loose files are read through search paths.
+ */
+static void ArchiveLooseRead(benchmark::State &state)
+{
+	BenchmarkTree tree("AcidArchiveLoose", state.range(0), 2048);
+	int64_t bytes = 0;
+
+	for (auto _ : state)
+	{
+		for (const auto &file : tree.GetFiles())
+		{
+			auto data = FileSystem::ReadBinaryFile(file);
+			benchmark::DoNotOptimize(Checksum(data->data(), data->size()));
+			bytes += static_cast<int64_t>(data->size());
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(bytes);
+}
+BENCHMARK(ArchiveLooseRead)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void ArchiveLooseMap(benchmark::State &state)
+{
+	BenchmarkTree tree("AcidArchiveLooseMap", state.range(0), 2048);
+	int64_t bytes = 0;
+
+	for (auto _ : state)
+	{
+		for (const auto &file : tree.GetFiles())
+		{
+			auto view = FileView::Map(file);
+			benchmark::DoNotOptimize(Checksum(view->GetData(), view->GetSize()));
+			bytes += static_cast<int64_t>(view->GetSize());
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(bytes);
+}
+BENCHMARK(ArchiveLooseMap)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Loads every file from a archive packed from the same tree, the archive is opened once as when it is mounted.
+ * @param state The benchmark state, the second argument is if entries are compressed.
+ */
+static void ArchiveRead(benchmark::State &state)
+{
+	BenchmarkTree tree("AcidArchivePacked", state.range(0), 2048);
+	auto filename = tree.GetPath() + ".arc";
+	auto files = tree.GetRelativeFiles();
+	Archive::Build(filename, tree.GetPath(), files, state.range(1) != 0);
+
+	{
+		Archive archive(filename);
+		int64_t bytes = 0;
+
+		for (auto _ : state)
+		{
+			for (const auto &file : files)
+			{
+				auto view = archive.Read(file);
+				benchmark::DoNotOptimize(Checksum(view->GetData(), view->GetSize()));
+				bytes += static_cast<int64_t>(view->GetSize());
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.SetBytesProcessed(bytes);
+	}
+
+	std::filesystem::remove(filename);
+}
+BENCHMARK(ArchiveRead)->ArgNames({"files", "compress"})->Args({1000, 0})->Args({10000, 0})->Args({1000, 1})->Args({10000, 1})->Unit(benchmark::kMillisecond);
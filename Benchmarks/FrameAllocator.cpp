@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+#include <Engine/FrameAllocator.hpp>
+#include <Maths/Matrix4.hpp>
+
+using namespace acid;
+
+/**
+ * Fills a list of pointers from the heap, as per frame queries did.
+ */
+static void VectorHeap(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		std::vector<void *> values;
+
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			values.emplace_back(&values);
+		}
+
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(VectorHeap)->Range(64, 4096);
+
+/**
+ * Fills a list of pointers from the frame allocator, reset every iteration as at the end of a frame.
+ */
+static void VectorFrame(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		{
+			FrameAllocator::Vector<void *> values(FrameAllocator::Get());
+
+			for (int64_t i = 0; i < state.range(0); i++)
+			{
+				values.emplace_back(&values);
+			}
+
+			benchmark::DoNotOptimize(values.data());
+		}
+
+		FrameAllocator::Reset();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(VectorFrame)->Range(64, 4096);
+
+static std::vector<std::string> JointNames(const int64_t &count)
+{
+	std::vector<std::string> names;
+
+	for (int64_t i = 0; i < count; i++)
+	{
+		names.emplace_back("Armature_Joint_" + std::to_string(i));
+	}
+
+	return names;
+}
+
+/**
+ * Builds an animation pose keyed by copied joint names on the heap.
+ */
+static void PoseHeap(benchmark::State &state)
+{
+	auto names = JointNames(state.range(0));
+
+	for (auto _ : state)
+	{
+		std::map<std::string, Matrix4> pose;
+
+		for (const auto &name : names)
+		{
+			pose.emplace(name, Matrix4::Identity);
+		}
+
+		benchmark::DoNotOptimize(pose.size());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PoseHeap)->Range(16, 256);
+
+/**
+ * Builds an animation pose keyed by views of the joint names in the frame allocator.
+ */
+static void PoseFrame(benchmark::State &state)
+{
+	auto names = JointNames(state.range(0));
+
+	for (auto _ : state)
+	{
+		{
+			FrameAllocator::Map<std::string_view, Matrix4, std::less<>> pose(FrameAllocator::Get());
+
+			for (const auto &name : names)
+			{
+				pose.emplace(name, Matrix4::Identity);
+			}
+
+			benchmark::DoNotOptimize(pose.size());
+		}
+
+		FrameAllocator::Reset();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PoseFrame)->Range(16, 256);
@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <benchmark/benchmark.h>
+#include <Engine/Log.hpp>
+
+using namespace acid;
+
+/**
+ * The previous logger, messages are formatted into a new string on the calling thread and written under a global mutex.
+ */
+class LockedLog
+{
+public:
+	template<typename... Args>
+	static void Out(const char *format, Args ... args)
+	{
+		auto length = std::snprintf(nullptr, 0, format, args...);
+		std::string string(static_cast<std::size_t>(length), '\0');
+		std::snprintf(string.data(), string.size() + 1, format, args...);
+
+		std::lock_guard<std::mutex> lock(Mutex);
+		Stream << string;
+	}
+
+	static std::mutex Mutex;
+	static std::ofstream Stream;
+};
+
+std::mutex LockedLog::Mutex;
+std::ofstream LockedLog::Stream;
+
+/**
+ * Both loggers write to a file in the temporary directory and not the console, so the results stay readable.
+ */
+static void OpenLogs()
+{
+	static std::once_flag opened;
+	std::call_once(opened, []()
+	{
+		auto directory = std::filesystem::temp_directory_path();
+		Log::OpenLog((directory / "AcidLog.txt").string());
+		Log::SetConsole(false);
+		Log::SetRateLimit(0);
+		LockedLog::Stream.open(directory / "AcidLockedLog.txt");
+	});
+}
+
+/**
+ * Logs a message with a few arguments from every thread, the dropped counter is the messages dropped because a queue was full.
+ * Each thread waits for the sink untimed before its queue fills, so the cost of queueing is measured rather than of dropping.
+ */
+static void LogOut(benchmark::State &state)
+{
+	uint64_t dropped = 0;
+
+	if (state.thread_index() == 0)
+	{
+		OpenLogs();
+		dropped = Log::GetDropped();
+	}
+
+	uint32_t id = 0;
+
+	for (auto _ : state)
+	{
+		Log::Out("Entity %u moved to %f %f %f\n", id++, 1.0f, 2.0f, 3.0f);
+
+		if (id % 256 == 0)
+		{
+			state.PauseTiming();
+			Log::Flush();
+			state.ResumeTiming();
+		}
+	}
+
+	if (state.thread_index() == 0)
+	{
+		Log::Flush();
+		state.counters["dropped"] = static_cast<double>(Log::GetDropped() - dropped);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(LogOut)->Threads(1)->Threads(16);
+
+static void LockedLogOut(benchmark::State &state)
+{
+	if (state.thread_index() == 0)
+	{
+		OpenLogs();
+	}
+
+	uint32_t id = 0;
+
+	for (auto _ : state)
+	{
+		LockedLog::Out("Entity %u moved to %f %f %f\n", id++, 1.0, 2.0, 3.0);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(LockedLogOut)->Threads(1)->Threads(16);
@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+// Every benchmark runs without a window or GPU, so this runs on build machines.
+// Pass "--benchmark_out=<file> --benchmark_out_format=json" or build RunBenchmarks to keep the results.
+BENCHMARK_MAIN();
@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+#include <Maths/Matrix4.hpp>
+#include <Maths/Quaternion.hpp>
+#include <Maths/Vector3.hpp>
+#include <Maths/Noise/Noise.hpp>
+
+using namespace acid;
+
+static void Matrix4Multiply(benchmark::State &state)
+{
+	auto a = Matrix4::TransformationMatrix(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(0.1f, 0.2f, 0.3f), Vector3f(2.0f));
+	auto b = Matrix4::PerspectiveMatrix(1.0f, 1.5f, 0.1f, 100.0f);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a = a.Multiply(b));
+	}
+}
+BENCHMARK(Matrix4Multiply);
+
+static void Matrix4Inverse(benchmark::State &state)
+{
+	auto a = Matrix4::TransformationMatrix(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(0.1f, 0.2f, 0.3f), Vector3f(2.0f));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a.Inverse());
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(Matrix4Inverse);
+
+static void Matrix4TransformationMatrix(benchmark::State &state)
+{
+	Vector3f position(1.0f, 2.0f, 3.0f);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(Matrix4::TransformationMatrix(position, Vector3f(0.1f, 0.2f, 0.3f), Vector3f(2.0f)));
+		position.m_x += 0.01f;
+	}
+}
+BENCHMARK(Matrix4TransformationMatrix);
+
+static void Matrix4Transform(benchmark::State &state)
+{
+	auto a = Matrix4::ViewMatrix(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(0.1f, 0.2f, 0.3f));
+	Vector4f point(1.0f, 1.0f, 1.0f, 1.0f);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(point = a.Transform(point));
+	}
+}
+BENCHMARK(Matrix4Transform);
+
+static void Vector3Normalize(benchmark::State &state)
+{
+	Vector3f a(12.9f, -2.0f, 6.7f);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a.Normalize());
+		a.m_x += 0.01f;
+	}
+}
+BENCHMARK(Vector3Normalize);
+
+static void Vector3Cross(benchmark::State &state)
+{
+	Vector3f a(12.9f, -2.0f, 6.7f);
+	Vector3f b(-9.7f, 15.9f, -13.8f);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a = a.Cross(b).Normalize());
+	}
+}
+BENCHMARK(Vector3Cross);
+
+static void Vector3Angle(benchmark::State &state)
+{
+	Vector3f a(12.9f, -2.0f, 6.7f);
+	Vector3f b(-9.7f, 15.9f, -13.8f);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a.Angle(b));
+		a.m_x += 0.01f;
+	}
+}
+BENCHMARK(Vector3Angle);
+
+static void QuaternionMultiply(benchmark::State &state)
+{
+	Quaternion a(Vector3f(0.1f, 0.2f, 0.3f));
+	Vector3f point(1.0f, 2.0f, 3.0f);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(point = a.Multiply(point));
+	}
+}
+BENCHMARK(QuaternionMultiply);
+
+static void QuaternionSlerp(benchmark::State &state)
+{
+	Quaternion a(Vector3f(0.1f, 0.2f, 0.3f));
+	Quaternion b(Vector3f(1.1f, -0.5f, 2.0f));
+	auto progression = 0.0f;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a.Slerp(b, progression));
+		progression = progression < 1.0f ? progression + 0.001f : 0.0f;
+	}
+}
+BENCHMARK(QuaternionSlerp);
+
+static void QuaternionToMatrix(benchmark::State &state)
+{
+	Quaternion a(Vector3f(0.1f, 0.2f, 0.3f));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a.ToRotationMatrix());
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(QuaternionToMatrix);
+
+/**
+ * Samples a 64x64 grid, the same access pattern as generating a terrain tile.
+ */
+template<float (Noise::*Function)(float, float) const>
+static void NoiseGrid(benchmark::State &state)
+{
+	Noise noise(420, 0.01f, Noise::Interp::Quintic, Noise::Type::Simplex, 4);
+	auto offset = 0.0f;
+
+	for (auto _ : state)
+	{
+		auto sum = 0.0f;
+
+		for (int32_t y = 0; y < 64; y++)
+		{
+			for (int32_t x = 0; x < 64; x++)
+			{
+				sum += (noise.*Function)(offset + static_cast<float>(x), static_cast<float>(y));
+			}
+		}
+
+		benchmark::DoNotOptimize(sum);
+		offset += 64.0f;
+	}
+
+	state.SetItemsProcessed(state.iterations() * 64 * 64);
+}
+BENCHMARK_TEMPLATE(NoiseGrid, &Noise::GetPerlin);
+BENCHMARK_TEMPLATE(NoiseGrid, &Noise::GetSimplex);
+BENCHMARK_TEMPLATE(NoiseGrid, &Noise::GetSimplexFractal);
+BENCHMARK_TEMPLATE(NoiseGrid, &Noise::GetCellular);
@@ -0,0 +1,605 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <benchmark/benchmark.h>
+#include <Engine/FrameAllocator.hpp>
+#include <Helpers/String.hpp>
+#include <Network/Http/Http.hpp>
+#include <Network/Http/HttpClient.hpp>
+#include <Network/Netcode/NetClient.hpp>
+#include <Network/Netcode/NetServer.hpp>
+#include <Network/Packet.hpp>
+#include <Network/SocketSelector.hpp>
+#include <Network/Tcp/TcpListener.hpp>
+#include <Network/Tcp/TcpSocket.hpp>
+#include <Network/Udp/UdpSocket.hpp>
+
+#if !defined(ACID_BUILD_WINDOWS)
+#include <sys/resource.h>
+#endif
+
+using namespace acid;
+
+/**
+ * Writes then reads a packet shaped like an entity state update.
+ */
+static void PacketRoundTrip(benchmark::State &state)
+{
+	std::string name = "Player";
+
+	for (auto _ : state)
+	{
+		Packet packet;
+
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			packet << static_cast<uint32_t>(i) << 1.0f << 2.0f << 3.0f << 0.5 << true << name;
+		}
+
+		uint32_t id;
+		float x, y, z;
+		double time;
+		bool grounded;
+		std::string read;
+
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			packet >> id >> x >> y >> z >> time >> grounded >> read;
+		}
+
+		benchmark::DoNotOptimize(id);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PacketRoundTrip)->Range(1, 256);
+
+/**
+ * Raises the open file limit so both ends of every loopback connection fit in this process.
+ * @param connections The number of connections wanted.
+ * @return The number of connections that fit.
+ */
+static std::size_t ReserveConnections(const std::size_t &connections)
+{
+#if !defined(ACID_BUILD_WINDOWS)
+	rlimit limit = {};
+	getrlimit(RLIMIT_NOFILE, &limit);
+	auto wanted = static_cast<rlim_t>(2 * connections + 64);
+
+	if (limit.rlim_cur < wanted)
+	{
+		limit.rlim_cur = std::min(wanted, limit.rlim_max);
+		setrlimit(RLIMIT_NOFILE, &limit);
+		getrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	return std::min(connections, static_cast<std::size_t>(limit.rlim_cur - 64) / 2);
+#else
+	return connections;
+#endif
+}
+
+/**
+ * Connects clients to a server thread over loopback, the server waits on a selector and echoes every byte it receives.
+ */
+class EchoServer
+{
+public:
+	explicit EchoServer(const std::size_t &connections) :
+		m_running(true)
+	{
+		m_listener.Listen(0, IpAddress::LocalHost);
+
+		for (std::size_t i = 0; i < connections; i++)
+		{
+			auto &client = m_clients.emplace_back(std::make_unique<TcpSocket>());
+			auto &accepted = m_accepted.emplace_back(std::make_unique<TcpSocket>());
+
+			if (client->Connect(IpAddress::LocalHost, m_listener.GetLocalPort()) != Socket::Status::Done ||
+				m_listener.Accept(*accepted) != Socket::Status::Done)
+			{
+				m_clients.pop_back();
+				m_accepted.pop_back();
+				break;
+			}
+
+			m_selector.Add(*accepted);
+		}
+
+		m_thread = std::thread([this]()
+		{
+			while (m_running)
+			{
+				if (!m_selector.Wait(Time::Milliseconds(100)))
+				{
+					continue;
+				}
+
+				for (auto socket : m_selector.GetReadySockets())
+				{
+					auto tcpSocket = static_cast<TcpSocket *>(socket);
+					char byte;
+					std::size_t received;
+
+					if (tcpSocket->Receive(&byte, 1, received) == Socket::Status::Done)
+					{
+						tcpSocket->Send(&byte, 1);
+					}
+				}
+			}
+		});
+	}
+
+	~EchoServer()
+	{
+		m_running = false;
+		m_thread.join();
+	}
+
+	const std::vector<std::unique_ptr<TcpSocket>> &GetClients() const { return m_clients; }
+
+private:
+	TcpListener m_listener;
+	std::vector<std::unique_ptr<TcpSocket>> m_clients;
+	std::vector<std::unique_ptr<TcpSocket>> m_accepted;
+	SocketSelector m_selector;
+	std::atomic<bool> m_running;
+	std::thread m_thread;
+};
+
+/**
+ * A stand-in web server on loopback, a thread answers every request with a small body.
+ * Connections are kept alive unless the request is HTTP/1.0 or asks to close, as a keep-alive server would.
+ */
+class HttpServer
+{
+public:
+	HttpServer() :
+		m_running(true),
+		m_body(256, 'B')
+	{
+		m_listener.Listen(0, IpAddress::LocalHost);
+		m_selector.Add(m_listener);
+		m_response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: " + String::To(m_body.size()) + "\r\n\r\n" + m_body;
+
+		m_thread = std::thread([this]()
+		{
+			while (m_running)
+			{
+				if (m_selector.Wait(Time::Milliseconds(100)))
+				{
+					Process();
+				}
+			}
+		});
+	}
+
+	~HttpServer()
+	{
+		m_running = false;
+		m_thread.join();
+	}
+
+	uint16_t GetPort() const { return m_listener.GetLocalPort(); }
+
+	const std::string &GetBody() const { return m_body; }
+
+private:
+	struct Connection
+	{
+		TcpSocket m_socket;
+		std::string m_received;
+	};
+
+	void Process()
+	{
+		if (m_selector.IsReady(m_listener))
+		{
+			auto connection = std::make_unique<Connection>();
+
+			if (m_listener.Accept(connection->m_socket) == Socket::Status::Done)
+			{
+				m_selector.Add(connection->m_socket);
+				m_connections.emplace_back(std::move(connection));
+			}
+		}
+
+		for (auto it = m_connections.begin(); it != m_connections.end();)
+		{
+			if (!m_selector.IsReady((*it)->m_socket) || Respond(**it))
+			{
+				++it;
+				continue;
+			}
+
+			m_selector.Remove((*it)->m_socket);
+			(*it)->m_socket.Disconnect();
+			it = m_connections.erase(it);
+		}
+	}
+
+	/**
+	 * Answers every complete request received on a connection, requests have no body.
+	 * @return If the connection stays open.
+	 */
+	bool Respond(Connection &connection)
+	{
+		char buffer[4096];
+		std::size_t received;
+
+		if (connection.m_socket.Receive(buffer, sizeof(buffer), received) != Socket::Status::Done)
+		{
+			return false;
+		}
+
+		connection.m_received.append(buffer, received);
+		std::string responses;
+		auto keepAlive = true;
+		std::size_t end;
+
+		while (keepAlive && (end = connection.m_received.find("\r\n\r\n")) != std::string::npos)
+		{
+			auto request = connection.m_received.substr(0, end);
+			connection.m_received.erase(0, end + 4);
+			keepAlive = request.find("HTTP/1.0") == std::string::npos && request.find("Connection: close") == std::string::npos;
+			responses += m_response;
+		}
+
+		if (!responses.empty())
+		{
+			connection.m_socket.Send(responses.data(), responses.size());
+		}
+
+		return keepAlive;
+	}
+
+	TcpListener m_listener;
+	SocketSelector m_selector;
+	std::vector<std::unique_ptr<Connection>> m_connections;
+	std::atomic<bool> m_running;
+	std::string m_body;
+	std::string m_response;
+	std::thread m_thread;
+};
+
+/**
+ * Times a one byte round trip on one connection at a time while every other connection stays open and idle.
+ * The p50, p99 and p999 counters are the round trip latency percentiles in microseconds.
+ */
+static void SocketSelectorLatency(benchmark::State &state)
+{
+	EchoServer server(ReserveConnections(static_cast<std::size_t>(state.range(0))));
+	const auto &clients = server.GetClients();
+	std::vector<double> latencies;
+	std::size_t i = 0;
+
+	for (auto _ : state)
+	{
+		// Steps through the connections out of order, so the ready socket is never the last one.
+		auto &client = clients[(i++ * 7919) % clients.size()];
+		char byte = 1;
+		std::size_t received;
+
+		auto start = std::chrono::steady_clock::now();
+		client->Send(&byte, 1);
+		client->Receive(&byte, 1, received);
+		auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		state.SetIterationTime(elapsed);
+		latencies.emplace_back(elapsed);
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](const double &fraction)
+	{
+		return 1000000.0 * latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(fraction * static_cast<double>(latencies.size())))];
+	};
+	state.counters["connections"] = static_cast<double>(clients.size());
+	state.counters["p50"] = percentile(0.5);
+	state.counters["p99"] = percentile(0.99);
+	state.counters["p999"] = percentile(0.999);
+}
+BENCHMARK(SocketSelectorLatency)->Arg(100)->Arg(1000)->Arg(10000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+/**
+ * Sends requests to the stand-in server one at a time, connecting for each request and waiting for the server to close.
+ */
+static void HttpSendRequest(benchmark::State &state)
+{
+	HttpServer server;
+	Http http("127.0.0.1", server.GetPort());
+
+	for (auto _ : state)
+	{
+		auto response = http.SendRequest(HttpRequest("/"));
+
+		if (response.GetBody() != server.GetBody())
+		{
+			state.SkipWithError("Request failed");
+			return;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(HttpSendRequest)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Sends a wave of requests to the stand-in server and waits for them all, over kept alive and pipelined connections.
+ * @param state The benchmark state, the argument is the requests in each wave.
+ */
+static void HttpClientRequests(benchmark::State &state)
+{
+	HttpServer server;
+	HttpClient client;
+	auto host = "127.0.0.1:" + String::To(server.GetPort());
+	int64_t completed = 0;
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			client.Send(host, HttpRequest("/"), [&](const HttpResponse &response)
+			{
+				if (response.GetBody() == server.GetBody())
+				{
+					completed++;
+				}
+			});
+		}
+
+		if (!client.Wait(Time::Seconds(10.0f)))
+		{
+			state.SkipWithError("Requests timed out");
+			return;
+		}
+	}
+
+	if (completed != state.iterations() * state.range(0))
+	{
+		state.SkipWithError("Requests failed");
+	}
+
+	state.counters["connections"] = static_cast<double>(client.GetConnectionCount());
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(HttpClientRequests)->Arg(1)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Gets if heap allocations are counted, Acid must be built with ACID_COUNT_ALLOCATIONS.
+ * @return If allocations are counted.
+ */
+static bool CountingAllocations()
+{
+	auto before = FrameAllocator::GetHeapAllocations();
+	auto value = new int(0);
+	benchmark::DoNotOptimize(value);
+	delete value;
+	return FrameAllocator::GetHeapAllocations() != before;
+}
+
+/**
+ * Sends packets shaped like entity state updates over a loopback connection and reads them back on the other end.
+ * When allocations are counted the allocations counter is the heap allocations made for each packet sent and received.
+ */
+static void TcpSocketPacketLoopback(benchmark::State &state)
+{
+	TcpListener listener;
+	listener.Listen(0, IpAddress::LocalHost);
+	TcpSocket sender;
+	TcpSocket receiver;
+	sender.Connect(IpAddress::LocalHost, listener.GetLocalPort());
+	listener.Accept(receiver);
+
+	std::string name = "Player";
+	Packet received;
+	auto allocations = FrameAllocator::GetHeapAllocations();
+
+	for (auto _ : state)
+	{
+		Packet packet;
+
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			packet << static_cast<uint32_t>(i) << 1.0f << 2.0f << 3.0f << 0.5 << true << name;
+		}
+
+		sender.Send(packet);
+		receiver.Receive(received);
+
+		uint32_t id;
+		float x, y, z;
+		double time;
+		bool grounded;
+		std::string read;
+
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			received >> id >> x >> y >> z >> time >> grounded >> read;
+		}
+
+		benchmark::DoNotOptimize(id);
+	}
+
+	if (CountingAllocations())
+	{
+		state.counters["allocations"] = benchmark::Counter(static_cast<double>(FrameAllocator::GetHeapAllocations() - allocations),
+			benchmark::Counter::kAvgIterations);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(received.GetDataSize()));
+}
+BENCHMARK(TcpSocketPacketLoopback)->Range(1, 256);
+
+/**
+ * Sends a wave of snapshot sized datagrams to a socket bound on loopback one at a time, then receives them one at a time.
+ */
+static void UdpSocketSendReceive(benchmark::State &state)
+{
+	UdpSocket sender;
+	UdpSocket receiver;
+	receiver.Bind(0, IpAddress::LocalHost);
+	std::vector<char> snapshot(64, 'S');
+	std::vector<char> buffer(1500);
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			sender.Send(snapshot.data(), snapshot.size(), IpAddress::LocalHost, receiver.GetLocalPort());
+		}
+
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			std::size_t received;
+			IpAddress address;
+			uint16_t port;
+			receiver.Receive(buffer.data(), buffer.size(), received, address, port);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(UdpSocketSendReceive)->Range(8, 256);
+
+/**
+ * Sends and receives the same waves with the batch functions.
+ */
+static void UdpSocketSendReceiveBatch(benchmark::State &state)
+{
+	UdpSocket sender;
+	UdpSocket receiver;
+	receiver.Bind(0, IpAddress::LocalHost);
+	std::vector<char> snapshot(64, 'S');
+	std::vector<std::vector<char>> buffers(static_cast<std::size_t>(state.range(0)), std::vector<char>(1500));
+	std::vector<UdpDatagram> sends;
+	std::vector<UdpDatagram> receives;
+
+	for (auto &buffer : buffers)
+	{
+		sends.emplace_back(UdpDatagram{snapshot.data(), snapshot.size(), 0, IpAddress::LocalHost, receiver.GetLocalPort()});
+		receives.emplace_back(UdpDatagram{buffer.data(), buffer.size(), 0, IpAddress(), 0});
+	}
+
+	for (auto _ : state)
+	{
+		std::size_t sent;
+		sender.SendBatch(sends.data(), sends.size(), sent);
+
+		// A batch receive takes the datagrams already waiting, so the wave may arrive in more than one.
+		for (std::size_t total = 0; total < sent;)
+		{
+			std::size_t received;
+			receiver.ReceiveBatch(receives.data() + total, receives.size() - total, received);
+			total += received;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(UdpSocketSendReceiveBatch)->Range(8, 256);
+
+/**
+ * Replicates entities to clients over loopback for a tick each iteration, a quarter of the entities move each tick.
+ * The bytesPerTick and encodeUs counters are the snapshot bytes sent to and encode time spent on each client each tick.
+ * @param state The benchmark state, the arguments are the client and entity counts.
+ */
+static void NetServerSnapshots(benchmark::State &state)
+{
+	auto clientCount = static_cast<uint32_t>(state.range(0));
+	auto entityCount = static_cast<uint32_t>(state.range(1));
+	NetServer server(0, clientCount);
+	std::vector<std::unique_ptr<NetClient>> clients;
+
+	for (uint32_t i = 0; i < clientCount; i++)
+	{
+		auto &client = clients.emplace_back(std::make_unique<NetClient>());
+		client->Connect(IpAddress::LocalHost, server.GetLocalPort());
+		client->Send();
+	}
+
+	server.Receive();
+
+	if (server.GetClientCount() != clientCount)
+	{
+		state.SkipWithError("Clients failed to connect");
+		return;
+	}
+
+	std::vector<Vector3f> positions(entityCount);
+
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		positions[i] = Vector3f(static_cast<float>(i % 32) * 4.0f, 0.0f, static_cast<float>(i / 32) * 4.0f);
+	}
+
+	auto tick = [&](const uint32_t &number)
+	{
+		auto &snapshot = server.CreateSnapshot();
+
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			if ((i + number) % 4 == 0)
+			{
+				positions[i].m_y += 0.05f;
+			}
+
+			snapshot.Add(i + 1, positions[i], Vector3f(0.0f, static_cast<float>(i), 0.0f), Vector3f::One);
+		}
+
+		server.Send();
+
+		for (auto &client : clients)
+		{
+			client->Receive();
+			client->Send();
+		}
+
+		server.Receive();
+	};
+
+	// The first ticks are full snapshots until each client acknowledges a baseline.
+	uint32_t number = 0;
+
+	for (; number < 4; number++)
+	{
+		tick(number);
+	}
+
+	auto totals = [&](uint64_t &bytes, Time &encodeTime)
+	{
+		for (uint32_t i = 0; i < clientCount; i++)
+		{
+			bytes += server.GetStatistics(i)->m_bytesSent;
+			encodeTime += server.GetStatistics(i)->m_encodeTimeTotal;
+		}
+	};
+
+	uint64_t bytesStart = 0, bytes = 0;
+	Time encodeTimeStart, encodeTime;
+	totals(bytesStart, encodeTimeStart);
+
+	for (auto _ : state)
+	{
+		tick(number++);
+	}
+
+	totals(bytes, encodeTime);
+
+	for (const auto &client : clients)
+	{
+		auto snapshot = client->GetSnapshot();
+
+		if (snapshot == nullptr || snapshot->GetEntities().size() != entityCount)
+		{
+			state.SkipWithError("Client snapshots do not match the server");
+			return;
+		}
+	}
+
+	auto ticks = static_cast<double>(state.iterations() * clientCount);
+	state.counters["bytesPerTick"] = static_cast<double>(bytes - bytesStart) / ticks;
+	state.counters["encodeUs"] = (encodeTime - encodeTimeStart).AsMicroseconds<double>() / ticks;
+}
+BENCHMARK(NetServerSnapshots)->ArgNames({"clients", "entities"})->Args({1, 500})->Args({8, 500})->Args({32, 500})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <Scenes/Component.hpp>
+
+using namespace acid;
+
+/**
+ * A component the size of a typical small component, allocated from its object pool.
+ */
+class BenchmarkBullet :
+	public Component
+{
+public:
+	float m_position[3] = {};
+	float m_velocity[3] = {};
+	float m_lifetime = 0.0f;
+};
+
+/**
+ * The same object allocated with the global operator new.
+ */
+class BenchmarkHeapBullet
+{
+public:
+	virtual ~BenchmarkHeapBullet() = default;
+
+	bool m_flags[3] = {};
+	void *m_parent = nullptr;
+	float m_position[3] = {};
+	float m_velocity[3] = {};
+	float m_lifetime = 0.0f;
+};
+
+/**
+ * Spawns a wave of objects and despawns them in a random order, as bullets and particles are.
+ */
+template<typename T>
+static void Churn(benchmark::State &state)
+{
+	std::vector<T *> objects(static_cast<std::size_t>(state.range(0)));
+	std::vector<std::size_t> order(objects.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+	for (auto _ : state)
+	{
+		for (auto &object : objects)
+		{
+			object = new T();
+		}
+
+		for (const auto &i : order)
+		{
+			delete objects[i];
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ObjectPoolChurn(benchmark::State &state)
+{
+	Churn<BenchmarkBullet>(state);
+}
+BENCHMARK(ObjectPoolChurn)->Range(64, 4096);
+
+static void HeapChurn(benchmark::State &state)
+{
+	Churn<BenchmarkHeapBullet>(state);
+}
+BENCHMARK(HeapChurn)->Range(64, 4096);
+
+/**
+ * Updates objects that were spawned between other allocations, pooled objects stay packed in their slabs.
+ */
+template<typename T>
+static void Iterate(benchmark::State &state)
+{
+	std::mt19937 random(42);
+	std::uniform_int_distribution<std::size_t> sizes(16, 512);
+	std::vector<std::unique_ptr<char[]>> others;
+	std::vector<T *> objects;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		others.emplace_back(std::make_unique<char[]>(sizes(random)));
+		objects.emplace_back(new T());
+	}
+
+	for (auto _ : state)
+	{
+		for (auto &object : objects)
+		{
+			object->m_lifetime += 0.016f;
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	for (auto &object : objects)
+	{
+		delete object;
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ObjectPoolIterate(benchmark::State &state)
+{
+	Iterate<BenchmarkBullet>(state);
+}
+BENCHMARK(ObjectPoolIterate)->Range(4096, 65536);
+
+static void HeapIterate(benchmark::State &state)
+{
+	Iterate<BenchmarkHeapBullet>(state);
+}
+BENCHMARK(HeapIterate)->Range(4096, 65536);
@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+#include <Resources/Resources.hpp>
+
+using namespace acid;
+
+class BenchmarkResource :
+	public Resource
+{
+};
+
+/**
+ * Finds resources by the metadata they were created from, as every Resource::Create does before loading.
+ */
+static void ResourcesFind(benchmark::State &state)
+{
+	Resources resources;
+	std::vector<std::unique_ptr<Metadata>> keys;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		auto &key = keys.emplace_back(std::make_unique<Metadata>());
+		key->SetChild("filename", "Objects/Object" + String::To(i) + "/Diffuse.png");
+		key->SetChild("anisotropic", true);
+		key->SetChild("mipmap", true);
+		resources.Add(*key, std::make_shared<BenchmarkResource>());
+	}
+
+	std::size_t i = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(resources.Find(*keys[i]));
+		i = (i + 1) % keys.size();
+	}
+}
+BENCHMARK(ResourcesFind)->Range(16, 1024);
@@ -0,0 +1,507 @@
+#include <set>
+#include <benchmark/benchmark.h>
+#include <btBulletDynamicsCommon.h>
+#include <Physics/CollisionObject.hpp>
+#include <Scenes/ScenePhysics.hpp>
+#include <Scenes/SceneStructure.hpp>
+
+using namespace acid;
+
+class BenchmarkHealth :
+	public Component
+{
+};
+
+class BenchmarkMesh :
+	public Component
+{
+};
+
+class BenchmarkMaterial :
+	public Component
+{
+};
+
+class BenchmarkCollider :
+	public Component
+{
+};
+
+/**
+ * Queries one component type from a structure where every entity has several components, as the renderers do each frame.
+ */
+static void SceneStructureQueryComponents(benchmark::State &state)
+{
+	SceneStructure structure;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		auto entity = structure.CreateEntity(Transform());
+		entity->AddComponent<BenchmarkMesh>();
+
+		if (i % 4 == 0)
+		{
+			entity->AddComponent<BenchmarkHealth>();
+		}
+	}
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(structure.QueryComponents<BenchmarkHealth>());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructureQueryComponents)->Range(64, 4096);
+
+/**
+ * The same query with the result in the frame allocator, reset every iteration as at the end of a frame.
+ */
+static void SceneStructureQueryComponentsFrame(benchmark::State &state)
+{
+	SceneStructure structure;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		auto entity = structure.CreateEntity(Transform());
+		entity->AddComponent<BenchmarkMesh>();
+
+		if (i % 4 == 0)
+		{
+			entity->AddComponent<BenchmarkHealth>();
+		}
+	}
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(structure.QueryComponents<BenchmarkHealth>(false, FrameAllocator::Get()));
+		FrameAllocator::Reset();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructureQueryComponentsFrame)->Range(64, 4096);
+
+/**
+ * Creates an entity with the components of a rendered physics object.
+ */
+static std::unique_ptr<Entity> RenderedEntity()
+{
+	auto entity = std::make_unique<Entity>(Transform());
+	entity->AddComponent<BenchmarkCollider>();
+	entity->AddComponent<BenchmarkHealth>();
+	entity->AddComponent<BenchmarkMesh>();
+	entity->AddComponent<BenchmarkMaterial>();
+	return entity;
+}
+
+/**
+ * Finds the sibling components a mesh render looks up every frame by casting each component, as lookups did.
+ */
+static void EntityGetComponentScan(benchmark::State &state)
+{
+	auto entity = RenderedEntity();
+	auto scan = [&entity](auto type) -> decltype(type)
+	{
+		for (const auto &component : entity->GetComponents())
+		{
+			if (auto casted = dynamic_cast<decltype(type)>(component.get()))
+			{
+				return casted;
+			}
+		}
+
+		return nullptr;
+	};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(scan(static_cast<BenchmarkMesh *>(nullptr)));
+		benchmark::DoNotOptimize(scan(static_cast<BenchmarkMaterial *>(nullptr)));
+		benchmark::DoNotOptimize(scan(static_cast<BenchmarkCollider *>(nullptr)));
+	}
+}
+BENCHMARK(EntityGetComponentScan);
+
+/**
+ * Finds the same sibling components from the entities component cache.
+ */
+static void EntityGetComponent(benchmark::State &state)
+{
+	auto entity = RenderedEntity();
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(entity->GetComponent<BenchmarkMesh>());
+		benchmark::DoNotOptimize(entity->GetComponent<BenchmarkMaterial>());
+		benchmark::DoNotOptimize(entity->GetComponent<BenchmarkCollider>());
+	}
+}
+BENCHMARK(EntityGetComponent);
+
+/**
+ * Steps a physics world of spheres falling into a pile on a ground plane.
+ * Rigidbodies are added to the world directly, creating them as components needs a running scene.
+ */
+static void ScenePhysicsStep(benchmark::State &state)
+{
+	ScenePhysics physics;
+	auto world = physics.GetDynamicsWorld();
+
+	btStaticPlaneShape groundShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
+	btRigidBody ground(0.0f, nullptr, &groundShape);
+	world->addRigidBody(&ground);
+
+	btSphereShape sphereShape(0.5f);
+	btVector3 inertia;
+	sphereShape.calculateLocalInertia(1.0f, inertia);
+	std::vector<std::unique_ptr<btDefaultMotionState>> motionStates;
+	std::vector<std::unique_ptr<btRigidBody>> bodies;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		btTransform transform;
+		transform.setIdentity();
+		transform.setOrigin(btVector3(static_cast<float>(i % 8) * 1.1f, 1.0f + static_cast<float>(i / 64) * 1.1f, static_cast<float>(i / 8 % 8) * 1.1f));
+		auto &motionState = motionStates.emplace_back(std::make_unique<btDefaultMotionState>(transform));
+		auto &body = bodies.emplace_back(std::make_unique<btRigidBody>(1.0f, motionState.get(), &sphereShape, inertia));
+		world->addRigidBody(body.get());
+	}
+
+	for (auto _ : state)
+	{
+		world->stepSimulation(1.0f / 60.0f, 1, 1.0f / 60.0f);
+	}
+
+	for (auto &body : bodies)
+	{
+		world->removeRigidBody(body.get());
+	}
+
+	world->removeRigidBody(&ground);
+}
+BENCHMARK(ScenePhysicsStep)->Range(64, 1024)->Unit(benchmark::kMicrosecond);
+
+/**
+ * A collision object that only receives events, rigidbodies need a running scene to create their shapes.
+ */
+class BenchmarkCollisionObject :
+	public CollisionObject
+{
+public:
+	bool InFrustum(const Frustum &frustum) override
+	{
+		return false;
+	}
+
+	void ClearForces() override
+	{
+	}
+
+protected:
+	void RecalculateMass() override
+	{
+	}
+};
+
+/**
+ * Spheres placed in touching pairs, every other pair is pulled apart and pushed back together on alternate updates.
+ */
+class CollisionPairsWorld
+{
+public:
+	CollisionPairsWorld(btDiscreteDynamicsWorld *world, const int64_t &pairs) :
+		m_world(world),
+		m_shape(0.5f),
+		m_apart(false),
+		m_events(0)
+	{
+		for (int64_t i = 0; i < 2 * pairs; i++)
+		{
+			auto &object = m_objects.emplace_back(std::make_unique<BenchmarkCollisionObject>());
+			object->OnCollision().Add([this](CollisionObject *)
+			{
+				m_events++;
+			});
+			object->OnSeparation().Add([this](CollisionObject *)
+			{
+				m_events++;
+			});
+
+			auto &body = m_bodies.emplace_back(std::make_unique<btRigidBody>(1.0f, nullptr, &m_shape, btVector3(0.1f, 0.1f, 0.1f)));
+			body->setWorldTransform(btTransform(btQuaternion::getIdentity(), Position(i)));
+			body->setUserPointer(object.get());
+			body->setActivationState(DISABLE_DEACTIVATION);
+			m_world->addRigidBody(body.get());
+		}
+
+		m_world->performDiscreteCollisionDetection();
+	}
+
+	~CollisionPairsWorld()
+	{
+		for (auto &body : m_bodies)
+		{
+			m_world->removeRigidBody(body.get());
+		}
+	}
+
+	/**
+	 * Moves every other pair apart or back together and finds the contacts, a quarter of the pairs begin or end each time.
+	 */
+	void Toggle()
+	{
+		m_apart = !m_apart;
+
+		for (std::size_t i = 3; i < m_bodies.size(); i += 4)
+		{
+			m_bodies[i]->setWorldTransform(btTransform(btQuaternion::getIdentity(), Position(static_cast<int64_t>(i))));
+		}
+
+		m_world->performDiscreteCollisionDetection();
+	}
+
+	const uint64_t &GetEvents() const { return m_events; }
+
+private:
+	btVector3 Position(const int64_t &i) const
+	{
+		auto pair = i / 2;
+		auto apart = m_apart && i % 4 == 3;
+		return btVector3(static_cast<float>(pair) * 3.0f + static_cast<float>(i % 2) * 0.9f, apart ? 5.0f : 0.0f, 0.0f);
+	}
+
+	btDiscreteDynamicsWorld *m_world;
+	btSphereShape m_shape;
+	std::vector<std::unique_ptr<BenchmarkCollisionObject>> m_objects;
+	std::vector<std::unique_ptr<btRigidBody>> m_bodies;
+	bool m_apart;
+	uint64_t m_events;
+};
+
+/**
+ * The previous collision events, pairs are kept in sets rebuilt every update and each event is sent on its own.
+ */
+class SetCollisionEvents
+{
+public:
+	void Check(btDispatcher *dispatcher)
+	{
+		std::set<CollisionPair> pairsThisUpdate;
+
+		for (int32_t i = 0; i < dispatcher->getNumManifolds(); ++i)
+		{
+			auto manifold = dispatcher->getManifoldByIndexInternal(i);
+
+			if (manifold->getNumContacts() == 0)
+			{
+				continue;
+			}
+
+			auto body0 = manifold->getBody0();
+			auto body1 = manifold->getBody1();
+			const bool swapped = body0 > body1;
+			auto pair = std::make_pair(swapped ? body1 : body0, swapped ? body0 : body1);
+			pairsThisUpdate.insert(pair);
+
+			if (m_pairsLastUpdate.find(pair) == m_pairsLastUpdate.end())
+			{
+				static_cast<CollisionObject *>(pair.first->getUserPointer())->OnCollision()(static_cast<CollisionObject *>(pair.second->getUserPointer()));
+			}
+		}
+
+		std::set<CollisionPair> removedPairs;
+		std::set_difference(m_pairsLastUpdate.begin(), m_pairsLastUpdate.end(), pairsThisUpdate.begin(), pairsThisUpdate.end(),
+			std::inserter(removedPairs, removedPairs.begin()));
+
+		for (const auto &pair : removedPairs)
+		{
+			static_cast<CollisionObject *>(pair.first->getUserPointer())->OnSeparation()(static_cast<CollisionObject *>(pair.second->getUserPointer()));
+		}
+
+		m_pairsLastUpdate = pairsThisUpdate;
+	}
+
+private:
+	std::set<CollisionPair> m_pairsLastUpdate;
+};
+
+/**
+ * Sends the collision events for a world of touching pairs, contact detection is not timed.
+ */
+static void ScenePhysicsCollisionEvents(benchmark::State &state)
+{
+	ScenePhysics physics;
+	CollisionPairsWorld world(physics.GetDynamicsWorld(), state.range(0));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		world.Toggle();
+		state.ResumeTiming();
+		physics.CheckForCollisionEvents();
+	}
+
+	benchmark::DoNotOptimize(world.GetEvents());
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ScenePhysicsCollisionEvents)->Range(64, 4096);
+
+static void SetCollisionEventsCheck(benchmark::State &state)
+{
+	ScenePhysics physics;
+	CollisionPairsWorld world(physics.GetDynamicsWorld(), state.range(0));
+	SetCollisionEvents events;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		world.Toggle();
+		state.ResumeTiming();
+		events.Check(physics.GetDynamicsWorld()->getDispatcher());
+	}
+
+	benchmark::DoNotOptimize(world.GetEvents());
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SetCollisionEventsCheck)->Range(64, 4096);
+
+/**
+ * A floor of static spheres for queries to hit, rays are cast down onto it and about half of them hit a sphere.
+ */
+class QueryWorld
+{
+public:
+	explicit QueryWorld(btDiscreteDynamicsWorld *world) :
+		m_world(world),
+		m_shape(0.5f)
+	{
+		for (int32_t i = 0; i < 32 * 32; i++)
+		{
+			auto &body = m_bodies.emplace_back(std::make_unique<btRigidBody>(0.0f, nullptr, &m_shape));
+			body->setWorldTransform(btTransform(btQuaternion::getIdentity(), btVector3(static_cast<float>(i % 32) * 2.0f, 0.0f, static_cast<float>(i / 32) * 2.0f)));
+			m_world->addRigidBody(body.get());
+		}
+	}
+
+	~QueryWorld()
+	{
+		for (auto &body : m_bodies)
+		{
+			m_world->removeRigidBody(body.get());
+		}
+	}
+
+	static Vector3f Position(const int64_t &i)
+	{
+		return Vector3f(static_cast<float>(i % 64) * 0.97f, 0.0f, static_cast<float>(i / 64 % 64) * 0.97f);
+	}
+
+private:
+	btDiscreteDynamicsWorld *m_world;
+	btSphereShape m_shape;
+	std::vector<std::unique_ptr<btRigidBody>> m_bodies;
+};
+
+static std::vector<RayQuery> DownwardRays(const int64_t &count)
+{
+	std::vector<RayQuery> rays;
+
+	for (int64_t i = 0; i < count; i++)
+	{
+		auto position = QueryWorld::Position(i);
+		rays.emplace_back(RayQuery{position + Vector3f(0.0f, 10.0f, 0.0f), position - Vector3f(0.0f, 10.0f, 0.0f)});
+	}
+
+	return rays;
+}
+
+/**
+ * Casts rays one at a time through Raytest, as systems did before batches.
+ */
+static void ScenePhysicsRaytest(benchmark::State &state)
+{
+	ScenePhysics physics;
+	QueryWorld world(physics.GetDynamicsWorld());
+	auto rays = DownwardRays(state.range(0));
+
+	for (auto _ : state)
+	{
+		for (const auto &ray : rays)
+		{
+			benchmark::DoNotOptimize(physics.Raytest(ray.m_start, ray.m_end));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ScenePhysicsRaytest)->Range(64, 4096);
+
+static void ScenePhysicsRaytestBatch(benchmark::State &state)
+{
+	ScenePhysics physics;
+	QueryWorld world(physics.GetDynamicsWorld());
+	auto rays = DownwardRays(state.range(0));
+	std::vector<Raycast> results(rays.size());
+
+	for (auto _ : state)
+	{
+		physics.RaytestBatch(rays.data(), results.data(), rays.size());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ScenePhysicsRaytestBatch)->Range(64, 4096);
+
+static void ScenePhysicsSweepTestBatch(benchmark::State &state)
+{
+	ScenePhysics physics;
+	QueryWorld world(physics.GetDynamicsWorld());
+	std::vector<SweepQuery> sweeps;
+
+	for (const auto &ray : DownwardRays(state.range(0)))
+	{
+		sweeps.emplace_back(SweepQuery{ray.m_start, ray.m_end, 0.25f});
+	}
+
+	std::vector<Raycast> results(sweeps.size());
+
+	for (auto _ : state)
+	{
+		physics.SweepTestBatch(sweeps.data(), results.data(), sweeps.size());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ScenePhysicsSweepTestBatch)->Range(64, 4096);
+
+/**
+ * Tests spheres against the broadphase, large batches are split across the query threads.
+ */
+static void ScenePhysicsOverlapTestBatch(benchmark::State &state)
+{
+	static const uint32_t MaxResults = 8;
+
+	ScenePhysics physics;
+	QueryWorld world(physics.GetDynamicsWorld());
+	std::vector<OverlapQuery> overlaps;
+
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		overlaps.emplace_back(OverlapQuery{QueryWorld::Position(i), 1.5f});
+	}
+
+	std::vector<CollisionObject *> results(overlaps.size() * MaxResults);
+	std::vector<uint32_t> resultCounts(overlaps.size());
+
+	for (auto _ : state)
+	{
+		physics.OverlapTestBatch(overlaps.data(), results.data(), resultCounts.data(), overlaps.size(), MaxResults);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ScenePhysicsOverlapTestBatch)->Range(64, 4096);
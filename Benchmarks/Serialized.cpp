@@ -0,0 +1,100 @@
+#include <sstream>
+#include <benchmark/benchmark.h>
+#include <Maths/Vector3.hpp>
+#include <Serialized/Json/Json.hpp>
+#include <Serialized/Xml/Xml.hpp>
+#include <Serialized/Yaml/Yaml.hpp>
+
+using namespace acid;
+
+/**
+ * Fills a document shaped like a saved scene, a list of named entities with transforms and tags.
+ * @param metadata The metadata to fill.
+ * @param entities The number of entities.
+ */
+static void FillScene(Metadata &metadata, const int64_t &entities)
+{
+	for (int64_t i = 0; i < entities; i++)
+	{
+		auto entity = metadata.AddChild(new Metadata("entity"));
+		entity->SetChild("name", "Entity " + String::To(i));
+		entity->SetChild("position", Vector3f(static_cast<float>(i), 2.5f, -0.125f * static_cast<float>(i)));
+		entity->SetChild("rotation", Vector3f(0.0f, 0.5f * static_cast<float>(i), 0.0f));
+		entity->SetChild("enabled", i % 2 == 0);
+		entity->SetChild("tags", std::vector<std::string>{ "static", "shadow", "layer" + String::To(i % 4) });
+	}
+}
+
+template<typename T, typename... Args>
+static void LoadScene(benchmark::State &state, Args... args)
+{
+	Metadata metadata;
+	FillScene(metadata, state.range(0));
+	std::stringstream written;
+	T(args..., &metadata).Write(&written);
+	auto text = written.str();
+
+	for (auto _ : state)
+	{
+		T document(args...);
+		std::stringstream stream(text);
+		document.Load(&stream);
+		benchmark::DoNotOptimize(document.GetChildCount());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+template<typename T, typename... Args>
+static void WriteScene(benchmark::State &state, Args... args)
+{
+	Metadata metadata;
+	FillScene(metadata, state.range(0));
+	T document(args..., &metadata);
+	std::size_t size = 0;
+
+	for (auto _ : state)
+	{
+		std::stringstream stream;
+		document.Write(&stream);
+		size = stream.str().size();
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+static void JsonLoad(benchmark::State &state)
+{
+	LoadScene<Json>(state);
+}
+BENCHMARK(JsonLoad)->Range(8, 512);
+
+static void JsonWrite(benchmark::State &state)
+{
+	WriteScene<Json>(state);
+}
+BENCHMARK(JsonWrite)->Range(8, 512);
+
+static void XmlLoad(benchmark::State &state)
+{
+	LoadScene<Xml>(state, std::string("Scene"));
+}
+BENCHMARK(XmlLoad)->Range(8, 512);
+
+static void XmlWrite(benchmark::State &state)
+{
+	WriteScene<Xml>(state, std::string("Scene"));
+}
+BENCHMARK(XmlWrite)->Range(8, 512);
+
+static void YamlLoad(benchmark::State &state)
+{
+	LoadScene<Yaml>(state);
+}
+BENCHMARK(YamlLoad)->Range(8, 512);
+
+static void YamlWrite(benchmark::State &state)
+{
+	WriteScene<Yaml>(state);
+}
+BENCHMARK(YamlWrite)->Range(8, 512);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <Helpers/String.hpp>
+
+using namespace acid;
+
+static const std::string LINE = "  position: 12.5, -3.25, 1000.0  # Camera start, in world units\t\n";
+
+static void StringSplit(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(String::Split(LINE, ",", true));
+	}
+}
+BENCHMARK(StringSplit);
+
+static void StringTrim(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(String::Trim(LINE));
+	}
+}
+BENCHMARK(StringTrim);
+
+static void StringReplaceAll(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(String::ReplaceAll(LINE, ", ", ";"));
+	}
+}
+BENCHMARK(StringReplaceAll);
+
+static void StringLowercase(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(String::Lowercase(LINE));
+	}
+}
+BENCHMARK(StringLowercase);
+
+static void StringToFloat(benchmark::State &state)
+{
+	auto value = 0.0f;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(String::To(value));
+		value += 0.125f;
+	}
+}
+BENCHMARK(StringToFloat);
+
+static void StringFromFloat(benchmark::State &state)
+{
+	std::string value = "-1000.0625";
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(String::From<float>(value));
+	}
+}
+BENCHMARK(StringFromFloat);
+
+static void StringToUtf32(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(String::ToUtf32(LINE));
+	}
+}
+BENCHMARK(StringToUtf32);
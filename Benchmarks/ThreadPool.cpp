@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <Helpers/ThreadPool.hpp>
+
+using namespace acid;
+
+/**
+ * Enqueues small tasks and waits on their futures, measures the scheduling overhead rather than the work.
+ */
+static void ThreadPoolEnqueue(benchmark::State &state)
+{
+	ThreadPool threadPool(static_cast<uint32_t>(state.range(0)));
+	std::vector<std::future<uint32_t>> futures;
+	futures.reserve(256);
+
+	for (auto _ : state)
+	{
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			futures.emplace_back(threadPool.Enqueue([i]
+			{
+				return i * i;
+			}));
+		}
+
+		for (auto &future : futures)
+		{
+			benchmark::DoNotOptimize(future.get());
+		}
+
+		futures.clear();
+	}
+
+	state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(ThreadPoolEnqueue)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
@@ -0,0 +1,173 @@
+#include <benchmark/benchmark.h>
+#include <Devices/Mouse.hpp>
+#include <Devices/Window.hpp>
+#include <Maths/Colour.hpp>
+#include <Uis/Uis.hpp>
+
+using namespace acid;
+
+/**
+ * Gets a headless engine with only the modules ui layout uses, it is kept for the whole run so the engine instance is never left dangling.
+ * @return The ui module.
+ */
+static Uis *GetHeadlessUis()
+{
+	static Engine engine("Benchmarks", true, true);
+	static Uis *uis = []()
+	{
+		auto &moduleManager = engine.GetModuleManager();
+		moduleManager.Add<Window>(Module::Stage::Always);
+		moduleManager.Add<Mouse>(Module::Stage::Pre);
+		return moduleManager.Add<Uis>(Module::Stage::Pre);
+	}();
+	return uis;
+}
+
+/**
+ * Stands in for a gui or text, the values the renderer reads for the object are written to a draw record when its layout changes.
+ */
+class BenchmarkWidget :
+	public UiObject
+{
+public:
+	struct DrawRecord
+	{
+		Matrix4 m_modelMatrix;
+		Vector4f m_screenOffset;
+		Colour m_colour;
+		Vector4f m_scissor;
+		float m_depth;
+		float m_alpha;
+		float m_padding[2];
+	};
+
+	BenchmarkWidget(UiObject *parent, const UiBound &rectangle, DrawRecord &record) :
+		UiObject(parent, rectangle),
+		m_record(record)
+	{
+	}
+
+protected:
+	void UpdateLayout() override
+	{
+		m_record.m_modelMatrix = GetModelMatrix();
+		m_record.m_screenOffset = Vector4f(2.0f * GetScreenSize(), 2.0f * GetScreenPosition() - 1.0f);
+		m_record.m_colour = Colour::White;
+		m_record.m_scissor = GetScissor();
+		m_record.m_depth = GetScreenDepth();
+		m_record.m_alpha = GetScreenAlpha();
+	}
+
+private:
+	DrawRecord &m_record;
+};
+
+/**
+ * A editor like layout of 4,960 widgets in the screen container, 10 panels of 55 rows with a background and 8 cells each.
+ * The widgets are removed from the container when destroyed.
+ */
+class BenchmarkPanels
+{
+public:
+	static constexpr uint32_t PanelCount = 10;
+	static constexpr uint32_t RowCount = 55;
+	static constexpr uint32_t CellCount = 8;
+
+	explicit BenchmarkPanels(Uis &uis) :
+		m_records(PanelCount * (1 + RowCount * (1 + CellCount)))
+	{
+		auto record = m_records.begin();
+
+		for (uint32_t p = 0; p < PanelCount; p++)
+		{
+			auto panel = m_widgets.emplace_back(std::make_unique<BenchmarkWidget>(&uis.GetContainer(),
+				UiBound(Vector2f(0.1f * p, 0.0f), UiReference::TopLeft, UiAspect::Position | UiAspect::Size, Vector2f(0.1f, 1.0f)), *record++)).get();
+			m_panels.emplace_back(panel);
+
+			for (uint32_t r = 0; r < RowCount; r++)
+			{
+				auto row = m_widgets.emplace_back(std::make_unique<BenchmarkWidget>(panel,
+					UiBound(Vector2f(0.0f, 0.02f * r), UiReference::TopLeft, UiAspect::Position | UiAspect::Size | UiAspect::Scale, Vector2f(1.0f, 0.02f)), *record++)).get();
+
+				for (uint32_t c = 0; c < CellCount; c++)
+				{
+					m_widgets.emplace_back(std::make_unique<BenchmarkWidget>(row,
+						UiBound(Vector2f(0.125f * c, 0.0f), UiReference::TopLeft, UiAspect::Position | UiAspect::Size | UiAspect::Scale, Vector2f(0.125f, 1.0f)), *record++));
+				}
+			}
+		}
+
+		// The first updates lay out every widget and flatten the list, as the first frames after a menu is opened.
+		uis.Update();
+		uis.Update();
+	}
+
+	const std::vector<std::unique_ptr<BenchmarkWidget>> &GetWidgets() const { return m_widgets; }
+
+	const std::vector<BenchmarkWidget *> &GetPanels() const { return m_panels; }
+
+private:
+	std::vector<BenchmarkWidget::DrawRecord> m_records;
+	std::vector<std::unique_ptr<BenchmarkWidget>> m_widgets;
+	std::vector<BenchmarkWidget *> m_panels;
+};
+
+/**
+ * Updates the laid out panels when nothing has changed, the retained layout only walks the tree.
+ */
+static void UisLayoutStatic(benchmark::State &state)
+{
+	auto uis = GetHeadlessUis();
+	BenchmarkPanels panels(*uis);
+
+	for (auto _ : state)
+	{
+		uis->Update();
+	}
+
+	state.counters["widgets"] = static_cast<double>(panels.GetWidgets().size());
+	state.counters["visible"] = static_cast<double>(uis->GetObjects().size());
+}
+BENCHMARK(UisLayoutStatic)->Unit(benchmark::kMillisecond);
+
+/**
+ * Updates the panels while one of them scrolls, only the 496 widgets in that panel are laid out again each frame.
+ */
+static void UisLayoutDirtyPanel(benchmark::State &state)
+{
+	auto uis = GetHeadlessUis();
+	BenchmarkPanels panels(*uis);
+	auto panel = panels.GetPanels()[3];
+	uint32_t frame = 0;
+
+	for (auto _ : state)
+	{
+		panel->GetRectangle().SetPosition(Vector2f(0.3f, 0.001f * (frame++ % 100)));
+		uis->Update();
+	}
+
+	state.counters["widgets"] = static_cast<double>(panels.GetWidgets().size());
+}
+BENCHMARK(UisLayoutDirtyPanel)->Unit(benchmark::kMillisecond);
+
+/**
+ * Updates the panels while the window is resized, the aspect ratio changes every frame so every widget is laid out again.
+ */
+static void UisLayoutDirtyWindow(benchmark::State &state)
+{
+	auto uis = GetHeadlessUis();
+	BenchmarkPanels panels(*uis);
+	auto window = Window::Get();
+	Vector2i size(window->GetSize());
+	int32_t frame = 0;
+
+	for (auto _ : state)
+	{
+		window->SetSize(Vector2i(size.m_x + (frame++ % 100), size.m_y));
+		uis->Update();
+	}
+
+	window->SetSize(size);
+	state.counters["widgets"] = static_cast<double>(panels.GetWidgets().size());
+}
+BENCHMARK(UisLayoutDirtyWindow)->Unit(benchmark::kMillisecond);
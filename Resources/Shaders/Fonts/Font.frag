@@ -2,36 +2,62 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-layout(binding = 1) uniform UniformObject
+struct TextData
 {
 	mat4 modelMatrix;
 	vec4 screenOffset;
-	int modelMode;
-	float depth;
-	float alpha;
-
 	vec4 colour;
 	vec4 borderColour;
+	vec4 scissor;
 	vec2 borderSizes;
 	vec2 edgeData;
-} object;
+	int modelMode;
+	float depth;
+	float alpha;
+};
+
+layout(binding = 0) uniform UniformScene
+{
+	mat4 projection;
+	mat4 view;
+	vec2 size;
+} scene;
+
+layout(binding = 1) buffer BufferTexts
+{
+	TextData texts[];
+} bufferTexts;
 
 layout(binding = 2) uniform sampler2D samplerColour;
 
 layout(location = 0) in vec2 inUV;
+layout(location = 1) flat in uint inText;
+layout(location = 2) flat in uint inPage;
 
 layout(location = 0) out vec4 outColour;
 
 void main() 
 {
-	float distance = texture(samplerColour, inUV).a;
-	float alpha = smoothstep((1.0f - object.edgeData.x) - object.edgeData.y, 1.0f - object.edgeData.x, distance);
-	float outlineAlpha = smoothstep((1.0f - object.borderSizes.x) - object.borderSizes.y, 1.0f - object.borderSizes.x, distance);
+	TextData text = bufferTexts.texts[inText];
+
+	// All texts of a font are drawn together, so the scissor is tested here.
+	vec2 screenPosition = gl_FragCoord.xy / scene.size;
+
+	if (any(lessThan(screenPosition, text.scissor.xy)) || any(greaterThan(screenPosition, text.scissor.xy + text.scissor.zw)))
+	{
+		discard;
+	}
+
+	// The prebaked atlas keeps the distance in alpha, runtime atlas pages are single channel.
+	vec4 sampled = texture(samplerColour, inUV);
+	float distance = inPage == 0u ? sampled.a : sampled.r;
+	float alpha = smoothstep((1.0f - text.edgeData.x) - text.edgeData.y, 1.0f - text.edgeData.x, distance);
+	float outlineAlpha = smoothstep((1.0f - text.borderSizes.x) - text.borderSizes.y, 1.0f - text.borderSizes.x, distance);
 	float overallAlpha = alpha + (1.0f - alpha) * outlineAlpha;
-	vec3 overallColour = mix(object.borderColour.rgb, object.colour.rgb, alpha / overallAlpha);
+	vec3 overallColour = mix(text.borderColour.rgb, text.colour.rgb, alpha / overallAlpha);
 
 	outColour = vec4(overallColour, overallAlpha);
-	outColour.a *= object.alpha;
+	outColour.a *= text.alpha;
 
 	if (outColour.a < 0.05f)
 	{
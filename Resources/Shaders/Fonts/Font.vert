@@ -2,30 +2,45 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
+struct TextData
+{
+	mat4 modelMatrix;
+	vec4 screenOffset;
+	vec4 colour;
+	vec4 borderColour;
+	vec4 scissor;
+	vec2 borderSizes;
+	vec2 edgeData;
+	int modelMode;
+	float depth;
+	float alpha;
+};
+
 layout(binding = 0) uniform UniformScene
 {
 	mat4 projection;
 	mat4 view;
+	vec2 size;
 } scene;
 
-layout(binding = 1) uniform UniformObject
+layout(binding = 1) buffer BufferTexts
 {
-	mat4 modelMatrix;
-	vec4 screenOffset;
-	int modelMode;
-	float depth;
-	float alpha;
+	TextData texts[];
+} bufferTexts;
 
-	vec4 colour;
-	vec4 borderColour;
-	vec2 borderSizes;
-	vec2 edgeData;
-} object;
+layout(push_constant) uniform PushPage
+{
+	uint page;
+} push;
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec2 inUV;
+layout(location = 0) in vec4 inRect;
+layout(location = 1) in vec4 inUVRect;
+layout(location = 2) in uint inText;
+layout(location = 3) in uint inPage;
 
 layout(location = 0) out vec2 outUV;
+layout(location = 1) flat out uint outText;
+layout(location = 2) flat out uint outPage;
 
 out gl_PerVertex 
 {
@@ -37,11 +52,27 @@ const vec3 rotation = vec3(3.14159f, 0.0f, 0.0f);
 
 void main() 
 {
-	vec4 position = vec4((inPosition.xy * object.screenOffset.xy) + object.screenOffset.zw, 0.0f, 1.0f);
+	outText = inText;
+	outPage = inPage;
+
+	// The glyphs are drawn once per texture, glyphs on other textures collapse to a point and make no fragments.
+	if (inPage != push.page)
+	{
+		outUV = vec2(0.0f);
+		gl_Position = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		return;
+	}
+
+	TextData text = bufferTexts.texts[inText];
+
+	// The glyph quad is drawn as a strip, the corner is picked from the vertex index.
+	vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+	vec2 inPosition = mix(inRect.xy, inRect.zw, corner);
+	vec4 position = vec4((inPosition * text.screenOffset.xy) + text.screenOffset.zw, 0.0f, 1.0f);
 
-	if (object.modelMode != 0)
+	if (text.modelMode != 0)
 	{
-		mat4 modelMatrix = modelMatrix(object.modelMatrix, scene.view, object.modelMode == 2, rotation);
+		mat4 modelMatrix = modelMatrix(text.modelMatrix, scene.view, text.modelMode == 2, rotation);
 		vec4 worldPosition = modelMatrix * position;
 		gl_Position = scene.projection * scene.view * worldPosition;
 	}
@@ -51,7 +82,7 @@ void main()
 		gl_Position.z = 0.5f;
 	}
 
-	gl_Position.z -= object.depth;
+	gl_Position.z -= text.depth;
 
-	outUV = inUV;
+	outUV = mix(inUVRect.xy, inUVRect.zw, corner);
 }
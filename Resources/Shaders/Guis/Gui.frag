@@ -2,25 +2,38 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-layout(binding = 1) uniform UniformObject
+struct GuiData
 {
-	float aspectRatio;
 	mat4 modelMatrix;
 	vec4 screenOffset;
-	int modelMode;
-	float depth;
-	float alpha;
-
 	vec4 colourOffset;
+	vec4 scissor;
+	vec4 ninePatches;
 	vec2 atlasOffset;
 	vec2 atlasScale;
 	float atlasRows;
-	vec4 ninePatches;
-} object;
+	int modelMode;
+	float depth;
+	float alpha;
+};
+
+layout(binding = 0) uniform UniformScene
+{
+	mat4 projection;
+	mat4 view;
+	vec2 size;
+	float aspectRatio;
+} scene;
+
+layout(binding = 1) buffer BufferGuis
+{
+	GuiData guis[];
+} bufferGuis;
 
 layout(binding = 2) uniform sampler2D samplerColour;
 
 layout(location = 0) in vec2 inUV;
+layout(location = 1) flat in uint inGui;
 
 layout(location = 0) out vec4 outColour;
 
@@ -46,11 +59,21 @@ float processAxis(float coord, float textureBorder, float windowBorder)
 
 void main() 
 {
-	if (object.ninePatches != vec4(0.0f))
+	GuiData gui = bufferGuis.guis[inGui];
+
+	// All guis of a texture are drawn together, so the scissor is tested here.
+	vec2 screenPosition = gl_FragCoord.xy / scene.size;
+
+	if (any(lessThan(screenPosition, gui.scissor.xy)) || any(greaterThan(screenPosition, gui.scissor.xy + gui.scissor.zw)))
+	{
+		discard;
+	}
+
+	if (gui.ninePatches != vec4(0.0f))
 	{
 		vec2 newUV = vec2(
-		    processAxis(inUV.x, object.ninePatches.x, object.ninePatches.x / (object.screenOffset.x / object.screenOffset.y) / object.aspectRatio),
-		    processAxis(inUV.y, object.ninePatches.y, object.ninePatches.y)
+		    processAxis(inUV.x, gui.ninePatches.x, gui.ninePatches.x / (gui.screenOffset.x / gui.screenOffset.y) / scene.aspectRatio),
+		    processAxis(inUV.y, gui.ninePatches.y, gui.ninePatches.y)
 		);
 
 		outColour = texture(samplerColour, newUV);
@@ -60,8 +83,8 @@ void main()
 		outColour = texture(samplerColour, inUV);
 	}
 
-	outColour *= object.colourOffset;
-	outColour.a *= object.alpha;
+	outColour *= gui.colourOffset;
+	outColour.a *= gui.alpha;
 
 	if (outColour.a < 0.05f)
 	{
@@ -2,32 +2,36 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-layout(binding = 0) uniform UniformScene
+struct GuiData
 {
-	mat4 projection;
-	mat4 view;
-} scene;
-
-layout(binding = 1) uniform UniformObject
-{
-	float aspectRatio;
 	mat4 modelMatrix;
 	vec4 screenOffset;
-	int modelMode;
-	float depth;
-	float alpha;
-
 	vec4 colourOffset;
+	vec4 scissor;
+	vec4 ninePatches;
 	vec2 atlasOffset;
 	vec2 atlasScale;
 	float atlasRows;
-	vec4 ninePatches;
-} object;
+	int modelMode;
+	float depth;
+	float alpha;
+};
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec2 inUV;
+layout(binding = 0) uniform UniformScene
+{
+	mat4 projection;
+	mat4 view;
+	vec2 size;
+	float aspectRatio;
+} scene;
+
+layout(binding = 1) buffer BufferGuis
+{
+	GuiData guis[];
+} bufferGuis;
 
 layout(location = 0) out vec2 outUV;
+layout(location = 1) flat out uint outGui;
 
 out gl_PerVertex 
 {
@@ -39,11 +43,15 @@ const vec3 rotation = vec3(3.14159f, 0.0f, 0.0f);
 
 void main()
 {
-	vec4 position = vec4((inPosition.xy * object.screenOffset.xy) + object.screenOffset.zw, 0.0f, 1.0f);
+	GuiData gui = bufferGuis.guis[gl_InstanceIndex];
+
+	// The gui quad is drawn as a strip, the corner is picked from the vertex index.
+	vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+	vec4 position = vec4((corner * gui.screenOffset.xy) + gui.screenOffset.zw, 0.0f, 1.0f);
 
-	if (object.modelMode != 0)
+	if (gui.modelMode != 0)
 	{
-		mat4 modelMatrix = modelMatrix(object.modelMatrix, scene.view, object.modelMode == 2, rotation);
+		mat4 modelMatrix = modelMatrix(gui.modelMatrix, scene.view, gui.modelMode == 2, rotation);
 		vec4 worldPosition = modelMatrix * position;
 		gl_Position = scene.projection * scene.view * worldPosition;
 	}
@@ -53,7 +61,8 @@ void main()
 		gl_Position.z = 0.5f;
 	}
 
-	gl_Position.z -= object.depth;
+	gl_Position.z -= gui.depth;
 
-	outUV = object.atlasScale * ((inUV.xy / object.atlasRows) + object.atlasOffset);
+	outUV = gui.atlasScale * ((corner / gui.atlasRows) + gui.atlasOffset);
+	outGui = uint(gl_InstanceIndex);
 }
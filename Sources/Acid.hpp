@@ -15,6 +15,9 @@
 #include "Audio/Audio.hpp"
 #include "Audio/Sound.hpp"
 #include "Audio/SoundBuffer.hpp"
+#include "Audio/SoundStream.hpp"
+#include "Audio/Voice.hpp"
+#include "Audio/VoiceManager.hpp"
 #include "Devices/Instance.hpp"
 #include "Devices/Joysticks.hpp"
 #include "Devices/Keyboard.hpp"
@@ -30,32 +33,43 @@
 #include "Emitters/EmitterPoint.hpp"
 #include "Emitters/EmitterSphere.hpp"
 #include "Engine/Engine.hpp"
+#include "Engine/FrameAllocator.hpp"
 #include "Engine/Game.hpp"
 #include "Engine/Log.hpp"
 #include "Engine/Module.hpp"
 #include "Engine/ModuleManager.hpp"
 #include "Engine/ModuleUpdater.hpp"
+#include "Engine/Profiler.hpp"
+#include "Files/Archive.hpp"
 #include "Files/File.hpp"
 #include "Files/Files.hpp"
+#include "Files/FileView.hpp"
 #include "Files/FileSystem.hpp"
 #include "Files/FileWatcher.hpp"
 #include "Fonts/FontMetafile.hpp"
 #include "Fonts/FontType.hpp"
 #include "Fonts/Geometry.hpp"
+#include "Fonts/GlyphAtlas.hpp"
+#include "Fonts/GlyphRun.hpp"
 #include "Fonts/Outline.hpp"
 #include "Fonts/RendererFonts.hpp"
 #include "Fonts/RendererFonts2.hpp"
+#include "Fonts/SkylinePacker.hpp"
 #include "Fonts/Text.hpp"
+#include "Fonts/TextBatch.hpp"
 #include "Gizmos/Gizmo.hpp"
 #include "Gizmos/Gizmos.hpp"
 #include "Gizmos/GizmoType.hpp"
 #include "Gizmos/RendererGizmos.hpp"
 #include "Guis/Gui.hpp"
+#include "Guis/GuiBatch.hpp"
 #include "Guis/RendererGuis.hpp"
 #include "Helpers/Delegate.hpp"
 #include "Helpers/EnumClass.hpp"
 #include "Helpers/Future.hpp"
+#include "Helpers/Handle.hpp"
 #include "Helpers/NonCopyable.hpp"
+#include "Helpers/ObjectPool.hpp"
 #include "Helpers/RingBuffer.hpp"
 #include "Helpers/String.hpp"
 #include "Helpers/ThreadPool.hpp"
@@ -119,9 +133,17 @@
 #include "Network/Ftp/FtpResponseDirectory.hpp"
 #include "Network/Ftp/FtpResponseListing.hpp"
 #include "Network/Http/Http.hpp"
+#include "Network/Http/HttpClient.hpp"
 #include "Network/Http/HttpRequest.hpp"
 #include "Network/Http/HttpResponse.hpp"
 #include "Network/IpAddress.hpp"
+#include "Network/Netcode/BitStream.hpp"
+#include "Network/Netcode/NetChannel.hpp"
+#include "Network/Netcode/NetClient.hpp"
+#include "Network/Netcode/NetServer.hpp"
+#include "Network/Netcode/Replicated.hpp"
+#include "Network/Netcode/SequenceBuffer.hpp"
+#include "Network/Netcode/Snapshot.hpp"
 #include "Network/Packet.hpp"
 #include "Network/Socket.hpp"
 #include "Network/SocketSelector.hpp"
@@ -178,6 +200,7 @@
 #include "Renderer/Buffers/UniformHandler.hpp"
 #include "Renderer/Commands/CommandBuffer.hpp"
 #include "Renderer/Commands/CommandPool.hpp"
+#include "Renderer/Commands/TimestampQueries.hpp"
 #include "Renderer/Descriptors/Descriptor.hpp"
 #include "Renderer/Descriptors/DescriptorSet.hpp"
 #include "Renderer/Descriptors/DescriptorsHandler.hpp"
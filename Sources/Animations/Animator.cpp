@@ -33,29 +33,29 @@ void Animator::IncreaseAnimationTime()
 	}
 }
 
-std::map<std::string, Matrix4> Animator::CalculateCurrentAnimationPose()
+Animator::Pose Animator::CalculateCurrentAnimationPose()
 {
 	auto frames = GetPreviousAndNextFrames();
-	float progression = CalculateProgression(frames[0], frames[1]);
-	return InterpolatePoses(frames[0], frames[1], progression);
+	float progression = CalculateProgression(*frames[0], *frames[1]);
+	return InterpolatePoses(*frames[0], *frames[1], progression);
 }
 
-std::array<Keyframe, 2> Animator::GetPreviousAndNextFrames() const
+std::array<const Keyframe *, 2> Animator::GetPreviousAndNextFrames() const
 {
-	auto allFrames = m_currentAnimation->GetKeyframes();
-	Keyframe previousFrame = allFrames[0];
-	Keyframe nextFrame = allFrames[0];
+	const auto &allFrames = m_currentAnimation->GetKeyframes();
+	auto previousFrame = &allFrames[0];
+	auto nextFrame = &allFrames[0];
 
 	for (uint32_t i = 1; i < allFrames.size(); i++)
 	{
-		nextFrame = allFrames[i];
+		nextFrame = &allFrames[i];
 
-		if (nextFrame.GetTimeStamp() > m_animationTime)
+		if (nextFrame->GetTimeStamp() > m_animationTime)
 		{
 			break;
 		}
 
-		previousFrame = allFrames[i];
+		previousFrame = &allFrames[i];
 	}
 
 	return { previousFrame, nextFrame };
@@ -68,13 +68,12 @@ float Animator::CalculateProgression(const Keyframe &previousFrame, const Keyfra
 	return currentTime / totalTime;
 }
 
-std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression) const
+Animator::Pose Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression) const
 {
-	auto currentPose = std::map<std::string, Matrix4>();
+	Pose currentPose(FrameAllocator::Get());
 
-	for (const auto &[name, joint] : previousFrame.GetPose())
+	for (const auto &[name, previousTransform] : previousFrame.GetPose())
 	{
-		JointTransform previousTransform = previousFrame.GetPose().find(name)->second;
 		JointTransform nextTransform = nextFrame.GetPose().find(name)->second;
 		JointTransform currentTransform = JointTransform::Interpolate(previousTransform, nextTransform, progression);
 		currentPose.emplace(name, currentTransform.GetLocalTransform());
@@ -83,7 +82,7 @@ std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previo
 	return currentPose;
 }
 
-void Animator::ApplyPoseToJoints(const std::map<std::string, Matrix4> &currentPose, Joint &joint, const Matrix4 &parentTransform)
+void Animator::ApplyPoseToJoints(const Pose &currentPose, Joint &joint, const Matrix4 &parentTransform)
 {
 	Matrix4 currentLocalTransform = currentPose.find(joint.GetName())->second;
 	Matrix4 currentTransform = parentTransform * currentLocalTransform;
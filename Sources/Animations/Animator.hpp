@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/FrameAllocator.hpp"
 #include "Maths/Time.hpp"
 #include "Animation/Animation.hpp"
 #include "Joint/Joint.hpp"
@@ -21,6 +22,9 @@ namespace acid
 class ACID_EXPORT Animator
 {
 public:
+	/// Joint transforms by joint name, the names are the keys of the keyframes poses.
+	using Pose = FrameAllocator::Map<std::string_view, Matrix4, std::less<>>;
+
 	/**
 	 * Creates a new animator.
 	 * @param rootJoint The root joint of the joint hierarchy which makes up the "skeleton" of the entity.
@@ -54,9 +58,9 @@ public:
 	 * those keyframes.
 	 *
 	 * @return The current pose as a map of the desired local-space transforms for all the joints.
-	 * The transforms are indexed by the name ID of the joint that they should be applied to. </returns>
+	 * The transforms are indexed by the name ID of the joint that they should be applied to, the map is allocated from the frame allocator. </returns>
 	 **/
-	std::map<std::string, Matrix4> CalculateCurrentAnimationPose();
+	Pose CalculateCurrentAnimationPose();
 
 	/**
 	 * Finds the previous keyframe in the animation and the next keyframe in the animation, and returns them in an array of length 2.
@@ -64,7 +68,7 @@ public:
 	 * then the next keyframe is used as both the previous and next keyframe. The reverse happens if there is no next keyframe.
 	 * @return The previous and next keyframes, in an array which therefore will always have a length of 2.
 	 **/
-	std::array<Keyframe, 2> GetPreviousAndNextFrames() const;
+	std::array<const Keyframe *, 2> GetPreviousAndNextFrames() const;
 
 	/**
 	 * Calculates how far between the previous and next keyframe the current animation time is, and returns it as a value between 0 and 1.
@@ -85,7 +89,7 @@ public:
 	 * @return The local-space transforms for all the joints for the desired current pose.
 	 * They are returned in a map, indexed by the name of the joint to which they should be applied. </returns>
 	 **/
-	std::map<std::string, Matrix4> InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression) const;
+	Pose InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression) const;
 
 	/**
 	 * This method applies the current pose to a given joint, and all of its descendants.
@@ -110,7 +114,7 @@ public:
 	 * @param joint The current joint which the pose should be applied to.
 	 * @param parentTransform The desired model-space transform of the parent joint for the pose.
 	 **/
-	static void ApplyPoseToJoints(const std::map<std::string, Matrix4> &currentPose, Joint &joint, const Matrix4 &parentTransform);
+	static void ApplyPoseToJoints(const Pose &currentPose, Joint &joint, const Matrix4 &parentTransform);
 
 	const Animation *GetCurrentAnimation() const { return m_currentAnimation; }
 
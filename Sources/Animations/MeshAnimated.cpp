@@ -1,5 +1,6 @@
 #include "MeshAnimated.hpp"
 
+#include "Engine/Profiler.hpp"
 #include "Maths/Maths.hpp"
 #include "Files/File.hpp"
 #include "Serialized/Xml/Xml.hpp"
@@ -38,6 +39,8 @@ void MeshAnimated::Update()
 
 void MeshAnimated::Load()
 {
+	ACID_PROFILE_ZONE("MeshAnimated::Load");
+
 	if (m_filename.empty())
 	{
 		return;
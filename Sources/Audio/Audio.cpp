@@ -9,6 +9,7 @@
 #endif
 #include "Files/FileSystem.hpp"
 #include "Scenes/Scenes.hpp"
+#include "VoiceManager.hpp"
 
 namespace acid
 {
@@ -16,13 +17,37 @@ Audio::Audio() :
 	m_alDevice(nullptr),
 	m_alContext(nullptr)
 {
+	// A headless engine has no audio device, the voices are still ranked and mixed.
+	if (Engine::Get()->IsHeadless())
+	{
+		m_voiceManager = std::make_unique<VoiceManager>(VoiceManager::Mode::Offline);
+		return;
+	}
+
 	m_alDevice = alcOpenDevice(nullptr);
+
+	if (m_alDevice == nullptr)
+	{
+		Log::Error("Audio device could not be opened, sounds will be mixed offline\n");
+		m_voiceManager = std::make_unique<VoiceManager>(VoiceManager::Mode::Offline);
+		return;
+	}
+
 	m_alContext = alcCreateContext(m_alDevice, nullptr);
 	alcMakeContextCurrent(m_alContext);
+	m_voiceManager = std::make_unique<VoiceManager>(VoiceManager::Mode::Device);
 }
 
 Audio::~Audio()
 {
+	// Sources are deleted before the context they belong to.
+	m_voiceManager = nullptr;
+
+	if (m_alDevice == nullptr)
+	{
+		return;
+	}
+
 	alcMakeContextCurrent(nullptr);
 	alcDestroyContext(m_alContext);
 	alcCloseDevice(m_alDevice);
@@ -32,7 +57,14 @@ void Audio::Update()
 {
 	auto camera = Scenes::Get()->GetCamera();
 
-	if (camera == nullptr)
+	if (camera != nullptr)
+	{
+		m_voiceManager->SetListener(camera->GetPosition(), camera->GetViewRay().GetCurrentRay());
+	}
+
+	m_voiceManager->Update(Engine::Get()->GetDelta());
+
+	if (camera == nullptr || m_alDevice == nullptr)
 	{
 		return;
 	}
@@ -110,11 +142,13 @@ void Audio::SetGain(const Type &type, const float &volume)
 	if (it != m_gains.end())
 	{
 		it->second = volume;
+		m_voiceManager->SetTypeGain(type, volume);
 		m_onGain(type, volume);
 		return;
 	}
 
 	m_gains.emplace(type, volume);
+	m_voiceManager->SetTypeGain(type, volume);
 	m_onGain(type, volume);
 }
 }
@@ -8,6 +8,8 @@ typedef struct ALCcontext_struct ALCcontext;
 
 namespace acid
 {
+class VoiceManager;
+
 /**
  * M@brief odule used for loading, managing and playing a variety of different sound types.
  */
@@ -40,6 +42,12 @@ public:
 
 	ACID_HIDDEN ALCcontext *GetContext() const { return m_alContext; }
 
+	/**
+	 * Gets the voice manager that shares sources between sounds, it mixes offline when no audio device could be opened.
+	 * @return The voice manager.
+	 */
+	VoiceManager *GetVoiceManager() const { return m_voiceManager.get(); }
+
 	float GetGain(const Type &type) const;
 
 	void SetGain(const Type &type, const float &volume);
@@ -53,6 +61,7 @@ public:
 private:
 	ALCdevice *m_alDevice;
 	ALCcontext *m_alContext;
+	std::unique_ptr<VoiceManager> m_voiceManager;
 
 	std::map<Type, float> m_gains;
 
@@ -1,26 +1,25 @@
 ﻿#include "Sound.hpp"
 
-#if defined(ACID_BUILD_MACOS)
-#include <OpenAL/al.h>
-#else
-#include <al.h>
-#endif
 #include "Scenes/Entity.hpp"
+#include "VoiceManager.hpp"
 
 namespace acid
 {
-Sound::Sound(const std::string &filename, const Transform &localTransform, const Audio::Type &type, const bool &begin, const bool &loop, const float &gain, const float &pitch) :
-	m_soundBuffer(SoundBuffer::Create(filename)),
-	m_source(0),
-	m_localTransform(localTransform),
-	m_type(type),
-	m_gain(gain),
-	m_pitch(pitch)
+Sound::Sound(const std::string &filename, const Transform &localTransform, const Audio::Type &type, const bool &begin, const bool &loop, const float &gain, const float &pitch,
+	const bool &stream) :
+	m_voice(Audio::Get()->GetVoiceManager(), nullptr, type),
+	m_localTransform(localTransform)
 {
-	alGenSources(1, &m_source);
-	alSourcei(m_source, AL_BUFFER, m_soundBuffer->GetBuffer());
-
-	Audio::CheckAl(alGetError());
+	// Streams play on OpenAL sources, so without a device the whole file is loaded for the software mixer.
+	if (stream && Audio::Get()->GetVoiceManager()->GetMode() == VoiceManager::Mode::Device)
+	{
+		m_stream = std::make_unique<SoundStream>(filename);
+		m_voice.SetStream(m_stream.get());
+	}
+	else
+	{
+		m_voice.SetBuffer(SoundBuffer::Create(filename));
+	}
 
 	SetGain(gain);
 	SetPitch(pitch);
@@ -29,20 +28,6 @@ Sound::Sound(const std::string &filename, const Transform &localTransform, const
 	{
 		Play(loop);
 	}
-
-	Audio::Get()->OnGain() += [this](Audio::Type type, float volume)
-	{
-		if (type == m_type)
-		{
-			SetGain(m_gain);
-		}
-	};
-}
-
-Sound::~Sound()
-{
-	alDeleteSources(1, &m_source);
-	Audio::CheckAl(alGetError());
 }
 
 void Sound::Start()
@@ -56,63 +41,64 @@ void Sound::Update()
 
 void Sound::Decode(const Metadata &metadata)
 {
-	metadata.GetResource("Buffer", m_soundBuffer);
+	m_voice.SetStream(nullptr);
+	m_stream = nullptr;
+
+	if (auto streamNode = metadata.FindChild("Stream", false); streamNode != nullptr)
+	{
+		// Like the constructor, without a device the whole file is loaded for the software mixer.
+		if (Audio::Get()->GetVoiceManager()->GetMode() == VoiceManager::Mode::Device)
+		{
+			m_stream = std::make_unique<SoundStream>(streamNode->Get<std::string>());
+			m_voice.SetStream(m_stream.get());
+		}
+		else
+		{
+			m_voice.SetBuffer(SoundBuffer::Create(streamNode->Get<std::string>()));
+		}
+
+		return;
+	}
+
+	std::shared_ptr<SoundBuffer> soundBuffer;
+	metadata.GetResource("Buffer", soundBuffer);
+	m_voice.SetBuffer(soundBuffer);
 }
 
 void Sound::Encode(Metadata &metadata) const
 {
-	metadata.SetResource("Buffer", m_soundBuffer);
+	if (m_stream != nullptr)
+	{
+		metadata.SetChild("Stream", m_stream->GetFilename());
+		return;
+	}
+
+	metadata.SetResource("Buffer", m_voice.GetBuffer());
 }
 
 void Sound::Play(const bool &loop)
 {
-	alSourcei(m_source, AL_LOOPING, loop);
-	alSourcePlay(m_source);
-	Audio::CheckAl(alGetError());
-
-	SetGain(m_gain);
+	m_voice.Play(loop);
 }
 
 void Sound::Pause()
 {
-	if (!IsPlaying())
-	{
-		return;
-	}
-
-	alSourcePause(m_source);
-	Audio::CheckAl(alGetError());
+	m_voice.Pause();
 }
 
 void Sound::Resume()
 {
-	if (IsPlaying())
-	{
-		return;
-	}
-
-	alSourcePlay(m_source);
-	Audio::CheckAl(alGetError());
-
-	SetGain(m_gain);
+	m_voice.Resume();
 }
 
 void Sound::Stop()
 {
-	if (!IsPlaying())
-	{
-		return;
-	}
-
-	alSourceStop(m_source);
-	Audio::CheckAl(alGetError());
+	m_voice.Stop();
 }
 
 bool Sound::IsPlaying() const
 {
-	ALenum state;
-	alGetSourcei(m_source, AL_SOURCE_STATE, &state);
-	return state == AL_PLAYING;
+	return m_voice.IsPlaying();
 }
 
 Transform Sound::GetWorldTransform() const
@@ -128,36 +114,26 @@ Transform Sound::GetWorldTransform() const
 
 void Sound::SetPosition(const Vector3f &position)
 {
-	m_position = position;
-	alSource3f(m_source, AL_POSITION, m_position.m_x, m_position.m_y, m_position.m_z);
-	Audio::CheckAl(alGetError());
+	m_voice.SetPosition(position);
 }
 
 void Sound::SetDirection(const Vector3f &direction)
 {
-	m_direction = direction;
-	alSource3f(m_source, AL_DIRECTION, m_direction.m_x, m_direction.m_y, m_direction.m_z);
-	Audio::CheckAl(alGetError());
+	m_voice.SetDirection(direction);
 }
 
 void Sound::SetVelocity(const Vector3f &velocity)
 {
-	m_velocity = velocity;
-	alSource3f(m_source, AL_VELOCITY, m_velocity.m_x, m_velocity.m_y, m_velocity.m_z);
-	Audio::CheckAl(alGetError());
+	m_voice.SetVelocity(velocity);
 }
 
 void Sound::SetGain(const float &gain)
 {
-	m_gain = gain;
-	alSourcef(m_source, AL_GAIN, m_gain * Audio::Get()->GetGain(m_type));
-	Audio::CheckAl(alGetError());
+	m_voice.SetGain(gain);
 }
 
 void Sound::SetPitch(const float &pitch)
 {
-	m_pitch = pitch;
-	alSourcef(m_source, AL_PITCH, m_pitch);
-	Audio::CheckAl(alGetError());
+	m_voice.SetPitch(pitch);
 }
 }
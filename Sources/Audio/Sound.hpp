@@ -4,21 +4,24 @@
 #include "Maths/Transform.hpp"
 #include "Scenes/Component.hpp"
 #include "SoundBuffer.hpp"
+#include "SoundStream.hpp"
+#include "Voice.hpp"
 #include "Audio.hpp"
 
 namespace acid
 {
 /**
  * @brief Class that represents a playable sound.
+ * A streamed sound decodes its file in blocks while it plays instead of loading all of it into a buffer,
+ * use it for music and other long sounds.
+ * Sounds play through a voice, so only the most important audible sounds use a source at any time.
  */
 class ACID_EXPORT Sound :
 	public Component
 {
 public:
 	explicit Sound(const std::string &filename, const Transform &localTransform = Transform::Identity, const Audio::Type &type = Audio::Type::General, const bool &begin = false,
-		const bool &loop = false, const float &gain = 1.0f, const float &pitch = 1.0f);
-
-	~Sound();
+		const bool &loop = false, const float &gain = 1.0f, const float &pitch = 1.0f, const bool &stream = false);
 
 	void Start() override;
 
@@ -38,6 +41,8 @@ public:
 
 	bool IsPlaying() const;
 
+	bool IsStreamed() const { return m_stream != nullptr; }
+
 	const Transform &GetLocalTransform() const { return m_localTransform; }
 
 	void SetLocalTransform(const Transform &localTransform) { m_localTransform = localTransform; }
@@ -50,30 +55,30 @@ public:
 
 	void SetVelocity(const Vector3f &velocity);
 
-	const Audio::Type &GetType() const { return m_type; }
+	const Audio::Type &GetType() const { return m_voice.GetType(); }
 
-	void SetType(const Audio::Type &type) { m_type = type; }
+	void SetType(const Audio::Type &type) { m_voice.SetType(type); }
 
-	const float &GetGain() const { return m_gain; }
+	const float &GetGain() const { return m_voice.GetGain(); }
 
 	void SetGain(const float &gain);
 
-	const float &GetPitch() const { return m_pitch; }
+	const float &GetPitch() const { return m_voice.GetPitch(); }
 
 	void SetPitch(const float &pitch);
 
+	const int32_t &GetPriority() const { return m_voice.GetPriority(); }
+
+	void SetPriority(const int32_t &priority) { m_voice.SetPriority(priority); }
+
+	const Voice &GetVoice() const { return m_voice; }
+
 private:
-	std::shared_ptr<SoundBuffer> m_soundBuffer;
-	uint32_t m_source;
+	/// Declared before the voice, which stops the stream when it is destroyed.
+	std::unique_ptr<SoundStream> m_stream;
+	Voice m_voice;
 
 	Transform m_localTransform;
 	mutable Transform m_worldTransform;
-	Vector3f m_position;
-	Vector3f m_direction;
-	Vector3f m_velocity;
-
-	Audio::Type m_type;
-	float m_gain;
-	float m_pitch;
 };
 }
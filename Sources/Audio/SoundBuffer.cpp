@@ -5,10 +5,12 @@
 #else
 #include <al.h>
 #endif
+#include "Engine/Profiler.hpp"
 #include "Files/Files.hpp"
 #include "Files/FileSystem.hpp"
 #include "Helpers/String.hpp"
 #include "Resources/Resources.hpp"
+#include "VoiceManager.hpp"
 #include "stb_vorbis.c"
 
 namespace acid
@@ -39,7 +41,10 @@ std::shared_ptr<SoundBuffer> SoundBuffer::Create(const std::string &filename)
 
 SoundBuffer::SoundBuffer(std::string filename, const bool &load) :
 	m_filename(std::move(filename)),
-	m_buffer(0)
+	m_buffer(0),
+	m_channels(0),
+	m_sampleRate(0),
+	m_frames(0)
 {
 	if (load)
 	{
@@ -47,13 +52,28 @@ SoundBuffer::SoundBuffer(std::string filename, const bool &load) :
 	}
 }
 
+SoundBuffer::SoundBuffer(std::vector<int16_t> samples, const int32_t &channels, const int32_t &sampleRate) :
+	m_buffer(0),
+	m_samples(std::move(samples)),
+	m_channels(channels),
+	m_sampleRate(sampleRate),
+	m_frames(0)
+{
+	Upload();
+}
+
 SoundBuffer::~SoundBuffer()
 {
-	alDeleteBuffers(1, &m_buffer);
+	if (m_buffer != 0)
+	{
+		alDeleteBuffers(1, &m_buffer);
+	}
 }
 
 void SoundBuffer::Load()
 {
+	ACID_PROFILE_ZONE("SoundBuffer::Load");
+
 	if (m_filename.empty())
 	{
 		return;
@@ -63,12 +83,14 @@ void SoundBuffer::Load()
 
 	if (fileExt == ".wav")
 	{
-		m_buffer = LoadBufferWav(m_filename);
+		LoadWav(m_filename, m_samples, m_channels, m_sampleRate);
 	}
 	else if (fileExt == ".ogg")
 	{
-		m_buffer = LoadBufferOgg(m_filename);
+		LoadOgg(m_filename, m_samples, m_channels, m_sampleRate);
 	}
+
+	Upload();
 }
 
 void SoundBuffer::Decode(const Metadata &metadata)
@@ -81,22 +103,31 @@ void SoundBuffer::Encode(Metadata &metadata) const
 	metadata.SetChild("Filename", m_filename);
 }
 
-uint32_t SoundBuffer::LoadBufferWav(const std::string &filename)
+Time SoundBuffer::GetDuration() const
+{
+	if (m_sampleRate == 0)
+	{
+		return Time::Zero;
+	}
+
+	return Time::Seconds(static_cast<double>(m_frames) / m_sampleRate);
+}
+
+bool SoundBuffer::LoadWav(const std::string &filename, std::vector<int16_t> &samples, int32_t &channels, int32_t &sampleRate)
 {
 #if defined(ACID_VERBOSE)
 	auto debugStart = Engine::GetTime();
 #endif
 
-	auto fileLoaded = Files::Read(filename);
+	auto fileLoaded = Files::ReadView(filename);
 
 	if (!fileLoaded)
 	{
 		Log::Error("WAV file could not be loaded: '%s'\n", filename.c_str());
-		return 0;
+		return false;
 	}
 
-	std::stringstream file;
-	file << *fileLoaded;
+	ViewStream file(*fileLoaded);
 
 	char chunkId[5] = "\0";
 
@@ -119,14 +150,14 @@ uint32_t SoundBuffer::LoadBufferWav(const std::string &filename)
 
 	// Read first chunk content.
 	int16_t formatTag;
-	int16_t channels;
+	int16_t channelCount;
 	int32_t samplesPerSec;
 	int32_t averageBytesPerSec;
 	int16_t blockAlign;
 	int16_t bitsPerSample;
 
 	file.read(reinterpret_cast<char *>(&formatTag), 2);
-	file.read(reinterpret_cast<char *>(&channels), 2);
+	file.read(reinterpret_cast<char *>(&channelCount), 2);
 	file.read(reinterpret_cast<char *>(&samplesPerSec), 4);
 	file.read(reinterpret_cast<char *>(&averageBytesPerSec), 4);
 	file.read(reinterpret_cast<char *>(&blockAlign), 2);
@@ -143,57 +174,74 @@ uint32_t SoundBuffer::LoadBufferWav(const std::string &filename)
 
 	chunkId[4] = '\0';
 
-	std::unique_ptr<uint8_t[]> data(new uint8_t[size]);
-	file.read(reinterpret_cast<char *>(data.get()), size);
-
-	uint32_t buffer;
-	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, data.get(), size, samplesPerSec);
-
-	Audio::CheckAl(alGetError());
+	samples.resize(size / sizeof(int16_t));
+	file.read(reinterpret_cast<char *>(samples.data()), samples.size() * sizeof(int16_t));
+	channels = channelCount;
+	sampleRate = samplesPerSec;
 
 #if defined(ACID_VERBOSE)
 	auto debugEnd = Engine::GetTime();
 	Log::Out("Sound WAV '%s' loaded in %.3fms\n", filename.c_str(), (debugEnd - debugStart).AsMilliseconds<float>());
 #endif
-	return buffer;
+	return true;
 }
 
-uint32_t SoundBuffer::LoadBufferOgg(const std::string &filename)
+bool SoundBuffer::LoadOgg(const std::string &filename, std::vector<int16_t> &samples, int32_t &channels, int32_t &sampleRate)
 {
 #if defined(ACID_VERBOSE)
 	auto debugStart = Engine::GetTime();
 #endif
 
-	auto fileLoaded = Files::Read(filename);
+	auto fileLoaded = Files::ReadView(filename);
 
 	if (!fileLoaded)
 	{
 		Log::Error("OGG file could not be loaded: '%s'\n", filename.c_str());
-		return 0;
+		return false;
 	}
 
-	int32_t channels;
-	int32_t samplesPerSec;
 	int16_t *data;
-	auto size = stb_vorbis_decode_memory(reinterpret_cast<uint8_t *>(fileLoaded->data()), static_cast<uint32_t>(fileLoaded->size()), &channels, &samplesPerSec, &data);
+	auto size = stb_vorbis_decode_memory(reinterpret_cast<const uint8_t *>(fileLoaded->GetData()), static_cast<int32_t>(fileLoaded->GetSize()), &channels, &sampleRate, &data);
 
 	if (size == -1)
 	{
 		Log::Error("Error reading the OGG '%s', could not find size! The audio could not be loaded.\n", filename.c_str());
+		return false;
 	}
 
-	uint32_t buffer;
-	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, data, size, samplesPerSec);
-
-	delete[] data;
-	Audio::CheckAl(alGetError());
+	samples.assign(data, data + size * channels);
+	std::free(data);
 
 #if defined(ACID_VERBOSE)
 	auto debugEnd = Engine::GetTime();
 	Log::Out("Sound OGG '%s' loaded in %.3fms\n", filename.c_str(), (debugEnd - debugStart).AsMilliseconds<float>());
 #endif
-	return buffer;
+	return true;
+}
+
+void SoundBuffer::Upload()
+{
+	if (m_channels == 0)
+	{
+		return;
+	}
+
+	m_frames = m_samples.size() / m_channels;
+
+	// Without an audio device the samples are kept for the software mixer.
+	auto engine = Engine::Get();
+	auto audio = engine != nullptr ? engine->GetModuleManager().Get<Audio>() : nullptr;
+
+	if (audio == nullptr || audio->GetVoiceManager()->GetMode() == VoiceManager::Mode::Offline)
+	{
+		return;
+	}
+
+	alGenBuffers(1, &m_buffer);
+	alBufferData(m_buffer, (m_channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, m_samples.data(), static_cast<ALsizei>(m_samples.size() * sizeof(int16_t)), m_sampleRate);
+	Audio::CheckAl(alGetError());
+
+	m_samples.clear();
+	m_samples.shrink_to_fit();
 }
 }
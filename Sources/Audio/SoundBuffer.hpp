@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Maths/Time.hpp"
 #include "Maths/Vector3.hpp"
 #include "Resources/Resource.hpp"
 #include "Audio.hpp"
@@ -34,6 +35,14 @@ public:
 	 */
 	explicit SoundBuffer(std::string filename, const bool &load = true);
 
+	/**
+	 * Creates a new sound buffer from decoded samples.
+	 * @param samples The interleaved 16 bit samples.
+	 * @param channels The number of channels, 1 or 2.
+	 * @param sampleRate The number of frames per second.
+	 */
+	SoundBuffer(std::vector<int16_t> samples, const int32_t &channels, const int32_t &sampleRate);
+
 	~SoundBuffer();
 
 	void Load() override;
@@ -46,12 +55,33 @@ public:
 
 	const uint32_t &GetBuffer() const { return m_buffer; }
 
+	/**
+	 * Gets the decoded samples, these are only kept when there is no audio device to upload them to.
+	 * @return The interleaved 16 bit samples.
+	 */
+	const std::vector<int16_t> &GetSamples() const { return m_samples; }
+
+	const int32_t &GetChannels() const { return m_channels; }
+
+	const int32_t &GetSampleRate() const { return m_sampleRate; }
+
+	Time GetDuration() const;
+
 private:
-	static uint32_t LoadBufferWav(const std::string &filename);
+	static bool LoadWav(const std::string &filename, std::vector<int16_t> &samples, int32_t &channels, int32_t &sampleRate);
 
-	static uint32_t LoadBufferOgg(const std::string &filename);
+	static bool LoadOgg(const std::string &filename, std::vector<int16_t> &samples, int32_t &channels, int32_t &sampleRate);
+
+	/**
+	 * Uploads the samples into an OpenAL buffer and frees them, unless voices are being mixed offline.
+	 */
+	void Upload();
 
 	std::string m_filename;
 	uint32_t m_buffer;
+	std::vector<int16_t> m_samples;
+	int32_t m_channels;
+	int32_t m_sampleRate;
+	std::size_t m_frames;
 };
 }
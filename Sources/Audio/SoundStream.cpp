@@ -0,0 +1,409 @@
+#include "SoundStream.hpp"
+
+#if defined(ACID_BUILD_MACOS)
+#include <OpenAL/al.h>
+#else
+#include <al.h>
+#endif
+#include "Engine/Engine.hpp"
+#include "Files/Files.hpp"
+#include "Files/FileSystem.hpp"
+#include "Helpers/String.hpp"
+#include "Audio.hpp"
+#define STB_VORBIS_HEADER_ONLY
+#include "stb_vorbis.c"
+
+namespace acid
+{
+SoundStream::SoundStream(std::string filename, const Time &blockLength) :
+	m_filename(std::move(filename)),
+	m_vorbis(nullptr),
+	m_dataOffset(0),
+	m_dataSize(0),
+	m_dataPosition(0),
+	m_channels(0),
+	m_sampleRate(0),
+	m_format(0),
+	m_blockFrames(0),
+	m_buffers(),
+	m_source(0),
+	m_playing(false),
+	m_readBlock(0),
+	m_readyBlocks(0),
+	m_loop(false),
+	m_ended(false),
+	m_rewind(false),
+	m_closing(false)
+{
+#if defined(ACID_VERBOSE)
+	auto debugStart = Engine::GetTime();
+#endif
+
+	m_file = Files::ReadView(m_filename);
+
+	if (!m_file)
+	{
+		Log::Error("Sound stream file could not be loaded: '%s'\n", m_filename.c_str());
+		return;
+	}
+
+	auto fileExt = String::Lowercase(FileSystem::FileSuffix(m_filename));
+
+	if (!(fileExt == ".wav" ? OpenWav() : fileExt == ".ogg" ? OpenOgg() : false))
+	{
+		Log::Error("Sound stream file could not be decoded: '%s'\n", m_filename.c_str());
+		m_sampleRate = 0;
+		return;
+	}
+
+	m_format = m_channels == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+	m_blockFrames = std::max<std::size_t>(static_cast<std::size_t>(blockLength.AsSeconds<double>() * m_sampleRate), 1024);
+
+	for (auto &block : m_blocks)
+	{
+		block.m_samples.resize(m_blockFrames * m_channels);
+	}
+
+	alGenBuffers(BufferCount, m_buffers.data());
+	Audio::CheckAl(alGetError());
+	m_freeBuffers.assign(m_buffers.begin(), m_buffers.end());
+
+	m_thread = std::thread(&SoundStream::DecodeLoop, this);
+
+#if defined(ACID_VERBOSE)
+	auto debugEnd = Engine::GetTime();
+	Log::Out("Sound stream '%s' opened in %.3fms\n", m_filename.c_str(), (debugEnd - debugStart).AsMilliseconds<float>());
+#endif
+}
+
+SoundStream::~SoundStream()
+{
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_closing = true;
+		}
+
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	if (m_source != 0)
+	{
+		alSourceStop(m_source);
+		alSourcei(m_source, AL_BUFFER, 0);
+	}
+
+	if (IsLoaded())
+	{
+		alDeleteBuffers(BufferCount, m_buffers.data());
+	}
+
+	if (m_vorbis != nullptr)
+	{
+		stb_vorbis_close(m_vorbis);
+	}
+}
+
+void SoundStream::Play(const uint32_t &source, const bool &loop)
+{
+	if (!IsLoaded())
+	{
+		return;
+	}
+
+	Stop();
+
+	m_source = source;
+	alSourcei(m_source, AL_BUFFER, 0);
+	alSourcei(m_source, AL_LOOPING, AL_FALSE);
+
+	{
+		// Only the first block is waited for, it's normally decoded long before playback is asked for.
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_loop = loop;
+		m_condition.wait(lock, [this]()
+		{
+			return !m_rewind && (m_readyBlocks > 0 || m_ended);
+		});
+	}
+
+	Queue();
+	alSourcePlay(m_source);
+	Audio::CheckAl(alGetError());
+	m_playing = true;
+}
+
+void SoundStream::Pause()
+{
+	if (!m_playing)
+	{
+		return;
+	}
+
+	alSourcePause(m_source);
+	m_playing = false;
+}
+
+void SoundStream::Resume()
+{
+	if (m_playing || m_source == 0)
+	{
+		return;
+	}
+
+	alSourcePlay(m_source);
+	m_playing = true;
+}
+
+void SoundStream::Stop()
+{
+	if (m_source != 0)
+	{
+		// Stopping marks every queued buffer as processed, so they can all be taken back.
+		alSourceStop(m_source);
+		alSourcei(m_source, AL_BUFFER, 0);
+		m_freeBuffers.assign(m_buffers.begin(), m_buffers.end());
+		m_source = 0;
+	}
+
+	m_playing = false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_readBlock = 0;
+		m_readyBlocks = 0;
+		m_ended = false;
+		m_rewind = true;
+	}
+
+	m_condition.notify_all();
+}
+
+void SoundStream::Update()
+{
+	if (m_source == 0 || !m_playing)
+	{
+		return;
+	}
+
+	ALint processed = 0;
+	alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+
+	while (processed-- > 0)
+	{
+		ALuint buffer;
+		alSourceUnqueueBuffers(m_source, 1, &buffer);
+		m_freeBuffers.emplace_back(buffer);
+	}
+
+	Queue();
+
+	ALint state;
+	ALint queued;
+	alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+	alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+
+	if (state != AL_PLAYING)
+	{
+		if (queued > 0)
+		{
+			// The decoder fell behind and the source ran dry, carry on from where it stopped.
+			alSourcePlay(m_source);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_playing = !m_ended;
+		}
+	}
+
+	Audio::CheckAl(alGetError());
+}
+
+bool SoundStream::OpenWav()
+{
+	auto data = reinterpret_cast<const uint8_t *>(m_file->GetData());
+	auto size = m_file->GetSize();
+
+	if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0)
+	{
+		return false;
+	}
+
+	auto readU16 = [&](const std::size_t &offset)
+	{
+		return static_cast<uint32_t>(data[offset] | data[offset + 1] << 8);
+	};
+	auto readU32 = [&](const std::size_t &offset)
+	{
+		return readU16(offset) | readU16(offset + 2) << 16;
+	};
+
+	uint32_t bitsPerSample = 0;
+	std::size_t offset = 12;
+
+	while (offset + 8 <= size)
+	{
+		auto chunkSize = static_cast<std::size_t>(readU32(offset + 4));
+		auto chunkData = offset + 8;
+
+		if (std::memcmp(data + offset, "fmt ", 4) == 0 && chunkSize >= 16 && chunkData + 16 <= size)
+		{
+			m_channels = static_cast<int32_t>(readU16(chunkData + 2));
+			m_sampleRate = static_cast<int32_t>(readU32(chunkData + 4));
+			bitsPerSample = readU16(chunkData + 14);
+		}
+		else if (std::memcmp(data + offset, "data", 4) == 0)
+		{
+			m_dataOffset = chunkData;
+			m_dataSize = std::min(chunkSize, size - chunkData);
+			break;
+		}
+
+		// Chunks are padded to an even size.
+		offset = chunkData + chunkSize + (chunkSize & 1);
+	}
+
+	return bitsPerSample == 16 && (m_channels == 1 || m_channels == 2) && m_sampleRate > 0 && m_dataOffset != 0;
+}
+
+bool SoundStream::OpenOgg()
+{
+	int32_t error = 0;
+	m_vorbis = stb_vorbis_open_memory(reinterpret_cast<const uint8_t *>(m_file->GetData()), static_cast<int32_t>(m_file->GetSize()), &error, nullptr);
+
+	if (m_vorbis == nullptr)
+	{
+		return false;
+	}
+
+	auto info = stb_vorbis_get_info(m_vorbis);
+	m_channels = std::min(info.channels, 2);
+	m_sampleRate = static_cast<int32_t>(info.sample_rate);
+	return m_sampleRate > 0;
+}
+
+std::size_t SoundStream::Decode(int16_t *samples, const std::size_t &frames)
+{
+	if (m_vorbis != nullptr)
+	{
+		std::size_t decoded = 0;
+
+		while (decoded < frames)
+		{
+			auto count = stb_vorbis_get_samples_short_interleaved(m_vorbis, m_channels, samples + decoded * m_channels,
+				static_cast<int32_t>((frames - decoded) * m_channels));
+
+			if (count <= 0)
+			{
+				break;
+			}
+
+			decoded += count;
+		}
+
+		return decoded;
+	}
+
+	auto frameSize = static_cast<std::size_t>(m_channels) * sizeof(int16_t);
+	auto decoded = std::min(frames, (m_dataSize - m_dataPosition) / frameSize);
+	std::memcpy(samples, m_file->GetData() + m_dataOffset + m_dataPosition, decoded * frameSize);
+	m_dataPosition += decoded * frameSize;
+	return decoded;
+}
+
+void SoundStream::Rewind()
+{
+	if (m_vorbis != nullptr)
+	{
+		stb_vorbis_seek_start(m_vorbis);
+	}
+
+	m_dataPosition = 0;
+}
+
+void SoundStream::DecodeLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (true)
+	{
+		m_condition.wait(lock, [this]()
+		{
+			return m_closing || m_rewind || (!m_ended && m_readyBlocks < BufferCount);
+		});
+
+		if (m_closing)
+		{
+			return;
+		}
+
+		if (m_rewind)
+		{
+			Rewind();
+			m_rewind = false;
+			m_condition.notify_all();
+			continue;
+		}
+
+		// The block being written isn't visible to Update until it is counted as ready.
+		auto &block = m_blocks[(m_readBlock + m_readyBlocks) % BufferCount];
+		auto loop = m_loop;
+		lock.unlock();
+
+		auto frames = Decode(block.m_samples.data(), m_blockFrames);
+		auto ended = frames < m_blockFrames;
+
+		if (ended && loop)
+		{
+			Rewind();
+			frames += Decode(block.m_samples.data() + frames * m_channels, m_blockFrames - frames);
+			ended = frames == 0;
+		}
+
+		lock.lock();
+
+		// A Stop while decoding makes this block stale.
+		if (m_rewind)
+		{
+			continue;
+		}
+
+		if (frames > 0)
+		{
+			block.m_count = frames * m_channels;
+			m_readyBlocks++;
+		}
+
+		m_ended = ended;
+		m_condition.notify_all();
+	}
+}
+
+void SoundStream::Queue()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto queued = false;
+
+	while (!m_freeBuffers.empty() && m_readyBlocks > 0)
+	{
+		auto &block = m_blocks[m_readBlock];
+		auto buffer = m_freeBuffers.back();
+		m_freeBuffers.pop_back();
+		alBufferData(buffer, m_format, block.m_samples.data(), static_cast<ALsizei>(block.m_count * sizeof(int16_t)), m_sampleRate);
+		alSourceQueueBuffers(m_source, 1, &buffer);
+		m_readBlock = (m_readBlock + 1) % BufferCount;
+		m_readyBlocks--;
+		queued = true;
+	}
+
+	lock.unlock();
+
+	if (queued)
+	{
+		m_condition.notify_all();
+	}
+}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <condition_variable>
+#include <thread>
+#include "Files/FileView.hpp"
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Time.hpp"
+
+typedef struct stb_vorbis stb_vorbis;
+
+namespace acid
+{
+/**
+ * @brief Plays a long sound file without decoding it all into memory.
+ * A background thread decodes the file in short blocks, and Update queues them onto the playing source
+ * through a few rotating buffers, so memory use is a few blocks of samples no matter how long the file is.
+ * The first block is decoded as soon as the stream is created, so playback starts without waiting on the whole file.
+ */
+class ACID_EXPORT SoundStream :
+	public NonCopyable
+{
+public:
+	/// Number of buffers rotated through the source, and blocks decoded ahead.
+	static constexpr uint32_t BufferCount = 4;
+
+	/**
+	 * Creates a new sound stream, and starts decoding the start of the file.
+	 * @param filename The WAV or OGG file to stream.
+	 * @param blockLength The length of audio decoded into each buffer.
+	 */
+	explicit SoundStream(std::string filename, const Time &blockLength = Time::Milliseconds(250));
+
+	~SoundStream();
+
+	/**
+	 * Starts playing the stream on a source from the start of the file, the source must not have a static buffer.
+	 * @param source The source to play on.
+	 * @param loop If the stream restarts when it reaches the end of the file.
+	 */
+	void Play(const uint32_t &source, const bool &loop);
+
+	void Pause();
+
+	void Resume();
+
+	/**
+	 * Stops playback, rewinds to the start of the file, and lets go of the source.
+	 */
+	void Stop();
+
+	/**
+	 * Refills the buffers the source has finished with, must be called regularly while playing.
+	 */
+	void Update();
+
+	bool IsLoaded() const { return m_sampleRate != 0; }
+
+	bool IsPlaying() const { return m_playing; }
+
+	const std::string &GetFilename() const { return m_filename; }
+
+	const int32_t &GetChannels() const { return m_channels; }
+
+	const int32_t &GetSampleRate() const { return m_sampleRate; }
+
+private:
+	struct Block
+	{
+		std::vector<int16_t> m_samples;
+		std::size_t m_count = 0;
+	};
+
+	bool OpenWav();
+
+	bool OpenOgg();
+
+	/**
+	 * Decodes interleaved samples from the current position, only called on the decode thread.
+	 * @param samples The samples to fill.
+	 * @param frames The number of frames to decode.
+	 * @return The number of frames decoded, less than requested at the end of the file.
+	 */
+	std::size_t Decode(int16_t *samples, const std::size_t &frames);
+
+	void Rewind();
+
+	void DecodeLoop();
+
+	void Queue();
+
+	std::string m_filename;
+	std::optional<FileView> m_file;
+	stb_vorbis *m_vorbis;
+	std::size_t m_dataOffset;
+	std::size_t m_dataSize;
+	std::size_t m_dataPosition;
+	int32_t m_channels;
+	int32_t m_sampleRate;
+	int32_t m_format;
+	std::size_t m_blockFrames;
+
+	std::array<uint32_t, BufferCount> m_buffers;
+	std::vector<uint32_t> m_freeBuffers;
+	uint32_t m_source;
+	bool m_playing;
+
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::array<Block, BufferCount> m_blocks;
+	uint32_t m_readBlock;
+	uint32_t m_readyBlocks;
+	bool m_loop;
+	bool m_ended;
+	bool m_rewind;
+	bool m_closing;
+};
+}
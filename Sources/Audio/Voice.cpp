@@ -0,0 +1,184 @@
+#include "Voice.hpp"
+
+#include "SoundStream.hpp"
+#include "VoiceManager.hpp"
+
+namespace acid
+{
+Voice::Voice(VoiceManager *manager, std::shared_ptr<SoundBuffer> buffer, const Audio::Type &type) :
+	m_manager(manager),
+	m_index(0),
+	m_slot(NoSlot),
+	m_rankFrame(0),
+	m_dirty(DirtyAll),
+	m_buffer(std::move(buffer)),
+	m_stream(nullptr),
+	m_type(type),
+	m_priority(0),
+	m_state(State::Stopped),
+	m_loop(false),
+	m_offset(0.0),
+	m_audibility(0.0f),
+	m_gain(1.0f),
+	m_pitch(1.0f)
+{
+	if (m_manager != nullptr)
+	{
+		m_manager->Add(*this);
+	}
+}
+
+Voice::~Voice()
+{
+	if (m_manager != nullptr)
+	{
+		m_manager->Remove(*this);
+	}
+}
+
+void Voice::Play(const bool &loop)
+{
+	m_state = State::Playing;
+	m_loop = loop;
+	m_offset = 0.0;
+
+	if (m_manager != nullptr)
+	{
+		m_manager->Start(*this, true);
+	}
+}
+
+void Voice::Pause()
+{
+	if (m_state != State::Playing)
+	{
+		return;
+	}
+
+	m_state = State::Paused;
+
+	if (m_manager == nullptr || !IsReal())
+	{
+		return;
+	}
+
+	// A paused stream keeps its source, it couldn't pick up where it left off on another one.
+	if (m_stream != nullptr)
+	{
+		m_stream->Pause();
+		return;
+	}
+
+	m_manager->Release(*this);
+}
+
+void Voice::Resume()
+{
+	if (m_state != State::Paused)
+	{
+		return;
+	}
+
+	m_state = State::Playing;
+
+	if (m_stream != nullptr && IsReal())
+	{
+		m_stream->Resume();
+		return;
+	}
+
+	if (m_manager != nullptr)
+	{
+		m_manager->Start(*this, false);
+	}
+}
+
+void Voice::Stop()
+{
+	m_state = State::Stopped;
+	m_offset = 0.0;
+
+	if (m_manager != nullptr && IsReal())
+	{
+		m_manager->Release(*this);
+	}
+}
+
+bool Voice::IsReal() const
+{
+	return m_slot != NoSlot;
+}
+
+void Voice::SetBuffer(const std::shared_ptr<SoundBuffer> &buffer)
+{
+	if (m_manager != nullptr && IsReal())
+	{
+		m_manager->Release(*this);
+	}
+
+	m_buffer = buffer;
+	m_offset = 0.0;
+}
+
+void Voice::SetStream(SoundStream *stream)
+{
+	if (m_manager != nullptr && IsReal())
+	{
+		m_manager->Release(*this);
+	}
+
+	m_stream = stream;
+	m_offset = 0.0;
+}
+
+void Voice::SetType(const Audio::Type &type)
+{
+	m_type = type;
+	m_dirty |= DirtyGain;
+}
+
+void Voice::SetPosition(const Vector3f &position)
+{
+	if (m_position != position)
+	{
+		m_position = position;
+		m_dirty |= DirtyPosition;
+	}
+}
+
+void Voice::SetVelocity(const Vector3f &velocity)
+{
+	if (m_velocity != velocity)
+	{
+		m_velocity = velocity;
+		m_dirty |= DirtyVelocity;
+	}
+}
+
+void Voice::SetDirection(const Vector3f &direction)
+{
+	if (m_direction != direction)
+	{
+		m_direction = direction;
+		m_dirty |= DirtyDirection;
+	}
+}
+
+void Voice::SetGain(const float &gain)
+{
+	if (m_gain != gain)
+	{
+		m_gain = gain;
+		m_dirty |= DirtyGain;
+	}
+}
+
+void Voice::SetPitch(const float &pitch)
+{
+	if (m_pitch != pitch)
+	{
+		m_pitch = pitch;
+		m_dirty |= DirtyPitch;
+	}
+}
+}
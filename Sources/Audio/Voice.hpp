@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Vector3.hpp"
+#include "Audio.hpp"
+
+namespace acid
+{
+class SoundBuffer;
+class SoundStream;
+class VoiceManager;
+
+/**
+ * @brief A playing instance of a sound, that is given a real source by the voice manager only while it can be heard.
+ * Voices that are too quiet, or outranked by more important voices once every source is in use, become virtual:
+ * they keep their play position ticking so they pick up where they should be when they get a source again.
+ * Setters only record what changed, the voice manager pushes changes to the sources of real voices once per update.
+ */
+class ACID_EXPORT Voice :
+	public NonCopyable
+{
+public:
+	enum class State
+	{
+		Stopped, Playing, Paused
+	};
+
+	/**
+	 * Creates a new voice.
+	 * @param manager The voice manager to register with.
+	 * @param buffer The sound buffer to play.
+	 * @param type The gain group of the voice.
+	 */
+	explicit Voice(VoiceManager *manager, std::shared_ptr<SoundBuffer> buffer = nullptr, const Audio::Type &type = Audio::Type::General);
+
+	~Voice();
+
+	/**
+	 * Plays the voice from the start.
+	 * @param loop If the voice repeats until it is stopped.
+	 */
+	void Play(const bool &loop = false);
+
+	void Pause();
+
+	void Resume();
+
+	void Stop();
+
+	const State &GetState() const { return m_state; }
+
+	bool IsPlaying() const { return m_state == State::Playing; }
+
+	/**
+	 * Gets if the voice has a source, and so is heard.
+	 * @return If the voice is real.
+	 */
+	bool IsReal() const;
+
+	const std::shared_ptr<SoundBuffer> &GetBuffer() const { return m_buffer; }
+
+	void SetBuffer(const std::shared_ptr<SoundBuffer> &buffer);
+
+	SoundStream *GetStream() const { return m_stream; }
+
+	/**
+	 * Sets a stream to play instead of a buffer. Streams can't seek, so once a streamed voice has a source it keeps it
+	 * until it is stopped, and it is never made virtual.
+	 * @param stream The stream, owned by the caller, or null to play the buffer.
+	 */
+	void SetStream(SoundStream *stream);
+
+	const Audio::Type &GetType() const { return m_type; }
+
+	void SetType(const Audio::Type &type);
+
+	const int32_t &GetPriority() const { return m_priority; }
+
+	/**
+	 * Sets the priority of the voice, when there are more audible voices than sources higher priorities are given sources first.
+	 * @param priority The priority.
+	 */
+	void SetPriority(const int32_t &priority) { m_priority = priority; }
+
+	const Vector3f &GetPosition() const { return m_position; }
+
+	void SetPosition(const Vector3f &position);
+
+	const Vector3f &GetVelocity() const { return m_velocity; }
+
+	void SetVelocity(const Vector3f &velocity);
+
+	const Vector3f &GetDirection() const { return m_direction; }
+
+	void SetDirection(const Vector3f &direction);
+
+	const float &GetGain() const { return m_gain; }
+
+	void SetGain(const float &gain);
+
+	const float &GetPitch() const { return m_pitch; }
+
+	void SetPitch(const float &pitch);
+
+	/**
+	 * Gets how loud the voice was at the last update, from its gain, type gain and distance to the listener.
+	 * @return The audibility.
+	 */
+	const float &GetAudibility() const { return m_audibility; }
+
+	/**
+	 * Gets the play position of a virtual voice, or of a real voice when it last lost its source.
+	 * @return The play position in seconds.
+	 */
+	const double &GetOffset() const { return m_offset; }
+
+private:
+	friend class VoiceManager;
+
+	enum Dirty : uint32_t
+	{
+		DirtyPosition = 1 << 0,
+		DirtyVelocity = 1 << 1,
+		DirtyDirection = 1 << 2,
+		DirtyGain = 1 << 3,
+		DirtyPitch = 1 << 4,
+		DirtyAll = 0xFF
+	};
+
+	static constexpr uint32_t NoSlot = std::numeric_limits<uint32_t>::max();
+
+	VoiceManager *m_manager;
+	uint32_t m_index;
+	uint32_t m_slot;
+	uint64_t m_rankFrame;
+	uint32_t m_dirty;
+
+	std::shared_ptr<SoundBuffer> m_buffer;
+	SoundStream *m_stream;
+	Audio::Type m_type;
+	int32_t m_priority;
+	State m_state;
+	bool m_loop;
+	double m_offset;
+	float m_audibility;
+
+	Vector3f m_position;
+	Vector3f m_velocity;
+	Vector3f m_direction;
+	float m_gain;
+	float m_pitch;
+};
+}
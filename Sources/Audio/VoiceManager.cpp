@@ -0,0 +1,465 @@
+#include "VoiceManager.hpp"
+
+#if defined(ACID_BUILD_MACOS)
+#include <OpenAL/al.h>
+#else
+#include <al.h>
+#endif
+#include "Maths/Maths.hpp"
+#include "SoundBuffer.hpp"
+#include "SoundStream.hpp"
+
+namespace acid
+{
+VoiceManager::VoiceManager(const Mode &mode, const uint32_t &maxVoices) :
+	m_mode(mode),
+	m_frame(0),
+	m_mixed(false),
+	m_listenerRight(Vector3f::Right)
+{
+	m_typeGains.fill(1.0f);
+
+	for (uint32_t i = 0; i < maxVoices; i++)
+	{
+		uint32_t source = 0;
+
+		if (m_mode == Mode::Device)
+		{
+			// Devices have a limited number of sources, use as many as it will give up to the maximum.
+			alGenSources(1, &source);
+
+			if (alGetError() != AL_NO_ERROR)
+			{
+				break;
+			}
+		}
+
+		m_sources.emplace_back(source);
+	}
+
+	m_owners.resize(m_sources.size(), nullptr);
+
+	for (auto slot = static_cast<uint32_t>(m_sources.size()); slot-- > 0;)
+	{
+		m_freeSlots.emplace_back(slot);
+	}
+}
+
+VoiceManager::~VoiceManager()
+{
+	for (auto &voice : m_voices)
+	{
+		if (voice->IsReal())
+		{
+			Release(*voice);
+		}
+
+		voice->m_manager = nullptr;
+	}
+
+	if (m_mode == Mode::Device && !m_sources.empty())
+	{
+		alDeleteSources(static_cast<ALsizei>(m_sources.size()), m_sources.data());
+	}
+}
+
+void VoiceManager::Update(const Time &delta)
+{
+	m_frame++;
+	m_ranked.clear();
+	auto pinned = 0u;
+	auto mixed = m_mixed;
+	m_mixed = false;
+
+	for (auto &voice : m_voices)
+	{
+		if (voice->m_state != Voice::State::Playing)
+		{
+			// Paused streams hold onto their source.
+			if (voice->IsReal())
+			{
+				pinned++;
+			}
+
+			continue;
+		}
+
+		if (voice->IsReal())
+		{
+			auto finished = false;
+
+			if (voice->m_stream != nullptr)
+			{
+				voice->m_stream->Update();
+				finished = !voice->m_stream->IsPlaying();
+			}
+			else if (m_mode == Mode::Device)
+			{
+				ALint state;
+				alGetSourcei(m_sources[voice->m_slot], AL_SOURCE_STATE, &state);
+				finished = state != AL_PLAYING;
+			}
+			else if (!mixed)
+			{
+				// Without a device nothing may be mixing, so offline voices keep time here like virtual voices.
+				finished = !Advance(*voice, delta);
+			}
+
+			if (finished)
+			{
+				voice->m_state = Voice::State::Stopped;
+				voice->m_offset = 0.0;
+				Release(*voice);
+				continue;
+			}
+		}
+		else if (voice->m_stream == nullptr)
+		{
+			// Virtual voices keep time, so they're heard from the right place when they get a source.
+			if (!Advance(*voice, delta))
+			{
+				voice->m_state = Voice::State::Stopped;
+				voice->m_offset = 0.0;
+				continue;
+			}
+		}
+
+		voice->m_audibility = GetAudibility(*voice);
+
+		if (voice->m_stream != nullptr && voice->IsReal())
+		{
+			voice->m_rankFrame = m_frame;
+			pinned++;
+			continue;
+		}
+
+		if (voice->m_audibility >= AudibleThreshold)
+		{
+			m_ranked.emplace_back(voice);
+		}
+	}
+
+	auto slots = static_cast<std::size_t>(m_sources.size() - pinned);
+
+	if (m_ranked.size() > slots)
+	{
+		std::nth_element(m_ranked.begin(), m_ranked.begin() + slots, m_ranked.end(), [](const Voice *a, const Voice *b)
+		{
+			if (a->m_priority != b->m_priority)
+			{
+				return a->m_priority > b->m_priority;
+			}
+
+			return a->m_audibility > b->m_audibility;
+		});
+		m_ranked.resize(slots);
+	}
+
+	for (auto &voice : m_ranked)
+	{
+		voice->m_rankFrame = m_frame;
+	}
+
+	// Voices that have dropped out of the ranking give up their sources before the newly ranked voices claim them.
+	for (auto &owner : m_owners)
+	{
+		if (owner != nullptr && owner->m_state == Voice::State::Playing && owner->m_rankFrame != m_frame)
+		{
+			Release(*owner);
+		}
+	}
+
+	for (auto &voice : m_ranked)
+	{
+		if (!voice->IsReal())
+		{
+			Claim(*voice);
+		}
+	}
+
+	for (auto &owner : m_owners)
+	{
+		if (owner != nullptr && owner->m_dirty != 0)
+		{
+			Flush(*owner);
+		}
+	}
+}
+
+void VoiceManager::Mix(float *output, const uint32_t &frames, const uint32_t &sampleRate)
+{
+	std::fill(output, output + frames * 2, 0.0f);
+
+	if (m_mode != Mode::Offline)
+	{
+		return;
+	}
+
+	m_mixed = true;
+
+	auto master = GetTypeGain(Audio::Type::Master);
+
+	for (auto &owner : m_owners)
+	{
+		if (owner == nullptr || owner->m_state != Voice::State::Playing || owner->m_buffer == nullptr)
+		{
+			continue;
+		}
+
+		auto &voice = *owner;
+		auto &samples = voice.m_buffer->GetSamples();
+		auto channels = static_cast<std::size_t>(voice.m_buffer->GetChannels());
+		auto rate = voice.m_buffer->GetSampleRate();
+		auto count = channels != 0 ? samples.size() / channels : 0;
+
+		if (count == 0)
+		{
+			continue;
+		}
+
+		auto gain = master * GetAudibility(voice);
+		auto left = gain;
+		auto right = gain;
+
+		// Like OpenAL, only mono sounds are positioned, using an equal power pan.
+		if (channels == 1)
+		{
+			auto offset = voice.m_position - m_listenerPosition;
+			auto length = offset.Length();
+			auto pan = length > 0.0f ? offset.Dot(m_listenerRight) / length : 0.0f;
+			auto angle = (pan + 1.0f) * 0.25f * Maths::Pi;
+			left *= std::cos(angle);
+			right *= std::sin(angle);
+		}
+
+		auto step = static_cast<double>(voice.m_pitch) * rate / sampleRate;
+		auto position = voice.m_offset * rate;
+		auto finished = false;
+
+		for (uint32_t i = 0; i < frames; i++)
+		{
+			if (position >= count)
+			{
+				if (!voice.m_loop)
+				{
+					finished = true;
+					break;
+				}
+
+				position = std::fmod(position, static_cast<double>(count));
+			}
+
+			auto index = static_cast<std::size_t>(position);
+			auto next = index + 1 < count ? index + 1 : voice.m_loop ? 0 : index;
+			auto blend = static_cast<float>(position - index);
+
+			auto sampleLeft = Maths::Lerp<float>(samples[index * channels], samples[next * channels], blend) / 32768.0f;
+			auto sampleRight = channels == 1 ? sampleLeft : Maths::Lerp<float>(samples[index * channels + 1], samples[next * channels + 1], blend) / 32768.0f;
+			output[2 * i] += sampleLeft * left;
+			output[2 * i + 1] += sampleRight * right;
+			position += step;
+		}
+
+		voice.m_offset = position / rate;
+
+		if (finished)
+		{
+			voice.m_state = Voice::State::Stopped;
+			voice.m_offset = 0.0;
+			Release(voice);
+		}
+	}
+}
+
+void VoiceManager::SetListener(const Vector3f &position, const Vector3f &forward, const Vector3f &up)
+{
+	m_listenerPosition = position;
+	auto right = forward.Cross(up);
+	auto length = right.Length();
+
+	if (length > 0.0f)
+	{
+		m_listenerRight = right / length;
+	}
+}
+
+void VoiceManager::SetTypeGain(const Audio::Type &type, const float &gain)
+{
+	m_typeGains[static_cast<uint32_t>(type)] = gain;
+
+	for (auto &voice : m_voices)
+	{
+		voice->m_dirty |= Voice::DirtyGain;
+	}
+}
+
+void VoiceManager::Add(Voice &voice)
+{
+	voice.m_index = static_cast<uint32_t>(m_voices.size());
+	m_voices.emplace_back(&voice);
+}
+
+void VoiceManager::Remove(Voice &voice)
+{
+	if (voice.IsReal())
+	{
+		Release(voice);
+	}
+
+	auto last = m_voices.back();
+	last->m_index = voice.m_index;
+	m_voices[voice.m_index] = last;
+	m_voices.pop_back();
+}
+
+void VoiceManager::Start(Voice &voice, const bool &restart)
+{
+	if (voice.IsReal())
+	{
+		if (restart)
+		{
+			Release(voice);
+		}
+		else
+		{
+			return;
+		}
+	}
+
+	voice.m_audibility = GetAudibility(voice);
+
+	// Only free sources are taken here, taking one from a lower ranked voice waits for the next update.
+	if (!m_freeSlots.empty() && (voice.m_audibility >= AudibleThreshold || voice.m_stream != nullptr))
+	{
+		Claim(voice);
+		Flush(voice);
+	}
+}
+
+void VoiceManager::Claim(Voice &voice)
+{
+	if (m_freeSlots.empty())
+	{
+		return;
+	}
+
+	voice.m_slot = m_freeSlots.back();
+	voice.m_dirty = Voice::DirtyAll;
+	m_freeSlots.pop_back();
+	m_owners[voice.m_slot] = &voice;
+
+	if (m_mode == Mode::Offline)
+	{
+		return;
+	}
+
+	auto source = m_sources[voice.m_slot];
+
+	if (voice.m_stream != nullptr)
+	{
+		voice.m_stream->Play(source, voice.m_loop);
+		return;
+	}
+
+	if (voice.m_buffer == nullptr)
+	{
+		return;
+	}
+
+	alSourcei(source, AL_BUFFER, voice.m_buffer->GetBuffer());
+	alSourcei(source, AL_LOOPING, voice.m_loop);
+	alSourcef(source, AL_SEC_OFFSET, static_cast<float>(voice.m_offset));
+	alSourcePlay(source);
+}
+
+void VoiceManager::Release(Voice &voice)
+{
+	if (m_mode == Mode::Device)
+	{
+		auto source = m_sources[voice.m_slot];
+
+		if (voice.m_stream != nullptr)
+		{
+			voice.m_stream->Stop();
+		}
+		else
+		{
+			if (voice.m_state != Voice::State::Stopped)
+			{
+				ALfloat offset;
+				alGetSourcef(source, AL_SEC_OFFSET, &offset);
+				voice.m_offset = offset;
+			}
+
+			alSourceStop(source);
+			alSourcei(source, AL_BUFFER, 0);
+		}
+	}
+
+	m_owners[voice.m_slot] = nullptr;
+	m_freeSlots.emplace_back(voice.m_slot);
+	voice.m_slot = Voice::NoSlot;
+}
+
+void VoiceManager::Flush(Voice &voice)
+{
+	if (m_mode == Mode::Device)
+	{
+		auto source = m_sources[voice.m_slot];
+
+		if (voice.m_dirty & Voice::DirtyPosition)
+		{
+			alSource3f(source, AL_POSITION, voice.m_position.m_x, voice.m_position.m_y, voice.m_position.m_z);
+		}
+
+		if (voice.m_dirty & Voice::DirtyVelocity)
+		{
+			alSource3f(source, AL_VELOCITY, voice.m_velocity.m_x, voice.m_velocity.m_y, voice.m_velocity.m_z);
+		}
+
+		if (voice.m_dirty & Voice::DirtyDirection)
+		{
+			alSource3f(source, AL_DIRECTION, voice.m_direction.m_x, voice.m_direction.m_y, voice.m_direction.m_z);
+		}
+
+		if (voice.m_dirty & Voice::DirtyGain)
+		{
+			alSourcef(source, AL_GAIN, voice.m_gain * GetTypeGain(voice.m_type));
+		}
+
+		if (voice.m_dirty & Voice::DirtyPitch)
+		{
+			alSourcef(source, AL_PITCH, voice.m_pitch);
+		}
+
+		Audio::CheckAl(alGetError());
+	}
+
+	voice.m_dirty = 0;
+}
+
+bool VoiceManager::Advance(Voice &voice, const Time &delta)
+{
+	auto duration = voice.m_buffer != nullptr ? voice.m_buffer->GetDuration().AsSeconds<double>() : 0.0;
+	voice.m_offset += delta.AsSeconds<double>() * voice.m_pitch;
+
+	if (voice.m_offset >= duration)
+	{
+		if (!voice.m_loop || duration <= 0.0)
+		{
+			return false;
+		}
+
+		voice.m_offset = std::fmod(voice.m_offset, duration);
+	}
+
+	return true;
+}
+
+float VoiceManager::GetAudibility(const Voice &voice) const
+{
+	auto distance = std::max(voice.m_position.Distance(m_listenerPosition), ReferenceDistance);
+	auto attenuation = ReferenceDistance / (ReferenceDistance + RolloffFactor * (distance - ReferenceDistance));
+	return voice.m_gain * GetTypeGain(voice.m_type) * attenuation;
+}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Time.hpp"
+#include "Maths/Vector3.hpp"
+#include "Voice.hpp"
+
+namespace acid
+{
+/**
+ * @brief Shares a fixed number of sources between any number of voices.
+ * Every update the playing voices are ranked by priority and then audibility, the highest ranked get real sources,
+ * and the rest become virtual until they rank high enough again. Voices quieter than AudibleThreshold are always virtual.
+ *
+ * In Device mode sources are OpenAL sources and changed voice properties are pushed to them in one pass per update.
+ * In Offline mode nothing touches OpenAL, real voices are mixed in software by Mix, so the whole voice path can be run
+ * and measured without an audio device. If nothing calls Mix between updates, real voices keep time in Update instead.
+ */
+class ACID_EXPORT VoiceManager :
+	public NonCopyable
+{
+public:
+	enum class Mode
+	{
+		Device, Offline
+	};
+
+	/// Audibility below which a voice is never given a source.
+	static constexpr float AudibleThreshold = 0.001f;
+	/// Distance model, matching the OpenAL default inverse distance clamped model.
+	static constexpr float ReferenceDistance = 1.0f;
+	static constexpr float RolloffFactor = 1.0f;
+
+	/**
+	 * Creates a new voice manager.
+	 * @param mode If voices play on OpenAL sources or are mixed in software.
+	 * @param maxVoices The most voices heard at once, in Device mode fewer if the device can't create as many sources.
+	 */
+	explicit VoiceManager(const Mode &mode, const uint32_t &maxVoices = 32);
+
+	~VoiceManager();
+
+	/**
+	 * Advances virtual voices, and real voices in Offline mode when they were not mixed since the last update,
+	 * ranks voices onto the sources, and pushes changed voice properties to the sources.
+	 * @param delta The time since the last update.
+	 */
+	void Update(const Time &delta);
+
+	/**
+	 * Mixes the real voices into a stereo buffer, only in Offline mode.
+	 * @param output The interleaved stereo samples to write, frames * 2 long.
+	 * @param frames The number of frames to mix.
+	 * @param sampleRate The sample rate to mix at.
+	 */
+	void Mix(float *output, const uint32_t &frames, const uint32_t &sampleRate);
+
+	/**
+	 * Sets the position and orientation of the listener, used to rank voices and pan them in Offline mode.
+	 * @param position The listener position.
+	 * @param forward The direction the listener faces.
+	 * @param up The listener up direction.
+	 */
+	void SetListener(const Vector3f &position, const Vector3f &forward, const Vector3f &up = Vector3f::Up);
+
+	float GetTypeGain(const Audio::Type &type) const { return m_typeGains[static_cast<uint32_t>(type)]; }
+
+	void SetTypeGain(const Audio::Type &type, const float &gain);
+
+	const Mode &GetMode() const { return m_mode; }
+
+	uint32_t GetMaxVoices() const { return static_cast<uint32_t>(m_sources.size()); }
+
+	uint32_t GetVoiceCount() const { return static_cast<uint32_t>(m_voices.size()); }
+
+	uint32_t GetRealCount() const { return static_cast<uint32_t>(m_sources.size() - m_freeSlots.size()); }
+
+private:
+	friend class Voice;
+
+	void Add(Voice &voice);
+
+	void Remove(Voice &voice);
+
+	/**
+	 * Gives a voice a source as soon as it is played or resumed, if one is free.
+	 * @param voice The voice.
+	 * @param restart If the voice is played from the start.
+	 */
+	void Start(Voice &voice, const bool &restart);
+
+	void Claim(Voice &voice);
+
+	/**
+	 * Takes the source back from a voice, remembering its play position.
+	 * @param voice The voice.
+	 */
+	void Release(Voice &voice);
+
+	void Flush(Voice &voice);
+
+	/**
+	 * Moves the play position of a buffered voice forward, wrapping looping voices.
+	 * @param voice The voice.
+	 * @param delta The time to advance by.
+	 * @return If the voice is still playing.
+	 */
+	static bool Advance(Voice &voice, const Time &delta);
+
+	float GetAudibility(const Voice &voice) const;
+
+	Mode m_mode;
+	std::vector<uint32_t> m_sources;
+	std::vector<Voice *> m_owners;
+	std::vector<uint32_t> m_freeSlots;
+
+	std::vector<Voice *> m_voices;
+	std::vector<Voice *> m_ranked;
+	uint64_t m_frame;
+	/// If Mix ran since the last update, so real voices in Offline mode have already been advanced.
+	bool m_mixed;
+
+	std::array<float, 4> m_typeGains;
+	Vector3f m_listenerPosition;
+	Vector3f m_listenerRight;
+};
+}
@@ -15,6 +15,9 @@ set(_temp_acid_headers
 		Audio/Audio.hpp
 		Audio/Sound.hpp
 		Audio/SoundBuffer.hpp
+		Audio/SoundStream.hpp
+		Audio/Voice.hpp
+		Audio/VoiceManager.hpp
 		Devices/Instance.hpp
 		Devices/Joysticks.hpp
 		Devices/Keyboard.hpp
@@ -30,32 +33,43 @@ set(_temp_acid_headers
 		Emitters/EmitterPoint.hpp
 		Emitters/EmitterSphere.hpp
 		Engine/Engine.hpp
+		Engine/FrameAllocator.hpp
 		Engine/Game.hpp
 		Engine/Log.hpp
 		Engine/Module.hpp
 		Engine/ModuleManager.hpp
 		Engine/ModuleUpdater.hpp
+		Engine/Profiler.hpp
+		Files/Archive.hpp
 		Files/File.hpp
 		Files/Files.hpp
+		Files/FileView.hpp
 		Files/FileSystem.hpp
 		Files/FileWatcher.hpp
 		Fonts/FontMetafile.hpp
 		Fonts/FontType.hpp
 		Fonts/Geometry.hpp
+		Fonts/GlyphAtlas.hpp
+		Fonts/GlyphRun.hpp
 		Fonts/Outline.hpp
 		Fonts/RendererFonts.hpp
 		Fonts/RendererFonts2.hpp
+		Fonts/SkylinePacker.hpp
 		Fonts/Text.hpp
+		Fonts/TextBatch.hpp
 		Gizmos/Gizmo.hpp
 		Gizmos/Gizmos.hpp
 		Gizmos/GizmoType.hpp
 		Gizmos/RendererGizmos.hpp
 		Guis/Gui.hpp
+		Guis/GuiBatch.hpp
 		Guis/RendererGuis.hpp
 		Helpers/Delegate.hpp
 		Helpers/EnumClass.hpp
 		Helpers/Future.hpp
+		Helpers/Handle.hpp
 		Helpers/NonCopyable.hpp
+		Helpers/ObjectPool.hpp
 		Helpers/RingBuffer.hpp
 		Helpers/String.hpp
 		Helpers/ThreadPool.hpp
@@ -119,9 +133,17 @@ set(_temp_acid_headers
 		Network/Ftp/FtpResponseDirectory.hpp
 		Network/Ftp/FtpResponseListing.hpp
 		Network/Http/Http.hpp
+		Network/Http/HttpClient.hpp
 		Network/Http/HttpRequest.hpp
 		Network/Http/HttpResponse.hpp
 		Network/IpAddress.hpp
+		Network/Netcode/BitStream.hpp
+		Network/Netcode/NetChannel.hpp
+		Network/Netcode/NetClient.hpp
+		Network/Netcode/NetServer.hpp
+		Network/Netcode/Replicated.hpp
+		Network/Netcode/SequenceBuffer.hpp
+		Network/Netcode/Snapshot.hpp
 		Network/Packet.hpp
 		Network/Socket.hpp
 		Network/SocketSelector.hpp
@@ -178,6 +200,7 @@ set(_temp_acid_headers
 		Renderer/Buffers/UniformHandler.hpp
 		Renderer/Commands/CommandBuffer.hpp
 		Renderer/Commands/CommandPool.hpp
+		Renderer/Commands/TimestampQueries.hpp
 		Renderer/Descriptors/Descriptor.hpp
 		Renderer/Descriptors/DescriptorSet.hpp
 		Renderer/Descriptors/DescriptorsHandler.hpp
@@ -249,6 +272,9 @@ set(_temp_acid_sources
 		Audio/Audio.cpp
 		Audio/Sound.cpp
 		Audio/SoundBuffer.cpp
+		Audio/SoundStream.cpp
+		Audio/Voice.cpp
+		Audio/VoiceManager.cpp
 		Devices/Instance.cpp
 		Devices/Joysticks.cpp
 		Devices/Keyboard.cpp
@@ -263,26 +289,36 @@ set(_temp_acid_sources
 		Emitters/EmitterPoint.cpp
 		Emitters/EmitterSphere.cpp
 		Engine/Engine.cpp
+		Engine/FrameAllocator.cpp
 		Engine/Log.cpp
 		Engine/ModuleManager.cpp
 		Engine/ModuleUpdater.cpp
+		Engine/Profiler.cpp
+		Files/Archive.cpp
 		Files/File.cpp
 		Files/Files.cpp
+		Files/FileView.cpp
 		Files/FileSystem.cpp
 		Files/FileWatcher.cpp
 		Fonts/FontMetafile.cpp
 		Fonts/FontType.cpp
 		Fonts/Geometry.cpp
+		Fonts/GlyphAtlas.cpp
+		Fonts/GlyphRun.cpp
 		Fonts/Outline.cpp
 		Fonts/RendererFonts.cpp
 		Fonts/RendererFonts2.cpp
+		Fonts/SkylinePacker.cpp
 		Fonts/Text.cpp
+		Fonts/TextBatch.cpp
 		Gizmos/Gizmo.cpp
 		Gizmos/Gizmos.cpp
 		Gizmos/GizmoType.cpp
 		Gizmos/RendererGizmos.cpp
 		Guis/Gui.cpp
+		Guis/GuiBatch.cpp
 		Guis/RendererGuis.cpp
+		Helpers/ObjectPool.cpp
 		Helpers/String.cpp
 		Helpers/ThreadPool.cpp
 		Inputs/AxisButton.cpp
@@ -332,9 +368,16 @@ set(_temp_acid_sources
 		Network/Ftp/FtpResponseDirectory.cpp
 		Network/Ftp/FtpResponseListing.cpp
 		Network/Http/Http.cpp
+		Network/Http/HttpClient.cpp
 		Network/Http/HttpRequest.cpp
 		Network/Http/HttpResponse.cpp
 		Network/IpAddress.cpp
+		Network/Netcode/BitStream.cpp
+		Network/Netcode/NetChannel.cpp
+		Network/Netcode/NetClient.cpp
+		Network/Netcode/NetServer.cpp
+		Network/Netcode/Replicated.cpp
+		Network/Netcode/Snapshot.cpp
 		Network/Packet.cpp
 		Network/Socket.cpp
 		Network/SocketSelector.cpp
@@ -390,6 +433,7 @@ set(_temp_acid_sources
 		Renderer/Buffers/UniformHandler.cpp
 		Renderer/Commands/CommandBuffer.cpp
 		Renderer/Commands/CommandPool.cpp
+		Renderer/Commands/TimestampQueries.cpp
 		Renderer/Descriptors/DescriptorSet.cpp
 		Renderer/Descriptors/DescriptorsHandler.cpp
 		Renderer/Images/Image.cpp
@@ -406,6 +450,7 @@ set(_temp_acid_sources
 		Renderer/Renderpass/Swapchain.cpp
 		Renderer/RenderStage.cpp
 		Resources/Resources.cpp
+		Scenes/Camera.cpp
 		Scenes/ComponentRegister.cpp
 		Scenes/Entity.cpp
 		Scenes/EntityPrefab.cpp
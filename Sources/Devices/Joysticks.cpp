@@ -24,6 +24,12 @@ void CallbackJoystick(int32_t id, int32_t event)
 
 Joysticks::Joysticks()
 {
+	// GLFW is never initialized when headless, so no joysticks connect.
+	if (Engine::Get()->IsHeadless())
+	{
+		return;
+	}
+
 	glfwSetJoystickCallback(CallbackJoystick);
 
 	for (uint32_t i = 0; i < GLFW_JOYSTICK_LAST; i++)
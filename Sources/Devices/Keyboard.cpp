@@ -16,6 +16,12 @@ void CallbackChar(GLFWwindow *window, uint32_t codepoint)
 
 Keyboard::Keyboard()
 {
+	// A headless keyboard never has its keys pressed.
+	if (Window::Get()->GetWindow() == nullptr)
+	{
+		return;
+	}
+
 	glfwSetKeyCallback(Window::Get()->GetWindow(), CallbackKey);
 	glfwSetCharCallback(Window::Get()->GetWindow(), CallbackChar);
 }
@@ -26,6 +32,11 @@ void Keyboard::Update()
 
 InputAction Keyboard::GetKey(const Key &key) const
 {
+	if (Window::Get()->GetWindow() == nullptr)
+	{
+		return InputAction::Release;
+	}
+
 	auto state = glfwGetKey(Window::Get()->GetWindow(), static_cast<int32_t>(key));
 	return static_cast<InputAction>(state);
 }
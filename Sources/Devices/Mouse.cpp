@@ -48,6 +48,12 @@ Mouse::Mouse() :
 	m_windowSelected(true),
 	m_cursorHidden(false)
 {
+	// A headless mouse never has its buttons pressed or moves.
+	if (Window::Get()->GetWindow() == nullptr)
+	{
+		return;
+	}
+
 	glfwSetMouseButtonCallback(Window::Get()->GetWindow(), CallbackMouseButton);
 	glfwSetCursorPosCallback(Window::Get()->GetWindow(), CallbackCursorPos);
 	glfwSetCursorEnterCallback(Window::Get()->GetWindow(), CallbackCursorEnter);
@@ -77,7 +83,7 @@ void Mouse::Update()
 
 void Mouse::SetCursor(const std::string &filename, const CursorHotspot &hotspot)
 {
-	if (m_currentCursor && m_currentCursor->first == filename && m_currentCursor->second == hotspot)
+	if (Window::Get()->GetWindow() == nullptr || (m_currentCursor && m_currentCursor->first == filename && m_currentCursor->second == hotspot))
 	{
 		return;
 	}
@@ -126,7 +132,7 @@ void Mouse::SetCursor(const std::string &filename, const CursorHotspot &hotspot)
 
 void Mouse::SetCursor(const CursorStandard &standard)
 {
-	if (m_currentStandard == standard)
+	if (Window::Get()->GetWindow() == nullptr || m_currentStandard == standard)
 	{
 		return;
 	}
@@ -142,16 +148,31 @@ void Mouse::SetCursor(const CursorStandard &standard)
 
 std::string Mouse::GetClipboard() const
 {
+	if (Window::Get()->GetWindow() == nullptr)
+	{
+		return "";
+	}
+
 	return glfwGetClipboardString(Window::Get()->GetWindow());
 }
 
 void Mouse::SetClipboard(const std::string &string) const
 {
+	if (Window::Get()->GetWindow() == nullptr)
+	{
+		return;
+	}
+
 	glfwSetClipboardString(Window::Get()->GetWindow(), string.c_str());
 }
 
 InputAction Mouse::GetButton(const MouseButton &mouseButton) const
 {
+	if (Window::Get()->GetWindow() == nullptr)
+	{
+		return InputAction::Release;
+	}
+
 	auto state = glfwGetMouseButton(Window::Get()->GetWindow(), static_cast<int32_t>(mouseButton));
 	return static_cast<InputAction>(state);
 }
@@ -159,12 +180,16 @@ InputAction Mouse::GetButton(const MouseButton &mouseButton) const
 void Mouse::SetPosition(const Vector2f &position)
 {
 	m_mousePosition = position;
-	glfwSetCursorPos(Window::Get()->GetWindow(), m_mousePosition.m_x * Window::Get()->GetSize().m_x, m_mousePosition.m_y * Window::Get()->GetSize().m_y);
+
+	if (Window::Get()->GetWindow() != nullptr)
+	{
+		glfwSetCursorPos(Window::Get()->GetWindow(), m_mousePosition.m_x * Window::Get()->GetSize().m_x, m_mousePosition.m_y * Window::Get()->GetSize().m_y);
+	}
 }
 
 void Mouse::SetCursorHidden(const bool &hidden)
 {
-	if (m_cursorHidden != hidden)
+	if (m_cursorHidden != hidden && Window::Get()->GetWindow() != nullptr)
 	{
 		glfwSetInputMode(Window::Get()->GetWindow(), GLFW_CURSOR, hidden ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
 
@@ -113,6 +113,13 @@ Window::Window() :
 	m_iconified(false),
 	m_window(nullptr)
 {
+	// A headless window only keeps its size and state, nothing is ever focused.
+	if (Engine::Get()->IsHeadless())
+	{
+		m_focused = false;
+		return;
+	}
+
 	// Set the error error callback
 	glfwSetErrorCallback(CallbackError);
 
@@ -194,6 +201,12 @@ Window::Window() :
 
 Window::~Window()
 {
+	if (m_window == nullptr)
+	{
+		m_closed = true;
+		return;
+	}
+
 	// Free the window callbacks and destroy the window.
 	glfwDestroyWindow(m_window);
 
@@ -205,6 +218,11 @@ Window::~Window()
 
 void Window::Update()
 {
+	if (m_window == nullptr)
+	{
+		return;
+	}
+
 	// Polls for window events.
 	glfwPollEvents();
 }
@@ -214,25 +232,47 @@ void Window::SetSize(const Vector2i &size)
 	m_size.m_x = size.m_x == -1 ? m_size.m_x : size.m_x;
 	m_size.m_y = size.m_y == -1 ? m_size.m_y : size.m_y;
 	m_aspectRatio = static_cast<float>(m_size.m_x) / static_cast<float>(m_size.m_y);
-	glfwSetWindowSize(m_window, m_size.m_x, m_size.m_y);
+
+	if (m_window != nullptr)
+	{
+		glfwSetWindowSize(m_window, m_size.m_x, m_size.m_y);
+	}
+	else
+	{
+		m_onSize(m_size);
+	}
 }
 
 void Window::SetPosition(const Vector2i &position)
 {
 	m_position.m_x = position.m_x == -1 ? m_position.m_x : position.m_x;
 	m_position.m_y = position.m_y == -1 ? m_position.m_y : position.m_y;
-	glfwSetWindowPos(m_window, m_position.m_x, m_position.m_y);
+
+	if (m_window != nullptr)
+	{
+		glfwSetWindowPos(m_window, m_position.m_x, m_position.m_y);
+	}
 }
 
 void Window::SetTitle(const std::string &title)
 {
 	m_title = title;
-	glfwSetWindowTitle(m_window, m_title.c_str());
+
+	if (m_window != nullptr)
+	{
+		glfwSetWindowTitle(m_window, m_title.c_str());
+	}
+
 	m_onTitle(m_title);
 }
 
 void Window::SetIcons(const std::vector<std::string> &filenames)
 {
+	if (m_window == nullptr)
+	{
+		return;
+	}
+
 	std::vector<GLFWimage> icons;
 	std::vector<std::unique_ptr<uint8_t[]>> pixels;
 
@@ -263,21 +303,36 @@ void Window::SetIcons(const std::vector<std::string> &filenames)
 void Window::SetBorderless(const bool &borderless)
 {
 	m_borderless = borderless;
-	glfwSetWindowAttrib(m_window, GLFW_DECORATED, m_borderless ? GLFW_FALSE : GLFW_TRUE);
+
+	if (m_window != nullptr)
+	{
+		glfwSetWindowAttrib(m_window, GLFW_DECORATED, m_borderless ? GLFW_FALSE : GLFW_TRUE);
+	}
+
 	m_onBorderless(m_borderless);
 }
 
 void Window::SetResizable(const bool &resizable)
 {
 	m_resizable = resizable;
-	glfwSetWindowAttrib(m_window, GLFW_RESIZABLE, m_resizable ? GLFW_TRUE : GLFW_FALSE);
+
+	if (m_window != nullptr)
+	{
+		glfwSetWindowAttrib(m_window, GLFW_RESIZABLE, m_resizable ? GLFW_TRUE : GLFW_FALSE);
+	}
+
 	m_onResizable(m_resizable);
 }
 
 void Window::SetFloating(const bool &floating)
 {
 	m_floating = floating;
-	glfwSetWindowAttrib(m_window, GLFW_FLOATING, m_floating ? GLFW_TRUE : GLFW_FALSE);
+
+	if (m_window != nullptr)
+	{
+		glfwSetWindowAttrib(m_window, GLFW_FLOATING, m_floating ? GLFW_TRUE : GLFW_FALSE);
+	}
+
 	m_onFloating(m_floating);
 }
 
@@ -285,6 +340,13 @@ void Window::SetFullscreen(const bool &fullscreen, Monitor *monitor)
 {
 	m_fullscreen = fullscreen;
 
+	// Without a window there are no monitors to go fullscreen on.
+	if (m_window == nullptr)
+	{
+		m_onFullscreen(m_fullscreen);
+		return;
+	}
+
 	auto selected = monitor != nullptr ? monitor : m_monitors[0].get();
 	auto videoMode = selected->GetVideoMode();
 
@@ -312,6 +374,11 @@ void Window::SetFullscreen(const bool &fullscreen, Monitor *monitor)
 
 void Window::SetIconified(const bool &iconify)
 {
+	if (m_window == nullptr)
+	{
+		return;
+	}
+
 	if (!m_iconified && iconify)
 	{
 		glfwIconifyWindow(m_window);
@@ -1,6 +1,7 @@
 #include "Engine.hpp"
 
 #include <chrono>
+#include "Profiler.hpp"
 
 namespace acid
 {
@@ -10,26 +11,33 @@ using MicrosecondsType = std::chrono::duration<int64_t, std::micro>;
 Engine *Engine::INSTANCE = nullptr;
 std::chrono::time_point<HighResolutionClock> TIME_START = HighResolutionClock::now();
 
-Engine::Engine(std::string argv0, const bool &emptyRegister) :
+Engine::Engine(std::string argv0, const bool &emptyRegister, const bool &headless) :
 	m_game(nullptr),
 	m_argv0(std::move(argv0)),
 	m_fpsLimit(-1.0f),
+	m_headless(headless),
 	m_running(true),
 	m_error(false)
 {
 	INSTANCE = this;
 	Log::OpenLog("Logs/" + GetDateTime() + ".log");
+	Profiler::SetThreadName("Main");
 
 	if (!emptyRegister)
 	{
-		m_moduleManager.FillRegister();
+		m_moduleManager.FillRegister(m_headless);
 	}
 }
 
-int32_t Engine::Run()
+int32_t Engine::Run(const uint32_t &frames)
 {
-	while (m_running)
+	for (uint32_t frame = 0; m_running && (frames == 0 || frame < frames); frame++)
 	{
+		if (m_fixedTimestep != Time::Zero)
+		{
+			m_fixedTime += m_fixedTimestep;
+		}
+
 		if (m_game != nullptr)
 		{
 			if (!m_game->m_started)
@@ -38,6 +46,7 @@ int32_t Engine::Run()
 				m_game->m_started = true;
 			}
 
+			ACID_PROFILE_ZONE("Game");
 			m_game->Update();
 		}
 
@@ -47,6 +56,17 @@ int32_t Engine::Run()
 	return EXIT_SUCCESS;
 }
 
+void Engine::SetFixedTimestep(const Time &fixedTimestep)
+{
+	// Fixed time starts from the clock, so timers started before it don't wait for it to catch up.
+	if (m_fixedTimestep == Time::Zero)
+	{
+		m_fixedTime = GetTime() - m_timeOffset;
+	}
+
+	m_fixedTimestep = fixedTimestep;
+}
+
 void Engine::RequestClose(const bool &error)
 {
 	m_running = false;
@@ -67,6 +87,11 @@ Time Engine::GetTime()
 		return duration;
 	}
 
+	if (INSTANCE->m_fixedTimestep != Time::Zero)
+	{
+		return INSTANCE->m_fixedTime + INSTANCE->m_timeOffset;
+	}
+
 	return duration + INSTANCE->m_timeOffset;
 }
 
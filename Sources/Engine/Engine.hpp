@@ -26,14 +26,16 @@ public:
 	 * Carries out the setup for basic engine components and the engine. Call {@link Engine#Run} after creating a instance.
 	 * @param argv0 The first argument passed to main.
 	 * @param emptyRegister If the module register will start empty.
+	 * @param headless If the window, renderer and audio device are replaced with null modules, for servers and automated runs.
 	 */
-	explicit Engine(std::string argv0, const bool &emptyRegister = false);
+	explicit Engine(std::string argv0, const bool &emptyRegister = false, const bool &headless = false);
 
 	/**
 	 * The update function for the updater.
+	 * @param frames The number of loops to run before returning, 0 runs until the engine is closed.
 	 * @return {@code EXIT_SUCCESS} or {@code EXIT_FAILURE}
 	 */
-	int32_t Run();
+	int32_t Run(const uint32_t &frames = 0);
 
 	/**
 	 * Gets the module manager used by the engine instance. The manager can be used to register/deregister modules.
@@ -41,6 +43,12 @@ public:
 	 */
 	ModuleManager &GetModuleManager() { return m_moduleManager; }
 
+	/**
+	 * Gets the module updater used by the engine instance. The updater can be used to change the timestep of updates.
+	 * @return The engines module updater.
+	 */
+	ModuleUpdater &GetModuleUpdater() { return m_moduleUpdater; }
+
 	/**
 	 * Gets the current game.
 	 * @return The renderer manager.
@@ -83,6 +91,24 @@ public:
 	 */
 	void SetTimeOffset(const Time &timeOffset) { m_timeOffset = timeOffset; }
 
+	/**
+	 * Gets the fixed timestep, engine time advances by it every loop rather than following the clock.
+	 * @return The fixed timestep, zero when time follows the clock.
+	 */
+	const Time &GetFixedTimestep() const { return m_fixedTimestep; }
+
+	/**
+	 * Sets a fixed timestep, so every run updates the same way no matter how long each loop takes. Zero follows the clock again.
+	 * @param fixedTimestep The new fixed timestep.
+	 */
+	void SetFixedTimestep(const Time &fixedTimestep);
+
+	/**
+	 * Gets if the engine was created without a window, renderer and audio device.
+	 * @return If the engine is headless.
+	 */
+	const bool &IsHeadless() const { return m_headless; }
+
 	/**
 	 * Gets the fps limit.
 	 * @return The frame per second limit.
@@ -113,6 +139,12 @@ public:
 	 */
 	const Time &GetDeltaRender() const { return m_moduleUpdater.GetDeltaRender(); }
 
+	/**
+	 * Gets how far the current render is between the previous and current update, from 0 to 1.
+	 * @return The interpolation alpha.
+	 */
+	const float &GetAlpha() const { return m_moduleUpdater.GetAlpha(); }
+
 	/**
 	 * Gets the average UPS over a short interval.
 	 * @return The updates per second.
@@ -141,7 +173,10 @@ private:
 
 	std::string m_argv0;
 	Time m_timeOffset;
+	Time m_fixedTimestep;
+	Time m_fixedTime;
 	float m_fpsLimit;
+	bool m_headless;
 	bool m_running;
 	bool m_error;
 };
@@ -0,0 +1,229 @@
+#include "FrameAllocator.hpp"
+
+#include <atomic>
+#include "Profiler.hpp"
+
+#if defined(ACID_COUNT_ALLOCATIONS)
+static std::atomic<uint64_t> HEAP_ALLOCATIONS = 0;
+
+// Replaces the global allocation functions, the array forms call into these. The aligned forms are replaced too,
+// the standard library implements them on top of the platforms aligned allocator rather than the plain forms.
+static void *AlignedAllocate(std::size_t size, std::size_t alignment) noexcept
+{
+	HEAP_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+#if defined(ACID_BUILD_MSVC)
+	return _aligned_malloc(size != 0 ? size : 1, alignment);
+#else
+	void *memory = nullptr;
+
+	if (posix_memalign(&memory, std::max(alignment, sizeof(void *)), size != 0 ? size : 1) != 0)
+	{
+		return nullptr;
+	}
+
+	return memory;
+#endif
+}
+
+static void AlignedFree(void *memory) noexcept
+{
+#if defined(ACID_BUILD_MSVC)
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+void *operator new(std::size_t size)
+{
+	HEAP_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+
+	if (auto memory = std::malloc(size != 0 ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	HEAP_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size != 0 ? size : 1);
+}
+
+void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+	std::free(memory);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+	if (auto memory = AlignedAllocate(size, static_cast<std::size_t>(alignment)))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+	return AlignedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+	AlignedFree(memory);
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept
+{
+	AlignedFree(memory);
+}
+
+void operator delete(void *memory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	AlignedFree(memory);
+}
+#endif
+
+namespace acid
+{
+static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+class FrameAllocator::Arena :
+	public std::pmr::memory_resource
+{
+public:
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> m_data;
+		std::size_t m_size;
+	};
+
+	Arena() :
+		m_offset(0),
+		m_used(0)
+	{
+	}
+
+	void Reset()
+	{
+		// Merges overflow blocks, the next frame fits in one.
+		if (m_blocks.size() > 1)
+		{
+			std::size_t size = 0;
+
+			for (const auto &block : m_blocks)
+			{
+				size += block.m_size;
+			}
+
+			m_blocks.clear();
+			m_blocks.emplace_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+		}
+
+		m_offset = 0;
+		m_used = 0;
+	}
+
+	std::vector<Block> m_blocks;
+	std::size_t m_offset;
+	std::size_t m_used;
+
+protected:
+	void *do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		if (!m_blocks.empty())
+		{
+			if (auto memory = Bump(m_blocks.back(), bytes, alignment))
+			{
+				return memory;
+			}
+		}
+
+		auto size = std::max(m_blocks.empty() ? BLOCK_SIZE : 2 * m_blocks.back().m_size, bytes + alignment);
+		m_blocks.emplace_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+		m_offset = 0;
+		return Bump(m_blocks.back(), bytes, alignment);
+	}
+
+	void do_deallocate(void *, std::size_t, std::size_t) override
+	{
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	void *Bump(const Block &block, const std::size_t &bytes, const std::size_t &alignment)
+	{
+		auto address = reinterpret_cast<std::uintptr_t>(block.m_data.get());
+		auto start = (address + m_offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+		if (start + bytes > address + block.m_size)
+		{
+			return nullptr;
+		}
+
+		m_used += start + bytes - (address + m_offset);
+		m_offset = start + bytes - address;
+		return reinterpret_cast<void *>(start);
+	}
+};
+
+std::pmr::memory_resource *FrameAllocator::Get()
+{
+	return &GetArena();
+}
+
+void *FrameAllocator::Allocate(const std::size_t &size, const std::size_t &alignment)
+{
+	return GetArena().allocate(size, alignment);
+}
+
+void FrameAllocator::Reset()
+{
+	GetArena().Reset();
+}
+
+void FrameAllocator::EndFrame()
+{
+	auto &arena = GetArena();
+	Profiler::SetCounter("Frame arena bytes", static_cast<int64_t>(arena.m_used));
+
+#if defined(ACID_COUNT_ALLOCATIONS)
+	Profiler::SetCounter("Heap allocations", static_cast<int64_t>(HEAP_ALLOCATIONS.exchange(0, std::memory_order_relaxed)));
+#endif
+
+	arena.Reset();
+}
+
+uint64_t FrameAllocator::GetHeapAllocations()
+{
+#if defined(ACID_COUNT_ALLOCATIONS)
+	return HEAP_ALLOCATIONS.load(std::memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+FrameAllocator::Arena &FrameAllocator::GetArena()
+{
+	thread_local Arena arena;
+	return arena;
+}
+}
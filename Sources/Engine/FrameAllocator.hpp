@@ -0,0 +1,62 @@
+#pragma once
+
+#include <map>
+#include <memory_resource>
+#include <vector>
+#include "StdAfx.hpp"
+
+namespace acid
+{
+/**
+ * @brief Scratch memory that lasts until the end of a frame, each thread bumps through its own arena.
+ *
+ * Containers use an arena through {@link FrameAllocator#Get}, for example {@code FrameAllocator::Vector<T> values(FrameAllocator::Get());}.
+ * Freeing does nothing, the whole arena is reused once its thread calls {@link FrameAllocator#Reset}.
+ * The main thread resets at the end of every frame and the simulation thread after every update, other threads reset when they are done with their memory.
+ * An arena that fills up takes another block from the heap, blocks are merged on reset so steady frames make no heap allocations.
+ */
+class ACID_EXPORT FrameAllocator
+{
+public:
+	template<typename T>
+	using Vector = std::pmr::vector<T>;
+
+	template<typename K, typename V, typename Compare = std::less<K>>
+	using Map = std::pmr::map<K, V, Compare>;
+
+	/**
+	 * Gets the calling threads arena.
+	 * @return The memory resource, its memory is valid until the thread resets.
+	 */
+	static std::pmr::memory_resource *Get();
+
+	/**
+	 * Allocates memory from the calling threads arena.
+	 * @param size The size in bytes.
+	 * @param alignment The alignment in bytes.
+	 * @return The memory.
+	 */
+	static void *Allocate(const std::size_t &size, const std::size_t &alignment = alignof(std::max_align_t));
+
+	/**
+	 * Reuses the calling threads arena from the start, all of its memory must be unused.
+	 */
+	static void Reset();
+
+	/**
+	 * Reports the calling threads arena and the heap allocations made this frame to the profiler, then resets the arena.
+	 */
+	static void EndFrame();
+
+	/**
+	 * Gets the heap allocations made since the last frame ended, only counted when built with ACID_COUNT_ALLOCATIONS.
+	 * @return The heap allocation count.
+	 */
+	static uint64_t GetHeapAllocations();
+
+private:
+	class Arena;
+
+	static Arena &GetArena();
+};
+}
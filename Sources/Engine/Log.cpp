@@ -1,5 +1,6 @@
 #include "Log.hpp"
 
+#include <condition_variable>
 #include <fstream>
 
 #if defined(ACID_BUILD_WINDOWS)
@@ -12,25 +13,247 @@
 
 namespace acid
 {
-std::mutex Log::MUTEX = std::mutex();
-std::ofstream Log::STREAM = std::ofstream();
+static constexpr uint32_t QUEUE_CAPACITY = 512;
+static constexpr uint32_t RATE_SLOTS = 64;
 
-void Log::Out(const std::string &string)
+/// Messages are written on the logging thread once the sink has been destroyed at exit.
+static std::atomic<bool> SINK_ALIVE = false;
+/// Messages are written on the logging thread once its queue has been retired as the thread exits.
+static thread_local bool QUEUE_RETIRED = false;
+
+static int64_t GetLogTime()
 {
-	std::lock_guard<std::mutex> lock(MUTEX);
-	fprintf(stdout, "%s", string.c_str());
-	STREAM << string;
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-void Log::Error(const std::string &string)
+/**
+ * @brief Owns the per thread queues and the thread that formats and writes their messages.
+ */
+class Log::Sink
 {
-	std::lock_guard<std::mutex> lock(MUTEX);
-	fprintf(stderr, "%s", string.c_str());
-	STREAM << string;
-}
+public:
+	/**
+	 * @brief A single producer single consumer queue of records.
+	 */
+	struct Queue
+	{
+		std::unique_ptr<Record[]> m_records;
+		/// Written only by the logging thread.
+		std::atomic<uint32_t> m_head;
+		/// Written only while holding the sink mutex.
+		std::atomic<uint32_t> m_tail;
+		std::atomic<uint64_t> m_dropped;
+		uint64_t m_reported;
+		/// Set when the owning thread exits, the queue is freed once drained.
+		std::atomic<bool> m_retired;
+	};
+
+	/**
+	 * @brief Owns the calling threads queue, and retires it when the thread exits.
+	 */
+	struct QueueOwner
+	{
+		QueueOwner() :
+			m_queue(Get().AddQueue())
+		{
+		}
+
+		~QueueOwner()
+		{
+			QUEUE_RETIRED = true;
+
+			if (SINK_ALIVE)
+			{
+				m_queue->m_retired.store(true, std::memory_order_release);
+			}
+		}
+
+		Queue *m_queue;
+	};
+
+	/**
+	 * @brief Counts the messages a thread logged with a format in the current second.
+	 */
+	struct Rate
+	{
+		const char *m_format;
+		int64_t m_start;
+		uint32_t m_count;
+		uint32_t m_suppressed;
+	};
+
+	Sink() :
+		m_retiredDropped(0),
+		m_running(true)
+	{
+		SINK_ALIVE = true;
+		m_thread = std::thread([this]
+		{
+			Run();
+		});
+	}
+
+	~Sink()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+
+		m_condition.notify_one();
+		m_thread.join();
+		SINK_ALIVE = false;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Drain();
+	}
+
+	static Sink &Get()
+	{
+		static Sink sink;
+		return sink;
+	}
+
+	/**
+	 * Gets the calling threads queue, creating it on first use.
+	 * @return The queue.
+	 */
+	static Queue *GetThreadQueue()
+	{
+		thread_local QueueOwner owner;
+		return owner.m_queue;
+	}
+
+	Queue *AddQueue()
+	{
+		auto queue = std::make_unique<Queue>();
+		queue->m_records = std::make_unique<Record[]>(QUEUE_CAPACITY);
+		queue->m_head = 0;
+		queue->m_tail = 0;
+		queue->m_dropped = 0;
+		queue->m_reported = 0;
+		queue->m_retired = false;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queues.emplace_back(std::move(queue));
+		return m_queues.back().get();
+	}
+
+	/**
+	 * Writes every queued message in the order they were logged, the sink mutex must be held.
+	 */
+	void Drain()
+	{
+		m_pending.clear();
+		m_heads.resize(m_queues.size());
+		m_retiring.resize(m_queues.size());
+
+		for (std::size_t q = 0; q < m_queues.size(); q++)
+		{
+			auto &queue = *m_queues[q];
+			// Read before the head, a retired queue has no messages after it.
+			m_retiring[q] = queue.m_retired.load(std::memory_order_acquire);
+			m_heads[q] = queue.m_head.load(std::memory_order_acquire);
+
+			for (auto i = queue.m_tail.load(std::memory_order_relaxed); i != m_heads[q]; i++)
+			{
+				m_pending.emplace_back(&queue.m_records[i % QUEUE_CAPACITY]);
+			}
+		}
+
+		std::stable_sort(m_pending.begin(), m_pending.end(), [](const Record *a, const Record *b)
+		{
+			return a->m_time < b->m_time;
+		});
+
+		for (const auto &record : m_pending)
+		{
+			m_text.clear();
+			record->m_formatter(record->m_format, record->m_data, m_text);
+			Write(record->m_level, m_text);
+		}
+
+		// Records are only released once written, so the logging threads can't reuse them first.
+		for (std::size_t q = 0; q < m_queues.size(); q++)
+		{
+			auto &queue = *m_queues[q];
+			queue.m_tail.store(m_heads[q], std::memory_order_release);
+			auto dropped = queue.m_dropped.load(std::memory_order_relaxed);
+
+			if (dropped != queue.m_reported)
+			{
+				Write(Level::Error, "Log dropped " + std::to_string(dropped - queue.m_reported) + " messages, the queue was full\n");
+				queue.m_reported = dropped;
+			}
+		}
+
+		// Queues of exited threads are freed now every message in them is written.
+		std::size_t kept = 0;
+
+		for (std::size_t q = 0; q < m_queues.size(); q++)
+		{
+			if (m_retiring[q])
+			{
+				m_retiredDropped += m_queues[q]->m_dropped.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			m_queues[kept++] = std::move(m_queues[q]);
+		}
+
+		m_queues.resize(kept);
+
+		std::fflush(stdout);
+		m_stream.flush();
+	}
+
+	void Write(const Level &level, const std::string &text)
+	{
+		if (CONSOLE.load(std::memory_order_relaxed))
+		{
+			std::fwrite(text.data(), 1, text.size(), level == Level::Error ? stderr : stdout);
+		}
+
+		m_stream << text;
+	}
+
+	std::mutex m_mutex;
+	std::ofstream m_stream;
+	std::vector<std::unique_ptr<Queue>> m_queues;
+	/// Messages dropped by queues that have since been freed.
+	uint64_t m_retiredDropped;
+
+private:
+	void Run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		while (m_running)
+		{
+			Drain();
+
+			// Logging threads only wake the sink for errors, other messages wait for the next drain.
+			m_condition.wait_for(lock, std::chrono::milliseconds(10));
+		}
+	}
+
+	bool m_running;
+	std::condition_variable m_condition;
+	std::thread m_thread;
+	std::vector<Record *> m_pending;
+	std::vector<uint32_t> m_heads;
+	std::vector<uint8_t> m_retiring;
+	std::string m_text;
+};
+
+std::atomic<Log::Level> Log::LEVEL = Level::Debug;
+std::atomic<uint32_t> Log::RATE_LIMIT = 0;
+std::atomic<bool> Log::CONSOLE = true;
 
 void Log::Popup(const std::string &title, const std::string &message)
 {
+	Flush();
+
 #if defined(ACID_BUILD_WINDOWS)
 	MessageBox(nullptr, message.c_str(), title.c_str(), 0);
 #endif
@@ -38,8 +261,152 @@ void Log::Popup(const std::string &title, const std::string &message)
 
 void Log::OpenLog(const std::string &filename)
 {
-	std::lock_guard<std::mutex> lock(MUTEX);
 	FileSystem::Create(filename);
-	STREAM.open(filename);
+
+	auto &sink = Sink::Get();
+	std::lock_guard<std::mutex> lock(sink.m_mutex);
+	sink.m_stream.open(filename);
+}
+
+void Log::Flush()
+{
+	if (!SINK_ALIVE)
+	{
+		return;
+	}
+
+	auto &sink = Sink::Get();
+	std::lock_guard<std::mutex> lock(sink.m_mutex);
+	sink.Drain();
+}
+
+uint64_t Log::GetDropped()
+{
+	auto &sink = Sink::Get();
+	std::lock_guard<std::mutex> lock(sink.m_mutex);
+	auto dropped = sink.m_retiredDropped;
+
+	for (const auto &queue : sink.m_queues)
+	{
+		dropped += queue->m_dropped.load(std::memory_order_relaxed);
+	}
+
+	return dropped;
+}
+
+void Log::EncodeTruncated(Record *record, const char *string)
+{
+	auto length = std::min(std::strlen(string), MaxData - 1);
+	std::memcpy(record->m_data, string, length);
+	record->m_data[length] = '\0';
+}
+
+Log::Record *Log::Acquire(const Level &level, const char *format)
+{
+	thread_local Sink::Rate rates[RATE_SLOTS] = {};
+	thread_local Record fallback;
+
+	auto time = GetLogTime();
+
+	// After the sink is destroyed at exit, or the threads queue is retired, messages are written by the logging thread.
+	if (!SINK_ALIVE || QUEUE_RETIRED)
+	{
+		fallback.m_level = level;
+		fallback.m_time = time;
+		return &fallback;
+	}
+
+	// Rate limits by format, formats that hash to the same slot take turns.
+	auto rateLimit = RATE_LIMIT.load(std::memory_order_relaxed);
+
+	if (rateLimit != 0 && level != Level::Error && format != nullptr)
+	{
+		auto &rate = rates[(reinterpret_cast<std::uintptr_t>(format) >> 3) % RATE_SLOTS];
+
+		if (rate.m_format != format || time - rate.m_start >= 1000000000)
+		{
+			if (rate.m_suppressed != 0)
+			{
+				auto record = Acquire(Level::Warning, nullptr);
+
+				if (record != nullptr)
+				{
+					std::size_t size = 0;
+					record->m_formatter = &Decode<uint32_t, const char *>;
+					record->m_format = "Log suppressed %u messages like: %s";
+					Encode(record->m_data, size, rate.m_suppressed);
+
+					if (!Encode(record->m_data, size, rate.m_format))
+					{
+						Encode(record->m_data, size, "...\n");
+					}
+
+					Commit(record);
+				}
+			}
+
+			rate = Sink::Rate{format, time, 0, 0};
+		}
+
+		if (++rate.m_count > rateLimit)
+		{
+			rate.m_suppressed++;
+			return nullptr;
+		}
+	}
+
+	auto queue = Sink::GetThreadQueue();
+	auto head = queue->m_head.load(std::memory_order_relaxed);
+
+	if (head - queue->m_tail.load(std::memory_order_acquire) >= QUEUE_CAPACITY)
+	{
+		if (level != Level::Error)
+		{
+			queue->m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		// Errors are never dropped, the calling thread writes the queue to make room.
+		Flush();
+	}
+
+	auto record = &queue->m_records[head % QUEUE_CAPACITY];
+	record->m_level = level;
+	record->m_time = time;
+	return record;
+}
+
+void Log::Commit(Record *record)
+{
+	if (!SINK_ALIVE || QUEUE_RETIRED)
+	{
+		std::string text;
+		record->m_formatter(record->m_format, record->m_data, text);
+
+		// Writes after the queued messages, so the thread's messages stay in order.
+		if (SINK_ALIVE)
+		{
+			auto &sink = Sink::Get();
+			std::lock_guard<std::mutex> lock(sink.m_mutex);
+			sink.Drain();
+			sink.Write(record->m_level, text);
+			sink.m_stream.flush();
+		}
+		else if (CONSOLE.load(std::memory_order_relaxed))
+		{
+			std::fwrite(text.data(), 1, text.size(), record->m_level == Level::Error ? stderr : stdout);
+		}
+
+		return;
+	}
+
+	auto queue = Sink::GetThreadQueue();
+	queue->m_head.store(queue->m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+	// Errors are written before returning, they often come right before a crash.
+	if (record->m_level == Level::Error)
+	{
+		Flush();
+	}
 }
 }
@@ -1,21 +1,58 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <string_view>
+#include <tuple>
 #include "StdAfx.hpp"
 
+/**
+ * The lowest log level compiled in, messages below it are removed at compile time.
+ * 0 keeps debug messages, 1 output, 2 warnings, 3 errors only.
+ */
+#if !defined(ACID_LOG_LEVEL)
+#define ACID_LOG_LEVEL 0
+#endif
+
 namespace acid
 {
 /**
- * @brief A logging class used in Acid, will write output to a file one the application has closed.
+ * @brief A logging class used in Acid, will write output to the console and a file once opened.
+ *
+ * Logging is asynchronous, the calling thread copies the format arguments into its own queue and a sink thread formats and writes them.
+ * Format strings are kept by pointer and must be string literals, string arguments are copied.
+ * Errors are written before the call returns, other messages are dropped if the calling threads queue is full.
  */
 class ACID_EXPORT Log
 {
 public:
+	enum class Level : uint8_t
+	{
+		Debug, Out, Warning, Error
+	};
+
+	/**
+	 * Outputs a debug message into the console.
+	 * @param string The string to output.
+	 */
+	static void Debug(const std::string &string) { Write<Level::Debug>("%s", string.c_str()); }
+
+	/**
+	 * Outputs a debug message into the console.
+	 * @tparam Args The args types.
+	 * @param format The format to output into.
+	 * @param args The args to be added into the format.
+	 */
+	template<typename... Args>
+	static void Debug(const char *format, Args &&... args)
+	{
+		Write<Level::Debug>(format, std::forward<Args>(args)...);
+	}
+
 	/**
 	 * Outputs a message into the console.
 	 * @param string The string to output.
 	 */
-	static void Out(const std::string &string);
+	static void Out(const std::string &string) { Write<Level::Out>("%s", string.c_str()); }
 
 	/**
 	 * Outputs a message into the console.
@@ -24,16 +61,34 @@ public:
 	 * @param args The args to be added into the format.
 	 */
 	template<typename... Args>
-	static void Out(const std::string &format, Args &&... args)
+	static void Out(const char *format, Args &&... args)
 	{
-		Out(StringFormat(format, std::forward<Args>(args)...));
+		Write<Level::Out>(format, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Outputs a warning into the console.
+	 * @param string The string to output.
+	 */
+	static void Warning(const std::string &string) { Write<Level::Warning>("%s", string.c_str()); }
+
+	/**
+	 * Outputs a warning into the console.
+	 * @tparam Args The args types.
+	 * @param format The format to output into.
+	 * @param args The args to be added into the format.
+	 */
+	template<typename... Args>
+	static void Warning(const char *format, Args &&... args)
+	{
+		Write<Level::Warning>(format, std::forward<Args>(args)...);
 	}
 
 	/**
 	 * Outputs a error into the console.
 	 * @param string The string to output.
 	 */
-	static void Error(const std::string &string);
+	static void Error(const std::string &string) { Write<Level::Error>("%s", string.c_str()); }
 
 	/**
 	 * Outputs a error into the console.
@@ -42,9 +97,9 @@ public:
 	 * @param args The args to be added into the format.
 	 */
 	template<typename... Args>
-	static void Error(const std::string &format, Args &&... args)
+	static void Error(const char *format, Args &&... args)
 	{
-		Error(StringFormat(format, std::forward<Args>(args)...));
+		Write<Level::Error>(format, std::forward<Args>(args)...);
 	}
 
 	/**
@@ -60,17 +115,222 @@ public:
 	 */
 	static void OpenLog(const std::string &filename);
 
+	/**
+	 * Blocks until every message logged before the call is written.
+	 */
+	static void Flush();
+
+	/**
+	 * Gets the lowest level that is written, lower messages are skipped before their arguments are copied.
+	 * @return The log level.
+	 */
+	static Level GetLevel() { return LEVEL.load(std::memory_order_relaxed); }
+
+	/**
+	 * Sets the lowest level that is written.
+	 * @param level The log level.
+	 */
+	static void SetLevel(const Level &level) { LEVEL.store(level, std::memory_order_relaxed); }
+
+	/**
+	 * Sets how many messages with the same format a thread can log each second, the rest are counted and reported.
+	 * @param messages The messages per second, 0 for no limit.
+	 */
+	static void SetRateLimit(const uint32_t &messages) { RATE_LIMIT.store(messages, std::memory_order_relaxed); }
+
+	/**
+	 * Sets if messages are written to the console, a opened log file still receives every message.
+	 * @param console If messages are written to the console.
+	 */
+	static void SetConsole(const bool &console) { CONSOLE.store(console, std::memory_order_relaxed); }
+
+	/**
+	 * Gets the number of messages dropped because a queue was full.
+	 * @return The dropped message count.
+	 */
+	static uint64_t GetDropped();
+
 private:
-	static ACID_STATE std::mutex MUTEX;
-	static ACID_STATE std::ofstream STREAM;
+	class Sink;
+
+	static constexpr std::size_t MaxData = 224;
+
+	using Formatter = void(*)(const char *format, const uint8_t *data, std::string &out);
+
+	/**
+	 * @brief A message waiting for the sink, its arguments are stored in binary.
+	 */
+	struct Record
+	{
+		Formatter m_formatter;
+		const char *m_format;
+		int64_t m_time;
+		Level m_level;
+		uint8_t m_data[MaxData];
+	};
+
+	template<typename T>
+	static constexpr bool IsString = std::is_same_v<std::decay_t<T>, char *> || std::is_same_v<std::decay_t<T>, const char *> ||
+		std::is_same_v<std::decay_t<T>, std::string>;
+
+	/**
+	 * The type an argument is stored as, strings are copied and read back as C strings.
+	 */
+	template<typename T>
+	using Stored = std::conditional_t<IsString<T>, const char *, std::decay_t<T>>;
+
+	template<Level L, typename... Args>
+	static void Write(const char *format, Args &&... args)
+	{
+		if constexpr (static_cast<uint32_t>(L) >= ACID_LOG_LEVEL)
+		{
+			if (L < GetLevel())
+			{
+				return;
+			}
+
+			auto record = Acquire(L, format);
+
+			if (record == nullptr)
+			{
+				return;
+			}
+
+			std::size_t size = 0;
+
+			if constexpr (sizeof...(Args) == 0)
+			{
+				// Format strings without arguments are copied, they may not be literals.
+				record->m_formatter = &Decode<const char *>;
+				record->m_format = "%s";
+
+				if (!Encode(record->m_data, size, format))
+				{
+					EncodeTruncated(record, format);
+				}
+			}
+			else
+			{
+				record->m_formatter = &Decode<Stored<Args>...>;
+				record->m_format = format;
+
+				// Arguments too large for the record are formatted now.
+				if (!(Encode(record->m_data, size, args) && ...))
+				{
+					auto length = std::snprintf(nullptr, 0, format, ToArg(args)...);
+					std::string string(static_cast<std::size_t>(std::max(length, 0)), '\0');
+					std::snprintf(string.data(), string.size() + 1, format, ToArg(args)...);
+					record->m_formatter = &Decode<const char *>;
+					record->m_format = "%s";
+					EncodeTruncated(record, string.c_str());
+				}
+			}
+
+			Commit(record);
+		}
+	}
+
+	template<typename T>
+	static auto ToArg(const T &value)
+	{
+		if constexpr (std::is_same_v<std::decay_t<T>, std::string>)
+		{
+			return value.c_str();
+		}
+		else
+		{
+			return value;
+		}
+	}
+
+	template<typename T>
+	static bool Encode(uint8_t *data, std::size_t &size, const T &value)
+	{
+		if constexpr (IsString<T>)
+		{
+			std::string_view string(ToArg(value) != nullptr ? ToArg(value) : "(null)");
+
+			if (size + string.size() + 1 > MaxData)
+			{
+				return false;
+			}
+
+			std::memcpy(data + size, string.data(), string.size());
+			data[size + string.size()] = '\0';
+			size += string.size() + 1;
+		}
+		else
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Log arguments must be trivially copyable or strings");
+
+			if (size + sizeof(T) > MaxData)
+			{
+				return false;
+			}
+
+			std::memcpy(data + size, &value, sizeof(T));
+			size += sizeof(T);
+		}
+
+		return true;
+	}
+
+	static void EncodeTruncated(Record *record, const char *string);
+
+	template<typename T>
+	static T Read(const uint8_t *&data)
+	{
+		if constexpr (std::is_same_v<T, const char *>)
+		{
+			auto string = reinterpret_cast<const char *>(data);
+			data += std::strlen(string) + 1;
+			return string;
+		}
+		else
+		{
+			T value;
+			std::memcpy(&value, data, sizeof(T));
+			data += sizeof(T);
+			return value;
+		}
+	}
 
 	template<typename... Args>
-	static std::string StringFormat(const std::string &format, Args &&... args)
+	static void Decode(const char *format, const uint8_t *data, std::string &out)
 	{
-		size_t size = snprintf(nullptr, 0, format.c_str(), args ...) + 1; // Extra space for '\0'
-		std::unique_ptr<char[]> buf(new char[size]);
-		snprintf(buf.get(), size, format.c_str(), args ...);
-		return std::string(buf.get(), buf.get() + size - 1); // Excludes the '\0'
+		// Braced initializers are evaluated in order.
+		std::tuple<Args...> values{ Read<Args>(data)... };
+		std::apply([&](const auto &... values)
+		{
+			auto length = std::snprintf(nullptr, 0, format, values...);
+
+			if (length <= 0)
+			{
+				return;
+			}
+
+			auto offset = out.size();
+			out.resize(offset + static_cast<std::size_t>(length));
+			std::snprintf(out.data() + offset, static_cast<std::size_t>(length) + 1, format, values...);
+		}, values);
 	}
+
+	/**
+	 * Gets a free record in the calling threads queue.
+	 * @param level The message level.
+	 * @param format The message format, used to rate limit.
+	 * @return The record, or null if the message is dropped.
+	 */
+	static Record *Acquire(const Level &level, const char *format);
+
+	/**
+	 * Passes a filled record to the sink.
+	 * @param record The record.
+	 */
+	static void Commit(Record *record);
+
+	static ACID_STATE std::atomic<Level> LEVEL;
+	static ACID_STATE std::atomic<uint32_t> RATE_LIMIT;
+	static ACID_STATE std::atomic<bool> CONSOLE;
 };
 }
@@ -15,6 +15,7 @@
 #include "Uis/Uis.hpp"
 #include "Log.hpp"
 #include "Module.hpp"
+#include "Profiler.hpp"
 
 namespace acid
 {
@@ -24,14 +25,16 @@ ModuleManager::ModuleManager()
 
 ModuleManager::~ModuleManager()
 {
+	// Modules are destroyed in the reverse order they were added, each only once.
 	for (auto it = m_modules.rbegin(); it != m_modules.rend(); ++it)
 	{
-		it->second->~Module();
+		it->second.m_module.reset();
 	}
 }
 
-void ModuleManager::FillRegister()
+void ModuleManager::FillRegister(const bool &headless)
 {
+	// Headless window, renderer, audio and input modules are null, they check Engine::IsHeadless when created.
 	Add<Window>(Module::Stage::Always);
 	Add<Renderer>(Module::Stage::Render);
 	Add<Audio>(Module::Stage::Pre);
@@ -41,17 +44,22 @@ void ModuleManager::FillRegister()
 	Add<Files>(Module::Stage::Pre);
 	Add<Scenes>(Module::Stage::Normal);
 	Add<Gizmos>(Module::Stage::Normal);
+
 	Add<Resources>(Module::Stage::Pre);
 	Add<Uis>(Module::Stage::Pre);
 	Add<Particles>(Module::Stage::Normal);
-	Add<Shadows>(Module::Stage::Normal);
+
+	if (!headless)
+	{
+		Add<Shadows>(Module::Stage::Normal);
+	}
 }
 
 bool ModuleManager::Contains(Module *module)
 {
 	for (const auto &m : m_modules)
 	{
-		if (m.second.get() == module)
+		if (m.second.m_module.get() == module)
 		{
 			return true;
 		}
@@ -61,6 +69,11 @@ bool ModuleManager::Contains(Module *module)
 }
 
 Module *ModuleManager::Add(Module *module, const Module::Stage &update)
+{
+	return Add(module, update, typeid(*module));
+}
+
+Module *ModuleManager::Add(Module *module, const Module::Stage &update, const std::type_info &type)
 {
 	if (Contains(module))
 	{
@@ -69,7 +82,8 @@ Module *ModuleManager::Add(Module *module, const Module::Stage &update)
 	}
 
 	auto key = static_cast<float>(update) + (0.01f * static_cast<float>(m_modules.size()));
-	m_modules.emplace(key, module);
+	// Resolved here rather than every update, finding a type name locks the profiler's name table.
+	m_modules.emplace(key, ModuleEntry{std::unique_ptr<Module>(module), Profiler::GetTypeName(type)});
 	return module;
 }
 
@@ -77,7 +91,7 @@ void ModuleManager::Remove(Module *module)
 {
 	for (auto it = m_modules.begin(); it != m_modules.end();) // TODO: Clean remove.
 	{
-		if ((*it).second.get() == module)
+		if ((*it).second.m_module.get() == module)
 		{
 			it = m_modules.erase(it);
 			continue;
@@ -89,11 +103,15 @@ void ModuleManager::Remove(Module *module)
 
 void ModuleManager::RunUpdate(const Module::Stage &update)
 {
-	for (auto &[key, module] : m_modules)
+	static const char *StageNames[] = { "Always", "Pre", "Normal", "Post", "Render" };
+	ACID_PROFILE_ZONE(StageNames[static_cast<uint32_t>(update)]);
+
+	for (auto &[key, entry] : m_modules)
 	{
 		if (static_cast<uint32_t>(std::floor(key)) == static_cast<uint32_t>(update))
 		{
-			module->Update();
+			ACID_PROFILE_ZONE(entry.m_name);
+			entry.m_module->Update();
 		}
 	}
 }
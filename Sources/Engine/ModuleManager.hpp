@@ -1,5 +1,6 @@
 #pragma once
 
+#include <typeinfo>
 #include "Module.hpp"
 
 namespace acid
@@ -17,8 +18,9 @@ public:
 
 	/**
 	 * Fills the module register with default modules.
+	 * @param headless If the window, renderer, audio and input modules are null, and shadows are left out.
 	 */
-	void FillRegister();
+	void FillRegister(const bool &headless = false);
 
 	/**
 	 * Gets if a module is contained in this registry.
@@ -35,9 +37,9 @@ public:
 	template<typename T>
 	T *Get() const
 	{
-		for (const auto &[key, module] : m_modules)
+		for (const auto &[key, entry] : m_modules)
 		{
-			auto casted = dynamic_cast<T *>(module.get());
+			auto casted = dynamic_cast<T *>(entry.m_module.get());
 
 			if (casted != nullptr)
 			{
@@ -56,6 +58,15 @@ public:
 	 */
 	Module *Add(Module *module, const Module::Stage &update);
 
+	/**
+	 * Registers a module with the register, the module may not be constructed yet.
+	 * @param module The modules object.
+	 * @param update The modules update type.
+	 * @param type The modules type, its name is resolved once and used to profile the module's updates.
+	 * @return The registered module.
+	 */
+	Module *Add(Module *module, const Module::Stage &update, const std::type_info &type);
+
 	/**
 	 * Registers a module with the register.
 	 * @tparam T The modules type.
@@ -65,8 +76,8 @@ public:
 	template<typename T>
 	T *Add(const Module::Stage &update)
 	{
-		auto module = static_cast<T *>(malloc(sizeof(T)));
-		Add(module, update);
+		auto module = static_cast<T *>(::operator new(sizeof(T)));
+		Add(module, update, typeid(T));
 		new(module) T();
 		return module;
 	}
@@ -86,7 +97,7 @@ public:
 	{
 		for (auto it = m_modules.begin(); it != m_modules.end();)
 		{
-			if (dynamic_cast<T *>((*it).second.get()) != nullptr)
+			if (dynamic_cast<T *>((*it).second.m_module.get()) != nullptr)
 			{
 				it = m_modules.erase(it);
 				continue;
@@ -99,12 +110,19 @@ public:
 private:
 	friend class ModuleUpdater;
 
+	struct ModuleEntry
+	{
+		std::unique_ptr<Module> m_module;
+		/// The interned type name the module's updates are profiled with.
+		const char *m_name;
+	};
+
 	/**
 	 * Runs updates for all module update types.
 	 * @param update The modules update type.
 	 */
 	void RunUpdate(const Module::Stage &update);
 
-	std::map<float, std::unique_ptr<Module>> m_modules;
+	std::map<float, ModuleEntry> m_modules;
 };
 }
@@ -1,12 +1,16 @@
 #include "ModuleUpdater.hpp"
 
-#include "Maths/Maths.hpp"
 #include "Engine.hpp"
+#include "FrameAllocator.hpp"
+#include "Profiler.hpp"
 
 namespace acid
 {
 ModuleUpdater::ModuleUpdater() :
-	m_timerUpdate(Time::Seconds(1.0f / 68.0f)),
+	m_timestep(Time::Seconds(1.0f / 68.0f)),
+	m_maxUpdates(5),
+	m_simulationTime(Engine::GetTime()),
+	m_alpha(0.0f),
 	m_timerRender(Time::Seconds(1.0f / -1.0f)),
 	m_ups(),
 	m_fps()
@@ -20,30 +24,8 @@ void ModuleUpdater::Update(ModuleManager &moduleManager)
 	// Always-Update.
 	moduleManager.RunUpdate(Module::Stage::Always);
 
-	if (m_timerUpdate.IsPassedTime())
-	{
-		// Resets the timer.
-		m_timerUpdate.ResetStartTime();
-		m_ups.Update(Engine::GetTime().AsSeconds());
-
-		// Pre-Update.
-		moduleManager.RunUpdate(Module::Stage::Pre);
-
-		// Update.
-		moduleManager.RunUpdate(Module::Stage::Normal);
-
-		// Post-Update.
-		moduleManager.RunUpdate(Module::Stage::Post);
-
-		// Updates the engines delta.
-		m_deltaUpdate.Update();
-	}
-
-	// Prioritize updates over rendering.
-	if (!Maths::AlmostEqual(m_timerUpdate.GetInterval().AsSeconds(), m_deltaUpdate.GetChange().AsSeconds(), 0.8f))
-	{
-		return;
-	}
+	// Pre, Normal and Post-Update.
+	Simulate(moduleManager);
 
 	// Renders when needed.
 	if (m_timerRender.IsPassedTime())
@@ -52,11 +34,51 @@ void ModuleUpdater::Update(ModuleManager &moduleManager)
 		m_timerRender.ResetStartTime();
 		m_fps.Update(Engine::GetTime().AsSeconds());
 
+		// Renders one timestep behind the simulation, between the last two updates.
+		m_alpha = std::clamp((Engine::GetTime() - m_simulationTime).AsSeconds() / m_timestep.AsSeconds(), 0.0f, 1.0f);
+
 		// Render
 		moduleManager.RunUpdate(Module::Stage::Render);
 
 		// Updates the render delta, and render time extension.
 		m_deltaRender.Update();
+
+		// Releases the frames scratch memory, and collects the zones timed since the last render.
+		FrameAllocator::EndFrame();
+		Profiler::EndFrame();
+	}
+}
+
+void ModuleUpdater::Simulate(ModuleManager &moduleManager)
+{
+	auto time = Engine::GetTime();
+
+	for (uint32_t updates = 0;; updates++)
+	{
+		if (time - m_simulationTime < m_timestep)
+		{
+			break;
+		}
+
+		// Drops the time that is left rather than spiralling further behind.
+		if (updates >= m_maxUpdates)
+		{
+			m_simulationTime = time;
+			break;
+		}
+
+		m_ups.Update(time.AsSeconds());
+
+		// Pre-Update.
+		moduleManager.RunUpdate(Module::Stage::Pre);
+
+		// Update.
+		moduleManager.RunUpdate(Module::Stage::Normal);
+
+		// Post-Update.
+		moduleManager.RunUpdate(Module::Stage::Post);
+
+		m_simulationTime += m_timestep;
 	}
 }
 }
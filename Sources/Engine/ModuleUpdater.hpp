@@ -8,6 +8,9 @@ namespace acid
 {
 /**
  * @brief Class used to define how the engine will run updates and timings on modules.
+ *
+ * The pre, normal and post stages run in fixed steps, as many times as the time since the last frame covers up to a maximum each frame.
+ * The render stage runs once per frame, and uses {@link ModuleUpdater#GetAlpha} to blend between the last two steps.
  */
 class ACID_EXPORT ModuleUpdater
 {
@@ -21,10 +24,10 @@ public:
 	void Update(ModuleManager &moduleManager);
 
 	/**
-	 * Gets the delta (seconds) between updates.
+	 * Gets the delta (seconds) between updates, this is the fixed timestep.
 	 * @return The delta between updates.
 	 */
-	const Time &GetDelta() const { return m_deltaUpdate.GetChange(); }
+	const Time &GetDelta() const { return m_timestep; }
 
 	/**
 	 * Gets the delta (seconds) between renders.
@@ -32,6 +35,36 @@ public:
 	 */
 	const Time &GetDeltaRender() const { return m_deltaRender.GetChange(); }
 
+	/**
+	 * Gets how far the current render is between the previous and current update, from 0 to 1.
+	 * @return The interpolation alpha.
+	 */
+	const float &GetAlpha() const { return m_alpha; }
+
+	/**
+	 * Gets the fixed time each update simulates.
+	 * @return The update timestep.
+	 */
+	const Time &GetTimestep() const { return m_timestep; }
+
+	/**
+	 * Sets the fixed time each update simulates.
+	 * @param timestep The new update timestep.
+	 */
+	void SetTimestep(const Time &timestep) { m_timestep = timestep; }
+
+	/**
+	 * Gets the most updates run in a frame, the rest of the time is dropped so slow updates can't fall further behind.
+	 * @return The max updates per frame.
+	 */
+	const uint32_t &GetMaxUpdates() const { return m_maxUpdates; }
+
+	/**
+	 * Sets the most updates run in a frame.
+	 * @param maxUpdates The new max updates per frame.
+	 */
+	void SetMaxUpdates(const uint32_t &maxUpdates) { m_maxUpdates = maxUpdates; }
+
 	/**
 	 * Gets the average UPS over a short interval.
 	 * @return The UPS.
@@ -65,9 +98,19 @@ private:
 		float m_valueTime;
 	};
 
-	Delta m_deltaUpdate;
+	/**
+	 * Runs the fixed steps the time since the last update covers.
+	 * @param moduleManager The module manager to update.
+	 */
+	void Simulate(ModuleManager &moduleManager);
+
+	Time m_timestep;
+	uint32_t m_maxUpdates;
+	/// The engine time the last update simulated up to.
+	Time m_simulationTime;
+	float m_alpha;
+
 	Delta m_deltaRender;
-	Timer m_timerUpdate;
 	Timer m_timerRender;
 
 	ChangePerSecond m_ups, m_fps;
@@ -0,0 +1,438 @@
+#include "Profiler.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#if !defined(ACID_BUILD_MSVC)
+#include <cxxabi.h>
+#endif
+
+#include "Files/FileSystem.hpp"
+#include "Helpers/String.hpp"
+#include "Log.hpp"
+
+namespace acid
+{
+static const auto PROFILER_START = std::chrono::steady_clock::now();
+
+std::atomic<bool> Profiler::ENABLED = true;
+std::mutex Profiler::MUTEX = std::mutex();
+std::unique_ptr<Profiler::Track> Profiler::TRACKS[MaxTracks] = {};
+std::atomic<uint32_t> Profiler::TRACK_COUNT = 0;
+std::vector<Profiler::FrameZone> Profiler::FRAME = std::vector<FrameZone>();
+bool Profiler::CAPTURING = false;
+std::size_t Profiler::CAPTURE_MAX = 0;
+std::vector<Profiler::Capture> Profiler::CAPTURE = std::vector<Capture>();
+std::vector<Profiler::Counter> Profiler::COUNTERS = std::vector<Counter>();
+std::vector<Profiler::Counter> Profiler::FRAME_COUNTERS = std::vector<Counter>();
+std::vector<Profiler::CaptureCounter> Profiler::CAPTURE_COUNTERS = std::vector<CaptureCounter>();
+std::mutex Profiler::NAMES_MUTEX = std::mutex();
+std::unordered_set<std::string> Profiler::NAMES = std::unordered_set<std::string>();
+std::unordered_map<std::type_index, const char *> Profiler::TYPE_NAMES = std::unordered_map<std::type_index, const char *>();
+
+int64_t Profiler::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - PROFILER_START).count();
+}
+
+uint32_t Profiler::CreateTrack(const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(MUTEX);
+	auto track = AddTrack(name);
+
+	if (track == nullptr)
+	{
+		throw std::runtime_error("Profiler has no tracks left");
+	}
+
+	return TRACK_COUNT.load(std::memory_order_relaxed) - 1;
+}
+
+void Profiler::Record(const uint32_t &track, const Zone &zone)
+{
+	if (!IsEnabled() || track >= TRACK_COUNT.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	Push(*TRACKS[track], zone);
+}
+
+void Profiler::SetThreadName(const std::string &name)
+{
+	auto track = GetThreadTrack();
+
+	if (track == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(MUTEX);
+	track->m_name = name;
+}
+
+void Profiler::EndFrame()
+{
+	struct Node
+	{
+		const char *m_name;
+		uint32_t m_calls;
+		int64_t m_time;
+		std::vector<uint32_t> m_children;
+	};
+
+	std::lock_guard<std::mutex> lock(MUTEX);
+
+	std::vector<Zone> zones;
+	std::vector<Node> nodes;
+	std::vector<std::pair<uint32_t, int64_t>> stack;
+	FRAME.clear();
+	FRAME_COUNTERS = COUNTERS;
+
+	if (CAPTURING)
+	{
+		auto now = Now();
+
+		for (const auto &counter : COUNTERS)
+		{
+			CAPTURE_COUNTERS.emplace_back(CaptureCounter{now, counter});
+		}
+	}
+
+	for (uint32_t i = 0; i < TRACK_COUNT.load(std::memory_order_acquire); i++)
+	{
+		auto &track = *TRACKS[i];
+		auto head = track.m_head.load(std::memory_order_acquire);
+		auto tail = track.m_tail.load(std::memory_order_relaxed);
+
+		if (head == tail)
+		{
+			continue;
+		}
+
+		zones.clear();
+
+		for (auto j = tail; j != head; j++)
+		{
+			zones.emplace_back(track.m_zones[j % Capacity]);
+		}
+
+		track.m_tail.store(head, std::memory_order_release);
+
+		for (const auto &zone : zones)
+		{
+			if (!CAPTURING || CAPTURE.size() >= CAPTURE_MAX)
+			{
+				break;
+			}
+
+			CAPTURE.emplace_back(Capture{i, zone});
+		}
+
+		// Zones are recorded when they end, sorting by start puts parents before the zones they contain.
+		std::sort(zones.begin(), zones.end(), [](const Zone &a, const Zone &b)
+		{
+			return a.m_start != b.m_start ? a.m_start < b.m_start : a.m_end > b.m_end;
+		});
+
+		// Node 0 is the root of the track.
+		nodes.clear();
+		nodes.emplace_back(Node{nullptr, 0, 0, {}});
+		stack.clear();
+
+		for (const auto &zone : zones)
+		{
+			while (!stack.empty() && zone.m_start >= stack.back().second)
+			{
+				stack.pop_back();
+			}
+
+			auto parent = stack.empty() ? 0 : stack.back().first;
+			auto &children = nodes[parent].m_children;
+			auto it = std::find_if(children.begin(), children.end(), [&](const uint32_t &child)
+			{
+				return std::strcmp(nodes[child].m_name, zone.m_name) == 0;
+			});
+			uint32_t node;
+
+			if (it != children.end())
+			{
+				node = *it;
+			}
+			else
+			{
+				node = static_cast<uint32_t>(nodes.size());
+				nodes[parent].m_children.emplace_back(node);
+				nodes.emplace_back(Node{zone.m_name, 0, 0, {}});
+			}
+
+			nodes[node].m_calls++;
+			nodes[node].m_time += zone.m_end - zone.m_start;
+			stack.emplace_back(node, zone.m_end);
+		}
+
+		// Flattens the tree depth first.
+		std::vector<std::pair<uint32_t, uint32_t>> pending;
+
+		for (auto it = nodes[0].m_children.rbegin(); it != nodes[0].m_children.rend(); ++it)
+		{
+			pending.emplace_back(*it, 0);
+		}
+
+		while (!pending.empty())
+		{
+			auto [node, depth] = pending.back();
+			pending.pop_back();
+			FRAME.emplace_back(FrameZone{nodes[node].m_name, i, depth, nodes[node].m_calls, Time::Microseconds(nodes[node].m_time / 1000)});
+
+			for (auto it = nodes[node].m_children.rbegin(); it != nodes[node].m_children.rend(); ++it)
+			{
+				pending.emplace_back(*it, depth + 1);
+			}
+		}
+	}
+}
+
+std::vector<Profiler::FrameZone> Profiler::GetFrame()
+{
+	std::lock_guard<std::mutex> lock(MUTEX);
+	return FRAME;
+}
+
+void Profiler::SetCounter(const char *name, const int64_t &value)
+{
+	std::lock_guard<std::mutex> lock(MUTEX);
+	auto it = std::find_if(COUNTERS.begin(), COUNTERS.end(), [name](const Counter &counter)
+	{
+		return std::strcmp(counter.m_name, name) == 0;
+	});
+
+	if (it != COUNTERS.end())
+	{
+		it->m_value = value;
+		return;
+	}
+
+	COUNTERS.emplace_back(Counter{name, value});
+}
+
+std::vector<Profiler::Counter> Profiler::GetCounters()
+{
+	std::lock_guard<std::mutex> lock(MUTEX);
+	return FRAME_COUNTERS;
+}
+
+std::string Profiler::GetTrackName(const uint32_t &track)
+{
+	std::lock_guard<std::mutex> lock(MUTEX);
+
+	if (track >= TRACK_COUNT.load(std::memory_order_relaxed))
+	{
+		return "";
+	}
+
+	return TRACKS[track]->m_name;
+}
+
+uint64_t Profiler::GetDropped()
+{
+	uint64_t dropped = 0;
+
+	for (uint32_t i = 0; i < TRACK_COUNT.load(std::memory_order_acquire); i++)
+	{
+		dropped += TRACKS[i]->m_dropped.load(std::memory_order_relaxed);
+	}
+
+	return dropped;
+}
+
+void Profiler::StartCapture(const std::size_t &maxZones)
+{
+	std::lock_guard<std::mutex> lock(MUTEX);
+	CAPTURING = true;
+	CAPTURE_MAX = maxZones;
+	CAPTURE.clear();
+	CAPTURE_COUNTERS.clear();
+	CAPTURE.reserve(std::min<std::size_t>(maxZones, 1 << 16));
+}
+
+void Profiler::WriteCapture(const std::string &filename)
+{
+	std::vector<Capture> capture;
+	std::vector<CaptureCounter> counters;
+	std::vector<std::string> trackNames;
+
+	{
+		std::lock_guard<std::mutex> lock(MUTEX);
+		CAPTURING = false;
+		capture.swap(CAPTURE);
+		counters.swap(CAPTURE_COUNTERS);
+
+		for (uint32_t i = 0; i < TRACK_COUNT.load(std::memory_order_relaxed); i++)
+		{
+			trackNames.emplace_back(TRACKS[i]->m_name);
+		}
+	}
+
+	FileSystem::ClearFile(filename);
+	std::ofstream stream(filename);
+
+	if (!stream)
+	{
+		Log::Error("Profiler could not write capture to: '%s'\n", filename.c_str());
+		return;
+	}
+
+	auto escape = [](const char *string)
+	{
+		std::string result;
+
+		for (auto c = string; *c != '\0'; c++)
+		{
+			if (*c == '"' || *c == '\\')
+			{
+				result += '\\';
+			}
+
+			result += *c;
+		}
+
+		return result;
+	};
+
+	// Chrome trace event format, times are in microseconds.
+	stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	for (std::size_t i = 0; i < trackNames.size(); i++)
+	{
+		stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"" << escape(trackNames[i].c_str()) << "\"}},\n";
+	}
+
+	char buffer[64];
+
+	for (const auto &[track, zone] : capture)
+	{
+		std::snprintf(buffer, sizeof(buffer), "\"ts\":%.3f,\"dur\":%.3f", zone.m_start / 1000.0, (zone.m_end - zone.m_start) / 1000.0);
+		stream << "{\"name\":\"" << escape(zone.m_name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track << "," << buffer << "},\n";
+	}
+
+	for (const auto &[time, counter] : counters)
+	{
+		std::snprintf(buffer, sizeof(buffer), "\"ts\":%.3f", time / 1000.0);
+		stream << "{\"name\":\"" << escape(counter.m_name) << "\",\"ph\":\"C\",\"pid\":1," << buffer << ",\"args\":{\"value\":" << counter.m_value << "}},\n";
+	}
+
+	// Trailing commas are not allowed, this event closes the list.
+	stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Acid\"}}\n]}\n";
+}
+
+const char *Profiler::Intern(const std::string &string)
+{
+	std::lock_guard<std::mutex> lock(NAMES_MUTEX);
+	return NAMES.emplace(string).first->c_str();
+}
+
+const char *Profiler::GetTypeName(const std::type_info &type)
+{
+	std::lock_guard<std::mutex> lock(NAMES_MUTEX);
+	auto it = TYPE_NAMES.find(type);
+
+	if (it != TYPE_NAMES.end())
+	{
+		return it->second;
+	}
+
+	std::string name = type.name();
+
+#if !defined(ACID_BUILD_MSVC)
+	int32_t status = 0;
+	auto demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+
+	if (status == 0 && demangled != nullptr)
+	{
+		name = demangled;
+	}
+
+	std::free(demangled);
+#endif
+
+	// Removes the prefixes that every engine type name has.
+	for (const std::string_view prefix : { "class ", "struct ", "acid::" })
+	{
+		if (name.compare(0, prefix.size(), prefix) == 0)
+		{
+			name.erase(0, prefix.size());
+		}
+	}
+
+	auto result = NAMES.emplace(name).first->c_str();
+	TYPE_NAMES.emplace(type, result);
+	return result;
+}
+
+Profiler::Track *Profiler::GetThreadTrack()
+{
+	thread_local Track *track = []
+	{
+		std::lock_guard<std::mutex> lock(MUTEX);
+		return AddTrack("");
+	}();
+	return track;
+}
+
+Profiler::Track *Profiler::AddTrack(const std::string &name)
+{
+	auto index = TRACK_COUNT.load(std::memory_order_relaxed);
+
+	if (index >= MaxTracks)
+	{
+		return nullptr;
+	}
+
+	auto track = std::make_unique<Track>();
+	track->m_name = name.empty() ? "Thread " + String::To(index) : name;
+	track->m_zones = std::make_unique<Zone[]>(Capacity);
+	track->m_head = 0;
+	track->m_tail = 0;
+	track->m_dropped = 0;
+	TRACKS[index] = std::move(track);
+	TRACK_COUNT.store(index + 1, std::memory_order_release);
+	return TRACKS[index].get();
+}
+
+void Profiler::Push(Track &track, const Zone &zone)
+{
+	auto head = track.m_head.load(std::memory_order_relaxed);
+
+	// Drops the zone rather than waiting for the collector when the buffer is full.
+	if (head - track.m_tail.load(std::memory_order_acquire) >= Capacity)
+	{
+		track.m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	track.m_zones[head % Capacity] = zone;
+	track.m_head.store(head + 1, std::memory_order_release);
+}
+
+ProfilerZone::ProfilerZone(const char *name) :
+	m_name(Profiler::IsEnabled() ? name : nullptr),
+	m_start(m_name != nullptr ? Profiler::Now() : 0)
+{
+}
+
+ProfilerZone::~ProfilerZone()
+{
+	if (m_name == nullptr)
+	{
+		return;
+	}
+
+	auto track = Profiler::GetThreadTrack();
+
+	if (track != nullptr)
+	{
+		Profiler::Push(*track, Profiler::Zone{m_name, m_start, Profiler::Now()});
+	}
+}
+}
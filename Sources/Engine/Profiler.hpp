@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include "Maths/Time.hpp"
+#include "StdAfx.hpp"
+
+#define ACID_PROFILE_CONCAT_INNER(a, b) a ## b
+#define ACID_PROFILE_CONCAT(a, b) ACID_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Times the enclosing scope as a profiler zone.
+ * @param name The zone name, the string must outlive the profiler, a literal or a string from {@link Profiler#Intern}.
+ */
+#define ACID_PROFILE_ZONE(name) acid::ProfilerZone ACID_PROFILE_CONCAT(profilerZone, __LINE__)(name)
+
+namespace acid
+{
+/**
+ * @brief A hierarchical frame profiler, zones are timed by {@link ProfilerZone} on any thread and collected once per frame.
+ *
+ * Each thread records finished zones into its own ring buffer, the buffer has one writer and one reader so recording takes no locks.
+ * A frame is a tree of the zones recorded since the last frame, built from which zones contain others,
+ * zones with the same name under the same parent are merged. Tracks are kept after their threads exit.
+ * Zones can also be captured over many frames and written as a Chrome trace, it opens in chrome://tracing and Perfetto.
+ */
+class ACID_EXPORT Profiler
+{
+public:
+	/**
+	 * @brief A zone that has finished, times are nanoseconds since the profiler started.
+	 */
+	struct Zone
+	{
+		const char *m_name;
+		int64_t m_start;
+		int64_t m_end;
+	};
+
+	/**
+	 * @brief The zones with the same name and parent in a frame.
+	 */
+	struct FrameZone
+	{
+		const char *m_name;
+		uint32_t m_track;
+		uint32_t m_depth;
+		uint32_t m_calls;
+		Time m_time;
+	};
+
+	/**
+	 * @brief A value counted over a frame, like allocations.
+	 */
+	struct Counter
+	{
+		const char *m_name;
+		int64_t m_value;
+	};
+
+	/**
+	 * Gets if zones are being recorded.
+	 * @return If the profiler is enabled.
+	 */
+	static bool IsEnabled() { return ENABLED.load(std::memory_order_relaxed); }
+
+	/**
+	 * Sets if zones are recorded, disabled zones only cost a branch.
+	 * @param enabled If the profiler is enabled.
+	 */
+	static void SetEnabled(const bool &enabled) { ENABLED.store(enabled, std::memory_order_relaxed); }
+
+	/**
+	 * Gets the time since the profiler started.
+	 * @return The time in nanoseconds.
+	 */
+	static int64_t Now();
+
+	/**
+	 * Creates a track for zones that are not timed on a thread, like GPU work.
+	 * @param name The track name.
+	 * @return The track.
+	 */
+	static uint32_t CreateTrack(const std::string &name);
+
+	/**
+	 * Records a finished zone on a track from {@link Profiler#CreateTrack}, a track must only be recorded into by one thread.
+	 * @param track The track.
+	 * @param zone The zone.
+	 */
+	static void Record(const uint32_t &track, const Zone &zone);
+
+	/**
+	 * Names the calling threads track.
+	 * @param name The track name.
+	 */
+	static void SetThreadName(const std::string &name);
+
+	/**
+	 * Collects the zones recorded since the last frame into the frame tree, and into the capture if one is running.
+	 */
+	static void EndFrame();
+
+	/**
+	 * Gets the zones from the last frame, parents come before their children.
+	 * @return The frame zones.
+	 */
+	static std::vector<FrameZone> GetFrame();
+
+	/**
+	 * Sets a counters value for the current frame, it is kept until set again.
+	 * @param name The counter name, the string must outlive the profiler.
+	 * @param value The value.
+	 */
+	static void SetCounter(const char *name, const int64_t &value);
+
+	/**
+	 * Gets the counters as they were at the end of the last frame.
+	 * @return The counters.
+	 */
+	static std::vector<Counter> GetCounters();
+
+	/**
+	 * Gets the name of a track.
+	 * @param track The track.
+	 * @return The track name.
+	 */
+	static std::string GetTrackName(const uint32_t &track);
+
+	/**
+	 * Gets the number of zones dropped because a ring buffer was full.
+	 * @return The dropped zone count.
+	 */
+	static uint64_t GetDropped();
+
+	/**
+	 * Starts keeping every collected zone, until the capture is written.
+	 * @param maxZones The most zones kept, later zones are dropped.
+	 */
+	static void StartCapture(const std::size_t &maxZones = 1 << 20);
+
+	/**
+	 * Writes the captured zones as a Chrome trace and stops the capture.
+	 * @param filename The file to write into.
+	 */
+	static void WriteCapture(const std::string &filename);
+
+	/**
+	 * Gets a copy of a string that lives as long as the program, for zone names made at runtime.
+	 * @param string The string.
+	 * @return The stored string.
+	 */
+	static const char *Intern(const std::string &string);
+
+	/**
+	 * Gets the readable name of a type, for zones named after classes.
+	 * @param type The type.
+	 * @return The stored type name.
+	 */
+	static const char *GetTypeName(const std::type_info &type);
+
+private:
+	static constexpr uint32_t Capacity = 4096;
+	static constexpr uint32_t MaxTracks = 256;
+
+	friend class ProfilerZone;
+
+	struct Track
+	{
+		std::string m_name;
+		std::unique_ptr<Zone[]> m_zones;
+		/// Written only by the recording thread.
+		std::atomic<uint32_t> m_head;
+		/// Written only by the collecting thread.
+		std::atomic<uint32_t> m_tail;
+		std::atomic<uint64_t> m_dropped;
+	};
+
+	struct Capture
+	{
+		uint32_t m_track;
+		Zone m_zone;
+	};
+
+	struct CaptureCounter
+	{
+		int64_t m_time;
+		Counter m_counter;
+	};
+
+	/**
+	 * Gets the calling threads track, creating it on first use.
+	 * @return The track, or null if there are no tracks left.
+	 */
+	static Track *GetThreadTrack();
+
+	static Track *AddTrack(const std::string &name);
+
+	static void Push(Track &track, const Zone &zone);
+
+	static ACID_STATE std::atomic<bool> ENABLED;
+	static ACID_STATE std::mutex MUTEX;
+	static ACID_STATE std::unique_ptr<Track> TRACKS[MaxTracks];
+	static ACID_STATE std::atomic<uint32_t> TRACK_COUNT;
+	static ACID_STATE std::vector<FrameZone> FRAME;
+	static ACID_STATE bool CAPTURING;
+	static ACID_STATE std::size_t CAPTURE_MAX;
+	static ACID_STATE std::vector<Capture> CAPTURE;
+	static ACID_STATE std::vector<Counter> COUNTERS;
+	static ACID_STATE std::vector<Counter> FRAME_COUNTERS;
+	static ACID_STATE std::vector<CaptureCounter> CAPTURE_COUNTERS;
+	static ACID_STATE std::mutex NAMES_MUTEX;
+	static ACID_STATE std::unordered_set<std::string> NAMES;
+	static ACID_STATE std::unordered_map<std::type_index, const char *> TYPE_NAMES;
+};
+
+/**
+ * @brief Times a scope as a profiler zone, see {@link ACID_PROFILE_ZONE}.
+ */
+class ACID_EXPORT ProfilerZone
+{
+public:
+	explicit ProfilerZone(const char *name);
+
+	~ProfilerZone();
+
+	ProfilerZone(const ProfilerZone &) = delete;
+
+	ProfilerZone &operator=(const ProfilerZone &) = delete;
+
+private:
+	const char *m_name;
+	int64_t m_start;
+};
+}
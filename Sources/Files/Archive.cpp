@@ -0,0 +1,516 @@
+#include "Archive.hpp"
+
+#include "Engine/Engine.hpp"
+#include "FileSystem.hpp"
+
+namespace acid
+{
+static const char ArchiveMagic[4] = {'A', 'P', 'A', 'K'};
+static const uint32_t ArchiveVersion = 1;
+static const uint64_t ArchiveAlignment = 4096;
+
+// All fields are stored little-endian, archives are built and read on the same kinds of machines.
+struct Archive::Header
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t namesSize;
+};
+
+struct Archive::Entry
+{
+	uint64_t hash;
+	uint64_t offset;
+	uint64_t size;
+	uint64_t storedSize;
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	Compression compression;
+	uint32_t reserved;
+};
+
+static bool IsSeparator(const char &c)
+{
+	return c == '\\' || c == '/';
+}
+
+static bool SameCharacter(const char &a, const char &b)
+{
+	return a == b || (IsSeparator(a) && IsSeparator(b));
+}
+
+static uint64_t Align(const uint64_t &value, const uint64_t &alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+static void WriteLength(std::vector<char> &dst, std::size_t length)
+{
+	while (length >= 255)
+	{
+		dst.emplace_back(static_cast<char>(255));
+		length -= 255;
+	}
+
+	dst.emplace_back(static_cast<char>(length));
+}
+
+/**
+ * Compresses into the LZ4 block format with a greedy single probe matcher, favouring a fast build over ratio.
+ */
+static std::vector<char> CompressLz4(const char *src, const std::size_t &size)
+{
+	static const std::size_t MinMatch = 4;
+	static const std::size_t LastLiterals = 5;
+	static const std::size_t MatchLimit = 12;
+	static const std::size_t MaxOffset = 65535;
+	static const std::size_t NoPosition = std::numeric_limits<std::size_t>::max();
+
+	std::vector<char> dst;
+	dst.reserve(size + size / 255 + 16);
+	std::vector<std::size_t> table(1 << 16, NoPosition);
+
+	auto writeSequence = [&dst](const char *literals, const std::size_t &literalLength, const std::size_t &offset, const std::size_t &matchLength)
+	{
+		auto matchCode = matchLength - MinMatch;
+		dst.emplace_back(static_cast<char>((std::min<std::size_t>(literalLength, 15) << 4) | std::min<std::size_t>(matchCode, 15)));
+
+		if (literalLength >= 15)
+		{
+			WriteLength(dst, literalLength - 15);
+		}
+
+		dst.insert(dst.end(), literals, literals + literalLength);
+		dst.emplace_back(static_cast<char>(offset & 0xFF));
+		dst.emplace_back(static_cast<char>((offset >> 8) & 0xFF));
+
+		if (matchCode >= 15)
+		{
+			WriteLength(dst, matchCode - 15);
+		}
+	};
+
+	std::size_t anchor = 0;
+	std::size_t i = 0;
+
+	// The format requires the last match to start at least 12 bytes, and end at least 5 bytes, before the end of the block.
+	while (i + MatchLimit <= size)
+	{
+		uint32_t sequence;
+		std::memcpy(&sequence, src + i, sizeof(uint32_t));
+		auto hash = (sequence * 2654435761u) >> 16;
+		auto reference = table[hash];
+		table[hash] = i;
+
+		if (reference == NoPosition || i - reference > MaxOffset || std::memcmp(src + reference, src + i, MinMatch) != 0)
+		{
+			i++;
+			continue;
+		}
+
+		auto matchLength = MinMatch;
+
+		while (i + matchLength < size - LastLiterals && src[reference + matchLength] == src[i + matchLength])
+		{
+			matchLength++;
+		}
+
+		writeSequence(src + anchor, i - anchor, i - reference, matchLength);
+		i += matchLength;
+		anchor = i;
+	}
+
+	auto literalLength = size - anchor;
+	dst.emplace_back(static_cast<char>(std::min<std::size_t>(literalLength, 15) << 4));
+
+	if (literalLength >= 15)
+	{
+		WriteLength(dst, literalLength - 15);
+	}
+
+	dst.insert(dst.end(), src + anchor, src + size);
+	return dst;
+}
+
+static bool DecompressLz4(const uint8_t *src, const std::size_t &srcSize, uint8_t *dst, const std::size_t &dstSize)
+{
+	std::size_t ip = 0;
+	std::size_t op = 0;
+
+	auto readLength = [&](std::size_t &length)
+	{
+		uint8_t byte;
+
+		do
+		{
+			if (ip >= srcSize)
+			{
+				return false;
+			}
+
+			byte = src[ip++];
+			length += byte;
+		}
+		while (byte == 255);
+
+		return true;
+	};
+
+	while (ip < srcSize)
+	{
+		auto token = src[ip++];
+		std::size_t literalLength = token >> 4;
+
+		if (literalLength == 15 && !readLength(literalLength))
+		{
+			return false;
+		}
+
+		if (ip + literalLength > srcSize || op + literalLength > dstSize)
+		{
+			return false;
+		}
+
+		std::memcpy(dst + op, src + ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		// The last sequence only has literals.
+		if (ip == srcSize)
+		{
+			break;
+		}
+
+		if (ip + 2 > srcSize)
+		{
+			return false;
+		}
+
+		std::size_t offset = src[ip] | (src[ip + 1] << 8);
+		ip += 2;
+		std::size_t matchLength = token & 15;
+
+		if (matchLength == 15 && !readLength(matchLength))
+		{
+			return false;
+		}
+
+		matchLength += 4;
+
+		if (offset == 0 || offset > op || op + matchLength > dstSize)
+		{
+			return false;
+		}
+
+		// Matches may overlap the bytes they produce, so they are copied forwards byte by byte.
+		for (std::size_t j = 0; j < matchLength; j++, op++)
+		{
+			dst[op] = dst[op - offset];
+		}
+	}
+
+	return op == dstSize;
+}
+
+Archive::Archive(std::string filename) :
+	m_filename(std::move(filename)),
+	m_entries(nullptr),
+	m_names(nullptr),
+	m_namesSize(0),
+	m_entryCount(0)
+{
+	auto view = FileView::Map(m_filename);
+
+	if (!view || view->GetSize() < sizeof(Header))
+	{
+		Log::Error("Archive could not be opened: '%s'\n", m_filename.c_str());
+		return;
+	}
+
+	auto header = reinterpret_cast<const Header *>(view->GetData());
+
+	if (std::memcmp(header->magic, ArchiveMagic, sizeof(ArchiveMagic)) != 0 || header->version != ArchiveVersion)
+	{
+		Log::Error("Archive has a invalid header: '%s'\n", m_filename.c_str());
+		return;
+	}
+
+	auto namesOffset = sizeof(Header) + static_cast<uint64_t>(header->entryCount) * sizeof(Entry);
+
+	if (namesOffset + header->namesSize > view->GetSize())
+	{
+		Log::Error("Archive table of contents is truncated: '%s'\n", m_filename.c_str());
+		return;
+	}
+
+	m_entries = reinterpret_cast<const Entry *>(view->GetData() + sizeof(Header));
+	m_names = view->GetData() + namesOffset;
+	m_namesSize = header->namesSize;
+	m_entryCount = header->entryCount;
+	m_view = std::make_shared<const FileView>(std::move(*view));
+}
+
+bool Archive::IsArchive(const std::string &filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	Header header = {};
+
+	if (!file.read(reinterpret_cast<char *>(&header), sizeof(Header)))
+	{
+		return false;
+	}
+
+	return std::memcmp(header.magic, ArchiveMagic, sizeof(ArchiveMagic)) == 0;
+}
+
+bool Archive::Build(const std::string &filename, const std::string &root, const std::vector<std::string> &files, const bool &compress)
+{
+#if defined(ACID_VERBOSE)
+	auto debugStart = Engine::GetTime();
+#endif
+
+	std::vector<Entry> entries;
+	std::string names;
+
+	for (const auto &file : files)
+	{
+		Entry entry = {};
+		entry.hash = Hash(file);
+		entry.nameOffset = static_cast<uint32_t>(names.size());
+		entry.nameLength = static_cast<uint32_t>(file.size());
+		entries.emplace_back(entry);
+		names += file;
+	}
+
+	auto dataOffset = Align(sizeof(Header) + entries.size() * sizeof(Entry) + names.size(), ArchiveAlignment);
+
+	FileSystem::Create(filename);
+	std::ofstream outStream(filename, std::ios::binary | std::ios::trunc);
+
+	if (!outStream)
+	{
+		Log::Error("Archive could not be created: '%s'\n", filename.c_str());
+		return false;
+	}
+
+	// Entries are written in the order given, so files loaded together are read from contiguous pages.
+	auto offset = dataOffset;
+	std::vector<char> padding(ArchiveAlignment, 0);
+
+	for (std::size_t i = 0; i < files.size(); i++)
+	{
+		auto path = root + FileSystem::Separator + files[i];
+		auto view = FileView::Map(path);
+
+		if (!view)
+		{
+			Log::Error("Archive could not read file: '%s'\n", path.c_str());
+			return false;
+		}
+
+		auto &entry = entries[i];
+		entry.offset = offset;
+		entry.size = view->GetSize();
+		entry.storedSize = view->GetSize();
+		entry.compression = Compression::None;
+
+		std::vector<char> compressed;
+
+		if (compress && !view->IsEmpty())
+		{
+			compressed = CompressLz4(view->GetData(), view->GetSize());
+
+			// Entries that barely compress are stored as-is, so they can be read without a copy.
+			if (compressed.size() < view->GetSize() - view->GetSize() / 8)
+			{
+				entry.storedSize = compressed.size();
+				entry.compression = Compression::Lz4;
+			}
+		}
+
+		outStream.seekp(static_cast<std::streamoff>(offset));
+
+		if (entry.compression == Compression::Lz4)
+		{
+			outStream.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+		}
+		else
+		{
+			outStream.write(view->GetData(), static_cast<std::streamsize>(view->GetSize()));
+		}
+
+		offset = Align(offset + entry.storedSize, ArchiveAlignment);
+	}
+
+	// Pads the last entry, so every entry can be mapped as whole pages.
+	auto end = static_cast<uint64_t>(outStream.tellp());
+
+	if (end < offset)
+	{
+		outStream.write(padding.data(), static_cast<std::streamsize>(offset - end));
+	}
+
+	// The table of contents is sorted by hash for binary searching, this is independent from the data layout.
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+	{
+		return a.hash < b.hash;
+	});
+
+	Header header = {};
+	std::memcpy(header.magic, ArchiveMagic, sizeof(ArchiveMagic));
+	header.version = ArchiveVersion;
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	header.namesSize = static_cast<uint32_t>(names.size());
+
+	outStream.seekp(0);
+	outStream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+	outStream.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+	outStream.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+	if (!outStream)
+	{
+		Log::Error("Archive could not be written: '%s'\n", filename.c_str());
+		return false;
+	}
+
+#if defined(ACID_VERBOSE)
+	auto debugEnd = Engine::GetTime();
+	Log::Out("Archive '%s' built with %i files in %.3fms\n", filename.c_str(), static_cast<int32_t>(files.size()), (debugEnd - debugStart).AsMilliseconds<float>());
+#endif
+	return true;
+}
+
+bool Archive::Exists(const std::string &path) const
+{
+	return Find(path) != nullptr;
+}
+
+std::optional<FileView> Archive::Read(const std::string &path) const
+{
+	auto entry = Find(path);
+
+	if (entry == nullptr)
+	{
+		return {};
+	}
+
+	if (entry->offset > m_view->GetSize() || entry->storedSize > m_view->GetSize() - entry->offset)
+	{
+		Log::Error("Archive entry is out of bounds '%s' in '%s'\n", path.c_str(), m_filename.c_str());
+		return {};
+	}
+
+	switch (entry->compression)
+	{
+	case Compression::None:
+		return FileView::Slice(m_view, static_cast<std::size_t>(entry->offset), static_cast<std::size_t>(entry->size));
+	case Compression::Lz4:
+	{
+		auto view = FileView::Pool(static_cast<std::size_t>(entry->size));
+
+		if (!DecompressLz4(reinterpret_cast<const uint8_t *>(m_view->GetData() + entry->offset), static_cast<std::size_t>(entry->storedSize),
+			reinterpret_cast<uint8_t *>(view.GetBuffer()), view.GetSize()))
+		{
+			Log::Error("Archive entry could not be decompressed '%s' in '%s'\n", path.c_str(), m_filename.c_str());
+			return {};
+		}
+
+		return view;
+	}
+	default:
+		Log::Error("Archive entry has a unknown compression '%s' in '%s'\n", path.c_str(), m_filename.c_str());
+		return {};
+	}
+}
+
+std::vector<std::string> Archive::FilesInPath(const std::string &path, const bool &recursive) const
+{
+	std::vector<std::string> files;
+	std::string_view directory = path;
+
+	while (!directory.empty() && IsSeparator(directory.back()))
+	{
+		directory.remove_suffix(1);
+	}
+
+	for (uint32_t i = 0; i < m_entryCount; i++)
+	{
+		const auto &entry = m_entries[i];
+
+		if (static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > m_namesSize)
+		{
+			continue;
+		}
+
+		std::string_view name(m_names + entry.nameOffset, entry.nameLength);
+
+		if (!directory.empty())
+		{
+			if (name.size() <= directory.size() || !IsSeparator(name[directory.size()]) ||
+				!std::equal(directory.begin(), directory.end(), name.begin(), SameCharacter))
+			{
+				continue;
+			}
+
+			name.remove_prefix(directory.size() + 1);
+		}
+
+		if (!recursive && std::find_if(name.begin(), name.end(), IsSeparator) != name.end())
+		{
+			continue;
+		}
+
+		files.emplace_back(name);
+	}
+
+	return files;
+}
+
+uint64_t Archive::Hash(const std::string &path)
+{
+	// FNV-1a, with both separators hashed the same so paths written on any platform match.
+	uint64_t hash = 14695981039346656037ull;
+
+	for (auto c : path)
+	{
+		hash ^= static_cast<uint8_t>(c == '\\' ? '/' : c);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+const Archive::Entry *Archive::Find(const std::string &path) const
+{
+	if (m_view == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto hash = Hash(path);
+	auto end = m_entries + m_entryCount;
+	auto it = std::lower_bound(m_entries, end, hash, [](const Entry &entry, const uint64_t &value)
+	{
+		return entry.hash < value;
+	});
+
+	for (; it != end && it->hash == hash; ++it)
+	{
+		// Offsets come from the file, a name reaching past the names block is treated as a corrupt entry.
+		if (it->nameLength != path.size() || static_cast<uint64_t>(it->nameOffset) + it->nameLength > m_namesSize)
+		{
+			continue;
+		}
+
+		auto name = m_names + it->nameOffset;
+
+		if (std::equal(name, name + it->nameLength, path.begin(), SameCharacter))
+		{
+			return &*it;
+		}
+	}
+
+	return nullptr;
+}
+}
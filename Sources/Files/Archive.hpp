@@ -0,0 +1,86 @@
+#pragma once
+
+#include "FileView.hpp"
+
+namespace acid
+{
+/**
+ * @brief Class that represents a packed asset archive, mounted through {@link Files#AddSearchPath}.
+ * The archive starts with a table of contents sorted by path hash, followed by the entries each aligned to 4 KB and laid out in the order they were added.
+ * Entries can be stored as-is, in which case reading them is a slice of the memory mapped archive, or compressed in the LZ4 block format.
+ */
+class ACID_EXPORT Archive
+{
+public:
+	enum class Compression : uint32_t
+	{
+		None = 0, Lz4 = 1
+	};
+
+	/**
+	 * Opens and memory maps a archive.
+	 * @param filename The real path to the archive.
+	 */
+	explicit Archive(std::string filename);
+
+	/**
+	 * Gets if a file on disk is a archive, by reading its header.
+	 * @param filename The real path to the file.
+	 * @return If the file is a archive.
+	 */
+	static bool IsArchive(const std::string &filename);
+
+	/**
+	 * Packs files into a new archive.
+	 * @param filename The real path of the archive to write.
+	 * @param root The directory the files are read from, paths in the archive are relative to it.
+	 * @param files The relative paths of the files, in the order they are expected to be loaded.
+	 * @param compress If entries will be compressed when it makes them smaller.
+	 * @return If the archive was written.
+	 */
+	static bool Build(const std::string &filename, const std::string &root, const std::vector<std::string> &files, const bool &compress = true);
+
+	/**
+	 * Gets if a path is packed in this archive.
+	 * @param path The path to look for.
+	 * @return If the path is found.
+	 */
+	bool Exists(const std::string &path) const;
+
+	/**
+	 * Reads a packed file, uncompressed entries are returned without a copy.
+	 * @param path The path to read.
+	 * @return The view of the file, or nothing if it is not in this archive.
+	 */
+	std::optional<FileView> Read(const std::string &path) const;
+
+	/**
+	 * Finds the packed files in a directory.
+	 * @param path The directory to search, relative to the archive root.
+	 * @param recursive If files in sub directories are included.
+	 * @return The paths of the files, relative to the directory.
+	 */
+	std::vector<std::string> FilesInPath(const std::string &path, const bool &recursive) const;
+
+	const std::string &GetFilename() const { return m_filename; }
+
+	bool IsLoaded() const { return m_view != nullptr; }
+
+	uint32_t GetEntryCount() const { return m_entryCount; }
+
+private:
+	struct Header;
+	struct Entry;
+
+	static uint64_t Hash(const std::string &path);
+
+	const Entry *Find(const std::string &path) const;
+
+	std::string m_filename;
+	std::shared_ptr<const FileView> m_view;
+	const Entry *m_entries;
+	const char *m_names;
+	uint32_t m_namesSize;
+	uint32_t m_entryCount;
+};
+}
@@ -18,16 +18,13 @@ void File::Read()
 	auto debugStart = Engine::GetTime();
 #endif
 
-	if (Files::ExistsInPath(m_filename))
-	{
-		IFStream inStream(m_filename);
-		m_metadata->Load(&inStream);
-	}
-	else if (FileSystem::Exists(m_filename))
+	if (Files::ExistsInPath(m_filename) || FileSystem::Exists(m_filename))
 	{
-		std::ifstream inStream(m_filename);
-		m_metadata->Load(&inStream);
-		inStream.close();
+		if (auto fileLoaded = Files::ReadView(m_filename))
+		{
+			ViewStream inStream(*fileLoaded);
+			m_metadata->Load(&inStream);
+		}
 	}
 
 #if defined(ACID_VERBOSE)
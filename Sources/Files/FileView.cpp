@@ -0,0 +1,290 @@
+#include "FileView.hpp"
+
+#include <mutex>
+#if defined(ACID_BUILD_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace acid
+{
+class ViewBuffer :
+	public std::streambuf
+{
+public:
+	ViewBuffer(const char *data, const std::size_t &size)
+	{
+		// The get area is never written through, streambuf only requires a non-const pointer.
+		auto begin = const_cast<char *>(data);
+		setg(begin, begin, begin + size);
+	}
+
+private:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode mode) override
+	{
+		switch (dir)
+		{
+		case std::ios_base::beg:
+			return seekpos(off, mode);
+		case std::ios_base::cur:
+			return seekpos((gptr() - eback()) + off, mode);
+		case std::ios_base::end:
+			return seekpos((egptr() - eback()) + off, mode);
+		default:
+			return pos_type(off_type(-1));
+		}
+	}
+
+	pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override
+	{
+		if (!(mode & std::ios_base::in) || pos < 0 || pos > egptr() - eback())
+		{
+			return pos_type(off_type(-1));
+		}
+
+		setg(eback(), eback() + static_cast<off_type>(pos), egptr());
+		return pos;
+	}
+};
+
+/**
+ * Buffers released by archive views are kept here, so loading many files reuses the same allocations.
+ */
+class BufferPool
+{
+public:
+	static std::unique_ptr<std::vector<char>> Acquire(const std::size_t &size)
+	{
+		std::unique_ptr<std::vector<char>> buffer;
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+
+			// Takes the largest buffer, it is the most likely to already hold the size.
+			auto it = std::max_element(Buffers.begin(), Buffers.end(), [](const auto &a, const auto &b)
+			{
+				return a->capacity() < b->capacity();
+			});
+
+			if (it != Buffers.end())
+			{
+				buffer = std::move(*it);
+				Buffers.erase(it);
+			}
+		}
+
+		if (buffer == nullptr)
+		{
+			buffer = std::make_unique<std::vector<char>>();
+		}
+
+		buffer->resize(size);
+		return buffer;
+	}
+
+	static void Release(std::unique_ptr<std::vector<char>> buffer)
+	{
+		// Very large buffers are not kept around after the load that needed them.
+		if (buffer->capacity() > MaxBufferSize)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		if (Buffers.size() < MaxBuffers)
+		{
+			Buffers.emplace_back(std::move(buffer));
+		}
+	}
+
+private:
+	static constexpr std::size_t MaxBuffers = 8;
+	static constexpr std::size_t MaxBufferSize = 64 * 1024 * 1024;
+
+	static std::mutex Mutex;
+	static std::vector<std::unique_ptr<std::vector<char>>> Buffers;
+};
+
+std::mutex BufferPool::Mutex;
+std::vector<std::unique_ptr<std::vector<char>>> BufferPool::Buffers;
+
+FileView::FileView() :
+	m_data(nullptr),
+	m_size(0),
+	m_mapping(nullptr)
+{
+}
+
+FileView::FileView(FileView &&other) noexcept :
+	m_data(std::exchange(other.m_data, nullptr)),
+	m_size(std::exchange(other.m_size, 0)),
+	m_mapping(std::exchange(other.m_mapping, nullptr)),
+	m_buffer(std::move(other.m_buffer)),
+	m_owner(std::move(other.m_owner))
+{
+}
+
+FileView::~FileView()
+{
+	Release();
+}
+
+std::optional<FileView> FileView::Map(const std::string &filename)
+{
+	FileView view;
+
+#if defined(ACID_BUILD_WINDOWS)
+	auto file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return {};
+	}
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(file, &size))
+	{
+		CloseHandle(file);
+		return {};
+	}
+
+	// Empty files can't be mapped, but are still valid views.
+	if (size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return view;
+	}
+
+	auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+
+	if (mapping == nullptr)
+	{
+		return {};
+	}
+
+	auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (data == nullptr)
+	{
+		CloseHandle(mapping);
+		return {};
+	}
+
+	view.m_data = static_cast<const char *>(data);
+	view.m_size = static_cast<std::size_t>(size.QuadPart);
+	view.m_mapping = mapping;
+#else
+	auto file = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+
+	if (file == -1)
+	{
+		return {};
+	}
+
+	struct stat info;
+
+	if (fstat(file, &info) == -1 || !S_ISREG(info.st_mode))
+	{
+		close(file);
+		return {};
+	}
+
+	// Empty files can't be mapped, but are still valid views.
+	if (info.st_size == 0)
+	{
+		close(file);
+		return view;
+	}
+
+	auto data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+
+	if (data == MAP_FAILED)
+	{
+		return {};
+	}
+
+	// Loaders read files front to back, so the kernel can read ahead aggressively.
+	madvise(data, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+
+	view.m_data = static_cast<const char *>(data);
+	view.m_size = static_cast<std::size_t>(info.st_size);
+	view.m_mapping = data;
+#endif
+
+	return view;
+}
+
+FileView FileView::Pool(const std::size_t &size)
+{
+	FileView view;
+	view.m_buffer = BufferPool::Acquire(size);
+	view.m_data = view.m_buffer->data();
+	view.m_size = size;
+	return view;
+}
+
+FileView FileView::Slice(const std::shared_ptr<const FileView> &owner, const std::size_t &offset, const std::size_t &size)
+{
+	FileView view;
+	view.m_data = owner->m_data + offset;
+	view.m_size = size;
+	view.m_owner = owner;
+	return view;
+}
+
+FileView &FileView::operator=(FileView &&other) noexcept
+{
+	if (this != &other)
+	{
+		Release();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_mapping = std::exchange(other.m_mapping, nullptr);
+		m_buffer = std::move(other.m_buffer);
+		m_owner = std::move(other.m_owner);
+	}
+
+	return *this;
+}
+
+void FileView::Release()
+{
+	if (m_mapping != nullptr)
+	{
+#if defined(ACID_BUILD_WINDOWS)
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+#else
+		munmap(m_mapping, m_size);
+#endif
+	}
+
+	if (m_buffer != nullptr)
+	{
+		BufferPool::Release(std::move(m_buffer));
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping = nullptr;
+	m_owner = nullptr;
+}
+
+ViewStream::ViewStream(const FileView &view) :
+	std::istream(new ViewBuffer(view.GetData(), view.GetSize()))
+{
+}
+
+ViewStream::~ViewStream()
+{
+	delete rdbuf();
+}
+}
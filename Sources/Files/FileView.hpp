@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string_view>
+#include "StdAfx.hpp"
+
+namespace acid
+{
+/**
+ * @brief Class that holds a read-only view of a files contents without copying it into a string.
+ * Loose files on disk are memory mapped, files inside archives are decompressed once into a pooled buffer.
+ */
+class ACID_EXPORT FileView
+{
+public:
+	/**
+	 * Creates a empty file view.
+	 */
+	FileView();
+
+	FileView(const FileView &) = delete;
+
+	FileView(FileView &&other) noexcept;
+
+	~FileView();
+
+	/**
+	 * Memory maps a file on disk.
+	 * @param filename The real path to the file.
+	 * @return The view of the file, or nothing if it could not be mapped.
+	 */
+	static std::optional<FileView> Map(const std::string &filename);
+
+	/**
+	 * Takes a buffer from the pool that can be filled before it is viewed.
+	 * @param size The size of the buffer.
+	 * @return The view of the buffer, its contents can be written through {@link FileView#GetBuffer}.
+	 */
+	static FileView Pool(const std::size_t &size);
+
+	/**
+	 * Creates a view into part of another view, the other view is kept alive for as long as the slice exists.
+	 * @param owner The view being sliced.
+	 * @param offset The offset of the slice in the owner.
+	 * @param size The size of the slice.
+	 * @return The view of the slice.
+	 */
+	static FileView Slice(const std::shared_ptr<const FileView> &owner, const std::size_t &offset, const std::size_t &size);
+
+	const char *GetData() const { return m_data; }
+
+	std::size_t GetSize() const { return m_size; }
+
+	bool IsEmpty() const { return m_size == 0; }
+
+	/**
+	 * Gets the writable pooled buffer behind this view.
+	 * @return The buffer, or null if the view is memory mapped.
+	 */
+	char *GetBuffer() { return m_buffer != nullptr ? m_buffer->data() : nullptr; }
+
+	std::string_view GetString() const { return std::string_view(m_data, m_size); }
+
+	FileView &operator=(const FileView &) = delete;
+
+	FileView &operator=(FileView &&other) noexcept;
+
+private:
+	void Release();
+
+	const char *m_data;
+	std::size_t m_size;
+	void *m_mapping;
+	std::unique_ptr<std::vector<char>> m_buffer;
+	std::shared_ptr<const FileView> m_owner;
+};
+
+/**
+ * @brief Class that reads a file view as a input stream, without copying the viewed data.
+ */
+class ACID_EXPORT ViewStream :
+	public std::istream
+{
+public:
+	explicit ViewStream(const FileView &view);
+
+	virtual ~ViewStream();
+};
+}
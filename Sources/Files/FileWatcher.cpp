@@ -1,29 +1,199 @@
 #include "FileWatcher.hpp"
 
 #include <chrono>
+#if defined(ACID_BUILD_LINUX)
+#include <dirent.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#endif
+#include "Engine/Log.hpp"
 #include "FileSystem.hpp"
 
 namespace acid
 {
-FileWatcher::FileWatcher(std::string path, const Time &delay) :
+#if defined(ACID_BUILD_LINUX)
+struct FileWatcher::FileWatcherImpl
+{
+	/// The inotify instance handle.
+	int notify = -1;
+	/// Event handle used to wake the watch thread when the watcher is destroyed.
+	int wake = -1;
+	/// Watched directory paths by watch descriptor.
+	std::unordered_map<int, std::string> directories;
+	/// Directories moved away by the cookie of the move, so a matching move into the tree is known to be a rename.
+	std::unordered_map<uint32_t, std::string> moves;
+	/// Coalesced changes waiting for the debounce, with the time of their last event.
+	std::unordered_map<std::string, std::pair<Status, std::chrono::steady_clock::time_point>> pending;
+
+	void AddWatches(const std::string &path, const bool &reportFiles, std::vector<std::string> &created)
+	{
+		auto wd = inotify_add_watch(notify, path.c_str(), IN_CREATE | IN_CLOSE_WRITE | IN_MODIFY | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+
+		if (wd == -1)
+		{
+			Log::Error("Could not watch directory: '%s'!\n", path.c_str());
+			return;
+		}
+
+		directories[wd] = path;
+
+		auto dr = opendir(path.c_str());
+
+		if (dr == nullptr)
+		{
+			return;
+		}
+
+		struct dirent *de;
+
+		while ((de = readdir(dr)) != nullptr)
+		{
+			if (std::strcmp(de->d_name, ".") == 0 || std::strcmp(de->d_name, "..") == 0)
+			{
+				continue;
+			}
+
+			auto relPath = path + FileSystem::Separator + de->d_name;
+
+			if (FileSystem::IsDirectory(relPath))
+			{
+				AddWatches(relPath, reportFiles, created);
+			}
+			else if (reportFiles)
+			{
+				created.emplace_back(relPath);
+			}
+		}
+
+		closedir(dr);
+	}
+
+	/**
+	 * Stops watching a directory and everything below it, a moved directory keeps its watches at its new location.
+	 * @param path The directory path.
+	 */
+	void RemoveWatches(const std::string &path)
+	{
+		for (auto it = directories.begin(); it != directories.end();)
+		{
+			if (it->second == path || (it->second.size() > path.size() && it->second.compare(0, path.size(), path) == 0 &&
+				it->second[path.size()] == FileSystem::Separator))
+			{
+				inotify_rm_watch(notify, it->first);
+				it = directories.erase(it);
+				continue;
+			}
+
+			++it;
+		}
+	}
+
+	void Queue(const std::string &path, const Status &status)
+	{
+		auto now = std::chrono::steady_clock::now();
+		auto it = pending.find(path);
+
+		if (it == pending.end())
+		{
+			pending.emplace(path, std::make_pair(status, now));
+			return;
+		}
+
+		auto &[previous, time] = it->second;
+		time = now;
+
+		// Merges the new event into the one already waiting, so bursts of writes are sent as a single change.
+		if (previous == Status::Created && status == Status::Erased)
+		{
+			pending.erase(it);
+		}
+		else if (previous == Status::Erased && status == Status::Created)
+		{
+			previous = Status::Modified;
+		}
+		else if (previous != Status::Created)
+		{
+			previous = status;
+		}
+	}
+};
+#else
+struct FileWatcher::FileWatcherImpl
+{
+};
+#endif
+
+FileWatcher::FileWatcher(std::string path, const Time &delay, const Time &debounce) :
 	m_path(std::move(path)),
 	m_delay(delay),
-	m_thread(&FileWatcher::QueueLoop, this),
+	m_debounce(debounce),
+	m_impl(std::make_unique<FileWatcherImpl>()),
 	m_running(true)
 {
+#if defined(ACID_BUILD_LINUX)
+	m_impl->notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	m_impl->wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (m_impl->notify != -1 && m_impl->wake != -1)
+	{
+		std::vector<std::string> created;
+		m_impl->AddWatches(m_path, false, created);
+		m_thread = std::thread(&FileWatcher::WatchLoop, this);
+		return;
+	}
+
+	Log::Error("Could not create inotify instance, falling back to polling: '%s'!\n", m_path.c_str());
+#endif
+
 	for (auto &file : FileSystem::FilesInPath(m_path))
 	{
 		m_paths[file] = FileSystem::LastModified(file);
 	}
+
+	m_thread = std::thread(&FileWatcher::QueueLoop, this);
 }
 
 FileWatcher::~FileWatcher()
 {
+	m_running = false;
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_impl->wake != -1)
+	{
+		uint64_t value = 1;
+		ssize_t written;
+
+		do
+		{
+			written = write(m_impl->wake, &value, sizeof(value));
+		}
+		while (written == -1 && errno == EINTR);
+
+		if (written != sizeof(value))
+		{
+			Log::Error("Failed to wake file watcher thread: '%s'!\n", m_path.c_str());
+		}
+	}
+#endif
+
 	if (m_thread.joinable())
 	{
-		m_running = false;
 		m_thread.join();
 	}
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_impl->notify != -1)
+	{
+		close(m_impl->notify);
+	}
+
+	if (m_impl->wake != -1)
+	{
+		close(m_impl->wake);
+	}
+#endif
 }
 
 void FileWatcher::QueueLoop()
@@ -70,6 +240,160 @@ void FileWatcher::QueueLoop()
 	}
 }
 
+void FileWatcher::WatchLoop()
+{
+#if defined(ACID_BUILD_LINUX)
+	alignas(inotify_event) char buffer[16 * 1024];
+	std::vector<std::string> created;
+
+	while (m_running)
+	{
+		// Sleeps until an event arrives, only waking early to flush changes that are being debounced.
+		auto timeout = -1;
+
+		if (!m_impl->pending.empty())
+		{
+			auto oldest = std::chrono::steady_clock::time_point::max();
+
+			for (const auto &[path, change] : m_impl->pending)
+			{
+				oldest = std::min(oldest, change.second);
+			}
+
+			auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(oldest + std::chrono::microseconds(m_debounce.AsMicroseconds()) -
+				std::chrono::steady_clock::now()).count();
+			timeout = static_cast<int>(std::max<int64_t>(remaining, 0));
+		}
+
+		pollfd fds[2] = {{m_impl->notify, POLLIN, 0}, {m_impl->wake, POLLIN, 0}};
+
+		if (poll(fds, 2, timeout) == -1 && errno != EINTR)
+		{
+			Log::Error("Failed to poll inotify events: '%s'!\n", m_path.c_str());
+			break;
+		}
+
+		if (!m_running)
+		{
+			break;
+		}
+
+		ssize_t length;
+
+		while ((length = read(m_impl->notify, buffer, sizeof(buffer))) > 0)
+		{
+			for (auto ptr = buffer; ptr < buffer + length;)
+			{
+				auto event = reinterpret_cast<const inotify_event *>(ptr);
+				ptr += sizeof(inotify_event) + event->len;
+
+				// Events were dropped, every file is sent as modified and any new directories are watched.
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					Log::Error("File watcher event queue overflowed, rescanning: '%s'!\n", m_path.c_str());
+					created.clear();
+					m_impl->AddWatches(m_path, true, created);
+
+					for (const auto &file : created)
+					{
+						m_impl->Queue(file, Status::Modified);
+					}
+
+					continue;
+				}
+
+				if (event->mask & IN_IGNORED)
+				{
+					m_impl->directories.erase(event->wd);
+					continue;
+				}
+
+				auto directory = m_impl->directories.find(event->wd);
+
+				if (directory == m_impl->directories.end() || event->len == 0)
+				{
+					continue;
+				}
+
+				auto path = directory->second + FileSystem::Separator + event->name;
+
+				if (event->mask & IN_ISDIR)
+				{
+					// New directories are watched and the files already inside them are reported, since they were written before the watch existed.
+					if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					{
+						created.clear();
+						m_impl->AddWatches(path, true, created);
+
+						// A directory renamed inside the tree also erases its files from their old paths.
+						auto move = m_impl->moves.find(event->cookie);
+
+						if ((event->mask & IN_MOVED_TO) && move != m_impl->moves.end())
+						{
+							for (const auto &file : created)
+							{
+								m_impl->Queue(move->second + file.substr(path.size()), Status::Erased);
+							}
+
+							m_impl->moves.erase(move);
+						}
+
+						for (const auto &file : created)
+						{
+							m_impl->Queue(file, Status::Created);
+						}
+					}
+					else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+					{
+						// A deleted directory has already sent its files, the files of a directory moved out of the tree can't be listed so the directory is sent.
+						if (event->mask & IN_MOVED_FROM)
+						{
+							m_impl->RemoveWatches(path);
+							m_impl->moves[event->cookie] = path;
+						}
+
+						m_impl->Queue(path, Status::Erased);
+					}
+
+					continue;
+				}
+
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					m_impl->Queue(path, Status::Created);
+				}
+				else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+				{
+					m_impl->Queue(path, Status::Erased);
+				}
+				else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+				{
+					m_impl->Queue(path, Status::Modified);
+				}
+			}
+		}
+
+		// Both halves of a rename are read together, any move left was out of the tree.
+		m_impl->moves.clear();
+
+		// Sends every change that has been quiet for the debounce time.
+		auto now = std::chrono::steady_clock::now();
+
+		for (auto it = m_impl->pending.begin(); it != m_impl->pending.end();)
+		{
+			if (now - it->second.second < std::chrono::microseconds(m_debounce.AsMicroseconds()))
+			{
+				++it;
+				continue;
+			}
+
+			m_onChange(it->first, it->second.first);
+			it = m_impl->pending.erase(it);
+		}
+	}
+#endif
+}
+
 bool FileWatcher::Contains(const std::string &key) const
 {
 	auto el = m_paths.find(key);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include "Maths/Time.hpp"
 #include "Helpers/Delegate.hpp"
@@ -8,6 +9,8 @@ namespace acid
 {
 /**
  * @brief Class that can listen to file changes on a path recursively.
+ * On Linux changes are received from inotify, on other platforms the path is rescanned every delay.
+ * If inotify drops events because its queue overflowed, every file under the path is sent as modified.
  */
 class ACID_EXPORT FileWatcher
 {
@@ -20,9 +23,10 @@ public:
 	/**
 	 * Creates a new file watcher.
 	 * @param path The path to watch recursively.
-	 * @param delay How frequently to check for changes.
+	 * @param delay How frequently to check for changes when polling.
+	 * @param debounce How long a path must be quiet before its coalesced change is sent, when using events.
 	 */
-	explicit FileWatcher(std::string path, const Time &delay = Time::Seconds(5.0f));
+	explicit FileWatcher(std::string path, const Time &delay = Time::Seconds(5.0f), const Time &debounce = Time::Milliseconds(100));
 
 	~FileWatcher();
 
@@ -34,6 +38,10 @@ public:
 
 	void SetDelay(const Time &delay) { m_delay = delay; }
 
+	const Time &GetDebounce() const { return m_debounce; }
+
+	void SetDebounce(const Time &debounce) { m_debounce = debounce; }
+
 	/**
 	 * Called when a file or directory has changed.
 	 * @return The delegate.
@@ -41,16 +49,22 @@ public:
 	Delegate<void(std::string, Status)> &OnChange() { return m_onChange; }
 
 private:
+	struct FileWatcherImpl;
+
 	void QueueLoop();
 
+	void WatchLoop();
+
 	bool Contains(const std::string &key) const;
 
 	std::string m_path;
 	Time m_delay;
+	Time m_debounce;
 	Delegate<void(std::string, Status)> m_onChange;
 
-	std::thread m_thread;
+	std::unique_ptr<FileWatcherImpl> m_impl;
 	std::unordered_map<std::string, long> m_paths;
-	bool m_running;
+	std::atomic<bool> m_running;
+	std::thread m_thread;
 };
 }
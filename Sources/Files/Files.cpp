@@ -226,6 +226,21 @@ void Files::AddSearchPath(const std::string &path)
 		return;
 	}
 
+	if (FileSystem::IsFile(path) && Archive::IsArchive(path))
+	{
+		auto archive = std::make_shared<const Archive>(path);
+
+		if (!archive->IsLoaded())
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_archivesMutex);
+		m_archives.emplace_back(std::move(archive));
+		m_searchPaths.emplace_back(path);
+		return;
+	}
+
 	if (PHYSFS_mount(path.c_str(), nullptr, true) == 0)
 	{
 		Log::Error("File System error while adding a path or zip(%s): %s\n", path.c_str(), PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
@@ -244,6 +259,21 @@ void Files::RemoveSearchPath(const std::string &path)
 		return;
 	}
 
+	{
+		std::lock_guard<std::mutex> lock(m_archivesMutex);
+		auto archive = std::find_if(m_archives.begin(), m_archives.end(), [&path](const std::shared_ptr<const Archive> &archive)
+		{
+			return archive->GetFilename() == path;
+		});
+
+		if (archive != m_archives.end())
+		{
+			m_archives.erase(archive);
+			m_searchPaths.erase(it);
+			return;
+		}
+	}
+
 	if (PHYSFS_unmount(path.c_str()) == 0)
 	{
 		Log::Error("File System error while removing a path: %s\n", path.c_str(), PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
@@ -263,6 +293,11 @@ void Files::ClearSearchPath()
 
 bool Files::ExistsInPath(const std::string &path)
 {
+	if (FindArchive(path) != nullptr)
+	{
+		return true;
+	}
+
 	if (PHYSFS_isInit() == 0)
 	{
 		return false;
@@ -273,6 +308,16 @@ bool Files::ExistsInPath(const std::string &path)
 
 std::optional<std::string> Files::Read(const std::string &path)
 {
+	if (auto archive = FindArchive(path))
+	{
+		if (auto view = archive->Read(path))
+		{
+			return std::string(view->GetData(), view->GetSize());
+		}
+
+		return {};
+	}
+
 	auto fsFile = PHYSFS_openRead(path.c_str());
 
 	if (fsFile == nullptr)
@@ -298,10 +343,85 @@ std::optional<std::string> Files::Read(const std::string &path)
 	return std::string(data.begin(), data.end());
 }
 
+std::optional<FileView> Files::ReadView(const std::string &path)
+{
+	if (auto archive = FindArchive(path))
+	{
+		return archive->Read(path);
+	}
+
+	if (PHYSFS_isInit() != 0 && PHYSFS_exists(path.c_str()) != 0)
+	{
+		// When the file is found in a directory search path it is mapped directly from disk.
+		auto realDir = PHYSFS_getRealDir(path.c_str());
+
+		if (realDir != nullptr && FileSystem::IsDirectory(realDir))
+		{
+			if (auto view = FileView::Map(std::string(realDir) + FileSystem::Separator + path))
+			{
+				return view;
+			}
+		}
+
+		// Files inside archives are decompressed once into a pooled buffer.
+		auto fsFile = PHYSFS_openRead(path.c_str());
+
+		if (fsFile == nullptr)
+		{
+			Log::Error("Error while opening file to load %s: %s\n", path.c_str(), PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
+			return {};
+		}
+
+		auto size = PHYSFS_fileLength(fsFile);
+		auto view = FileView::Pool(static_cast<std::size_t>(size));
+		auto bytesRead = PHYSFS_readBytes(fsFile, view.GetBuffer(), static_cast<PHYSFS_uint64>(size));
+
+		if (PHYSFS_close(fsFile) == 0)
+		{
+			Log::Error("Error while closing file %s: %s\n", path.c_str(), PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
+		}
+
+		if (bytesRead != size)
+		{
+			Log::Error("Error while reading file %s: %s\n", path.c_str(), PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
+			return {};
+		}
+
+		return view;
+	}
+
+	if (!FileSystem::Exists(path) || !FileSystem::IsFile(path))
+	{
+		Log::Error("Error while opening file to load %s\n", path.c_str());
+		return {};
+	}
+
+	return FileView::Map(path);
+}
+
 std::vector<std::string> Files::FilesInPath(const std::string &path, const bool &recursive)
 {
 	std::vector<std::string> files;
+
+	// PhysFS can't see into packed archives, their files are listed from the table of contents.
+	for (const auto &archive : GetArchives())
+	{
+		auto archiveFiles = archive->FilesInPath(path, recursive);
+		files.insert(files.end(), archiveFiles.begin(), archiveFiles.end());
+	}
+
+	if (PHYSFS_isInit() == 0)
+	{
+		return files;
+	}
+
 	auto rc = PHYSFS_enumerateFiles(path.c_str());
+
+	if (rc == nullptr)
+	{
+		return files;
+	}
+
 	char **i;
 
 	for (i = rc; *i != nullptr; i++)
@@ -321,9 +441,45 @@ std::vector<std::string> Files::FilesInPath(const std::string &path, const bool
 	}
 
 	PHYSFS_freeList(rc);
+
+	// A file in both an archive and a directory search path is listed once.
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
 	return files;
 }
 
+std::vector<std::shared_ptr<const Archive>> Files::GetArchives()
+{
+	// File reads can happen before the engine or this module exist, in which case there are no archives mounted.
+	if (Engine::Get() == nullptr)
+	{
+		return {};
+	}
+
+	auto files = Get();
+
+	if (files == nullptr)
+	{
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(files->m_archivesMutex);
+	return files->m_archives;
+}
+
+std::shared_ptr<const Archive> Files::FindArchive(const std::string &path)
+{
+	for (auto &archive : GetArchives())
+	{
+		if (archive->Exists(path))
+		{
+			return archive;
+		}
+	}
+
+	return nullptr;
+}
+
 std::istream &Files::SafeGetLine(std::istream &is, std::string &t)
 {
 	t.clear();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Engine/Engine.hpp"
+#include "Archive.hpp"
+#include "FileView.hpp"
 
 struct PHYSFS_File;
 
@@ -73,7 +75,7 @@ public:
 	void Update() override;
 
 	/**
-	 * Adds an file search path.
+	 * Adds an file search path, packed archives built with {@link Archive#Build} are mounted ahead of other search paths.
 	 * @param path The path to add.
 	 */
 	void AddSearchPath(const std::string &path);
@@ -104,7 +106,14 @@ public:
 	static std::optional<std::string> Read(const std::string &path);
 
 	/**
-	 * Finds all the files in a path.
+	 * Reads a file found by real or partial path without copying it, loose files are memory mapped.
+	 * @param path The path to read.
+	 * @return The read-only view of the file.
+	 */
+	static std::optional<FileView> ReadView(const std::string &path);
+
+	/**
+	 * Finds all the files in a path, including files packed in mounted archives.
 	 * @param path The path to search.
 	 * @param recursive If paths will be recursively searched.
 	 * @return The files found.
@@ -120,6 +129,17 @@ public:
 	static std::istream &SafeGetLine(std::istream &is, std::string &t);
 
 private:
+	/**
+	 * Copies the list of mounted archives, so they can be searched while search paths change on another thread.
+	 * @return The mounted archives, in search order.
+	 */
+	static std::vector<std::shared_ptr<const Archive>> GetArchives();
+
+	static std::shared_ptr<const Archive> FindArchive(const std::string &path);
+
 	std::vector<std::string> m_searchPaths;
+	/// Loader threads read the archives while they are mounted and unmounted, a removed archive lives until its last reader is done.
+	std::vector<std::shared_ptr<const Archive>> m_archives;
+	std::mutex m_archivesMutex;
 };
 }
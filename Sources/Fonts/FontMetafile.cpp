@@ -7,6 +7,7 @@
 namespace acid
 {
 FontMetafile::FontMetafile(std::string filename) :
+	m_asciiCharacters(),
 	m_filename(std::move(filename)),
 	m_verticalPerPixelSize(0.0f),
 	m_horizontalPerPixelSize(0.0f),
@@ -16,8 +17,16 @@ FontMetafile::FontMetafile(std::string filename) :
 	m_paddingHeight(0),
 	m_maxSizeY(0.0f)
 {
-	IFStream inStream(m_filename);
+	// Read through the file views, so metafiles packed in archives are found too.
+	auto fileLoaded = Files::ReadView(m_filename);
 
+	if (!fileLoaded)
+	{
+		Log::Error("Font metafile could not be loaded: '%s'\n", m_filename.c_str());
+		return;
+	}
+
+	ViewStream inStream(*fileLoaded);
 	size_t lineNum = 0;
 	std::string linebuf;
 
@@ -41,18 +50,44 @@ FontMetafile::FontMetafile(std::string filename) :
 			LoadCharacterData();
 		}
 	}
+
+	// Map nodes don't move, so the table can point into the map.
+	for (const auto &[id, character] : m_characters)
+	{
+		if (id >= 0 && id < static_cast<int32_t>(m_asciiCharacters.size()))
+		{
+			m_asciiCharacters[id] = &character;
+		}
+	}
 }
 
 std::optional<FontMetafile::Character> FontMetafile::GetCharacter(const int32_t &ascii) const
 {
+	auto character = FindCharacter(ascii);
+
+	if (character != nullptr)
+	{
+		return *character;
+	}
+
+	return {};
+}
+
+const FontMetafile::Character *FontMetafile::FindCharacter(const int32_t &ascii) const
+{
+	if (ascii >= 0 && ascii < static_cast<int32_t>(m_asciiCharacters.size()))
+	{
+		return m_asciiCharacters[ascii];
+	}
+
 	auto it = m_characters.find(ascii);
 
 	if (it != m_characters.end())
 	{
-		return it->second;
+		return &it->second;
 	}
 
-	return {};
+	return nullptr;
 }
 
 void FontMetafile::ProcessNextLine(const std::string &line)
@@ -73,6 +73,13 @@ public:
 
 	std::optional<Character> GetCharacter(const int32_t &ascii) const;
 
+	/**
+	 * Finds a character without copying it, ASCII characters are found with a single table lookup.
+	 * @param ascii The character code.
+	 * @return The character, or null if the font doesn't have it.
+	 */
+	const Character *FindCharacter(const int32_t &ascii) const;
+
 	const std::string &GetFileName() const { return m_filename; }
 
 	const float &GetSpaceWidth() const { return m_spaceWidth; }
@@ -118,6 +125,7 @@ private:
 	std::vector<int32_t> GetValuesOfVariable(const std::string &variable);
 
 	std::map<int32_t, Character> m_characters;
+	std::array<const Character *, 128> m_asciiCharacters;
 	std::map<std::string, std::string> m_values;
 
 	std::string m_filename;
@@ -2,6 +2,7 @@
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include "Engine/Profiler.hpp"
 #include "Resources/Resources.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Text.hpp"
@@ -41,6 +42,7 @@ FontType::FontType(std::string filename, std::string style, const bool &load) :
 	m_style(std::move(style)),
 	m_texture(nullptr),
 	m_metadata(nullptr),
+	m_atlas(nullptr),
 	m_storageGlyphs(nullptr),
 	m_instanceBuffer(nullptr),
 	m_glyphInstances(nullptr),
@@ -143,8 +145,61 @@ bool FontType::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraph
 	return true;
 }
 
+GlyphAtlas *FontType::GetAtlas()
+{
+	if (m_atlas == nullptr && !m_filename.empty() && !m_style.empty())
+	{
+		m_atlas = std::make_unique<GlyphAtlas>(m_filename + "/" + m_style + ".ttf");
+	}
+
+	return m_atlas.get();
+}
+
+void FontType::UpdateAtlas()
+{
+	if (m_atlas == nullptr)
+	{
+		return;
+	}
+
+	m_atlas->Update();
+	auto &pages = m_atlas->GetPages();
+
+	for (std::size_t i = 0; i < pages.size(); i++)
+	{
+		auto &page = *pages[i];
+
+		if (i >= m_atlasPages.size())
+		{
+			m_atlasPages.emplace_back(std::make_unique<Image2d>(page.m_packer.GetWidth(), page.m_packer.GetHeight(), nullptr, VK_FORMAT_R8_UNORM,
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT));
+		}
+
+		if (!page.m_dirty)
+		{
+			continue;
+		}
+
+		// Only the changed region of the page is copied.
+		auto &region = *page.m_dirty;
+		std::vector<uint8_t> pixels(static_cast<std::size_t>(region.m_width) * region.m_height);
+
+		for (uint32_t y = 0; y < region.m_height; y++)
+		{
+			std::memcpy(&pixels[y * region.m_width], &page.m_pixels[(region.m_y + y) * page.m_packer.GetWidth() + region.m_x], region.m_width);
+		}
+
+		m_atlasPages[i]->SetPixels(pixels.data(), pixels.size(), VkOffset3D{static_cast<int32_t>(region.m_x), static_cast<int32_t>(region.m_y), 0},
+			VkExtent3D{region.m_width, region.m_height, 1});
+	}
+
+	m_atlas->ClearDirty();
+}
+
 void FontType::Load()
 {
+	ACID_PROFILE_ZONE("FontType::Load");
+
 	if (m_filename.empty() || m_style.empty())
 	{
 		return;
@@ -8,7 +8,10 @@
 #include "Renderer/Images/Image2d.hpp"
 #include "Renderer/Pipelines/PipelineGraphics.hpp"
 #include "FontMetafile.hpp"
+#include "GlyphAtlas.hpp"
+#include "GlyphRun.hpp"
 #include "Outline.hpp"
+#include "TextBatch.hpp"
 
 namespace acid
 {
@@ -60,6 +63,32 @@ public:
 
 	const FontMetafile *GetMetadata() const { return m_metadata.get(); }
 
+	/**
+	 * Gets the cache of strings laid out with this font.
+	 * @return The glyph run cache.
+	 */
+	GlyphRunCache &GetGlyphRuns() { return m_glyphRuns; }
+
+	/**
+	 * Gets the batch holding the glyphs of every text using this font.
+	 * @return The text batch.
+	 */
+	TextBatch &GetTextBatch() { return m_textBatch; }
+
+	/**
+	 * Gets the atlas glyphs outside of the prebaked atlas are rasterized into, created from the font file when first used.
+	 * @return The glyph atlas, or null if the font has no file.
+	 */
+	GlyphAtlas *GetAtlas();
+
+	const std::vector<std::unique_ptr<Image2d>> &GetAtlasPages() const { return m_atlasPages; }
+
+	/**
+	 * Packs the atlas glyphs rasterized since the last update and uploads the changed region of each page.
+	 * The upload waits for the copy to finish, so it must be called before the render stage starts recording.
+	 */
+	void UpdateAtlas();
+
 private:
 	struct CellInfo
 	{
@@ -111,6 +140,10 @@ private:
 
 	std::shared_ptr<Image2d> m_texture;
 	std::unique_ptr<FontMetafile> m_metadata;
+	GlyphRunCache m_glyphRuns;
+	TextBatch m_textBatch;
+	std::unique_ptr<GlyphAtlas> m_atlas;
+	std::vector<std::unique_ptr<Image2d>> m_atlasPages;
 
 	DescriptorsHandler m_descriptorSet;
 	std::unique_ptr<StorageBuffer> m_storageGlyphs;
@@ -0,0 +1,437 @@
+#include "GlyphAtlas.hpp"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "Files/Files.hpp"
+#include "Helpers/String.hpp"
+#include "FontMetafile.hpp"
+
+namespace acid
+{
+static const uint32_t MAX_WORKERS = 4;
+static const float DISTANCE_INFINITY = 1e20f;
+
+GlyphAtlas::GlyphAtlas(const std::string &filename, const uint32_t &glyphSize, const uint32_t &spread, const uint32_t &pageSize, const uint32_t &maxPages) :
+	m_glyphSize(glyphSize),
+	m_spread(spread),
+	m_pageSize(pageSize),
+	m_maxPages(std::max(maxPages, 1u)),
+	m_lineHeight(0.0f),
+	m_ascender(0.0f),
+	m_scale(0.0f),
+	m_library(nullptr),
+	m_frame(0),
+	m_pending(0),
+	m_evictions(0),
+	m_workers(std::clamp(std::thread::hardware_concurrency(), 1u, MAX_WORKERS))
+{
+	auto fileLoaded = Files::Read(filename);
+
+	if (!fileLoaded)
+	{
+		Log::Error("Font could not be loaded: '%s'\n", filename.c_str());
+		return;
+	}
+
+	// Faces read from this memory for as long as they live.
+	m_fileData = std::move(*fileLoaded);
+
+	if (FT_Init_FreeType(&m_library) != 0)
+	{
+		throw std::runtime_error("Freetype failed to initialize");
+	}
+
+	for (std::size_t i = 0; i < m_workers.GetWorkers().size(); i++)
+	{
+		FT_Face face;
+
+		if (FT_New_Memory_Face(m_library, reinterpret_cast<const FT_Byte *>(m_fileData.data()), static_cast<FT_Long>(m_fileData.size()), 0, &face) != 0)
+		{
+			throw std::runtime_error("Freetype failed to create face from memory");
+		}
+
+		if (FT_Set_Pixel_Sizes(face, 0, m_glyphSize) != 0)
+		{
+			throw std::runtime_error("Freetype failed to set pixel size");
+		}
+
+		m_faces.emplace_back(face);
+	}
+
+	m_freeFaces = m_faces;
+	m_lineHeight = m_faces[0]->size->metrics.height / 64.0f;
+	m_ascender = m_faces[0]->size->metrics.ascender / 64.0f;
+	m_scale = FontMetafile::LineHeight / m_lineHeight;
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	// Workers may still be using the faces.
+	{
+		std::unique_lock<std::mutex> lock(m_finishedMutex);
+		m_finishedCondition.wait(lock, [this]()
+		{
+			return m_finished.size() >= m_pending;
+		});
+	}
+
+	for (auto &face : m_faces)
+	{
+		FT_Done_Face(face);
+	}
+
+	if (m_library != nullptr)
+	{
+		FT_Done_FreeType(m_library);
+	}
+}
+
+const GlyphAtlas::Glyph *GlyphAtlas::Find(const char32_t &codepoint)
+{
+	auto it = m_glyphs.find(codepoint);
+
+	if (it == m_glyphs.end())
+	{
+		if (IsLoaded())
+		{
+			m_glyphs.emplace(codepoint, Entry{std::nullopt, m_frame});
+			m_pending++;
+			m_workers.Enqueue([this, codepoint]()
+			{
+				Rasterize(codepoint);
+			});
+		}
+
+		return nullptr;
+	}
+
+	auto &entry = it->second;
+	entry.m_lastUsed = m_frame;
+
+	if (!entry.m_glyph)
+	{
+		return nullptr;
+	}
+
+	if (entry.m_glyph->m_sizeX != 0.0f)
+	{
+		m_pages[entry.m_glyph->m_page]->m_lastUsed = m_frame;
+	}
+
+	return &*entry.m_glyph;
+}
+
+void GlyphAtlas::Request(std::string_view string)
+{
+	for (const auto &codepoint : String::ToUtf32(string))
+	{
+		Find(codepoint);
+	}
+}
+
+void GlyphAtlas::Update()
+{
+	m_frame++;
+	std::vector<Bitmap> finished;
+
+	{
+		std::unique_lock<std::mutex> lock(m_finishedMutex);
+		finished.swap(m_finished);
+	}
+
+	for (const auto &bitmap : finished)
+	{
+		m_pending--;
+		Place(bitmap);
+	}
+}
+
+void GlyphAtlas::Wait()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_finishedMutex);
+		m_finishedCondition.wait(lock, [this]()
+		{
+			return m_finished.size() >= m_pending;
+		});
+	}
+
+	Update();
+}
+
+void GlyphAtlas::ClearDirty()
+{
+	for (auto &page : m_pages)
+	{
+		page->m_dirty = std::nullopt;
+	}
+}
+
+std::size_t GlyphAtlas::GetMemoryUsage() const
+{
+	// Each table entry is a node holding the key, the entry, and the next pointer, plus a bucket pointer.
+	auto entrySize = sizeof(char32_t) + sizeof(Entry) + 2 * sizeof(void *);
+	return m_pages.size() * static_cast<std::size_t>(m_pageSize) * m_pageSize + m_glyphs.size() * entrySize;
+}
+
+void GlyphAtlas::Rasterize(const char32_t &codepoint)
+{
+	FT_Face face;
+
+	{
+		std::unique_lock<std::mutex> lock(m_facesMutex);
+		face = m_freeFaces.back();
+		m_freeFaces.pop_back();
+	}
+
+	auto bitmap = Bitmap{codepoint, 0, 0, {}, 0.0f, 0.0f, 0.0f};
+
+	if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER) == 0)
+	{
+		auto glyph = face->glyph;
+		bitmap.m_advance = glyph->advance.x / 64.0f;
+
+		if (glyph->bitmap.width != 0 && glyph->bitmap.rows != 0)
+		{
+			bitmap.m_width = glyph->bitmap.width + 2 * m_spread;
+			bitmap.m_height = glyph->bitmap.rows + 2 * m_spread;
+			bitmap.m_pixels = DistanceField(glyph->bitmap.buffer, glyph->bitmap.width, glyph->bitmap.rows, glyph->bitmap.pitch, m_spread);
+			bitmap.m_left = static_cast<float>(glyph->bitmap_left) - m_spread;
+			bitmap.m_top = static_cast<float>(glyph->bitmap_top) + m_spread;
+		}
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_facesMutex);
+		m_freeFaces.emplace_back(face);
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_finishedMutex);
+		m_finished.emplace_back(std::move(bitmap));
+	}
+
+	m_finishedCondition.notify_all();
+}
+
+/**
+ * The squared distance transform of a sampled function in one dimension, from Felzenszwalb and Huttenlocher.
+ */
+static void DistanceTransform(const float *f, float *d, int32_t *v, float *z, const int32_t &n)
+{
+	auto k = 0;
+	v[0] = 0;
+	z[0] = -DISTANCE_INFINITY;
+	z[1] = DISTANCE_INFINITY;
+
+	for (auto q = 1; q < n; q++)
+	{
+		auto s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+
+		while (s <= z[k])
+		{
+			k--;
+			s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+		}
+
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = DISTANCE_INFINITY;
+	}
+
+	k = 0;
+
+	for (auto q = 0; q < n; q++)
+	{
+		while (z[k + 1] < q)
+		{
+			k++;
+		}
+
+		d[q] = static_cast<float>((q - v[k]) * (q - v[k])) + f[v[k]];
+	}
+}
+
+static void DistanceTransform(std::vector<float> &grid, const int32_t &width, const int32_t &height)
+{
+	auto length = std::max(width, height);
+	std::vector<float> f(length);
+	std::vector<float> d(length);
+	std::vector<int32_t> v(length);
+	std::vector<float> z(length + 1);
+
+	for (auto x = 0; x < width; x++)
+	{
+		for (auto y = 0; y < height; y++)
+		{
+			f[y] = grid[y * width + x];
+		}
+
+		DistanceTransform(f.data(), d.data(), v.data(), z.data(), height);
+
+		for (auto y = 0; y < height; y++)
+		{
+			grid[y * width + x] = d[y];
+		}
+	}
+
+	for (auto y = 0; y < height; y++)
+	{
+		DistanceTransform(&grid[y * width], d.data(), v.data(), z.data(), width);
+		std::copy(d.begin(), d.begin() + width, grid.begin() + y * width);
+	}
+}
+
+std::vector<uint8_t> GlyphAtlas::DistanceField(const uint8_t *coverage, const uint32_t &width, const uint32_t &height, const int32_t &pitch, const uint32_t &spread)
+{
+	auto fieldWidth = static_cast<int32_t>(width + 2 * spread);
+	auto fieldHeight = static_cast<int32_t>(height + 2 * spread);
+
+	// Squared distances to the nearest pixel inside the glyph, and to the nearest pixel outside it.
+	std::vector<float> toInside(fieldWidth * fieldHeight, DISTANCE_INFINITY);
+	std::vector<float> toOutside(fieldWidth * fieldHeight, 0.0f);
+
+	for (uint32_t y = 0; y < height; y++)
+	{
+		for (uint32_t x = 0; x < width; x++)
+		{
+			if (coverage[y * pitch + x] >= 128)
+			{
+				auto index = (y + spread) * fieldWidth + x + spread;
+				toInside[index] = 0.0f;
+				toOutside[index] = DISTANCE_INFINITY;
+			}
+		}
+	}
+
+	DistanceTransform(toInside, fieldWidth, fieldHeight);
+	DistanceTransform(toOutside, fieldWidth, fieldHeight);
+
+	// Edges sit half way between inside and outside pixels, and map to 0.5, inside is above.
+	std::vector<uint8_t> field(toInside.size());
+
+	for (std::size_t i = 0; i < field.size(); i++)
+	{
+		auto distance = toOutside[i] == 0.0f ? std::sqrt(toInside[i]) - 0.5f : 0.5f - std::sqrt(toOutside[i]);
+		auto value = std::clamp(0.5f - distance / (2.0f * spread), 0.0f, 1.0f);
+		field[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+	}
+
+	return field;
+}
+
+void GlyphAtlas::Place(const Bitmap &bitmap)
+{
+	auto it = m_glyphs.find(bitmap.m_codepoint);
+
+	if (it == m_glyphs.end())
+	{
+		return;
+	}
+
+	auto &entry = it->second;
+	auto glyph = Glyph{0, Rect{}, 0.0f, 0.0f, 0.0f, 0.0f, bitmap.m_advance * m_scale};
+
+	if (bitmap.m_width == 0 || bitmap.m_height == 0)
+	{
+		entry.m_glyph = glyph;
+		return;
+	}
+
+	if (bitmap.m_width > m_pageSize || bitmap.m_height > m_pageSize)
+	{
+		Log::Error("Glyph %u does not fit in a %u pixel atlas page\n", static_cast<uint32_t>(bitmap.m_codepoint), m_pageSize);
+		entry.m_glyph = glyph;
+		return;
+	}
+
+	std::optional<Vector2ui> position;
+	uint32_t page = 0;
+
+	for (; page < m_pages.size(); page++)
+	{
+		position = m_pages[page]->m_packer.Insert(bitmap.m_width, bitmap.m_height);
+
+		if (position)
+		{
+			break;
+		}
+	}
+
+	if (!position)
+	{
+		if (m_pages.size() < m_maxPages)
+		{
+			m_pages.emplace_back(std::make_unique<Page>(m_pageSize));
+			page = static_cast<uint32_t>(m_pages.size() - 1);
+		}
+		else
+		{
+			page = Evict();
+		}
+
+		position = m_pages[page]->m_packer.Insert(bitmap.m_width, bitmap.m_height);
+	}
+
+	auto &target = *m_pages[page];
+
+	for (uint32_t y = 0; y < bitmap.m_height; y++)
+	{
+		std::memcpy(&target.m_pixels[(position->m_y + y) * m_pageSize + position->m_x], &bitmap.m_pixels[y * bitmap.m_width], bitmap.m_width);
+	}
+
+	auto region = Region{position->m_x, position->m_y, bitmap.m_width, bitmap.m_height};
+
+	if (target.m_dirty)
+	{
+		auto right = std::max(target.m_dirty->m_x + target.m_dirty->m_width, region.m_x + region.m_width);
+		auto bottom = std::max(target.m_dirty->m_y + target.m_dirty->m_height, region.m_y + region.m_height);
+		region.m_x = std::min(target.m_dirty->m_x, region.m_x);
+		region.m_y = std::min(target.m_dirty->m_y, region.m_y);
+		region.m_width = right - region.m_x;
+		region.m_height = bottom - region.m_y;
+	}
+
+	target.m_dirty = region;
+	target.m_lastUsed = std::max(target.m_lastUsed, entry.m_lastUsed);
+
+	auto pageSize = static_cast<float>(m_pageSize);
+	glyph.m_page = page;
+	glyph.m_textureCoords = Rect{position->m_x / pageSize, position->m_y / pageSize, (position->m_x + bitmap.m_width) / pageSize,
+		(position->m_y + bitmap.m_height) / pageSize};
+	glyph.m_offsetX = bitmap.m_left * m_scale;
+	glyph.m_offsetY = (m_ascender - bitmap.m_top) * m_scale;
+	glyph.m_sizeX = bitmap.m_width * m_scale;
+	glyph.m_sizeY = bitmap.m_height * m_scale;
+	entry.m_glyph = glyph;
+}
+
+uint32_t GlyphAtlas::Evict()
+{
+	auto page = static_cast<uint32_t>(std::min_element(m_pages.begin(), m_pages.end(), [](const std::unique_ptr<Page> &a, const std::unique_ptr<Page> &b)
+	{
+		return a->m_lastUsed < b->m_lastUsed;
+	}) - m_pages.begin());
+
+	// Dropped glyphs are rasterized again the next time they are found.
+	for (auto it = m_glyphs.begin(); it != m_glyphs.end();)
+	{
+		if (it->second.m_glyph && it->second.m_glyph->m_sizeX != 0.0f && it->second.m_glyph->m_page == page)
+		{
+			it = m_glyphs.erase(it);
+			continue;
+		}
+
+		++it;
+	}
+
+	auto &target = *m_pages[page];
+	std::fill(target.m_pixels.begin(), target.m_pixels.end(), static_cast<uint8_t>(0));
+	target.m_packer.Clear();
+	target.m_dirty = Region{0, 0, m_pageSize, m_pageSize};
+	target.m_lastUsed = 0;
+	m_evictions++;
+	return page;
+}
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include "Helpers/NonCopyable.hpp"
+#include "Helpers/ThreadPool.hpp"
+#include "Geometry.hpp"
+#include "SkylinePacker.hpp"
+
+struct FT_LibraryRec_;
+struct FT_FaceRec_;
+
+namespace acid
+{
+/**
+ * @brief A font atlas filled at runtime with signed distance field glyphs rasterized from a TrueType or OpenType font,
+ * so any code point can be shown without baking an atlas for it.
+ *
+ * Glyphs are rasterized on worker threads the first time they are asked for, and packed into atlas pages on the next update.
+ * When every page is full, the least recently used page is cleared and its glyphs are rasterized again when next used.
+ * The pages are kept on the CPU, each page records the region changed since it was last uploaded.
+ */
+class ACID_EXPORT GlyphAtlas :
+	public NonCopyable
+{
+public:
+	/**
+	 * @brief A glyph packed into a page, the metrics are in the same units as {@link FontMetafile::Character}.
+	 */
+	struct Glyph
+	{
+		uint32_t m_page;
+		Rect m_textureCoords;
+		float m_offsetX;
+		float m_offsetY;
+		float m_sizeX;
+		float m_sizeY;
+		float m_advanceX;
+	};
+
+	/**
+	 * @brief A region of a page in pixels.
+	 */
+	struct Region
+	{
+		uint32_t m_x;
+		uint32_t m_y;
+		uint32_t m_width;
+		uint32_t m_height;
+	};
+
+	/**
+	 * @brief A single channel atlas page.
+	 */
+	struct Page
+	{
+		explicit Page(const uint32_t &size) :
+			m_pixels(static_cast<std::size_t>(size) * size),
+			m_packer(size, size),
+			m_lastUsed(0)
+		{
+		}
+
+		std::vector<uint8_t> m_pixels;
+		SkylinePacker m_packer;
+		/// The region changed since the page was last uploaded.
+		std::optional<Region> m_dirty;
+		uint64_t m_lastUsed;
+	};
+
+	/**
+	 * Creates a new glyph atlas.
+	 * @param filename The font file to rasterize glyphs from.
+	 * @param glyphSize The pixel size glyphs are rasterized at.
+	 * @param spread The distance in pixels the distance field reaches out from the glyph edges.
+	 * @param pageSize The width and height of a page.
+	 * @param maxPages The most pages created before pages are reused.
+	 */
+	explicit GlyphAtlas(const std::string &filename, const uint32_t &glyphSize = 48, const uint32_t &spread = 6, const uint32_t &pageSize = 1024,
+		const uint32_t &maxPages = 4);
+
+	~GlyphAtlas();
+
+	/**
+	 * Gets a glyph, starting to rasterize it if it isn't in the atlas.
+	 * @param codepoint The code point.
+	 * @return The glyph, or null while it is being rasterized.
+	 */
+	const Glyph *Find(const char32_t &codepoint);
+
+	/**
+	 * Starts rasterizing every glyph in a string that isn't in the atlas, so they are ready together.
+	 * @param string The UTF-8 string.
+	 */
+	void Request(std::string_view string);
+
+	/**
+	 * Packs the glyphs finished since the last update into the pages.
+	 */
+	void Update();
+
+	/**
+	 * Blocks until every requested glyph is rasterized, then packs them.
+	 */
+	void Wait();
+
+	const std::vector<std::unique_ptr<Page>> &GetPages() const { return m_pages; }
+
+	/**
+	 * Marks every page as uploaded.
+	 */
+	void ClearDirty();
+
+	/**
+	 * Gets the number of glyphs being rasterized.
+	 * @return The pending glyph count.
+	 */
+	uint32_t GetPendingCount() const { return m_pending; }
+
+	std::size_t GetGlyphCount() const { return m_glyphs.size(); }
+
+	const uint64_t &GetEvictions() const { return m_evictions; }
+
+	/**
+	 * Gets the memory held by the pages and glyph table.
+	 * @return The size in bytes.
+	 */
+	std::size_t GetMemoryUsage() const;
+
+	/**
+	 * Gets the height of a line in pixels, glyph metrics are scaled so it matches {@link FontMetafile::LineHeight}.
+	 * @return The line height in pixels.
+	 */
+	const float &GetLineHeight() const { return m_lineHeight; }
+
+	/**
+	 * Gets if the font file was loaded.
+	 * @return If glyphs can be rasterized.
+	 */
+	bool IsLoaded() const { return !m_faces.empty(); }
+
+private:
+	struct Bitmap
+	{
+		char32_t m_codepoint;
+		uint32_t m_width;
+		uint32_t m_height;
+		std::vector<uint8_t> m_pixels;
+		float m_left;
+		float m_top;
+		float m_advance;
+	};
+
+	struct Entry
+	{
+		std::optional<Glyph> m_glyph;
+		uint64_t m_lastUsed;
+	};
+
+	/**
+	 * Rasterizes a glyph and turns its coverage into a distance field, run on a worker thread.
+	 * @param codepoint The code point.
+	 */
+	void Rasterize(const char32_t &codepoint);
+
+	/**
+	 * Turns a coverage bitmap into a distance field using a separable exact Euclidean distance transform.
+	 * @param coverage The glyph coverage.
+	 * @param width The coverage width.
+	 * @param height The coverage height.
+	 * @param pitch The coverage row stride.
+	 * @param spread The distance field reach, the bitmap is padded by it on every side.
+	 * @return The distance field, width + 2 * spread by height + 2 * spread.
+	 */
+	static std::vector<uint8_t> DistanceField(const uint8_t *coverage, const uint32_t &width, const uint32_t &height, const int32_t &pitch, const uint32_t &spread);
+
+	void Place(const Bitmap &bitmap);
+
+	/**
+	 * Clears the least recently used page, dropping its glyphs.
+	 * @return The cleared page.
+	 */
+	uint32_t Evict();
+
+	std::string m_fileData;
+	uint32_t m_glyphSize;
+	uint32_t m_spread;
+	uint32_t m_pageSize;
+	uint32_t m_maxPages;
+	float m_lineHeight;
+	float m_ascender;
+	float m_scale;
+
+	FT_LibraryRec_ *m_library;
+	/// One face per worker, faces can't be used by two threads at once.
+	std::vector<FT_FaceRec_ *> m_faces;
+	std::vector<FT_FaceRec_ *> m_freeFaces;
+	std::mutex m_facesMutex;
+
+	std::unordered_map<char32_t, Entry> m_glyphs;
+	std::vector<std::unique_ptr<Page>> m_pages;
+	uint64_t m_frame;
+	uint32_t m_pending;
+	uint64_t m_evictions;
+
+	std::vector<Bitmap> m_finished;
+	std::mutex m_finishedMutex;
+	std::condition_variable m_finishedCondition;
+
+	ThreadPool m_workers;
+};
+}
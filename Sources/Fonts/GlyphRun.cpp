@@ -0,0 +1,319 @@
+#include "GlyphRun.hpp"
+
+#include "Helpers/String.hpp"
+#include "GlyphAtlas.hpp"
+
+namespace acid
+{
+namespace
+{
+struct Glyph
+{
+	Rect m_textureCoords;
+	float m_offsetX;
+	float m_offsetY;
+	float m_sizeX;
+	float m_sizeY;
+	float m_advanceX;
+	uint32_t m_page;
+};
+
+struct Word
+{
+	uint32_t m_begin;
+	uint32_t m_end;
+	float m_width;
+};
+
+struct Line
+{
+	uint32_t m_begin;
+	uint32_t m_end;
+	float m_wordsLength;
+	float m_lineLength;
+};
+
+constexpr std::string_view Whitespace = " \t\n\r";
+}
+
+GlyphRun::GlyphRun(const FontMetafile &metafile, GlyphAtlas *atlas, const std::string &string, const Justify &justify, const float &maxWidth, const float &kerning,
+	const float &leading) :
+	m_numberLines(0),
+	m_usingAtlas(false),
+	m_pending(false),
+	m_evictions(atlas != nullptr ? atlas->GetEvictions() : 0)
+{
+	// Scratch space reused between layouts, glyphs and words refer to each other by index.
+	thread_local std::vector<Glyph> glyphs;
+	thread_local std::vector<Word> lineWords;
+	thread_local std::vector<Line> lines;
+	thread_local std::vector<std::string_view> textLines;
+	glyphs.clear();
+	lineWords.clear();
+	lines.clear();
+	textLines.clear();
+
+	auto spaceWidth = metafile.GetSpaceWidth();
+
+	// Lines are split on newlines, skipping empty lines and trimming whitespace from each end.
+	std::string_view remaining = string;
+
+	while (!remaining.empty())
+	{
+		auto end = remaining.find('\n');
+		auto textLine = remaining.substr(0, end);
+		remaining = end == std::string_view::npos ? std::string_view() : remaining.substr(end + 1);
+
+		if (textLine.empty())
+		{
+			continue;
+		}
+
+		auto first = textLine.find_first_not_of(Whitespace);
+		textLine = first == std::string_view::npos ? std::string_view() : textLine.substr(first, textLine.find_last_not_of(Whitespace) - first + 1);
+		textLines.emplace_back(textLine);
+	}
+
+	auto currentLine = Line{0, 0, 0.0f, 0.0f};
+	auto currentWord = Word{0, 0, 0.0f};
+
+	// Adds a word to the end of a line if it fits.
+	auto addWord = [&](Line &line, const Word &word)
+	{
+		auto additionalLength = word.m_width + (line.m_end != line.m_begin ? spaceWidth : 0.0f);
+
+		if (line.m_lineLength + additionalLength > maxWidth)
+		{
+			return false;
+		}
+
+		lineWords.emplace_back(word);
+		line.m_end++;
+		line.m_wordsLength += word.m_width;
+		line.m_lineLength += additionalLength;
+		return true;
+	};
+	auto nextLine = [&]()
+	{
+		lines.emplace_back(currentLine);
+		auto begin = static_cast<uint32_t>(lineWords.size());
+		currentLine = Line{begin, begin, 0.0f, 0.0f};
+	};
+	auto nextWord = [&]()
+	{
+		auto begin = static_cast<uint32_t>(glyphs.size());
+		currentWord = Word{begin, begin, 0.0f};
+	};
+	auto findGlyph = [&](const char32_t &codepoint) -> std::optional<Glyph>
+	{
+		if (auto character = metafile.FindCharacter(static_cast<int32_t>(codepoint)))
+		{
+			return Glyph{Rect{character->m_textureCoordX, character->m_textureCoordY, character->m_maxTextureCoordX, character->m_maxTextureCoordY},
+				character->m_offsetX, character->m_offsetY, character->m_sizeX, character->m_sizeY, character->m_advanceX, 0};
+		}
+
+		// Code points outside of the prebaked atlas come from the runtime atlas, the run is laid out again once they are rasterized.
+		if (atlas == nullptr || !atlas->IsLoaded())
+		{
+			return std::nullopt;
+		}
+
+		m_usingAtlas = true;
+		auto glyph = atlas->Find(codepoint);
+
+		if (glyph == nullptr)
+		{
+			m_pending = true;
+			return std::nullopt;
+		}
+
+		return Glyph{glyph->m_textureCoords, glyph->m_offsetX, glyph->m_offsetY, glyph->m_sizeX, glyph->m_sizeY, glyph->m_advanceX, glyph->m_page + 1};
+	};
+
+	for (std::size_t i = 0; i < textLines.size(); i++)
+	{
+		if (textLines[i].empty())
+		{
+			continue;
+		}
+
+		for (const auto &codepoint : String::ToUtf32(textLines[i]))
+		{
+			if (codepoint == FontMetafile::SpaceAscii)
+			{
+				if (!addWord(currentLine, currentWord))
+				{
+					nextLine();
+					addWord(currentLine, currentWord);
+				}
+
+				nextWord();
+				continue;
+			}
+
+			if (auto glyph = findGlyph(codepoint))
+			{
+				glyphs.emplace_back(*glyph);
+				currentWord.m_end++;
+				currentWord.m_width += kerning + glyph->m_advanceX;
+			}
+		}
+
+		if (i != textLines.size() - 1)
+		{
+			auto wordAdded = addWord(currentLine, currentWord);
+			nextLine();
+
+			if (!wordAdded)
+			{
+				addWord(currentLine, currentWord);
+			}
+
+			nextWord();
+		}
+	}
+
+	if (!addWord(currentLine, currentWord))
+	{
+		nextLine();
+		addWord(currentLine, currentWord);
+	}
+
+	lines.emplace_back(currentLine);
+	m_numberLines = static_cast<uint32_t>(lines.size());
+
+	// Places the glyph quads.
+	m_quads.reserve(glyphs.size());
+	auto cursorY = 0.0f;
+	auto lineOrder = static_cast<int32_t>(lines.size());
+	auto min = Vector2f::PositiveInfinity;
+	auto max = Vector2f::NegativeInfinity;
+
+	for (const auto &line : lines)
+	{
+		auto cursorX = 0.0f;
+
+		if (justify == Justify::Centre)
+		{
+			cursorX = (maxWidth - line.m_lineLength) / 2.0f;
+		}
+		else if (justify == Justify::Right)
+		{
+			cursorX = maxWidth - line.m_lineLength;
+		}
+
+		for (auto w = line.m_begin; w < line.m_end; w++)
+		{
+			const auto &word = lineWords[w];
+
+			for (auto g = word.m_begin; g < word.m_end; g++)
+			{
+				const auto &glyph = glyphs[g];
+				auto position = Rect{cursorX + glyph.m_offsetX, cursorY + glyph.m_offsetY, 0.0f, 0.0f};
+				position.maxX = position.minX + glyph.m_sizeX;
+				position.maxY = position.minY + glyph.m_sizeY;
+				m_quads.emplace_back(GlyphQuad{position, glyph.m_textureCoords, glyph.m_page});
+
+				min = min.Min(Vector2f(position.minX, position.minY));
+				max = max.Max(Vector2f(position.maxX, position.maxY));
+				cursorX += kerning + glyph.m_advanceX;
+			}
+
+			if (justify == Justify::Fully && lineOrder > 1)
+			{
+				cursorX += (maxWidth - line.m_wordsLength) / static_cast<float>(line.m_end - line.m_begin);
+			}
+			else
+			{
+				cursorX += spaceWidth;
+			}
+		}
+
+		cursorY += leading + FontMetafile::LineHeight;
+		lineOrder--;
+	}
+
+	if (m_quads.empty())
+	{
+		return;
+	}
+
+	if (justify == Justify::Centre)
+	{
+		min.m_x = 0.0f;
+		max.m_x = maxWidth;
+	}
+
+	// Normalizes the quads to the bounds of the string.
+	m_bounding = (max - min) / 2.0f;
+	auto size = max - min;
+
+	for (auto &quad : m_quads)
+	{
+		quad.m_position.minX = (quad.m_position.minX - min.m_x) / size.m_x;
+		quad.m_position.minY = (quad.m_position.minY - min.m_y) / size.m_y;
+		quad.m_position.maxX = (quad.m_position.maxX - min.m_x) / size.m_x;
+		quad.m_position.maxY = (quad.m_position.maxY - min.m_y) / size.m_y;
+	}
+}
+
+bool GlyphRun::IsCurrent(const GlyphAtlas &atlas) const
+{
+	return !m_pending && m_evictions == atlas.GetEvictions();
+}
+
+GlyphRunCache::GlyphRunCache(const std::size_t &capacity) :
+	m_capacity(capacity),
+	m_hits(0),
+	m_misses(0)
+{
+}
+
+std::shared_ptr<const GlyphRun> GlyphRunCache::Get(const FontMetafile &metafile, GlyphAtlas *atlas, const std::string &string, const GlyphRun::Justify &justify,
+	const float &maxWidth, const float &kerning, const float &leading)
+{
+	// The key is the string followed by the raw layout values, built into a reused buffer.
+	const float values[] = { static_cast<float>(justify), maxWidth, kerning, leading };
+	m_key.assign(string);
+	m_key.push_back('\0');
+	m_key.append(reinterpret_cast<const char *>(values), sizeof(values));
+
+	auto it = m_lookup.find(m_key);
+
+	if (it != m_lookup.end())
+	{
+		m_runs.splice(m_runs.begin(), m_runs, it->second);
+		auto &run = it->second->second;
+
+		if (!run->IsUsingAtlas() || (atlas != nullptr && run->IsCurrent(*atlas)))
+		{
+			m_hits++;
+			return run;
+		}
+
+		// Texts still showing the old run keep it alive until they are laid out again.
+		m_misses++;
+		run = std::make_shared<const GlyphRun>(metafile, atlas, string, justify, maxWidth, kerning, leading);
+		return run;
+	}
+
+	m_misses++;
+	auto run = std::make_shared<const GlyphRun>(metafile, atlas, string, justify, maxWidth, kerning, leading);
+	m_runs.emplace_front(m_key, run);
+	m_lookup.emplace(m_key, m_runs.begin());
+
+	while (m_runs.size() > m_capacity)
+	{
+		m_lookup.erase(m_runs.back().first);
+		m_runs.pop_back();
+	}
+
+	return run;
+}
+
+void GlyphRunCache::Clear()
+{
+	m_runs.clear();
+	m_lookup.clear();
+}
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include "Maths/Vector2.hpp"
+#include "FontMetafile.hpp"
+#include "Geometry.hpp"
+
+namespace acid
+{
+class GlyphAtlas;
+
+/**
+ * @brief A glyph quad in a laid out string.
+ */
+struct GlyphQuad
+{
+	/// The quad position, normalized to the bounds of the string.
+	Rect m_position;
+	/// The quad texture coordinates in the font atlas.
+	Rect m_textureCoords;
+	/// The texture sampled, 0 for the prebaked font atlas, or one more than the page in the runtime glyph atlas.
+	uint32_t m_page;
+};
+
+/**
+ * @brief A string laid out into lines and glyph quads, shared by every text showing the same string with the same layout.
+ */
+class ACID_EXPORT GlyphRun
+{
+public:
+	/**
+	 * @brief A enum that represents how the text will be justified.
+	 */
+	enum class Justify
+	{
+		Left, Centre, Right, Fully
+	};
+
+	/**
+	 * Lays out a string.
+	 * @param metafile The font to lay out with.
+	 * @param atlas The runtime atlas code points missing from the font are taken from, or null to skip them.
+	 * @param string The string.
+	 * @param justify How the lines will justify.
+	 * @param maxWidth The maximum length of a line.
+	 * @param kerning The kerning (type character spacing multiplier).
+	 * @param leading The leading (vertical line spacing multiplier).
+	 */
+	GlyphRun(const FontMetafile &metafile, GlyphAtlas *atlas, const std::string &string, const Justify &justify, const float &maxWidth, const float &kerning,
+		const float &leading);
+
+	/**
+	 * Gets if the run has glyphs from the runtime atlas, or code points it is still rasterizing.
+	 * @return If the run depends on the atlas.
+	 */
+	const bool &IsUsingAtlas() const { return m_usingAtlas; }
+
+	/**
+	 * Gets if every glyph was ready when the run was laid out, and no atlas page has been cleared since.
+	 * Runs that are not current must be laid out again to show every glyph.
+	 * @param atlas The runtime atlas the run was laid out with.
+	 * @return If the run is current.
+	 */
+	bool IsCurrent(const GlyphAtlas &atlas) const;
+
+	const std::vector<GlyphQuad> &GetQuads() const { return m_quads; }
+
+	/**
+	 * Gets half the size of the laid out string.
+	 * @return The bounding half size.
+	 */
+	const Vector2f &GetBounding() const { return m_bounding; }
+
+	const uint32_t &GetNumberLines() const { return m_numberLines; }
+
+private:
+	std::vector<GlyphQuad> m_quads;
+	Vector2f m_bounding;
+	uint32_t m_numberLines;
+
+	bool m_usingAtlas;
+	bool m_pending;
+	uint64_t m_evictions;
+};
+
+/**
+ * @brief Keeps the most recently used glyph runs of a font, so labels cycling through the same strings skip layout.
+ */
+class ACID_EXPORT GlyphRunCache
+{
+public:
+	/**
+	 * Creates a new glyph run cache.
+	 * @param capacity The number of runs kept before the least recently used are dropped.
+	 */
+	explicit GlyphRunCache(const std::size_t &capacity = 4096);
+
+	/**
+	 * Gets a laid out string, laying it out if it isn't in the cache or is no longer current.
+	 * @param metafile The font to lay out with.
+	 * @param atlas The runtime atlas code points missing from the font are taken from, or null to skip them.
+	 * @param string The string.
+	 * @param justify How the lines will justify.
+	 * @param maxWidth The maximum length of a line.
+	 * @param kerning The kerning.
+	 * @param leading The leading.
+	 * @return The glyph run.
+	 */
+	std::shared_ptr<const GlyphRun> Get(const FontMetafile &metafile, GlyphAtlas *atlas, const std::string &string, const GlyphRun::Justify &justify,
+		const float &maxWidth, const float &kerning, const float &leading);
+
+	void Clear();
+
+	std::size_t GetSize() const { return m_runs.size(); }
+
+	const uint64_t &GetHits() const { return m_hits; }
+
+	const uint64_t &GetMisses() const { return m_misses; }
+
+private:
+	using Entry = std::pair<std::string, std::shared_ptr<const GlyphRun>>;
+
+	std::size_t m_capacity;
+	/// Most recently used first.
+	std::list<Entry> m_runs;
+	std::unordered_map<std::string, std::list<Entry>::iterator> m_lookup;
+	std::string m_key;
+	uint64_t m_hits;
+	uint64_t m_misses;
+};
+}
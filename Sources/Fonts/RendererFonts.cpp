@@ -1,15 +1,15 @@
 #include "RendererFonts.hpp"
 
-#include "Models/VertexModel.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Uis/Uis.hpp"
-#include "Text.hpp"
+#include "FontType.hpp"
 
 namespace acid
 {
 RendererFonts::RendererFonts(const Pipeline::Stage &pipelineStage) :
 	RenderPipeline(pipelineStage),
-	m_pipeline(pipelineStage, { "Shaders/Fonts/Font.vert", "Shaders/Fonts/Font.frag" }, { VertexModel::GetVertexInput() })
+	m_pipeline(pipelineStage, { "Shaders/Fonts/Font.vert", "Shaders/Fonts/Font.frag" }, { TextBatch::GetVertexInput() }, {}, PipelineGraphics::Mode::Polygon,
+		PipelineGraphics::Depth::ReadWrite, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP)
 {
 }
 
@@ -17,23 +17,27 @@ void RendererFonts::Render(const CommandBuffer &commandBuffer)
 {
 	auto camera = Scenes::Get()->GetCamera();
 	m_uniformScene.Push("projection", camera->GetProjectionMatrix());
-	m_uniformScene.Push("view", camera->GetViewMatrix());
+	m_uniformScene.Push("view", camera->GetRenderViewMatrix());
+	m_uniformScene.Push("size", Vector2f(m_pipeline.GetSize()));
 
 	m_pipeline.BindPipeline(commandBuffer);
 
-	for (const auto &screenObject : Uis::Get()->GetObjects())
+	// Texts clip to their scissor in the fragment shader.
+	VkRect2D scissorRect = {};
+	scissorRect.extent.width = m_pipeline.GetSize().m_x;
+	scissorRect.extent.height = m_pipeline.GetSize().m_y;
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
+
+	// Every text of a font is in its batch, so each font is drawn once.
+	for (const auto &fontType : Uis::Get()->GetFontTypes())
 	{
-		if (!screenObject->IsEnabled())
+		if (fontType->GetTextBatch().GetTextCount() == 0)
 		{
 			continue;
 		}
 
-		auto object = dynamic_cast<Text *>(screenObject);
-
-		if (object != nullptr)
-		{
-			object->CmdRender(commandBuffer, m_pipeline, m_uniformScene);
-		}
+		// The atlas pages were uploaded by Uis before recording started.
+		fontType->GetTextBatch().CmdRender(commandBuffer, m_pipeline, m_uniformScene, fontType->GetTexture(), fontType->GetAtlasPages());
 	}
 }
 }
@@ -0,0 +1,120 @@
+#include "SkylinePacker.hpp"
+
+namespace acid
+{
+SkylinePacker::SkylinePacker(const uint32_t &width, const uint32_t &height) :
+	m_width(width),
+	m_height(height),
+	m_usedArea(0)
+{
+	Clear();
+}
+
+std::optional<Vector2ui> SkylinePacker::Insert(const uint32_t &width, const uint32_t &height)
+{
+	std::optional<std::size_t> bestIndex;
+	auto bestTop = std::numeric_limits<uint32_t>::max();
+	auto bestWidth = std::numeric_limits<uint32_t>::max();
+	uint32_t bestY = 0;
+
+	for (std::size_t i = 0; i < m_skyline.size(); i++)
+	{
+		auto y = Fit(i, width, height);
+
+		// Lowest top edge first, then the narrowest node to leave wide gaps for wide rectangles.
+		if (y && (*y + height < bestTop || (*y + height == bestTop && m_skyline[i].m_width < bestWidth)))
+		{
+			bestIndex = i;
+			bestTop = *y + height;
+			bestWidth = m_skyline[i].m_width;
+			bestY = *y;
+		}
+	}
+
+	if (!bestIndex)
+	{
+		return std::nullopt;
+	}
+
+	auto position = Vector2ui(m_skyline[*bestIndex].m_x, bestY);
+	m_skyline.insert(m_skyline.begin() + *bestIndex, Node{position.m_x, bestTop, width});
+
+	// Shrinks or removes the nodes now under the new one.
+	for (auto i = *bestIndex + 1; i < m_skyline.size();)
+	{
+		auto &previous = m_skyline[i - 1];
+		auto &node = m_skyline[i];
+		auto previousRight = previous.m_x + previous.m_width;
+
+		if (node.m_x >= previousRight)
+		{
+			break;
+		}
+
+		auto shrink = previousRight - node.m_x;
+
+		if (node.m_width <= shrink)
+		{
+			m_skyline.erase(m_skyline.begin() + i);
+			continue;
+		}
+
+		node.m_x += shrink;
+		node.m_width -= shrink;
+		break;
+	}
+
+	// Joins neighbours at the same height.
+	for (std::size_t i = 0; i + 1 < m_skyline.size();)
+	{
+		if (m_skyline[i].m_y == m_skyline[i + 1].m_y)
+		{
+			m_skyline[i].m_width += m_skyline[i + 1].m_width;
+			m_skyline.erase(m_skyline.begin() + i + 1);
+			continue;
+		}
+
+		i++;
+	}
+
+	m_usedArea += static_cast<uint64_t>(width) * height;
+	return position;
+}
+
+void SkylinePacker::Clear()
+{
+	m_skyline.clear();
+	m_skyline.emplace_back(Node{0, 0, m_width});
+	m_usedArea = 0;
+}
+
+float SkylinePacker::GetOccupancy() const
+{
+	return static_cast<float>(static_cast<double>(m_usedArea) / (static_cast<double>(m_width) * m_height));
+}
+
+std::optional<uint32_t> SkylinePacker::Fit(const std::size_t &index, const uint32_t &width, const uint32_t &height) const
+{
+	if (m_skyline[index].m_x + width > m_width)
+	{
+		return std::nullopt;
+	}
+
+	uint32_t y = 0;
+	auto remaining = static_cast<int64_t>(width);
+
+	for (auto i = index; remaining > 0; i++)
+	{
+		y = std::max(y, m_skyline[i].m_y);
+
+		if (y + height > m_height)
+		{
+			return std::nullopt;
+		}
+
+		remaining -= m_skyline[i].m_width;
+	}
+
+	return y;
+}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Maths/Vector2.hpp"
+
+namespace acid
+{
+/**
+ * @brief Packs rectangles into a fixed size area by keeping the skyline of the packed rectangles' top edges,
+ * each rectangle is placed where it leaves the skyline lowest.
+ */
+class ACID_EXPORT SkylinePacker
+{
+public:
+	/**
+	 * Creates a new empty packer.
+	 * @param width The width of the area.
+	 * @param height The height of the area.
+	 */
+	SkylinePacker(const uint32_t &width, const uint32_t &height);
+
+	/**
+	 * Finds a place for a rectangle and adds it to the skyline.
+	 * @param width The rectangle width.
+	 * @param height The rectangle height.
+	 * @return The position of the rectangle, or nothing if it doesn't fit.
+	 */
+	std::optional<Vector2ui> Insert(const uint32_t &width, const uint32_t &height);
+
+	/**
+	 * Removes all rectangles.
+	 */
+	void Clear();
+
+	/**
+	 * Gets the fraction of the area covered by rectangles.
+	 * @return The occupancy between 0 and 1.
+	 */
+	float GetOccupancy() const;
+
+	const uint32_t &GetWidth() const { return m_width; }
+
+	const uint32_t &GetHeight() const { return m_height; }
+
+private:
+	struct Node
+	{
+		uint32_t m_x;
+		uint32_t m_y;
+		uint32_t m_width;
+	};
+
+	/**
+	 * Gets the height a rectangle would sit at if its left edge was placed at a node.
+	 * @param index The node index.
+	 * @param width The rectangle width.
+	 * @param height The rectangle height.
+	 * @return The y the rectangle would be placed at, or nothing if it doesn't fit there.
+	 */
+	std::optional<uint32_t> Fit(const std::size_t &index, const uint32_t &width, const uint32_t &height) const;
+
+	uint32_t m_width;
+	uint32_t m_height;
+	std::vector<Node> m_skyline;
+	uint64_t m_usedArea;
+};
+}
@@ -1,14 +1,15 @@
 ﻿#include "Text.hpp"
 
 #include "Maths/Visual/DriverConstant.hpp"
+#include "Uis/Uis.hpp"
 
 namespace acid
 {
 Text::Text(UiObject *parent, const UiBound &rectangle, const float &fontSize, std::string text, std::shared_ptr<FontType> fontType, const Justify &justify, const float &maxWidth,
 	const Colour &textColour, const float &kerning, const float &leading) :
 	UiObject(parent, rectangle),
-	m_model(nullptr),
-	m_numberLines(0),
+	m_run(nullptr),
+	m_batchId(0),
 	m_string(std::move(text)),
 	m_justify(justify),
 	m_fontType(std::move(fontType)),
@@ -25,9 +26,24 @@ Text::Text(UiObject *parent, const UiBound &rectangle, const float &fontSize, st
 	m_borderSize(0.0f)
 {
 	SetScaleDriver(new DriverConstant<Vector2f>(Vector2f(fontSize)));
+
+	if (m_fontType != nullptr)
+	{
+		m_batchId = m_fontType->GetTextBatch().Add();
+		Uis::Get()->AddFontType(m_fontType);
+	}
+
 	LoadText();
 }
 
+Text::~Text()
+{
+	if (m_fontType != nullptr)
+	{
+		m_fontType->GetTextBatch().Remove(m_batchId);
+	}
+}
+
 void Text::UpdateObject()
 {
 	if (m_newString.has_value())
@@ -36,52 +52,34 @@ void Text::UpdateObject()
 		LoadText();
 		m_newString = {};
 	}
-
-	m_glowSize = m_glowDriver->Update(Engine::Get()->GetDelta());
-	m_borderSize = m_borderDriver->Update(Engine::Get()->GetDelta());
-
-	// Updates uniforms.
-	m_uniformObject.Push("modelMatrix", GetModelMatrix());
-	m_uniformObject.Push("screenOffset", Vector4f(2.0f * GetScreenSize(), 2.0f * GetScreenPosition() - 1.0f));
-	m_uniformObject.Push("modelMode", GetWorldTransform() ? (IsLockRotation() + 1) : 0);
-	m_uniformObject.Push("depth", GetScreenDepth());
-	m_uniformObject.Push("alpha", GetScreenAlpha());
-
-	m_uniformObject.Push("colour", m_textColour);
-	m_uniformObject.Push("borderColour", m_borderColour);
-	m_uniformObject.Push("borderSizes", Vector2f(GetTotalBorderSize(), GetGlowSize()));
-	m_uniformObject.Push("edgeData", Vector2f(CalculateEdgeStart(), CalculateAntialiasSize()));
-}
-
-bool Text::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene)
-{
-	// Gets if this should be rendered.
-	if (m_model == nullptr || m_fontType == nullptr || !IsEnabled())
+	else if (m_run != nullptr && m_run->IsUsingAtlas() && !m_run->IsCurrent(*m_fontType->GetAtlas()))
 	{
-		return false;
+		// Glyphs that were being rasterized are now ready, or the atlas page holding some of them was cleared.
+		LoadText();
 	}
 
-	// Updates descriptors.
-	m_descriptorSet.Push("UniformScene", uniformScene);
-	m_descriptorSet.Push("UniformObject", m_uniformObject);
-	m_descriptorSet.Push("samplerColour", m_fontType->GetTexture());
-	bool updateSuccess = m_descriptorSet.Update(pipeline);
-
-	if (!updateSuccess)
+	// Border drivers are only evaluated until they finish.
+	if (!m_glowDriver->IsFinished())
 	{
-		return false;
+		auto glowSize = m_glowDriver->Update(Engine::Get()->GetDelta());
+
+		if (glowSize != m_glowSize)
+		{
+			m_glowSize = glowSize;
+			MarkDirty();
+		}
 	}
 
-	VkRect2D scissorRect = {};
-	scissorRect.offset.x = static_cast<int32_t>(pipeline.GetSize().m_x * GetScissor().m_x);
-	scissorRect.offset.y = static_cast<int32_t>(pipeline.GetSize().m_y * GetScissor().m_y);
-	scissorRect.extent.width = static_cast<uint32_t>(pipeline.GetSize().m_x * GetScissor().m_z);
-	scissorRect.extent.height = static_cast<uint32_t>(pipeline.GetSize().m_y * GetScissor().m_w);
-	vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
+	if (!m_borderDriver->IsFinished())
+	{
+		auto borderSize = m_borderDriver->Update(Engine::Get()->GetDelta());
 
-	// Draws the object.
-	m_descriptorSet.BindDescriptor(commandBuffer, pipeline);
-	return m_model->CmdRender(commandBuffer);
+		if (borderSize != m_borderSize)
+		{
+			m_borderSize = borderSize;
+			MarkDirty();
+		}
+	}
 }
 
 void Text::SetString(const std::string &string)
@@ -92,24 +90,41 @@ void Text::SetString(const std::string &string)
 	}
 }
 
+void Text::SetTextColour(const Colour &textColour)
+{
+	m_textColour = textColour;
+	MarkDirty();
+}
+
+void Text::SetBorderColour(const Colour &borderColour)
+{
+	m_borderColour = borderColour;
+	MarkDirty();
+}
+
 void Text::SetBorderDriver(Driver<float> *borderDriver)
 {
 	m_borderDriver.reset(borderDriver);
+	m_borderSize = m_borderDriver->Update(Time::Zero);
 	m_solidBorder = true;
 	m_glowBorder = false;
+	MarkDirty();
 }
 
 void Text::SetGlowDriver(Driver<float> *glowDriver)
 {
 	m_glowDriver.reset(glowDriver);
+	m_glowSize = m_glowDriver->Update(Time::Zero);
 	m_solidBorder = false;
 	m_glowBorder = true;
+	MarkDirty();
 }
 
 void Text::RemoveBorder()
 {
 	m_solidBorder = false;
 	m_glowBorder = false;
+	MarkDirty();
 }
 
 float Text::GetTotalBorderSize() const
@@ -162,209 +177,57 @@ float Text::CalculateAntialiasSize() const
 	return 0.1f / size;
 }
 
-bool Text::IsLoaded() const
-{
-	return !m_string.empty() && m_model != nullptr;
-}
-
-void Text::LoadText()
+void Text::UpdateLayout()
 {
-	if (m_string.empty())
+	if (m_fontType == nullptr)
 	{
-		m_model = nullptr;
 		return;
 	}
 
-	// Creates mesh data.
-	auto lines = CreateStructure();
-	auto vertices = CreateQuad(lines);
-
-	// Calculates the bounds and normalizes the vertices.
-	Vector2f bounding;
-	NormalizeQuad(bounding, vertices);
-
-	// Loads the mesh data.
-	m_model = std::make_unique<Model>(vertices);
-	GetRectangle().SetSize(bounding);
+	// Updates the values in the font batch, disabled texts stay in the batch but are not seen.
+	TextBatch::TextData data = TextBatch::TextData();
+	data.m_modelMatrix = GetModelMatrix();
+	data.m_screenOffset = Vector4f(2.0f * GetScreenSize(), 2.0f * GetScreenPosition() - 1.0f);
+	data.m_colour = m_textColour;
+	data.m_borderColour = m_borderColour;
+	data.m_scissor = GetScissor();
+	data.m_borderSizes = Vector2f(GetTotalBorderSize(), GetGlowSize());
+	data.m_edgeData = Vector2f(CalculateEdgeStart(), CalculateAntialiasSize());
+	data.m_modelMode = GetWorldTransform() ? (IsLockRotation() + 1) : 0;
+	data.m_depth = GetScreenDepth();
+	data.m_alpha = IsEnabled() ? GetScreenAlpha() : 0.0f;
+	m_fontType->GetTextBatch().SetData(m_batchId, data);
 }
 
-std::vector<Text::Line> Text::CreateStructure() const
-{
-	std::vector<Line> lines;
-	auto currentLine = Line(m_fontType->GetMetadata()->GetSpaceWidth(), m_maxWidth);
-	auto currentWord = Word();
-
-	auto formattedText = String::ReplaceAll(m_string, "\t", "	");
-	auto textLines = String::Split(formattedText, "\n", true);
-
-	for (uint32_t i = 0; i < textLines.size(); i++)
-	{
-		if (textLines.at(i).empty())
-		{
-			continue;
-		}
-
-		for (const auto &c : textLines.at(i))
-		{
-			auto ascii = static_cast<int32_t>(c);
-
-			if (ascii == FontMetafile::SpaceAscii)
-			{
-				bool added = currentLine.AddWord(currentWord);
-
-				if (!added)
-				{
-					lines.emplace_back(currentLine);
-					currentLine = Line(m_fontType->GetMetadata()->GetSpaceWidth(), m_maxWidth);
-					currentLine.AddWord(currentWord);
-				}
-
-				currentWord = Word();
-				continue;
-			}
-
-			auto character = m_fontType->GetMetadata()->GetCharacter(ascii);
-
-			if (character)
-			{
-				currentWord.AddCharacter(*character, m_kerning);
-			}
-		}
-
-		if (i != textLines.size() - 1)
-		{
-			bool wordAdded = currentLine.AddWord(currentWord);
-			lines.emplace_back(currentLine);
-			currentLine = Line(m_fontType->GetMetadata()->GetSpaceWidth(), m_maxWidth);
-
-			if (!wordAdded)
-			{
-				currentLine.AddWord(currentWord);
-			}
-
-			currentWord = Word();
-		}
-	}
-
-	CompleteStructure(lines, currentLine, currentWord);
-	return lines;
-}
-
-void Text::CompleteStructure(std::vector<Line> &lines, Line &currentLine, const Word &currentWord) const
-{
-	auto added = currentLine.AddWord(currentWord);
-
-	if (!added)
-	{
-		lines.emplace_back(currentLine);
-		currentLine = Line(m_fontType->GetMetadata()->GetSpaceWidth(), m_maxWidth);
-		currentLine.AddWord(currentWord);
-	}
-
-	lines.emplace_back(currentLine);
-}
-
-std::vector<VertexModel> Text::CreateQuad(const std::vector<Line> &lines)
-{
-	std::vector<VertexModel> vertices;
-	m_numberLines = static_cast<uint32_t>(lines.size());
-
-	auto cursorX = 0.0f;
-	auto cursorY = 0.0f;
-	auto lineOrder = static_cast<int32_t>(lines.size());
-
-	for (const auto &line : lines)
-	{
-		switch (m_justify)
-		{
-		case Justify::Left:
-			cursorX = 0.0f;
-			break;
-		case Justify::Centre:
-			cursorX = (line.m_maxLength - line.m_currentLineLength) / 2.0f;
-			break;
-		case Justify::Right:
-			cursorX = line.m_maxLength - line.m_currentLineLength;
-			break;
-		case Justify::Fully:
-			cursorX = 0.0f;
-			break;
-		}
-
-		for (const auto &word : line.m_words)
-		{
-			for (const auto &letter : word.m_characters)
-			{
-				AddVerticesForCharacter(cursorX, cursorY, letter, vertices);
-				cursorX += m_kerning + letter.m_advanceX;
-			}
-
-			if (m_justify == Justify::Fully && lineOrder > 1)
-			{
-				cursorX += (line.m_maxLength - line.m_currentWordsLength) / line.m_words.size();
-			}
-			else
-			{
-				cursorX += m_fontType->GetMetadata()->GetSpaceWidth();
-			}
-		}
-
-		cursorY += m_leading + FontMetafile::LineHeight;
-		lineOrder--;
-	}
-
-	return vertices;
-}
-
-void Text::AddVerticesForCharacter(const float &cursorX, const float &cursorY, const FontMetafile::Character &character, std::vector<VertexModel> &vertices)
-{
-	auto vertexX = cursorX + character.m_offsetX;
-	auto vertexY = cursorY + character.m_offsetY;
-	auto vertexMaxX = vertexX + character.m_sizeX;
-	auto vertexMaxY = vertexY + character.m_sizeY;
-
-	auto textureX = character.m_textureCoordX;
-	auto textureY = character.m_textureCoordY;
-	auto textureMaxX = character.m_maxTextureCoordX;
-	auto textureMaxY = character.m_maxTextureCoordY;
-
-	AddVertex(vertexX, vertexY, textureX, textureY, vertices);
-	AddVertex(vertexMaxX, vertexY, textureMaxX, textureY, vertices);
-	AddVertex(vertexMaxX, vertexMaxY, textureMaxX, textureMaxY, vertices);
-	AddVertex(vertexMaxX, vertexMaxY, textureMaxX, textureMaxY, vertices);
-	AddVertex(vertexX, vertexMaxY, textureX, textureMaxY, vertices);
-	AddVertex(vertexX, vertexY, textureX, textureY, vertices);
-}
-
-void Text::AddVertex(const float &vx, const float &vy, const float &tx, const float &ty, std::vector<VertexModel> &vertices)
+bool Text::IsLoaded() const
 {
-	vertices.emplace_back(VertexModel(Vector3f(vx, vy, 0.0f), Vector2f(tx, ty), Vector3f::Zero));
+	return !m_string.empty() && m_run != nullptr;
 }
 
-void Text::NormalizeQuad(Vector2f &bounding, std::vector<VertexModel> &vertices) const
+void Text::LoadText()
 {
-	auto min = Vector2f::PositiveInfinity;
-	auto max = Vector2f::NegativeInfinity;
-
-	for (const auto &vertex : vertices)
+	if (m_fontType == nullptr)
 	{
-		auto position = Vector2f(vertex.m_position);
-		min = min.Min(position);
-		max = max.Max(position);
+		return;
 	}
 
-	if (m_justify == Justify::Centre)
+	if (m_string.empty())
 	{
-		min.m_x = 0.0f;
-		max.m_x = m_maxWidth;
+		m_run = nullptr;
+		m_fontType->GetTextBatch().SetGlyphs(m_batchId, {});
+		return;
 	}
 
-	//max.m_y = static_cast<float>(GetFontType()->GetMetadata()->GetMaxSizeY()) * m_numberLines;
-	bounding = (max - min) / 2.0f;
-
-	for (auto &vertex : vertices)
+	// The runtime atlas is only created once a string has code points outside of ASCII, which the prebaked atlas covers.
+	auto ascii = std::all_of(m_string.begin(), m_string.end(), [](const char &c)
 	{
-		vertex.m_position = Vector3f((Vector2f(vertex.m_position) - min) / (max - min));
-	}
+		return static_cast<uint8_t>(c) < 0x80;
+	});
+	auto atlas = ascii ? nullptr : m_fontType->GetAtlas();
+
+	// Texts showing the same string with the same layout share the run.
+	m_run = m_fontType->GetGlyphRuns().Get(*m_fontType->GetMetadata(), atlas, m_string, m_justify, m_maxWidth, m_kerning, m_leading);
+	m_fontType->GetTextBatch().SetGlyphs(m_batchId, m_run->GetQuads());
+	GetRectangle().SetSize(m_run->GetBounding());
 }
 }
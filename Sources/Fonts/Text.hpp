@@ -3,13 +3,9 @@
 #include "Maths/Colour.hpp"
 #include "Maths/Vector2.hpp"
 #include "Maths/Visual/Driver.hpp"
-#include "Models/Model.hpp"
-#include "Models/VertexModel.hpp"
-#include "Renderer/Descriptors/DescriptorsHandler.hpp"
-#include "Renderer/Buffers/UniformHandler.hpp"
-#include "Renderer/Pipelines/PipelineGraphics.hpp"
 #include "Uis/UiObject.hpp"
 #include "FontType.hpp"
+#include "GlyphRun.hpp"
 
 namespace acid
 {
@@ -20,13 +16,7 @@ class ACID_EXPORT Text :
 	public UiObject
 {
 public:
-	/**
-	 * @brief A enum that represents how the text will be justified.
-	 */
-	enum class Justify
-	{
-		Left, Centre, Right, Fully
-	};
+	using Justify = GlyphRun::Justify;
 
 	/**
 	 * Creates a new text object.
@@ -44,21 +34,21 @@ public:
 	Text(UiObject *parent, const UiBound &rectangle, const float &fontSize, std::string text, std::shared_ptr<FontType> fontType = FontType::Create("Fonts/ProximaNova", "Regular"),
 		const Justify &justify = Justify::Left, const float &maxWidth = 1.0f, const Colour &textColour = Colour::Black, const float &kerning = 0.0f, const float &leading = 0.0f);
 
-	void UpdateObject() override;
+	~Text();
 
-	bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene);
+	void UpdateObject() override;
 
 	/**
-	 * Gets the text model, which contains all the vertex data for the quads on which the text will be rendered.
-	 * @return The model of the text.
+	 * Gets the laid out string, which contains the glyph quads on which the text will be rendered.
+	 * @return The glyph run of the text.
 	 */
-	const Model *GetModel() const { return m_model.get(); }
+	const GlyphRun *GetGlyphRun() const { return m_run.get(); }
 
 	/**
 	 * Gets the number of lines in this text.
 	 * @return The number of lines.
 	 */
-	const uint32_t &GetNumberLines() const { return m_numberLines; }
+	uint32_t GetNumberLines() const { return m_run != nullptr ? m_run->GetNumberLines() : 0; }
 
 	/**
 	 * Gets the string of text represented.
@@ -130,7 +120,7 @@ public:
 	 * Sets the colour of the text.
 	 * @param textColour The new colour of the text.
 	 */
-	void SetTextColour(const Colour &textColour) { m_textColour = textColour; }
+	void SetTextColour(const Colour &textColour);
 
 	/**
 	 * Gets the border colour of the text. This is used with border and glow drivers.
@@ -142,7 +132,7 @@ public:
 	 * Sets the border colour of the text. This is used with border and glow drivers.
 	 * @param borderColour The new border colour of the text.
 	 */
-	void SetBorderColour(const Colour &borderColour) { m_borderColour = borderColour; }
+	void SetBorderColour(const Colour &borderColour);
 
 	Driver<float> *GetGlowDriver() const { return m_glowDriver.get(); }
 
@@ -190,113 +180,23 @@ public:
 	float CalculateAntialiasSize() const;
 
 	/**
-	 * Gets if the text has been loaded to a model.
-	 * @return If the text has been loaded to a model.
+	 * Gets if the text has been laid out.
+	 * @return If the text has been laid out.
 	 */
 	bool IsLoaded() const;
 
-private:
-	/**
-	 * During the loading of a text this represents one word in the text.
-	 */
-	class Word
-	{
-	public:
-		/**
-		 * Creates a new text word.
-		 */
-		Word() :
-			m_width(0.0f)
-		{
-		}
-
-		/**
-		 * Adds a character to the end of the current word and increases the screen-space width of the word.
-		 * @param character The character to be added.
-		 * @param kerning The character kerning.
-		 */
-		void AddCharacter(const FontMetafile::Character &character, const float &kerning)
-		{
-			m_characters.emplace_back(character);
-			m_width += kerning + character.m_advanceX;
-		}
-
-		std::vector<FontMetafile::Character> m_characters;
-		float m_width;
-	};
-
-	/**
-	 * Represents a line of text during the loading of a text.
-	 */
-	class Line
-	{
-	public:
-		/**
-		 * Creates a new text line.
-		 * @param spaceWidth The screen-space width of a space character.
-		 * @param maxLength The screen-space maximum length of a line.
-		 */
-		Line(const float &spaceWidth, const float &maxLength) :
-			m_maxLength(maxLength),
-			m_spaceSize(spaceWidth),
-			m_currentWordsLength(0.0f),
-			m_currentLineLength(0.0f)
-		{
-		}
-
-		/**
-		 * Attempt to add a word to the line. If the line can fit the word in without reaching the maximum line length then the word is added and the line length increased.
-		 * @param word The word to try to add.
-		 * @return {@code true} if the word has successfully been added to the line.
-		 */
-		bool AddWord(const Word &word)
-		{
-			float additionalLength = word.m_width;
-			additionalLength += !m_words.empty() ? m_spaceSize : 0.0f;
-
-			if (m_currentLineLength + additionalLength <= m_maxLength)
-			{
-				m_words.emplace_back(word);
-				m_currentWordsLength += word.m_width;
-				m_currentLineLength += additionalLength;
-				return true;
-			}
-
-			return false;
-		}
-
-		float m_maxLength;
-		float m_spaceSize;
-
-		std::vector<Word> m_words;
-		float m_currentWordsLength;
-		float m_currentLineLength;
-	};
+protected:
+	void UpdateLayout() override;
 
+private:
 	/**
-	 * Takes in an unloaded text and calculate all of the vertices for the quads on which this text will be rendered.
-	 * The vertex positions and texture coords and calculated based on the information from the font file.
-	 * Then takes the information about the vertices of all the quads and stores it in a model.
+	 * Takes in an unloaded text and gets the glyph quads on which this text will be rendered from the font cache,
+	 * then writes them into the font text batch.
 	 */
 	void LoadText();
 
-	std::vector<Line> CreateStructure() const;
-
-	void CompleteStructure(std::vector<Line> &lines, Line &currentLine, const Word &currentWord) const;
-
-	std::vector<VertexModel> CreateQuad(const std::vector<Line> &lines);
-
-	static void AddVerticesForCharacter(const float &cursorX, const float &cursorY, const FontMetafile::Character &character, std::vector<VertexModel> &vertices);
-
-	static void AddVertex(const float &vx, const float &vy, const float &tx, const float &ty, std::vector<VertexModel> &vertices);
-
-	void NormalizeQuad(Vector2f &bounding, std::vector<VertexModel> &vertices) const;
-
-	DescriptorsHandler m_descriptorSet;
-	UniformHandler m_uniformObject;
-
-	std::unique_ptr<Model> m_model;
-	uint32_t m_numberLines;
+	std::shared_ptr<const GlyphRun> m_run;
+	uint32_t m_batchId;
 
 	std::string m_string;
 	std::optional<std::string> m_newString;
@@ -0,0 +1,319 @@
+#include "TextBatch.hpp"
+
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+static const uint32_t MIN_INSTANCES = 1024;
+static const uint32_t MIN_TEXTS = 64;
+
+static_assert(sizeof(TextBatch::TextData) == 160, "TextData must match the std430 layout of the shader block");
+
+TextBatch::TextBatch() :
+	m_instanceBuffer(nullptr),
+	m_instanceData(nullptr),
+	m_storageTexts(nullptr),
+	m_textData(nullptr)
+{
+}
+
+TextBatch::~TextBatch()
+{
+	if (m_instanceBuffer != nullptr)
+	{
+		m_instanceBuffer->UnmapMemory();
+	}
+
+	if (m_storageTexts != nullptr)
+	{
+		m_storageTexts->UnmapMemory();
+	}
+}
+
+uint32_t TextBatch::Add()
+{
+	uint32_t text;
+
+	if (!m_freeTexts.empty())
+	{
+		text = m_freeTexts.back();
+		m_freeTexts.pop_back();
+	}
+	else
+	{
+		text = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back(Slot{0, 0, 0});
+		m_texts.emplace_back(TextData());
+		m_dirtyTexts.emplace_back(text, text + 1);
+	}
+
+	return text;
+}
+
+void TextBatch::Remove(const uint32_t &text)
+{
+	FreeSlot(m_slots[text]);
+	m_texts[text] = TextData();
+	m_dirtyTexts.emplace_back(text, text + 1);
+	m_freeTexts.emplace_back(text);
+}
+
+void TextBatch::SetGlyphs(const uint32_t &text, const std::vector<GlyphQuad> &quads)
+{
+	auto &slot = m_slots[text];
+	auto count = static_cast<uint32_t>(quads.size());
+	auto previous = slot.m_count;
+
+	if (count > slot.m_capacity)
+	{
+		FreeSlot(slot);
+		AllocateSlot(slot, count);
+		previous = 0;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		m_instances[slot.m_offset + i] = GlyphInstance{quads[i].m_position, quads[i].m_textureCoords, text, quads[i].m_page};
+	}
+
+	// Glyphs left over from a longer string become empty quads.
+	for (auto i = count; i < previous; i++)
+	{
+		m_instances[slot.m_offset + i] = GlyphInstance{};
+	}
+
+	slot.m_count = count;
+	auto end = std::max(count, previous);
+
+	if (end != 0)
+	{
+		m_dirtyInstances.emplace_back(slot.m_offset, slot.m_offset + end);
+	}
+}
+
+void TextBatch::SetData(const uint32_t &text, const TextData &data)
+{
+	if (std::memcmp(&m_texts[text], &data, sizeof(TextData)) == 0)
+	{
+		return;
+	}
+
+	m_texts[text] = data;
+	m_dirtyTexts.emplace_back(text, text + 1);
+}
+
+bool TextBatch::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene, const std::shared_ptr<Image2d> &texture,
+	const std::vector<std::unique_ptr<Image2d>> &pages)
+{
+	Upload();
+
+	if (m_instanceBuffer == nullptr || m_storageTexts == nullptr)
+	{
+		return false;
+	}
+
+	if (m_descriptorSets.size() < pages.size() + 1)
+	{
+		m_descriptorSets.resize(pages.size() + 1);
+	}
+
+	VkDeviceSize offsets[] = { 0 };
+	vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_instanceBuffer->GetBuffer(), offsets);
+
+	// The prebaked atlas is drawn first, then each runtime atlas page.
+	auto rendered = CmdRenderPage(commandBuffer, pipeline, uniformScene, texture.get(), 0);
+
+	for (uint32_t i = 0; i < pages.size(); i++)
+	{
+		rendered |= CmdRenderPage(commandBuffer, pipeline, uniformScene, pages[i].get(), i + 1);
+	}
+
+	return rendered;
+}
+
+Shader::VertexInput TextBatch::GetVertexInput(const uint32_t &baseBinding)
+{
+	std::vector<VkVertexInputBindingDescription> bindingDescriptions = {
+		VkVertexInputBindingDescription{baseBinding, sizeof(GlyphInstance), VK_VERTEX_INPUT_RATE_INSTANCE}
+	};
+	std::vector<VkVertexInputAttributeDescription> attributeDescriptions = {
+		VkVertexInputAttributeDescription{0, baseBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(GlyphInstance, m_position)},
+		VkVertexInputAttributeDescription{1, baseBinding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(GlyphInstance, m_textureCoords)},
+		VkVertexInputAttributeDescription{2, baseBinding, VK_FORMAT_R32_UINT, offsetof(GlyphInstance, m_text)},
+		VkVertexInputAttributeDescription{3, baseBinding, VK_FORMAT_R32_UINT, offsetof(GlyphInstance, m_page)}
+	};
+	return Shader::VertexInput(bindingDescriptions, attributeDescriptions);
+}
+
+uint32_t TextBatch::GetSizeClass(const uint32_t &count)
+{
+	uint32_t sizeClass = 0;
+
+	while ((MinSlotCapacity << sizeClass) < count)
+	{
+		sizeClass++;
+	}
+
+	return sizeClass;
+}
+
+void TextBatch::AllocateSlot(Slot &slot, const uint32_t &count)
+{
+	auto sizeClass = GetSizeClass(count);
+	slot.m_capacity = MinSlotCapacity << sizeClass;
+	slot.m_count = 0;
+
+	if (sizeClass < m_freeSlots.size() && !m_freeSlots[sizeClass].empty())
+	{
+		slot.m_offset = m_freeSlots[sizeClass].back();
+		m_freeSlots[sizeClass].pop_back();
+		return;
+	}
+
+	// New slots are added to the end, and uploaded whole so the buffer never holds stale glyphs there.
+	slot.m_offset = static_cast<uint32_t>(m_instances.size());
+	m_instances.resize(m_instances.size() + slot.m_capacity);
+	m_dirtyInstances.emplace_back(slot.m_offset, slot.m_offset + slot.m_capacity);
+}
+
+void TextBatch::FreeSlot(Slot &slot)
+{
+	if (slot.m_capacity == 0)
+	{
+		return;
+	}
+
+	std::fill(m_instances.begin() + slot.m_offset, m_instances.begin() + slot.m_offset + slot.m_count, GlyphInstance{});
+
+	if (slot.m_count != 0)
+	{
+		m_dirtyInstances.emplace_back(slot.m_offset, slot.m_offset + slot.m_count);
+	}
+
+	auto sizeClass = GetSizeClass(slot.m_capacity);
+
+	if (sizeClass >= m_freeSlots.size())
+	{
+		m_freeSlots.resize(sizeClass + 1);
+	}
+
+	m_freeSlots[sizeClass].emplace_back(slot.m_offset);
+	slot = Slot{0, 0, 0};
+}
+
+void TextBatch::Upload()
+{
+	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+
+	if (!m_instances.empty() && (m_instanceBuffer == nullptr || m_instanceBuffer->GetSize() < m_instances.size() * sizeof(GlyphInstance)))
+	{
+		auto capacity = static_cast<VkDeviceSize>(MIN_INSTANCES);
+
+		if (m_instanceBuffer != nullptr)
+		{
+			// The old buffer may still be read by a frame in flight.
+			Renderer::CheckVk(vkDeviceWaitIdle(*logicalDevice));
+			m_instanceBuffer->UnmapMemory();
+			capacity = 2 * m_instanceBuffer->GetSize() / sizeof(GlyphInstance);
+		}
+
+		while (capacity < m_instances.size())
+		{
+			capacity *= 2;
+		}
+
+		m_instanceBuffer = std::make_unique<Buffer>(capacity * sizeof(GlyphInstance), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		m_instanceBuffer->MapMemory(reinterpret_cast<void **>(&m_instanceData));
+		m_dirtyInstances = { Range(0, static_cast<uint32_t>(m_instances.size())) };
+	}
+
+	if (!m_texts.empty() && (m_storageTexts == nullptr || m_storageTexts->GetSize() < m_texts.size() * sizeof(TextData)))
+	{
+		auto capacity = static_cast<VkDeviceSize>(MIN_TEXTS);
+
+		if (m_storageTexts != nullptr)
+		{
+			Renderer::CheckVk(vkDeviceWaitIdle(*logicalDevice));
+			m_storageTexts->UnmapMemory();
+			capacity = 2 * m_storageTexts->GetSize() / sizeof(TextData);
+		}
+
+		while (capacity < m_texts.size())
+		{
+			capacity *= 2;
+		}
+
+		m_storageTexts = std::make_unique<StorageBuffer>(capacity * sizeof(TextData));
+		m_storageTexts->MapMemory(reinterpret_cast<void **>(&m_textData));
+		m_dirtyTexts = { Range(0, static_cast<uint32_t>(m_texts.size())) };
+	}
+
+	MergeRanges(m_dirtyInstances);
+
+	for (const auto &[begin, end] : m_dirtyInstances)
+	{
+		std::memcpy(m_instanceData + begin, m_instances.data() + begin, (end - begin) * sizeof(GlyphInstance));
+	}
+
+	MergeRanges(m_dirtyTexts);
+
+	for (const auto &[begin, end] : m_dirtyTexts)
+	{
+		std::memcpy(m_textData + begin, m_texts.data() + begin, (end - begin) * sizeof(TextData));
+	}
+
+	m_dirtyInstances.clear();
+	m_dirtyTexts.clear();
+}
+
+bool TextBatch::CmdRenderPage(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene, const Image2d *texture,
+	const uint32_t &page)
+{
+	auto &descriptorSet = m_descriptorSets[page];
+
+	// Updates descriptors.
+	descriptorSet.Push("UniformScene", uniformScene);
+	descriptorSet.Push("BufferTexts", *m_storageTexts);
+	descriptorSet.Push("samplerColour", texture);
+	descriptorSet.Push("PushPage", m_pushPage);
+	bool updateSuccess = descriptorSet.Update(pipeline);
+
+	if (!updateSuccess)
+	{
+		return false;
+	}
+
+	// Draws every glyph of every text, glyphs on other pages and unused glyphs are collapsed by the vertex shader.
+	m_pushPage.Push("page", page);
+	descriptorSet.BindDescriptor(commandBuffer, pipeline);
+	m_pushPage.BindPush(commandBuffer, pipeline);
+	vkCmdDraw(commandBuffer, 4, static_cast<uint32_t>(m_instances.size()), 0, 0);
+	return true;
+}
+
+void TextBatch::MergeRanges(std::vector<Range> &ranges)
+{
+	if (ranges.size() < 2)
+	{
+		return;
+	}
+
+	std::sort(ranges.begin(), ranges.end());
+	std::size_t merged = 0;
+
+	for (std::size_t i = 1; i < ranges.size(); i++)
+	{
+		if (ranges[i].first <= ranges[merged].second)
+		{
+			ranges[merged].second = std::max(ranges[merged].second, ranges[i].second);
+		}
+		else
+		{
+			ranges[++merged] = ranges[i];
+		}
+	}
+
+	ranges.resize(merged + 1);
+}
+}
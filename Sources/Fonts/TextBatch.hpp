@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Colour.hpp"
+#include "Maths/Matrix4.hpp"
+#include "Maths/Vector4.hpp"
+#include "Renderer/Buffers/Buffer.hpp"
+#include "Renderer/Buffers/PushHandler.hpp"
+#include "Renderer/Buffers/StorageBuffer.hpp"
+#include "Renderer/Buffers/UniformHandler.hpp"
+#include "Renderer/Descriptors/DescriptorsHandler.hpp"
+#include "Renderer/Images/Image2d.hpp"
+#include "Renderer/Pipelines/PipelineGraphics.hpp"
+#include "GlyphRun.hpp"
+
+namespace acid
+{
+/**
+ * @brief Holds the glyphs of every text using a font in one instance buffer, so all of them are drawn in a single call.
+ * Each text owns a fixed capacity slot of glyphs that is rewritten in place when its string changes, and only the ranges
+ * that changed since the last frame are copied into the persistently mapped buffers.
+ * Glyphs from the runtime glyph atlas sample its pages, the buffer is drawn once per texture and each draw only keeps its own glyphs.
+ */
+class ACID_EXPORT TextBatch :
+	public NonCopyable
+{
+public:
+	/**
+	 * @brief A glyph instance, drawn as a four vertex strip.
+	 */
+	struct GlyphInstance
+	{
+		Rect m_position;
+		Rect m_textureCoords;
+		uint32_t m_text;
+		uint32_t m_page;
+	};
+
+	/**
+	 * @brief The per text values read by the shaders, laid out to match the std430 storage block.
+	 */
+	struct TextData
+	{
+		Matrix4 m_modelMatrix;
+		Vector4f m_screenOffset;
+		Colour m_colour;
+		Colour m_borderColour;
+		Vector4f m_scissor;
+		Vector2f m_borderSizes;
+		Vector2f m_edgeData;
+		int32_t m_modelMode;
+		float m_depth;
+		float m_alpha;
+		float m_padding;
+	};
+
+	/// The smallest number of glyphs a slot is created with, slots grow by powers of two.
+	static constexpr uint32_t MinSlotCapacity = 8;
+
+	TextBatch();
+
+	~TextBatch();
+
+	/**
+	 * Adds a text to the batch.
+	 * @return The id of the text in the batch.
+	 */
+	uint32_t Add();
+
+	/**
+	 * Removes a text from the batch, its glyphs stop being drawn and its slot is reused.
+	 * @param text The id of the text.
+	 */
+	void Remove(const uint32_t &text);
+
+	/**
+	 * Writes the glyphs of a text into its slot, moving it to a larger slot if they don't fit.
+	 * @param text The id of the text.
+	 * @param quads The glyph quads.
+	 */
+	void SetGlyphs(const uint32_t &text, const std::vector<GlyphQuad> &quads);
+
+	/**
+	 * Sets the values of a text, only uploaded if they changed.
+	 * @param text The id of the text.
+	 * @param data The text values.
+	 */
+	void SetData(const uint32_t &text, const TextData &data);
+
+	/**
+	 * Draws every text in the batch.
+	 * @param commandBuffer The command buffer to record into.
+	 * @param pipeline The font pipeline.
+	 * @param uniformScene The scene uniforms.
+	 * @param texture The prebaked font atlas, sampled by glyphs on page 0.
+	 * @param pages The runtime glyph atlas pages, sampled by glyphs on the following pages.
+	 * @return If anything was drawn.
+	 */
+	bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene, const std::shared_ptr<Image2d> &texture,
+		const std::vector<std::unique_ptr<Image2d>> &pages);
+
+	static Shader::VertexInput GetVertexInput(const uint32_t &baseBinding = 0);
+
+	uint32_t GetTextCount() const { return static_cast<uint32_t>(m_slots.size() - m_freeTexts.size()); }
+
+	uint32_t GetInstanceCount() const { return static_cast<uint32_t>(m_instances.size()); }
+
+private:
+	struct Slot
+	{
+		uint32_t m_offset;
+		uint32_t m_capacity;
+		uint32_t m_count;
+	};
+
+	using Range = std::pair<uint32_t, uint32_t>;
+
+	static uint32_t GetSizeClass(const uint32_t &count);
+
+	void AllocateSlot(Slot &slot, const uint32_t &count);
+
+	void FreeSlot(Slot &slot);
+
+	/**
+	 * Copies the changed instances and text values into the mapped buffers, recreating them if they have grown.
+	 */
+	void Upload();
+
+	/**
+	 * Draws the glyphs that sample one texture.
+	 * @param commandBuffer The command buffer to record into.
+	 * @param pipeline The font pipeline.
+	 * @param uniformScene The scene uniforms.
+	 * @param texture The texture.
+	 * @param page The page of the glyphs drawn.
+	 * @return If the glyphs were drawn.
+	 */
+	bool CmdRenderPage(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene, const Image2d *texture,
+		const uint32_t &page);
+
+	/**
+	 * Sorts and joins touching ranges.
+	 * @param ranges The ranges to merge.
+	 */
+	static void MergeRanges(std::vector<Range> &ranges);
+
+	std::vector<GlyphInstance> m_instances;
+	std::vector<Range> m_dirtyInstances;
+	std::vector<std::vector<uint32_t>> m_freeSlots;
+
+	std::vector<Slot> m_slots;
+	std::vector<TextData> m_texts;
+	std::vector<Range> m_dirtyTexts;
+	std::vector<uint32_t> m_freeTexts;
+
+	std::unique_ptr<Buffer> m_instanceBuffer;
+	GlyphInstance *m_instanceData;
+	std::unique_ptr<StorageBuffer> m_storageTexts;
+	TextData *m_textData;
+
+	/// One descriptor set per texture, sets can't be changed while a command buffer using them is recorded.
+	std::vector<DescriptorsHandler> m_descriptorSets;
+	PushHandler m_pushPage;
+};
+}
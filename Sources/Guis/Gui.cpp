@@ -1,75 +1,123 @@
 ﻿#include "Gui.hpp"
 
-#include "Renderer/Renderer.hpp"
-#include "Models/Shapes/ModelRectangle.hpp"
 #include "Maths/Visual/DriverConstant.hpp"
+#include "Uis/Uis.hpp"
 
 namespace acid
 {
 Gui::Gui(UiObject *parent, const UiBound &rectangle, std::shared_ptr<Image2d> texture, const Colour &colourOffset) :
 	UiObject(parent, rectangle),
-	m_model(ModelRectangle::Create(0.0f, 1.0f)),
-	m_texture(std::move(texture)),
+	m_batch(nullptr),
+	m_batchId(0),
 	m_numberOfRows(1),
 	m_selectedRow(0),
 	m_atlasScale(1.0f, 1.0f),
 	m_ninePatches(0.0f),
-	m_colourDriver(std::make_unique<DriverConstant<Colour>>(colourOffset))
+	m_colourDriver(std::make_unique<DriverConstant<Colour>>(colourOffset)),
+	m_colourOffset(colourOffset)
 {
+	SetTexture(texture);
+}
+
+Gui::~Gui()
+{
+	if (m_batch != nullptr)
+	{
+		m_batch->Remove(m_batchId);
+	}
 }
 
 void Gui::UpdateObject()
 {
-	int32_t numberOfRows = m_texture != nullptr ? m_numberOfRows : 1;
-	int32_t column = m_selectedRow % numberOfRows;
-	int32_t row = m_selectedRow / numberOfRows;
-	m_atlasOffset = Vector2f(static_cast<float>(column) / static_cast<float>(numberOfRows), static_cast<float>(row) / static_cast<float>(numberOfRows));
+	// The colour driver is only evaluated until it finishes.
+	if (!m_colourDriver->IsFinished())
+	{
+		auto colourOffset = m_colourDriver->Update(Engine::Get()->GetDelta());
 
-	m_colourOffset = m_colourDriver->Update(Engine::Get()->GetDelta());
-
-	// Updates uniforms.
-	m_uniformObject.Push("aspectRatio", Window::Get()->GetAspectRatio());
-	m_uniformObject.Push("modelMatrix", GetModelMatrix());
-	m_uniformObject.Push("screenOffset", Vector4f(2.0f * GetScreenSize(), 2.0f * GetScreenPosition() - 1.0f));
-	m_uniformObject.Push("modelMode", GetWorldTransform() ? (IsLockRotation() + 1) : 0);
-	m_uniformObject.Push("depth", GetScreenDepth());
-	m_uniformObject.Push("alpha", GetScreenAlpha());
-
-	m_uniformObject.Push("colourOffset", m_colourOffset);
-	m_uniformObject.Push("atlasOffset", m_atlasOffset);
-	m_uniformObject.Push("atlasScale", m_atlasScale);
-	m_uniformObject.Push("atlasRows", static_cast<float>(m_numberOfRows));
-	m_uniformObject.Push("ninePatches", m_ninePatches);
+		if (colourOffset != m_colourOffset)
+		{
+			m_colourOffset = colourOffset;
+			MarkDirty();
+		}
+	}
 }
 
-bool Gui::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene)
+void Gui::SetTexture(const std::shared_ptr<Image2d> &texture)
 {
-	// Gets if this should be rendered.
-	if (m_texture == nullptr || !IsEnabled())
+	if (m_batch != nullptr)
 	{
-		return false;
+		m_batch->Remove(m_batchId);
+		m_batch = nullptr;
 	}
 
-	// Updates descriptors.
-	m_descriptorSet.Push("UniformScene", uniformScene);
-	m_descriptorSet.Push("UniformObject", m_uniformObject);
-	m_descriptorSet.Push("samplerColour", m_texture);
-	bool updateSuccess = m_descriptorSet.Update(pipeline);
+	m_texture = texture;
 
-	if (!updateSuccess)
+	// Guis without a texture are not drawn.
+	if (m_texture != nullptr)
 	{
-		return false;
+		m_batch = &Uis::Get()->GetGuiBatch(m_texture);
+		m_batchId = m_batch->Add();
 	}
 
-	VkRect2D scissorRect = {};
-	scissorRect.offset.x = static_cast<int32_t>(pipeline.GetSize().m_x * GetScissor().m_x);
-	scissorRect.offset.y = static_cast<int32_t>(pipeline.GetSize().m_y * GetScissor().m_y);
-	scissorRect.extent.width = static_cast<uint32_t>(pipeline.GetSize().m_x * GetScissor().m_z);
-	scissorRect.extent.height = static_cast<uint32_t>(pipeline.GetSize().m_y * GetScissor().m_w);
-	vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
+	MarkDirty();
+}
+
+void Gui::SetNumberOfRows(const uint32_t &numberOfRows)
+{
+	m_numberOfRows = numberOfRows;
+	MarkDirty();
+}
+
+void Gui::SetSelectedRow(const uint32_t &selectedRow)
+{
+	m_selectedRow = selectedRow;
+	MarkDirty();
+}
+
+void Gui::SetAtlasScale(const Vector2f &atlasScale)
+{
+	m_atlasScale = atlasScale;
+	MarkDirty();
+}
+
+void Gui::SetNinePatches(const Vector4f &ninePatches)
+{
+	m_ninePatches = ninePatches;
+	MarkDirty();
+}
+
+void Gui::SetColourDriver(Driver<Colour> *colourDriver)
+{
+	m_colourDriver.reset(colourDriver);
+	m_colourOffset = m_colourDriver->Update(Time::Zero);
+	MarkDirty();
+}
+
+void Gui::UpdateLayout()
+{
+	int32_t numberOfRows = m_texture != nullptr ? m_numberOfRows : 1;
+	int32_t column = m_selectedRow % numberOfRows;
+	int32_t row = m_selectedRow / numberOfRows;
+	m_atlasOffset = Vector2f(static_cast<float>(column) / static_cast<float>(numberOfRows), static_cast<float>(row) / static_cast<float>(numberOfRows));
+
+	if (m_batch == nullptr)
+	{
+		return;
+	}
 
-	// Draws the object.
-	m_descriptorSet.BindDescriptor(commandBuffer, pipeline);
-	return m_model->CmdRender(commandBuffer);
+	// Updates the values in the texture batch, disabled guis stay in the batch but are not seen.
+	GuiBatch::GuiData data = GuiBatch::GuiData();
+	data.m_modelMatrix = GetModelMatrix();
+	data.m_screenOffset = Vector4f(2.0f * GetScreenSize(), 2.0f * GetScreenPosition() - 1.0f);
+	data.m_colourOffset = m_colourOffset;
+	data.m_scissor = GetScissor();
+	data.m_ninePatches = m_ninePatches;
+	data.m_atlasOffset = m_atlasOffset;
+	data.m_atlasScale = m_atlasScale;
+	data.m_atlasRows = static_cast<float>(m_numberOfRows);
+	data.m_modelMode = GetWorldTransform() ? (IsLockRotation() + 1) : 0;
+	data.m_depth = GetScreenDepth();
+	data.m_alpha = IsEnabled() ? GetScreenAlpha() : 0.0f;
+	m_batch->SetData(m_batchId, data);
 }
 }
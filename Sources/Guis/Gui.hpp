@@ -2,17 +2,14 @@
 
 #include "Maths/Colour.hpp"
 #include "Maths/Vector2.hpp"
-#include "Models/Model.hpp"
-#include "Renderer/Buffers/UniformHandler.hpp"
-#include "Renderer/Descriptors/DescriptorsHandler.hpp"
 #include "Renderer/Images/Image2d.hpp"
-#include "Renderer/Pipelines/PipelineGraphics.hpp"
 #include "Uis/UiObject.hpp"
+#include "GuiBatch.hpp"
 
 namespace acid
 {
 /**
- * @brief Class that represents a image UI.
+ * @brief Class that represents a image UI, drawn in the batch of its texture.
  */
 class ACID_EXPORT Gui :
 	public UiObject
@@ -27,27 +24,31 @@ public:
 	 */
 	Gui(UiObject *parent, const UiBound &rectangle, std::shared_ptr<Image2d> texture, const Colour &colourOffset = Colour::White);
 
-	void UpdateObject() override;
+	~Gui();
 
-	bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene);
+	void UpdateObject() override;
 
 	const std::shared_ptr<Image2d> &GetTexture() const { return m_texture; }
 
-	void SetTexture(const std::shared_ptr<Image2d> &texture) { m_texture = texture; }
+	/**
+	 * Sets the texture, moving the gui into the batch of the new texture.
+	 * @param texture The new texture.
+	 */
+	void SetTexture(const std::shared_ptr<Image2d> &texture);
 
 	const uint32_t &GetNumberOfRows() const { return m_numberOfRows; }
 
-	void SetNumberOfRows(const uint32_t &numberOfRows) { m_numberOfRows = numberOfRows; }
+	void SetNumberOfRows(const uint32_t &numberOfRows);
 
 	const uint32_t &GetSelectedRow() const { return m_selectedRow; }
 
-	void SetSelectedRow(const uint32_t &selectedRow) { m_selectedRow = selectedRow; }
+	void SetSelectedRow(const uint32_t &selectedRow);
 
 	const Vector2f &GetAtlasOffset() const { return m_atlasOffset; }
 	
 	const Vector2f &GetAtlasScale() const { return m_atlasScale; }
 	
-	void SetAtlasScale(const Vector2f &atlasScale) { m_atlasScale = atlasScale; }
+	void SetAtlasScale(const Vector2f &atlasScale);
 
 	const Vector4f &GetNinePatches() const { return m_ninePatches; }
 
@@ -56,7 +57,7 @@ public:
 	 * 9-patch/9-slicing allows for a single section of a texture to be scale with corners and edges kept in the screens aspect ratio.
 	 * @param ninePatches The values, x/y being to top left corner and z/w bottom right for the scalable section.
 	 */
-	void SetNinePatches(const Vector4f &ninePatches) { m_ninePatches = ninePatches; }
+	void SetNinePatches(const Vector4f &ninePatches);
 
 	Driver<Colour> *GetColourDriver() const { return m_colourDriver.get(); }
 
@@ -64,15 +65,17 @@ public:
 	 * Sets the colour offset driver.
 	 * @param colourDriver The new colour offset driver.
 	 */
-	void SetColourDriver(Driver<Colour> *colourDriver) { m_colourDriver.reset(colourDriver); }
+	void SetColourDriver(Driver<Colour> *colourDriver);
 
 	const Colour &GetColourOffset() const { return m_colourOffset; }
 
+protected:
+	void UpdateLayout() override;
+
 private:
-	DescriptorsHandler m_descriptorSet;
-	UniformHandler m_uniformObject;
+	GuiBatch *m_batch;
+	uint32_t m_batchId;
 
-	std::shared_ptr<Model> m_model;
 	std::shared_ptr<Image2d> m_texture;
 	uint32_t m_numberOfRows;
 	uint32_t m_selectedRow;
@@ -0,0 +1,137 @@
+#include "GuiBatch.hpp"
+
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+static const uint32_t MIN_GUIS = 256;
+
+static_assert(sizeof(GuiBatch::GuiData) == 160, "GuiData must match the std430 layout of the shader block");
+
+GuiBatch::GuiBatch(std::shared_ptr<Image2d> texture) :
+	m_texture(std::move(texture)),
+	m_storageGuis(nullptr),
+	m_guiData(nullptr),
+	m_emptyFrames(0)
+{
+}
+
+GuiBatch::~GuiBatch()
+{
+	if (m_storageGuis != nullptr)
+	{
+		m_storageGuis->UnmapMemory();
+	}
+}
+
+uint32_t GuiBatch::Add()
+{
+	uint32_t gui;
+	m_emptyFrames = 0;
+
+	if (!m_freeGuis.empty())
+	{
+		gui = m_freeGuis.back();
+		m_freeGuis.pop_back();
+	}
+	else
+	{
+		gui = static_cast<uint32_t>(m_guis.size());
+		m_guis.emplace_back(GuiData());
+		m_dirtyGuis.emplace_back(gui);
+	}
+
+	return gui;
+}
+
+void GuiBatch::Remove(const uint32_t &gui)
+{
+	m_guis[gui] = GuiData();
+	m_dirtyGuis.emplace_back(gui);
+	m_freeGuis.emplace_back(gui);
+}
+
+void GuiBatch::SetData(const uint32_t &gui, const GuiData &data)
+{
+	if (std::memcmp(&m_guis[gui], &data, sizeof(GuiData)) == 0)
+	{
+		return;
+	}
+
+	m_guis[gui] = data;
+	m_dirtyGuis.emplace_back(gui);
+}
+
+bool GuiBatch::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene)
+{
+	if (GetGuiCount() == 0)
+	{
+		m_emptyFrames++;
+		return false;
+	}
+
+	Upload();
+
+	// Updates descriptors.
+	m_descriptorSet.Push("UniformScene", uniformScene);
+	m_descriptorSet.Push("BufferGuis", *m_storageGuis);
+	m_descriptorSet.Push("samplerColour", m_texture);
+	bool updateSuccess = m_descriptorSet.Update(pipeline);
+
+	if (!updateSuccess)
+	{
+		return false;
+	}
+
+	// Draws every gui as a four vertex strip, removed guis have no alpha.
+	m_descriptorSet.BindDescriptor(commandBuffer, pipeline);
+	vkCmdDraw(commandBuffer, 4, static_cast<uint32_t>(m_guis.size()), 0, 0);
+	return true;
+}
+
+bool GuiBatch::IsUnused() const
+{
+	// Nothing was rendered yet or the batch is still used.
+	if (GetGuiCount() != 0 || m_emptyFrames == 0)
+	{
+		return false;
+	}
+
+	// Each frame in flight has its own swapchain image, the oldest has finished once as many frames have been rendered.
+	return m_emptyFrames > Renderer::Get()->GetSwapchain()->GetImageCount();
+}
+
+void GuiBatch::Upload()
+{
+	if (m_storageGuis == nullptr || m_storageGuis->GetSize() < m_guis.size() * sizeof(GuiData))
+	{
+		auto capacity = static_cast<VkDeviceSize>(MIN_GUIS);
+
+		if (m_storageGuis != nullptr)
+		{
+			// The old buffer may still be read by a frame in flight.
+			Renderer::CheckVk(vkDeviceWaitIdle(*Renderer::Get()->GetLogicalDevice()));
+			m_storageGuis->UnmapMemory();
+			capacity = 2 * m_storageGuis->GetSize() / sizeof(GuiData);
+		}
+
+		while (capacity < m_guis.size())
+		{
+			capacity *= 2;
+		}
+
+		m_storageGuis = std::make_unique<StorageBuffer>(capacity * sizeof(GuiData));
+		m_storageGuis->MapMemory(reinterpret_cast<void **>(&m_guiData));
+		std::memcpy(m_guiData, m_guis.data(), m_guis.size() * sizeof(GuiData));
+		m_dirtyGuis.clear();
+		return;
+	}
+
+	for (const auto &gui : m_dirtyGuis)
+	{
+		m_guiData[gui] = m_guis[gui];
+	}
+
+	m_dirtyGuis.clear();
+}
+}
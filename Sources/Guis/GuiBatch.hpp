@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Colour.hpp"
+#include "Maths/Matrix4.hpp"
+#include "Maths/Vector4.hpp"
+#include "Renderer/Buffers/StorageBuffer.hpp"
+#include "Renderer/Buffers/UniformHandler.hpp"
+#include "Renderer/Descriptors/DescriptorsHandler.hpp"
+#include "Renderer/Images/Image2d.hpp"
+#include "Renderer/Pipelines/PipelineGraphics.hpp"
+
+namespace acid
+{
+/**
+ * @brief Holds the values of every gui using a texture in one storage buffer, so all of them are drawn in a single instanced call.
+ * Only the guis that changed since the last frame are copied into the persistently mapped buffer.
+ */
+class ACID_EXPORT GuiBatch :
+	public NonCopyable
+{
+public:
+	/**
+	 * @brief The per gui values read by the shaders, laid out to match the std430 storage block.
+	 */
+	struct GuiData
+	{
+		Matrix4 m_modelMatrix;
+		Vector4f m_screenOffset;
+		Colour m_colourOffset;
+		Vector4f m_scissor;
+		Vector4f m_ninePatches;
+		Vector2f m_atlasOffset;
+		Vector2f m_atlasScale;
+		float m_atlasRows;
+		int32_t m_modelMode;
+		float m_depth;
+		float m_alpha;
+	};
+
+	/**
+	 * Creates a new gui batch.
+	 * @param texture The texture every gui in the batch is drawn with.
+	 */
+	explicit GuiBatch(std::shared_ptr<Image2d> texture);
+
+	~GuiBatch();
+
+	/**
+	 * Adds a gui to the batch.
+	 * @return The id of the gui in the batch.
+	 */
+	uint32_t Add();
+
+	/**
+	 * Removes a gui from the batch, it stops being drawn and its slot is reused.
+	 * @param gui The id of the gui.
+	 */
+	void Remove(const uint32_t &gui);
+
+	/**
+	 * Sets the values of a gui, only uploaded if they changed.
+	 * @param gui The id of the gui.
+	 * @param data The gui values.
+	 */
+	void SetData(const uint32_t &gui, const GuiData &data);
+
+	bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene);
+
+	const std::shared_ptr<Image2d> &GetTexture() const { return m_texture; }
+
+	uint32_t GetGuiCount() const { return static_cast<uint32_t>(m_guis.size() - m_freeGuis.size()); }
+
+	/**
+	 * Gets if the batch has had no guis since before any frame in flight was recorded, so it can be destroyed.
+	 * @return If the batch is unused.
+	 */
+	bool IsUnused() const;
+
+private:
+	/**
+	 * Copies the changed gui values into the mapped buffer, recreating it if it has grown.
+	 */
+	void Upload();
+
+	std::shared_ptr<Image2d> m_texture;
+
+	std::vector<GuiData> m_guis;
+	std::vector<uint32_t> m_dirtyGuis;
+	std::vector<uint32_t> m_freeGuis;
+
+	std::unique_ptr<StorageBuffer> m_storageGuis;
+	GuiData *m_guiData;
+
+	DescriptorsHandler m_descriptorSet;
+
+	/// Frames rendered since the batch was left without guis.
+	uint32_t m_emptyFrames;
+};
+}
@@ -1,15 +1,16 @@
 #include "RendererGuis.hpp"
 
-#include "Models/VertexModel.hpp"
+#include "Devices/Window.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Uis/Uis.hpp"
-#include "Gui.hpp"
+#include "GuiBatch.hpp"
 
 namespace acid
 {
 RendererGuis::RendererGuis(const Pipeline::Stage &pipelineStage) :
 	RenderPipeline(pipelineStage),
-	m_pipeline(pipelineStage, { "Shaders/Guis/Gui.vert", "Shaders/Guis/Gui.frag" }, { VertexModel::GetVertexInput() })
+	m_pipeline(pipelineStage, { "Shaders/Guis/Gui.vert", "Shaders/Guis/Gui.frag" }, {}, {}, PipelineGraphics::Mode::Polygon, PipelineGraphics::Depth::ReadWrite,
+		VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP)
 {
 }
 
@@ -17,23 +18,22 @@ void RendererGuis::Render(const CommandBuffer &commandBuffer)
 {
 	auto camera = Scenes::Get()->GetCamera();
 	m_uniformScene.Push("projection", camera->GetProjectionMatrix());
-	m_uniformScene.Push("view", camera->GetViewMatrix());
+	m_uniformScene.Push("view", camera->GetRenderViewMatrix());
+	m_uniformScene.Push("size", Vector2f(m_pipeline.GetSize()));
+	m_uniformScene.Push("aspectRatio", Window::Get()->GetAspectRatio());
 
 	m_pipeline.BindPipeline(commandBuffer);
 
-	for (const auto &screenObject : Uis::Get()->GetObjects())
-	{
-		if (!screenObject->IsEnabled())
-		{
-			continue;
-		}
-
-		auto object = dynamic_cast<Gui *>(screenObject);
+	// Guis clip to their scissor in the fragment shader.
+	VkRect2D scissorRect = {};
+	scissorRect.extent.width = m_pipeline.GetSize().m_x;
+	scissorRect.extent.height = m_pipeline.GetSize().m_y;
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
 
-		if (object != nullptr)
-		{
-			object->CmdRender(commandBuffer, m_pipeline, m_uniformScene);
-		}
+	// Every gui with a texture is in its batch, so each texture is drawn once.
+	for (const auto &batch : Uis::Get()->GetGuiBatches())
+	{
+		batch->CmdRender(commandBuffer, m_pipeline, m_uniformScene);
 	}
 }
 }
@@ -1,121 +1,324 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
-#include <algorithm>
-#include <functional>
 
 namespace acid
 {
 template<typename>
 class Delegate;
 
+/**
+ * @brief A list of functions that are called together, like a C# multicast delegate.
+ *
+ * Functions are kept in an array that is never changed once published, adding or removing a function publishes a changed copy.
+ * Invoking reads the current array without locking or allocating, replaced arrays are freed once no invoke is reading them.
+ * Functions no larger than {@link Delegate#BufferSize} are stored inside the array, larger functions are allocated when added.
+ * @tparam TReturnType The return type, invoking returns the result of the last function called.
+ * @tparam TArgs The argument types.
+ */
 template<typename TReturnType, typename... TArgs>
-struct Invoker
+class Delegate<TReturnType(TArgs ...)>
 {
-	using ReturnType = std::vector<TReturnType>;
+public:
+	/// Identifies an added function so it can be removed, no function is given 0.
+	using Token = uint64_t;
+	using ReturnType = std::conditional_t<std::is_void_v<TReturnType>, void, std::optional<TReturnType>>;
+
+	static constexpr std::size_t BufferSize = 4 * sizeof(void *);
 
-	static ReturnType Invoke(Delegate<TReturnType(TArgs ...)> &delegate, TArgs ... params)
+	Delegate() :
+		m_list(nullptr),
+		m_readers(0),
+		m_retiring(false),
+		m_nextToken(1)
 	{
-		std::lock_guard<std::mutex> lock(delegate.m_mutex);
-		ReturnType returnValues;
+	}
 
-		for (const auto &functionPtr : delegate.m_functionList)
-		{
-			returnValues.emplace_back((*functionPtr)(params...));
-		}
+	Delegate(const Delegate &) = delete;
+
+	Delegate &operator=(const Delegate &) = delete;
 
-		return returnValues;
+	virtual ~Delegate()
+	{
+		delete m_list.load();
 	}
-};
 
-template<typename... TArgs>
-struct Invoker<void, TArgs...>
-{
-	using ReturnType = void;
+	/**
+	 * Adds a function to be called on invoke.
+	 * @tparam F The callable type, it must be copyable.
+	 * @param function The function.
+	 * @return The token used to remove the function.
+	 */
+	template<typename F>
+	Token Add(F &&function)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto list = Copy(0);
+		auto token = m_nextToken++;
+		list->emplace_back(token, std::forward<F>(function));
+		Publish(std::move(list));
+		return token;
+	}
+
+	/**
+	 * Removes a function, it may still be called by invokes that have already started.
+	 * @param token The token returned when the function was added.
+	 * @return This delegate.
+	 */
+	Delegate &Remove(const Token &token)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Publish(Copy(token));
+		return *this;
+	}
 
-	static void Invoke(Delegate<void(TArgs ...)> &delegate, TArgs ... params)
+	/**
+	 * Calls every function in the order they were added.
+	 * @param args The arguments passed to every function.
+	 * @return The result of the last function, empty if there are no functions.
+	 */
+	ReturnType Invoke(TArgs ... args)
 	{
-		std::lock_guard<std::mutex> lock(delegate.m_mutex);
+		Reader reader(*this);
 
-		if (delegate.m_functionList.empty())
+		if constexpr (std::is_void_v<TReturnType>)
 		{
-			return;
+			if (reader.m_list != nullptr)
+			{
+				for (auto &entry : *reader.m_list)
+				{
+					entry.m_invoke(&entry.m_storage, args...);
+				}
+			}
 		}
-
-		std::for_each(delegate.m_functionList.begin(), delegate.m_functionList.end(), [&](auto &f)
+		else
 		{
-			f(params...);
-		});
-	}
-};
-
-template<typename TReturnType, typename... TArgs>
-class Delegate<TReturnType(TArgs ...)>
-{
-public:
-	using Invoker = acid::Invoker<TReturnType, TArgs...>;
-	using FunctionType = std::function<TReturnType(TArgs ...)>;
+			ReturnType result;
 
-	Delegate() = default;
+			if (reader.m_list != nullptr)
+			{
+				for (auto &entry : *reader.m_list)
+				{
+					result = entry.m_invoke(&entry.m_storage, args...);
+				}
+			}
 
-	virtual ~Delegate() = default;
+			return result;
+		}
+	}
 
-	Delegate &Add(FunctionType &&function)
+	Delegate &Clear()
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_functionList.emplace_back(function);
+		Publish(nullptr);
 		return *this;
 	}
 
-	Delegate &Remove(const FunctionType function)
+	template<typename F>
+	Delegate &operator+=(F &&function)
 	{
-		std::lock_guard<std::mutex> lock(m_mutex);
-
-		m_functionList.remove_if([&](FunctionType &f)
-		{
-			return Hash(f) == Hash(function);
-		});
-
+		Add(std::forward<F>(function));
 		return *this;
 	}
 
-	typename Invoker::ReturnType Invoke(TArgs ... args)
+	Delegate &operator-=(const Token &token)
 	{
-		return Invoker::Invoke(*this, args...);
+		return Remove(token);
 	}
 
-	Delegate &Clear()
+	ReturnType operator()(TArgs ... args)
 	{
-		std::lock_guard<std::mutex> lock(m_mutex);
-		m_functionList.clear();
-		return *this;
+		return Invoke(args...);
 	}
 
-	Delegate &operator+=(FunctionType &&function)
+private:
+	/**
+	 * A function and its token, the function is placement constructed in the storage or pointed to from it.
+	 */
+	class Entry
 	{
-		return Add(std::move(function));
-	}
+	public:
+		template<typename F>
+		Entry(const Token &token, F &&function) :
+			m_token(token)
+		{
+			using Type = std::decay_t<F>;
 
-	Delegate &operator-=(const FunctionType function)
+			if constexpr (sizeof(Type) <= BufferSize && alignof(Type) <= alignof(std::max_align_t))
+			{
+				new(&m_storage) Type(std::forward<F>(function));
+				m_invoke = [](void *storage, TArgs ... args) -> TReturnType
+				{
+					return (*static_cast<Type *>(storage))(args...);
+				};
+				m_manage = [](void *storage, const void *other)
+				{
+					if (other != nullptr)
+					{
+						new(storage) Type(*static_cast<const Type *>(other));
+					}
+					else
+					{
+						static_cast<Type *>(storage)->~Type();
+					}
+				};
+			}
+			else
+			{
+				*reinterpret_cast<Type **>(&m_storage) = new Type(std::forward<F>(function));
+				m_invoke = [](void *storage, TArgs ... args) -> TReturnType
+				{
+					return (**static_cast<Type **>(storage))(args...);
+				};
+				m_manage = [](void *storage, const void *other)
+				{
+					if (other != nullptr)
+					{
+						*static_cast<Type **>(storage) = new Type(**static_cast<Type *const *>(other));
+					}
+					else
+					{
+						delete *static_cast<Type **>(storage);
+					}
+				};
+			}
+		}
+
+		Entry(const Entry &other) :
+			m_token(other.m_token),
+			m_invoke(other.m_invoke),
+			m_manage(other.m_manage)
+		{
+			m_manage(&m_storage, &other.m_storage);
+		}
+
+		~Entry()
+		{
+			m_manage(&m_storage, nullptr);
+		}
+
+		Entry &operator=(const Entry &) = delete;
+
+		Token m_token;
+		std::aligned_storage_t<BufferSize, alignof(std::max_align_t)> m_storage;
+		TReturnType (*m_invoke)(void *, TArgs ...);
+		/// Copies the function from other into storage, or destroys the function in storage if other is null.
+		void (*m_manage)(void *, const void *);
+	};
+
+	using List = std::vector<Entry>;
+
+	/**
+	 * Marks an invoke as reading the current list while it is alive.
+	 */
+	class Reader
+	{
+	public:
+		explicit Reader(Delegate &delegate) :
+			m_delegate(delegate)
+		{
+			m_delegate.m_readers.fetch_add(1);
+			m_list = m_delegate.m_list.load();
+		}
+
+		~Reader()
+		{
+			if (m_delegate.m_readers.fetch_sub(1) == 1 && m_delegate.m_retiring.load(std::memory_order_relaxed))
+			{
+				m_delegate.TryReclaim();
+			}
+		}
+
+		Reader(const Reader &) = delete;
+
+		Reader &operator=(const Reader &) = delete;
+
+		Delegate &m_delegate;
+		List *m_list;
+	};
+
+	/**
+	 * Copies the current list, must be called with the mutex held.
+	 * @param skip The token of a function to leave out, or 0.
+	 * @return The copied list.
+	 */
+	std::unique_ptr<List> Copy(const Token &skip) const
 	{
-		return Remove(function);
+		auto list = std::make_unique<List>();
+
+		if (auto current = m_list.load(std::memory_order_relaxed))
+		{
+			list->reserve(current->size() + 1);
+
+			for (const auto &entry : *current)
+			{
+				if (entry.m_token != skip)
+				{
+					list->emplace_back(entry);
+				}
+			}
+		}
+
+		return list;
 	}
 
-	typename Invoker::ReturnType operator()(TArgs ... args)
+	/**
+	 * Replaces the current list, must be called with the mutex held.
+	 * @param list The new list, empty lists are published as null.
+	 */
+	void Publish(std::unique_ptr<List> list)
 	{
-		return Invoker::Invoke(*this, args...);
+		if (list != nullptr && list->empty())
+		{
+			list = nullptr;
+		}
+
+		if (auto old = m_list.exchange(list.release()))
+		{
+			m_retired.emplace_back(old);
+			m_retiring.store(true, std::memory_order_relaxed);
+		}
+
+		Reclaim();
 	}
 
-private:
-	friend Invoker;
+	/**
+	 * Frees replaced lists if no invoke is reading, must be called with the mutex held.
+	 * An invoke that starts after this check loads the current list, so it can't be reading a replaced one.
+	 */
+	void Reclaim()
+	{
+		if (!m_retired.empty() && m_readers.load() == 0)
+		{
+			m_retired.clear();
+			m_retiring.store(false, std::memory_order_relaxed);
+		}
+	}
 
-	static constexpr size_t Hash(const FunctionType &function)
+	/**
+	 * Frees replaced lists after the last reader leaves, unless a writer is busy and will free them itself.
+	 */
+	void TryReclaim()
 	{
-		return function.target_type().hash_code();
+		std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+
+		if (lock)
+		{
+			Reclaim();
+		}
 	}
 
+	std::atomic<List *> m_list;
+	std::atomic<uint32_t> m_readers;
+	std::atomic<bool> m_retiring;
 	std::mutex m_mutex;
-	std::vector<FunctionType> m_functionList;
+	std::vector<std::unique_ptr<List>> m_retired;
+	Token m_nextToken;
 };
 }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ObjectPool.hpp"
+
+namespace acid
+{
+/**
+ * @brief A reference to a pooled object that becomes null once the object is deleted, even if its memory is reused.
+ *
+ * The object must have been created with new from a type allocated by {@link ObjectPool}, like entities and components.
+ * Checking a handle is not synchronized with deletes on other threads.
+ * @tparam T The object type.
+ */
+template<typename T>
+class Handle
+{
+public:
+	Handle() :
+		m_object(nullptr),
+		m_memory(nullptr),
+		m_generation(0)
+	{
+	}
+
+	Handle(T *object) :
+		m_object(object),
+		m_memory(GetMemory(object)),
+		m_generation(object != nullptr ? ObjectPool::GetGeneration(m_memory) : 0)
+	{
+	}
+
+	/**
+	 * Gets the object if it has not been deleted.
+	 * @return The object, or null.
+	 */
+	T *Get() const
+	{
+		if (m_object == nullptr || ObjectPool::GetGeneration(m_memory) != m_generation)
+		{
+			return nullptr;
+		}
+
+		return m_object;
+	}
+
+	/**
+	 * Gets if the object has not been deleted.
+	 * @return If the object is alive.
+	 */
+	bool IsValid() const { return Get() != nullptr; }
+
+	explicit operator bool() const { return IsValid(); }
+
+	T *operator->() const { return Get(); }
+
+	bool operator==(const Handle &other) const { return m_object == other.m_object && m_generation == other.m_generation; }
+
+	bool operator!=(const Handle &other) const { return !(*this == other); }
+
+private:
+	/**
+	 * Gets the start of the allocation, base class pointers can point into the middle of it.
+	 * It is found while the object is alive, a deleted object can't be cast.
+	 */
+	static const void *GetMemory(const T *object)
+	{
+		if constexpr (std::is_polymorphic_v<T>)
+		{
+			return dynamic_cast<const void *>(object);
+		}
+		else
+		{
+			return object;
+		}
+	}
+
+	T *m_object;
+	const void *m_memory;
+	uint32_t m_generation;
+};
+}
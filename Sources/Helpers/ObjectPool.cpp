@@ -0,0 +1,132 @@
+#include "ObjectPool.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace acid
+{
+static constexpr std::size_t SLAB_SIZE = 64 * 1024;
+static constexpr std::size_t SLAB_MIN_OBJECTS = 8;
+
+std::atomic<ObjectPool *> ObjectPool::SIZE_CLASSES[MaxSizeClasses] = {};
+
+ObjectPool::ObjectPool(const std::size_t &size) :
+	m_size(std::max<std::size_t>(size, sizeof(void *))),
+	m_stride(HeaderSize + ((m_size + SizeClass - 1) & ~(SizeClass - 1))),
+	m_capacity(0),
+	m_allocated(0),
+	m_free(nullptr)
+{
+}
+
+ObjectPool *ObjectPool::Create(const std::size_t &sizeClass)
+{
+	// Pools are never destroyed, objects can be freed during static destruction.
+	static std::mutex mutex;
+	static std::map<std::size_t, ObjectPool *> large;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (sizeClass < MaxSizeClasses)
+	{
+		auto pool = SIZE_CLASSES[sizeClass].load(std::memory_order_relaxed);
+
+		if (pool == nullptr)
+		{
+			pool = new ObjectPool(sizeClass * SizeClass);
+			SIZE_CLASSES[sizeClass].store(pool, std::memory_order_release);
+		}
+
+		return pool;
+	}
+
+	auto &pool = large[sizeClass];
+
+	if (pool == nullptr)
+	{
+		pool = new ObjectPool(sizeClass * SizeClass);
+	}
+
+	return pool;
+}
+
+void *ObjectPool::Allocate()
+{
+	Lock();
+
+	if (m_free == nullptr)
+	{
+		Grow();
+	}
+
+	auto object = m_free;
+	m_free = *static_cast<void **>(object);
+	m_allocated++;
+	Unlock();
+	return object;
+}
+
+void ObjectPool::Free(void *object)
+{
+	if (object == nullptr)
+	{
+		return;
+	}
+
+	auto header = GetHeader(object);
+	auto pool = header->m_pool;
+
+	pool->Lock();
+	header->m_generation.store(header->m_generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	*static_cast<void **>(object) = pool->m_free;
+	pool->m_free = object;
+	pool->m_allocated--;
+	pool->Unlock();
+}
+
+uint32_t ObjectPool::GetGeneration(const void *object)
+{
+	return GetHeader(object)->m_generation.load(std::memory_order_relaxed);
+}
+
+std::size_t ObjectPool::GetAllocated() const
+{
+	Lock();
+	auto allocated = m_allocated;
+	Unlock();
+	return allocated;
+}
+
+std::size_t ObjectPool::GetCapacity() const
+{
+	Lock();
+	auto capacity = m_capacity;
+	Unlock();
+	return capacity;
+}
+
+ObjectPool::Header *ObjectPool::GetHeader(const void *object)
+{
+	return reinterpret_cast<Header *>(const_cast<std::byte *>(static_cast<const std::byte *>(object)) - HeaderSize);
+}
+
+void ObjectPool::Grow()
+{
+	auto count = std::max(SLAB_SIZE / m_stride, SLAB_MIN_OBJECTS);
+	auto slab = std::unique_ptr<std::byte[]>(new std::byte[count * m_stride]);
+
+	// Links the new objects into the free list in address order.
+	for (auto i = count; i-- > 0;)
+	{
+		auto header = new(slab.get() + i * m_stride) Header();
+		header->m_pool = this;
+		header->m_generation = 0;
+		auto object = slab.get() + i * m_stride + HeaderSize;
+		*reinterpret_cast<void **>(object) = m_free;
+		m_free = object;
+	}
+
+	m_slabs.emplace_back(std::move(slab));
+	m_capacity += count;
+}
+}
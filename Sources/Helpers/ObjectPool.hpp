@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include "NonCopyable.hpp"
+
+namespace acid
+{
+/**
+ * @brief A pool of objects with the same size, memory is taken from slabs of many objects and freed objects are reused first.
+ *
+ * Each object is preceded by a header with its pool and a generation that changes every time it is freed, {@link Handle} uses it to find freed objects.
+ * Slabs are never released and pools live until the program exits, so headers can be read after their objects are freed.
+ * Pools are shared by every type with the same rounded size, objects must not be aligned more than {@code alignof(std::max_align_t)}.
+ */
+class ACID_EXPORT ObjectPool :
+	public NonCopyable
+{
+public:
+	/**
+	 * Creates a new pool, use {@link ObjectPool#Get} for the shared pools.
+	 * @param size The object size in bytes.
+	 */
+	explicit ObjectPool(const std::size_t &size);
+
+	/**
+	 * Gets the shared pool for objects of a size, creating it on first use.
+	 * @param size The object size in bytes.
+	 * @return The pool.
+	 */
+	static ObjectPool *Get(const std::size_t &size)
+	{
+		auto sizeClass = (size + SizeClass - 1) / SizeClass;
+
+		if (sizeClass < MaxSizeClasses)
+		{
+			if (auto pool = SIZE_CLASSES[sizeClass].load(std::memory_order_acquire))
+			{
+				return pool;
+			}
+		}
+
+		return Create(sizeClass);
+	}
+
+	/**
+	 * Gets the shared pool for a type.
+	 * @tparam T The object type.
+	 * @return The pool.
+	 */
+	template<typename T>
+	static ObjectPool *Get()
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Pooled types can't be over aligned");
+		return Get(sizeof(T));
+	}
+
+	/**
+	 * Takes memory for an object from the pool.
+	 * @return The uninitialized memory.
+	 */
+	void *Allocate();
+
+	/**
+	 * Returns an objects memory to the pool it came from.
+	 * @param object The memory from {@link ObjectPool#Allocate}, may be null.
+	 */
+	static void Free(void *object);
+
+	/**
+	 * Gets the generation of an objects memory, it changes every time the object is freed.
+	 * @param object The memory from {@link ObjectPool#Allocate}.
+	 * @return The generation.
+	 */
+	static uint32_t GetGeneration(const void *object);
+
+	/**
+	 * Gets the size of the objects in this pool.
+	 * @return The object size in bytes.
+	 */
+	const std::size_t &GetSize() const { return m_size; }
+
+	/**
+	 * Gets the number of objects allocated and not yet freed.
+	 * @return The allocated object count.
+	 */
+	std::size_t GetAllocated() const;
+
+	/**
+	 * Gets the number of objects all slabs can hold.
+	 * @return The object capacity.
+	 */
+	std::size_t GetCapacity() const;
+
+private:
+	struct Header
+	{
+		ObjectPool *m_pool;
+		std::atomic<uint32_t> m_generation;
+	};
+
+	static constexpr std::size_t SizeClass = alignof(std::max_align_t);
+	static constexpr std::size_t MaxSizeClasses = 4096 / SizeClass + 1;
+	static constexpr std::size_t HeaderSize = (sizeof(Header) + SizeClass - 1) & ~(SizeClass - 1);
+
+	static ObjectPool *Create(const std::size_t &sizeClass);
+
+	static Header *GetHeader(const void *object);
+
+	/**
+	 * Locks the pool, objects are taken and freed in a few instructions so it spins rather than sleeping.
+	 */
+	void Lock() const
+	{
+		while (m_lock.test_and_set(std::memory_order_acquire))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	void Unlock() const { m_lock.clear(std::memory_order_release); }
+
+	void Grow();
+
+	static ACID_STATE std::atomic<ObjectPool *> SIZE_CLASSES[MaxSizeClasses];
+
+	std::size_t m_size;
+	std::size_t m_stride;
+	mutable std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+	std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+	std::size_t m_capacity;
+	std::size_t m_allocated;
+	/// Freed objects, each stores the next freed object in its memory.
+	void *m_free;
+};
+}
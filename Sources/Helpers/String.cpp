@@ -139,4 +139,38 @@ std::string String::Uppercase(std::string str)
 	std::transform(str.begin(), str.end(), str.begin(), toupper);
 	return str;
 }
+
+std::u32string String::ToUtf32(std::string_view str)
+{
+	std::u32string result;
+	result.reserve(str.size());
+
+	for (std::size_t i = 0; i < str.size();)
+	{
+		auto lead = static_cast<uint8_t>(str[i]);
+		auto length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+		char32_t codepoint = length == 1 ? lead : length == 2 ? lead & 0x1F : length == 3 ? lead & 0x0F : lead & 0x07;
+
+		if (length == 0 || i + length > str.size())
+		{
+			result.push_back(U'\uFFFD');
+			i++;
+			continue;
+		}
+
+		auto valid = true;
+
+		for (auto j = 1; j < length; j++)
+		{
+			auto continuation = static_cast<uint8_t>(str[i + j]);
+			valid &= (continuation & 0xC0) == 0x80;
+			codepoint = (codepoint << 6) | (continuation & 0x3F);
+		}
+
+		result.push_back(valid ? codepoint : U'\uFFFD');
+		i += valid ? length : 1;
+	}
+
+	return result;
+}
 }
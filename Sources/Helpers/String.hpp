@@ -123,6 +123,13 @@ public:
 	 */
 	static std::string Uppercase(std::string str);
 
+	/**
+	 * Decodes a UTF-8 string into code points, invalid bytes become the replacement character.
+	 * @param str The UTF-8 string.
+	 * @return The code points.
+	 */
+	static std::u32string ToUtf32(std::string_view str);
+
 	/**
 	 * Converts a type to a string.
 	 * @tparam T The type to convert from.
@@ -1,5 +1,8 @@
 #include "ThreadPool.hpp"
 
+#include "Engine/Profiler.hpp"
+#include "String.hpp"
+
 namespace acid
 {
 ThreadPool::ThreadPool(const uint32_t &threadCount) :
@@ -9,8 +12,10 @@ ThreadPool::ThreadPool(const uint32_t &threadCount) :
 
 	for (size_t i = 0; i < threadCount; ++i)
 	{
-		m_workers.emplace_back([this]
+		m_workers.emplace_back([this, i]
 		{
+			Profiler::SetThreadName("Worker " + String::To(i));
+
 			while (true)
 			{
 				std::function<void()> task;
@@ -80,7 +80,7 @@ void MaterialDefault::PushUniforms(UniformHandler &uniformObject)
 		uniformObject.Push("jointTransforms", *joints.data(), sizeof(Matrix4) * joints.size());
 	}
 
-	uniformObject.Push("transform", GetParent()->GetWorldMatrix());
+	uniformObject.Push("transform", GetParent()->GetRenderMatrix());
 	uniformObject.Push("baseDiffuse", m_baseDiffuse);
 	uniformObject.Push("metallic", m_metallic);
 	uniformObject.Push("roughness", m_roughness);
@@ -52,6 +52,12 @@ public:
 	 **/
 	void SetLength(const Time &length) { m_length = length; }
 
+	/**
+	 * Gets if the driver has stopped changing, once finished it always calculates the same value.
+	 * @return If the driver is finished.
+	 **/
+	virtual bool IsFinished() const { return false; }
+
 protected:
 	/**
 	 * Calculates the new value.
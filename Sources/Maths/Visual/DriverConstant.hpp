@@ -20,7 +20,8 @@ public:
 	 **/
 	explicit DriverConstant(const T &constant) :
 		Driver<T>(Time::Max),
-		m_constant(constant)
+		m_constant(constant),
+		m_changed(true)
 	{
 	}
 
@@ -34,14 +35,23 @@ public:
 	 * Sets the constant.
 	 * @param constant The new constant. 
 	 **/
-	void SetConstant(const T &constant) { m_constant = constant; };
+	void SetConstant(const T &constant)
+	{
+		m_constant = constant;
+		m_changed = true;
+	}
+
+	bool IsFinished() const override { return !m_changed; }
+
 protected:
 	T Calculate(const float &factor) override
 	{
+		m_changed = false;
 		return m_constant;
 	}
 
 private:
 	T m_constant;
+	bool m_changed;
 };
 }
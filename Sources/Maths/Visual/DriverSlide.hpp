@@ -50,6 +50,8 @@ public:
 	 **/
 	void SetEnd(const T &end) { m_end = end; }
 
+	bool IsFinished() const override { return Driver<T>::m_actualTime > Driver<T>::GetLength(); }
+
 protected:
 	T Calculate(const float &factor) override
 	{
@@ -16,10 +16,10 @@ void RendererMeshes::Render(const CommandBuffer &commandBuffer)
 {
 	auto camera = Scenes::Get()->GetCamera();
 	m_uniformScene.Push("projection", camera->GetProjectionMatrix());
-	m_uniformScene.Push("view", camera->GetViewMatrix());
-	m_uniformScene.Push("cameraPos", camera->GetPosition());
+	m_uniformScene.Push("view", camera->GetRenderViewMatrix());
+	m_uniformScene.Push("cameraPos", camera->GetRenderPosition());
 
-	auto sceneMeshRenders = Scenes::Get()->GetStructure()->QueryComponents<MeshRender>();
+	auto sceneMeshRenders = Scenes::Get()->GetStructure()->QueryComponents<MeshRender>(false, FrameAllocator::Get());
 
 	if (m_sort != Sort::None)
 	{
@@ -5,6 +5,7 @@
 #define TINYGLTF_IMPLEMENTATION
 
 #include "tiny_gltf.h"
+#include "Engine/Profiler.hpp"
 #include "Files/FileSystem.hpp"
 #include "Resources/Resources.hpp"
 #include "Models/VertexModel.hpp"
@@ -46,6 +47,8 @@ ModelGltf::ModelGltf(std::string filename, const bool &load) :
 
 void ModelGltf::Load()
 {
+	ACID_PROFILE_ZONE("ModelGltf::Load");
+
 	if (m_filename.empty())
 	{
 		return;
@@ -56,7 +59,7 @@ void ModelGltf::Load()
 #endif
 
 	auto folder = FileSystem::ParentDirectory(m_filename);
-	auto fileLoaded = Files::Read(m_filename);
+	auto fileLoaded = Files::ReadView(m_filename);
 
 	if (!fileLoaded)
 	{
@@ -71,14 +74,14 @@ void ModelGltf::Load()
 
 	if (String::Lowercase(FileSystem::FileSuffix(m_filename)) == ".glb")
 	{
-		if (!gltfContext.LoadBinaryFromMemory(&gltfModel, &err, &warn, reinterpret_cast<uint8_t *>(fileLoaded->data()), static_cast<uint32_t>(fileLoaded->size())))
+		if (!gltfContext.LoadBinaryFromMemory(&gltfModel, &err, &warn, reinterpret_cast<const uint8_t *>(fileLoaded->GetData()), static_cast<uint32_t>(fileLoaded->GetSize())))
 		{
 			throw std::runtime_error(warn + err);
 		}
 	}
 	else
 	{
-		if (!gltfContext.LoadASCIIFromString(&gltfModel, &err, &warn, fileLoaded->c_str(), static_cast<uint32_t>(fileLoaded->size()), folder))
+		if (!gltfContext.LoadASCIIFromString(&gltfModel, &err, &warn, fileLoaded->GetData(), static_cast<uint32_t>(fileLoaded->GetSize()), folder))
 		{
 			throw std::runtime_error(warn + err);
 		}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Engine.hpp"
 #include "Maths/Vector3.hpp"
 #include "Renderer/Buffers/Buffer.hpp"
 #include "Resources/Resource.hpp"
@@ -84,6 +85,26 @@ protected:
 		m_vertexBuffer = nullptr;
 		m_indexBuffer = nullptr;
 
+		m_minExtents = Vector3f::PositiveInfinity;
+		m_maxExtents = Vector3f::NegativeInfinity;
+
+		for (const auto &vertex : vertices)
+		{
+			auto position = vertex.m_position;
+			m_minExtents = m_minExtents.Min(position);
+			m_maxExtents = m_maxExtents.Max(position);
+		}
+
+		m_radius = std::max(m_minExtents.Length(), m_maxExtents.Length());
+
+		// Headless models keep their counts and extents, but no buffers are created on a device.
+		if (Engine::Get()->IsHeadless())
+		{
+			m_vertexCount = static_cast<uint32_t>(vertices.size());
+			m_indexCount = static_cast<uint32_t>(indices.size());
+			return;
+		}
+
 		if (!vertices.empty())
 		{
 			auto vertexStaging = Buffer(sizeof(T) * vertices.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -117,18 +138,6 @@ protected:
 
 			commandBuffer.SubmitIdle();
 		}
-
-		m_minExtents = Vector3f::PositiveInfinity;
-		m_maxExtents = Vector3f::NegativeInfinity;
-
-		for (const auto &vertex : vertices)
-		{
-			auto position = vertex.m_position;
-			m_minExtents = m_minExtents.Min(position);
-			m_maxExtents = m_maxExtents.Max(position);
-		}
-
-		m_radius = std::max(m_minExtents.Length(), m_maxExtents.Length());
 	}
 
 private:
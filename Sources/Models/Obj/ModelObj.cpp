@@ -3,6 +3,7 @@
 #define TINYOBJLOADER_IMPLEMENTATION
 
 #include "tiny_obj_loader.h"
+#include "Engine/Profiler.hpp"
 #include "Files/FileSystem.hpp"
 #include "Resources/Resources.hpp"
 #include "Models/VertexModel.hpp"
@@ -38,7 +39,14 @@ public:
 			return false;
 		}
 
-		IFStream inStream(filepath);
+		auto fileLoaded = Files::ReadView(filepath);
+
+		if (!fileLoaded)
+		{
+			return false;
+		}
+
+		ViewStream inStream(*fileLoaded);
 		tinyobj::LoadMtl(matMap, materials, &inStream, warn, err);
 		return true;
 	}
@@ -82,6 +90,8 @@ ModelObj::ModelObj(std::string filename, const bool &load) :
 
 void ModelObj::Load()
 {
+	ACID_PROFILE_ZONE("ModelObj::Load");
+
 	if (m_filename.empty())
 	{
 		return;
@@ -92,7 +102,15 @@ void ModelObj::Load()
 #endif
 
 	auto folder = FileSystem::ParentDirectory(m_filename);
-	IFStream inStream(m_filename);
+	auto fileLoaded = Files::ReadView(m_filename);
+
+	if (!fileLoaded)
+	{
+		Log::Error("OBJ file could not be loaded: '%s'\n", m_filename.c_str());
+		return;
+	}
+
+	ViewStream inStream(*fileLoaded);
 	MaterialStreamReader materialReader(folder);
 
 	tinyobj::attrib_t attrib;
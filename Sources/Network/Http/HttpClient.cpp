@@ -0,0 +1,630 @@
+#include "HttpClient.hpp"
+
+#include "Engine/Log.hpp"
+#include "Helpers/String.hpp"
+
+namespace acid
+{
+/// Idempotent requests interrupted by the server closing the connection are resent this many times.
+static constexpr uint32_t MaxRetries = 1;
+/// A response header larger than this is treated as invalid.
+static constexpr std::size_t MaxHeaderSize = 64 * 1024;
+static constexpr std::size_t ReceiveSize = 64 * 1024;
+
+HttpClient::HttpClient(const uint32_t &maxConnections, const uint32_t &pipelineDepth) :
+	m_maxConnections(std::max(maxConnections, 1u)),
+	m_pipelineDepth(std::max(pipelineDepth, 1u)),
+	m_connectTimeout(Time::Seconds(10.0f)),
+	m_idleTimeout(Time::Seconds(30.0f)),
+	m_buffer(ReceiveSize)
+{
+}
+
+HttpClient::~HttpClient()
+{
+	for (auto &[key, host] : m_hosts)
+	{
+		for (auto &connection : host.m_connections)
+		{
+			m_selector.Remove(connection->m_socket);
+			connection->m_socket.Disconnect();
+		}
+	}
+}
+
+void HttpClient::Send(const std::string &host, const HttpRequest &request, const ResponseCallback &onResponse, const BodyCallback &onBody)
+{
+	Request pending = {};
+	pending.m_onResponse = onResponse;
+	pending.m_onBody = onBody;
+
+	// Split the host into its name and port, the same way Http::SetHost does.
+	auto name = host;
+	uint16_t port = 80;
+
+	if (String::Lowercase(name.substr(0, 7)) == "http://")
+	{
+		name = name.substr(7);
+	}
+	else if (String::Lowercase(name.substr(0, 8)) == "https://")
+	{
+		Log::Error("HTTPS protocol is not supported by HttpClient\n");
+		Fail(pending);
+		return;
+	}
+
+	if (!name.empty() && name.back() == '/')
+	{
+		name.erase(name.size() - 1);
+	}
+
+	auto colon = name.find(':');
+
+	if (colon != std::string::npos)
+	{
+		port = static_cast<uint16_t>(std::strtoul(name.c_str() + colon + 1, nullptr, 10));
+		name.erase(colon);
+	}
+
+	auto key = name + ":" + std::to_string(port);
+	auto it = m_hosts.find(key);
+
+	if (it == m_hosts.end())
+	{
+		Host created;
+		created.m_name = name;
+		created.m_address = IpAddress(name);
+		created.m_port = port;
+		it = m_hosts.emplace(key, std::move(created)).first;
+	}
+
+	if (it->second.m_address == IpAddress::None)
+	{
+		Log::Error("HttpClient could not resolve host '%s'\n", name.c_str());
+		Fail(pending);
+		return;
+	}
+
+	// Add missing mandatory fields, connections are kept alive so the request is upgraded to HTTP/1.1.
+	HttpRequest toSend(request);
+
+	if (toSend.m_majorVersion * 10 + toSend.m_minorVersion < 11)
+	{
+		toSend.SetHttpVersion(1, 1);
+	}
+
+	if (!toSend.HasField("User-Agent"))
+	{
+		toSend.SetField("User-Agent", "libsfml-network/2.x");
+	}
+
+	if (!toSend.HasField("Host"))
+	{
+		toSend.SetField("Host", name);
+	}
+
+	if (!toSend.HasField("Content-Length"))
+	{
+		toSend.SetField("Content-Length", std::to_string(toSend.m_body.size()));
+	}
+
+	if ((toSend.m_method == HttpRequest::Method::Post) && !toSend.HasField("Content-Type"))
+	{
+		toSend.SetField("Content-Type", "application/x-www-form-urlencoded");
+	}
+
+	pending.m_data = toSend.Prepare();
+	pending.m_idempotent = toSend.m_method != HttpRequest::Method::Post && toSend.m_method != HttpRequest::Method::Patch &&
+		toSend.m_method != HttpRequest::Method::Connect;
+	pending.m_head = toSend.m_method == HttpRequest::Method::Head;
+	it->second.m_queue.emplace_back(std::move(pending));
+}
+
+bool HttpClient::Update(const Time &timeout)
+{
+	auto completed = Pump();
+
+	if (!completed && timeout > Time::Zero && GetPendingCount() > 0)
+	{
+		// Sockets still connecting are only noticed by polling, so don't sleep long while there are any.
+		auto connecting = false;
+
+		for (const auto &[key, host] : m_hosts)
+		{
+			for (const auto &connection : host.m_connections)
+			{
+				connecting |= connection->m_connecting;
+			}
+		}
+
+		m_selector.Wait(connecting ? std::min(timeout, Time::Milliseconds(1)) : timeout);
+		Pump();
+	}
+
+	return GetPendingCount() > 0;
+}
+
+bool HttpClient::Wait(const Time &timeout)
+{
+	auto end = Clock::now() + std::chrono::microseconds(timeout.AsMicroseconds());
+
+	while (GetPendingCount() > 0)
+	{
+		auto now = Clock::now();
+
+		if (now >= end)
+		{
+			return false;
+		}
+
+		Update(Time::Microseconds(std::chrono::duration_cast<std::chrono::microseconds>(end - now).count()));
+	}
+
+	return true;
+}
+
+uint32_t HttpClient::GetPendingCount() const
+{
+	std::size_t count = 0;
+
+	for (const auto &[key, host] : m_hosts)
+	{
+		count += host.m_queue.size();
+
+		for (const auto &connection : host.m_connections)
+		{
+			count += connection->m_inFlight.size();
+		}
+	}
+
+	return static_cast<uint32_t>(count);
+}
+
+uint32_t HttpClient::GetConnectionCount() const
+{
+	std::size_t count = 0;
+
+	for (const auto &[key, host] : m_hosts)
+	{
+		count += host.m_connections.size();
+	}
+
+	return static_cast<uint32_t>(count);
+}
+
+bool HttpClient::Pump()
+{
+	auto completed = false;
+
+	for (auto &[key, host] : m_hosts)
+	{
+		Dispatch(host);
+
+		for (std::size_t i = 0; i < host.m_connections.size();)
+		{
+			auto &connection = *host.m_connections[i];
+
+			if (!Process(host, connection, completed))
+			{
+				Close(host, connection);
+				host.m_connections.erase(host.m_connections.begin() + i);
+				continue;
+			}
+
+			i++;
+		}
+
+		// Requests given back by closed connections, or queued by callbacks, can go out straight away.
+		Dispatch(host);
+	}
+
+	return completed;
+}
+
+void HttpClient::Dispatch(Host &host)
+{
+	while (!host.m_queue.empty())
+	{
+		auto &request = host.m_queue.front();
+		Connection *target = nullptr;
+
+		for (auto &connection : host.m_connections)
+		{
+			if (connection->m_inFlight.empty() && connection->m_keepAlive)
+			{
+				target = connection.get();
+				break;
+			}
+		}
+
+		if (target == nullptr && host.m_connections.size() < m_maxConnections)
+		{
+			target = Open(host);
+
+			if (target == nullptr)
+			{
+				Fail(request);
+				host.m_queue.pop_front();
+				continue;
+			}
+		}
+
+		// Pipelining only happens on connections the server has shown it keeps alive, and only for requests
+		// that are safe to resend if the connection closes before they are answered.
+		if (target == nullptr && request.m_idempotent)
+		{
+			for (auto &connection : host.m_connections)
+			{
+				if (connection->m_confirmed && connection->m_keepAlive && connection->m_inFlight.size() < m_pipelineDepth &&
+					connection->m_inFlight.back().m_idempotent && (target == nullptr || connection->m_inFlight.size() < target->m_inFlight.size()))
+				{
+					target = connection.get();
+				}
+			}
+		}
+
+		if (target == nullptr)
+		{
+			break;
+		}
+
+		target->m_sendBuffer.append(request.m_data);
+		target->m_inFlight.emplace_back(std::move(request));
+		host.m_queue.pop_front();
+	}
+}
+
+HttpClient::Connection *HttpClient::Open(Host &host)
+{
+	auto connection = std::make_unique<Connection>();
+	connection->m_socket.SetBlocking(false);
+	auto status = connection->m_socket.Connect(host.m_address, host.m_port);
+
+	if (status != Socket::Status::Done && status != Socket::Status::NotReady)
+	{
+		return nullptr;
+	}
+
+	connection->m_connecting = status != Socket::Status::Done;
+	connection->m_lastActive = Clock::now();
+	m_selector.Add(connection->m_socket);
+	host.m_connections.emplace_back(std::move(connection));
+	return host.m_connections.back().get();
+}
+
+bool HttpClient::Process(Host &host, Connection &connection, bool &completed)
+{
+	auto now = Clock::now();
+
+	if (connection.m_connecting)
+	{
+		auto status = connection.m_socket.PollConnect();
+
+		if (status == Socket::Status::NotReady)
+		{
+			return now - connection.m_lastActive < std::chrono::microseconds(m_connectTimeout.AsMicroseconds());
+		}
+
+		if (status != Socket::Status::Done)
+		{
+			return false;
+		}
+
+		connection.m_connecting = false;
+		connection.m_lastActive = now;
+	}
+
+	// Send as much of the queued requests as the socket takes.
+	while (connection.m_sendOffset < connection.m_sendBuffer.size())
+	{
+		std::size_t sent = 0;
+		auto status = connection.m_socket.Send(connection.m_sendBuffer.data() + connection.m_sendOffset,
+			connection.m_sendBuffer.size() - connection.m_sendOffset, sent);
+		connection.m_sendOffset += sent;
+
+		if (status == Socket::Status::NotReady || status == Socket::Status::Partial)
+		{
+			break;
+		}
+
+		if (status != Socket::Status::Done)
+		{
+			return false;
+		}
+	}
+
+	if (connection.m_sendOffset == connection.m_sendBuffer.size())
+	{
+		connection.m_sendBuffer.clear();
+		connection.m_sendOffset = 0;
+	}
+
+	while (true)
+	{
+		std::size_t received = 0;
+		auto status = connection.m_socket.Receive(m_buffer.data(), m_buffer.size(), received);
+
+		if (status == Socket::Status::NotReady)
+		{
+			break;
+		}
+
+		if (status != Socket::Status::Done)
+		{
+			// A response delimited by the end of the connection is complete now.
+			if (connection.m_state == ParseState::UntilClose && !connection.m_inFlight.empty())
+			{
+				Complete(connection);
+				completed = true;
+			}
+
+			return false;
+		}
+
+		connection.m_lastActive = now;
+		connection.m_receiveBuffer.append(m_buffer.data(), received);
+
+		if (!Parse(connection, completed))
+		{
+			return false;
+		}
+	}
+
+	if (!connection.m_keepAlive && connection.m_inFlight.empty())
+	{
+		return false;
+	}
+
+	return !connection.m_inFlight.empty() || now - connection.m_lastActive < std::chrono::microseconds(m_idleTimeout.AsMicroseconds());
+}
+
+bool HttpClient::Parse(Connection &connection, bool &completed)
+{
+	auto &buffer = connection.m_receiveBuffer;
+	auto &offset = connection.m_receiveOffset;
+
+	auto deliver = [&](const std::size_t &size)
+	{
+		auto &request = connection.m_inFlight.front();
+
+		if (request.m_onBody)
+		{
+			request.m_onBody(buffer.data() + offset, size);
+		}
+		else
+		{
+			connection.m_response.m_body.append(buffer.data() + offset, size);
+		}
+
+		offset += size;
+	};
+
+	// Drops parsed data once it's most of the buffer, so the buffer doesn't grow with every response.
+	auto compact = [&]()
+	{
+		if (offset == buffer.size())
+		{
+			buffer.clear();
+			offset = 0;
+		}
+		else if (offset > ReceiveSize)
+		{
+			buffer.erase(0, offset);
+			offset = 0;
+		}
+
+		return true;
+	};
+
+	while (offset < buffer.size() || connection.m_state == ParseState::Header)
+	{
+		if (connection.m_inFlight.empty())
+		{
+			// Data nobody asked for, the connection can't be trusted anymore.
+			return offset == buffer.size();
+		}
+
+		auto &request = connection.m_inFlight.front();
+
+		switch (connection.m_state)
+		{
+		case ParseState::Header:
+		{
+			auto end = buffer.find("\r\n\r\n", offset);
+
+			if (end == std::string::npos)
+			{
+				if (buffer.size() - offset > MaxHeaderSize)
+				{
+					return false;
+				}
+
+				return compact();
+			}
+
+			std::istringstream in(buffer.substr(offset, end + 4 - offset));
+			offset = end + 4;
+			connection.m_response = HttpResponse();
+
+			if (!connection.m_response.ParseHeader(in))
+			{
+				return false;
+			}
+
+			auto status = static_cast<int32_t>(connection.m_response.GetStatus());
+
+			// Interim responses (100 Continue etc.) are followed by the real response.
+			if (status >= 100 && status < 200)
+			{
+				continue;
+			}
+
+			auto version = connection.m_response.m_majorVersion * 10 + connection.m_response.m_minorVersion;
+			auto connectionField = String::Lowercase(connection.m_response.GetField("connection"));
+			connection.m_keepAlive = version >= 11 ? connectionField != "close" : connectionField == "keep-alive";
+			connection.m_confirmed = connection.m_keepAlive;
+
+			auto contentLength = connection.m_response.GetField("content-length");
+
+			if (request.m_head || status == 204 || status == 304)
+			{
+				Complete(connection);
+				completed = true;
+			}
+			else if (String::Lowercase(connection.m_response.GetField("transfer-encoding")) == "chunked")
+			{
+				connection.m_state = ParseState::ChunkSize;
+			}
+			else if (!contentLength.empty())
+			{
+				connection.m_remaining = std::strtoull(contentLength.c_str(), nullptr, 10);
+				connection.m_state = ParseState::Body;
+
+				if (connection.m_remaining == 0)
+				{
+					Complete(connection);
+					completed = true;
+				}
+			}
+			else
+			{
+				connection.m_keepAlive = false;
+				connection.m_state = ParseState::UntilClose;
+			}
+
+			break;
+		}
+		case ParseState::Body:
+		case ParseState::ChunkData:
+		{
+			auto size = static_cast<std::size_t>(std::min<uint64_t>(connection.m_remaining, buffer.size() - offset));
+			deliver(size);
+			connection.m_remaining -= size;
+
+			if (connection.m_remaining == 0)
+			{
+				if (connection.m_state == ParseState::Body)
+				{
+					Complete(connection);
+					completed = true;
+				}
+				else
+				{
+					connection.m_state = ParseState::ChunkEnd;
+				}
+			}
+
+			break;
+		}
+		case ParseState::ChunkSize:
+		{
+			auto end = buffer.find("\r\n", offset);
+
+			if (end == std::string::npos)
+			{
+				return compact();
+			}
+
+			// Any chunk extension after the size is ignored.
+			char *sizeEnd;
+			connection.m_remaining = std::strtoull(buffer.c_str() + offset, &sizeEnd, 16);
+
+			if (sizeEnd == buffer.c_str() + offset)
+			{
+				return false;
+			}
+
+			offset = end + 2;
+			connection.m_state = connection.m_remaining == 0 ? ParseState::Trailers : ParseState::ChunkData;
+			break;
+		}
+		case ParseState::ChunkEnd:
+		{
+			if (buffer.size() - offset < 2)
+			{
+				return compact();
+			}
+
+			offset += 2;
+			connection.m_state = ParseState::ChunkSize;
+			break;
+		}
+		case ParseState::Trailers:
+		{
+			auto end = buffer.find("\r\n", offset);
+
+			if (end == std::string::npos)
+			{
+				return compact();
+			}
+
+			// Trailer fields are added to the response like header fields, an empty line ends the response.
+			if (end != offset)
+			{
+				std::istringstream in(buffer.substr(offset, end + 2 - offset));
+				connection.m_response.ParseFields(in);
+				offset = end + 2;
+				break;
+			}
+
+			offset = end + 2;
+			Complete(connection);
+			completed = true;
+			break;
+		}
+		case ParseState::UntilClose:
+			deliver(buffer.size() - offset);
+			break;
+		}
+	}
+
+	return compact();
+}
+
+void HttpClient::Complete(Connection &connection)
+{
+	auto request = std::move(connection.m_inFlight.front());
+	auto response = std::move(connection.m_response);
+	connection.m_inFlight.pop_front();
+	connection.m_response = HttpResponse();
+	connection.m_state = ParseState::Header;
+
+	if (request.m_onResponse)
+	{
+		request.m_onResponse(response);
+	}
+}
+
+void HttpClient::Close(Host &host, Connection &connection)
+{
+	m_selector.Remove(connection.m_socket);
+	connection.m_socket.Disconnect();
+
+	// Requests that weren't answered are retried in their original order ahead of anything queued, unless resending
+	// them could repeat a side effect on the server, or part of the body was already streamed to the caller.
+	for (auto i = connection.m_inFlight.size(); i-- > 0;)
+	{
+		auto &request = connection.m_inFlight[i];
+		auto streamed = i == 0 && connection.m_state != ParseState::Header && request.m_onBody;
+
+		if (!request.m_idempotent || request.m_retries >= MaxRetries || streamed)
+		{
+			Fail(request);
+			continue;
+		}
+
+		request.m_retries++;
+		host.m_queue.emplace_front(std::move(request));
+	}
+
+	connection.m_inFlight.clear();
+}
+
+void HttpClient::Fail(Request &request)
+{
+	if (request.m_onResponse)
+	{
+		request.m_onResponse(HttpResponse());
+	}
+}
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include "Helpers/NonCopyable.hpp"
+#include "Network/Tcp/TcpSocket.hpp"
+#include "Network/SocketSelector.hpp"
+#include "Network/IpAddress.hpp"
+#include "HttpRequest.hpp"
+#include "HttpResponse.hpp"
+
+namespace acid
+{
+/**
+ * @brief An asynchronous HTTP client that keeps connections to each host open and reuses them.
+ *
+ * Unlike acid::Http, which connects, sends one request and waits for the server to close the connection,
+ * requests are queued with Send and progressed by Update on non-blocking sockets, so many requests can be in flight
+ * from a single thread. Each host gets a pool of up to MaxConnections keep-alive connections, and once a connection
+ * has shown the server keeps it alive further idempotent requests are pipelined on it, up to PipelineDepth deep.
+ *
+ * Responses may be sized by Content-Length, chunked, or delimited by the server closing the connection.
+ * The body is collected into the acid::HttpResponse, or, when a body callback is given, streamed to the callback
+ * as it arrives so large downloads can go straight into a caller owned buffer.
+ *
+ * Requests are sent as HTTP/1.1. Idempotent requests lost to a connection the server closed are retried once.
+ * Host names are resolved the first time a host is used. The HTTPS protocol is not supported.
+ **/
+class ACID_EXPORT HttpClient :
+	public NonCopyable
+{
+public:
+	/// Called with the response once it is complete, or with a ConnectionFailed response if it failed.
+	using ResponseCallback = std::function<void(const HttpResponse &)>;
+	/// Called with each piece of the response body as it is received.
+	using BodyCallback = std::function<void(const char *, std::size_t)>;
+
+	/**
+	 * Creates a new HTTP client.
+	 * @param maxConnections Maximum number of connections opened to each host.
+	 * @param pipelineDepth Maximum number of requests in flight on each connection.
+	 **/
+	explicit HttpClient(const uint32_t &maxConnections = 4, const uint32_t &pipelineDepth = 8);
+
+	~HttpClient();
+
+	/**
+	 * Queues a request, it is sent by the following calls to Update.
+	 * Any missing mandatory header field in the request will be added with an appropriate value.
+	 * @param host Web server to send to, optionally with a "http://" prefix and a ":port" suffix.
+	 * @param request Request to send.
+	 * @param onResponse Called when the response is complete.
+	 * @param onBody Optional, receives the body as it arrives instead of it being stored in the response.
+	 **/
+	void Send(const std::string &host, const HttpRequest &request, const ResponseCallback &onResponse, const BodyCallback &onBody = nullptr);
+
+	/**
+	 * Connects, sends and receives on every connection without blocking, calling the callbacks of completed requests.
+	 * @param timeout Maximum time to wait for network activity if no request completes straight away.
+	 * @return If any requests are still pending.
+	 **/
+	bool Update(const Time &timeout = Time::Zero);
+
+	/**
+	 * Updates until every pending request has completed, or the timeout has passed.
+	 * @param timeout Maximum time to wait.
+	 * @return If every request completed.
+	 **/
+	bool Wait(const Time &timeout);
+
+	/**
+	 * Gets the number of requests queued or in flight.
+	 * @return The number of pending requests.
+	 **/
+	uint32_t GetPendingCount() const;
+
+	/**
+	 * Gets the number of open connections, over all hosts.
+	 * @return The number of connections.
+	 **/
+	uint32_t GetConnectionCount() const;
+
+	const Time &GetConnectTimeout() const { return m_connectTimeout; }
+
+	void SetConnectTimeout(const Time &connectTimeout) { m_connectTimeout = connectTimeout; }
+
+	const Time &GetIdleTimeout() const { return m_idleTimeout; }
+
+	/**
+	 * Sets how long a connection with nothing in flight is kept open for later requests.
+	 * @param idleTimeout The idle timeout.
+	 **/
+	void SetIdleTimeout(const Time &idleTimeout) { m_idleTimeout = idleTimeout; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Request
+	{
+		std::string m_data;
+		bool m_idempotent;
+		bool m_head;
+		uint32_t m_retries;
+		ResponseCallback m_onResponse;
+		BodyCallback m_onBody;
+	};
+
+	enum class ParseState
+	{
+		Header,
+		Body,
+		ChunkSize,
+		ChunkData,
+		ChunkEnd,
+		Trailers,
+		UntilClose
+	};
+
+	struct Connection
+	{
+		TcpSocket m_socket;
+		bool m_connecting = true;
+		bool m_keepAlive = true;
+		bool m_confirmed = false;
+		Clock::time_point m_lastActive;
+		std::deque<Request> m_inFlight;
+		std::string m_sendBuffer;
+		std::size_t m_sendOffset = 0;
+		std::string m_receiveBuffer;
+		std::size_t m_receiveOffset = 0;
+		ParseState m_state = ParseState::Header;
+		HttpResponse m_response;
+		uint64_t m_remaining = 0;
+	};
+
+	struct Host
+	{
+		std::string m_name;
+		IpAddress m_address;
+		uint16_t m_port = 0;
+		std::deque<Request> m_queue;
+		std::vector<std::unique_ptr<Connection>> m_connections;
+	};
+
+	bool Pump();
+
+	void Dispatch(Host &host);
+
+	Connection *Open(Host &host);
+
+	/**
+	 * Sends, receives and parses on a connection.
+	 * @return If the connection is still usable, if not it must be closed.
+	 **/
+	bool Process(Host &host, Connection &connection, bool &completed);
+
+	bool Parse(Connection &connection, bool &completed);
+
+	void Complete(Connection &connection);
+
+	void Close(Host &host, Connection &connection);
+
+	static void Fail(Request &request);
+
+	uint32_t m_maxConnections;
+	uint32_t m_pipelineDepth;
+	Time m_connectTimeout;
+	Time m_idleTimeout;
+
+	/// Hosts by name and port, a map so callbacks queuing requests to new hosts don't invalidate iteration.
+	std::map<std::string, Host> m_hosts;
+	SocketSelector m_selector;
+	std::vector<char> m_buffer;
+};
+}
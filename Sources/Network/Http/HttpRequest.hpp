@@ -86,6 +86,7 @@ public:
 
 private:
 	friend class Http;
+	friend class HttpClient;
 	using FieldTable = std::map<std::string, std::string>;
 
 	/**
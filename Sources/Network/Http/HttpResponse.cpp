@@ -28,44 +28,11 @@ void HttpResponse::Parse(const std::string &data)
 {
 	std::istringstream in(data);
 
-	// Extract the HTTP version from the first line.
-	std::string version;
-
-	if (in >> version)
-	{
-		if ((version.size() >= 8) && (version[6] == '.') && (String::Lowercase(version.substr(0, 5)) == "http/") && isdigit(version[5]) && isdigit(version[7]))
-		{
-			m_majorVersion = version[5] - '0';
-			m_minorVersion = version[7] - '0';
-		}
-		else
-		{
-			// Invalid HTTP version.
-			m_status = Status::InvalidResponse;
-			return;
-		}
-	}
-
-	// Extract the status code from the first line.
-	int status;
-
-	if (in >> status)
+	if (!ParseHeader(in))
 	{
-		m_status = static_cast<Status>(status);
-	}
-	else
-	{
-		// Invalid status code.
-		m_status = Status::InvalidResponse;
 		return;
 	}
 
-	// Ignore the end of the first line.
-	in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-	// Parse the other lines, which contain fields, one by one.
-	ParseFields(in);
-
 	m_body.clear();
 
 	// Determine whether the transfer is chunked.
@@ -103,6 +70,48 @@ void HttpResponse::Parse(const std::string &data)
 	}
 }
 
+bool HttpResponse::ParseHeader(std::istream &in)
+{
+	// Extract the HTTP version from the first line.
+	std::string version;
+
+	if (in >> version)
+	{
+		if ((version.size() >= 8) && (version[6] == '.') && (String::Lowercase(version.substr(0, 5)) == "http/") && isdigit(version[5]) && isdigit(version[7]))
+		{
+			m_majorVersion = version[5] - '0';
+			m_minorVersion = version[7] - '0';
+		}
+		else
+		{
+			// Invalid HTTP version.
+			m_status = Status::InvalidResponse;
+			return false;
+		}
+	}
+
+	// Extract the status code from the first line.
+	int status;
+
+	if (in >> status)
+	{
+		m_status = static_cast<Status>(status);
+	}
+	else
+	{
+		// Invalid status code.
+		m_status = Status::InvalidResponse;
+		return false;
+	}
+
+	// Ignore the end of the first line.
+	in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+	// Parse the other lines, which contain fields, one by one.
+	ParseFields(in);
+	return true;
+}
+
 void HttpResponse::ParseFields(std::istream &in)
 {
 	std::string line;
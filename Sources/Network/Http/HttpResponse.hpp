@@ -132,6 +132,13 @@ private:
 	 **/
 	void Parse(const std::string &data);
 
+	/**
+	 * Read the status line and header fields, leaving the stream at the start of the body.
+	 * @param in Stream containing the response header. 
+	 * @return If the status line was valid. 
+	 **/
+	bool ParseHeader(std::istream &in);
+
 	/**
 	 * Read values passed in the answer header.
 	 * This function is used by Http to extract values passed in the response.
@@ -140,6 +147,7 @@ private:
 	void ParseFields(std::istream &in);
 
 	friend class Http;
+	friend class HttpClient;
 
 	/// Fields of the header.
 	FieldTable m_fields;
@@ -0,0 +1,176 @@
+#include "BitStream.hpp"
+
+namespace acid
+{
+static uint64_t MaxQuantized(const uint32_t &bits)
+{
+	return (uint64_t(1) << bits) - 1;
+}
+
+void BitWriter::Write(const uint32_t &value, const uint32_t &bits)
+{
+	uint64_t remaining = bits >= 32 ? value : value & MaxQuantized(bits);
+	auto count = bits;
+
+	while (count > 0)
+	{
+		auto offset = static_cast<uint32_t>(m_bitCount & 7);
+
+		if (offset == 0)
+		{
+			m_data.emplace_back(0);
+		}
+
+		auto taken = std::min(8 - offset, count);
+		m_data.back() |= static_cast<uint8_t>((remaining & MaxQuantized(taken)) << offset);
+		remaining >>= taken;
+		count -= taken;
+		m_bitCount += taken;
+	}
+}
+
+void BitWriter::WriteVarUint(uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		Write((value & 0x7F) | 0x80, 8);
+		value >>= 7;
+	}
+
+	Write(value, 8);
+}
+
+void BitWriter::WriteVarInt(const int32_t &value)
+{
+	WriteVarUint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+}
+
+void BitWriter::WriteQuantized(const float &value, const float &min, const float &max, const uint32_t &bits)
+{
+	Write(Quantize(value, min, max, bits), bits);
+}
+
+void BitWriter::WriteBytes(const void *data, const std::size_t &size)
+{
+	auto bytes = static_cast<const uint8_t *>(data);
+
+	if ((m_bitCount & 7) == 0)
+	{
+		m_data.insert(m_data.end(), bytes, bytes + size);
+		m_bitCount += size * 8;
+		return;
+	}
+
+	for (std::size_t i = 0; i < size; i++)
+	{
+		Write(bytes[i], 8);
+	}
+}
+
+void BitWriter::AlignToByte()
+{
+	m_bitCount = m_data.size() * 8;
+}
+
+void BitWriter::Clear()
+{
+	m_data.clear();
+	m_bitCount = 0;
+}
+
+uint32_t BitWriter::Quantize(const float &value, const float &min, const float &max, const uint32_t &bits)
+{
+	auto normalized = (std::clamp(value, min, max) - min) / (max - min);
+	return static_cast<uint32_t>(std::llround(static_cast<double>(normalized) * static_cast<double>(MaxQuantized(bits))));
+}
+
+BitReader::BitReader(const void *data, const std::size_t &size) :
+	m_data(static_cast<const uint8_t *>(data)),
+	m_size(size),
+	m_bitPosition(0),
+	m_overflow(false)
+{
+}
+
+uint32_t BitReader::Read(const uint32_t &bits)
+{
+	if (m_bitPosition + bits > m_size * 8)
+	{
+		m_overflow = true;
+		m_bitPosition = m_size * 8;
+		return 0;
+	}
+
+	uint64_t value = 0;
+	uint32_t read = 0;
+
+	while (read < bits)
+	{
+		auto offset = static_cast<uint32_t>(m_bitPosition & 7);
+		auto taken = std::min(8 - offset, bits - read);
+		uint64_t part = (m_data[m_bitPosition >> 3] >> offset) & MaxQuantized(taken);
+		value |= part << read;
+		read += taken;
+		m_bitPosition += taken;
+	}
+
+	return static_cast<uint32_t>(value);
+}
+
+uint32_t BitReader::ReadVarUint()
+{
+	uint32_t value = 0;
+
+	for (uint32_t shift = 0; shift < 35; shift += 7)
+	{
+		auto byte = Read(8);
+		value |= (byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0 || m_overflow)
+		{
+			return value;
+		}
+	}
+
+	m_overflow = true;
+	return 0;
+}
+
+int32_t BitReader::ReadVarInt()
+{
+	auto value = ReadVarUint();
+	return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+float BitReader::ReadQuantized(const float &min, const float &max, const uint32_t &bits)
+{
+	return Dequantize(Read(bits), min, max, bits);
+}
+
+void BitReader::ReadBytes(void *data, const std::size_t &size)
+{
+	auto bytes = static_cast<uint8_t *>(data);
+
+	if ((m_bitPosition & 7) == 0 && m_bitPosition + size * 8 <= m_size * 8)
+	{
+		std::memcpy(bytes, m_data + m_bitPosition / 8, size);
+		m_bitPosition += size * 8;
+		return;
+	}
+
+	for (std::size_t i = 0; i < size; i++)
+	{
+		bytes[i] = static_cast<uint8_t>(Read(8));
+	}
+}
+
+void BitReader::AlignToByte()
+{
+	m_bitPosition = std::min(m_size * 8, (m_bitPosition + 7) & ~std::size_t(7));
+}
+
+float BitReader::Dequantize(const uint32_t &value, const float &min, const float &max, const uint32_t &bits)
+{
+	return min + static_cast<float>(static_cast<double>(value) / static_cast<double>(MaxQuantized(bits))) * (max - min);
+}
+}
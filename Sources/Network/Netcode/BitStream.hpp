@@ -0,0 +1,154 @@
+#pragma once
+
+#include "StdAfx.hpp"
+
+namespace acid
+{
+/**
+ * @brief Writes values into a buffer using only as many bits as each value needs.
+ * Unlike acid::Packet values are not byte aligned, a bool takes one bit and a quantized float takes as few bits as its precision allows.
+ * Bits are written least significant first, the buffer is reused after Clear so a writer kept around doesn't reallocate.
+ **/
+class ACID_EXPORT BitWriter
+{
+public:
+	BitWriter() = default;
+
+	/**
+	 * Writes the low bits of a value.
+	 * @param value The value to write, bits above the count are ignored.
+	 * @param bits The number of bits to write, from 1 to 32.
+	 **/
+	void Write(const uint32_t &value, const uint32_t &bits);
+
+	void WriteBool(const bool &value) { Write(value ? 1 : 0, 1); }
+
+	/**
+	 * Writes an unsigned value in groups of 7 bits, so small values take a single byte worth of bits.
+	 * @param value The value to write.
+	 **/
+	void WriteVarUint(uint32_t value);
+
+	/**
+	 * Writes a signed value zig-zag encoded, so values close to zero take few bits.
+	 * @param value The value to write.
+	 **/
+	void WriteVarInt(const int32_t &value);
+
+	/**
+	 * Writes a float quantized to a range.
+	 * @param value The value to write, clamped to the range.
+	 * @param min The range minimum.
+	 * @param max The range maximum.
+	 * @param bits The number of bits, the precision is (max - min) / (2^bits - 1).
+	 **/
+	void WriteQuantized(const float &value, const float &min, const float &max, const uint32_t &bits);
+
+	/**
+	 * Writes raw bytes, the bytes are not aligned to the buffer.
+	 * @param data The bytes to write.
+	 * @param size The number of bytes.
+	 **/
+	void WriteBytes(const void *data, const std::size_t &size);
+
+	/**
+	 * Pads the buffer with zero bits up to the next whole byte.
+	 **/
+	void AlignToByte();
+
+	/**
+	 * Clears the written bits, keeping the buffer storage.
+	 **/
+	void Clear();
+
+	const uint8_t *GetData() const { return m_data.data(); }
+
+	/**
+	 * Gets the written size rounded up to whole bytes.
+	 * @return The size in bytes.
+	 **/
+	std::size_t GetSize() const { return m_data.size(); }
+
+	const std::size_t &GetBitCount() const { return m_bitCount; }
+
+	/**
+	 * Quantizes a float to a range.
+	 * @param value The value, clamped to the range.
+	 * @param min The range minimum.
+	 * @param max The range maximum.
+	 * @param bits The number of bits.
+	 * @return The quantized value.
+	 **/
+	static uint32_t Quantize(const float &value, const float &min, const float &max, const uint32_t &bits);
+
+private:
+	std::vector<uint8_t> m_data;
+	std::size_t m_bitCount = 0;
+};
+
+/**
+ * @brief Reads values written by acid::BitWriter, in the same order and with the same bit counts.
+ * Reading past the end of the data returns zeros and marks the reader as overflowed, so a malformed packet can be read
+ * to the end and checked once with IsOverflow instead of after every value.
+ **/
+class ACID_EXPORT BitReader
+{
+public:
+	/**
+	 * Creates a reader over existing data, the data is not copied.
+	 * @param data The data to read.
+	 * @param size The size of the data in bytes.
+	 **/
+	BitReader(const void *data, const std::size_t &size);
+
+	/**
+	 * Reads a value.
+	 * @param bits The number of bits to read, from 1 to 32.
+	 * @return The value, or 0 if the reader has overflowed.
+	 **/
+	uint32_t Read(const uint32_t &bits);
+
+	bool ReadBool() { return Read(1) != 0; }
+
+	uint32_t ReadVarUint();
+
+	int32_t ReadVarInt();
+
+	float ReadQuantized(const float &min, const float &max, const uint32_t &bits);
+
+	void ReadBytes(void *data, const std::size_t &size);
+
+	/**
+	 * Skips to the next whole byte.
+	 **/
+	void AlignToByte();
+
+	/**
+	 * Gets the data that has not been read, only meaningful when the reader is aligned to a byte.
+	 * @return The unread data.
+	 **/
+	const uint8_t *GetRemainingData() const { return m_data + (m_bitPosition + 7) / 8; }
+
+	std::size_t GetRemainingBytes() const { return m_size - std::min(m_size, (m_bitPosition + 7) / 8); }
+
+	std::size_t GetRemainingBits() const { return m_size * 8 - std::min(m_size * 8, m_bitPosition); }
+
+	const bool &IsOverflow() const { return m_overflow; }
+
+	/**
+	 * Reverses BitWriter::Quantize.
+	 * @param value The quantized value.
+	 * @param min The range minimum.
+	 * @param max The range maximum.
+	 * @param bits The number of bits.
+	 * @return The float value.
+	 **/
+	static float Dequantize(const uint32_t &value, const float &min, const float &max, const uint32_t &bits);
+
+private:
+	const uint8_t *m_data;
+	std::size_t m_size;
+	std::size_t m_bitPosition;
+	bool m_overflow;
+};
+}
@@ -0,0 +1,242 @@
+#include "NetChannel.hpp"
+
+#include "Engine/Log.hpp"
+
+namespace acid
+{
+static constexpr auto MessageResendTime = std::chrono::milliseconds(100);
+/// Packets older than this many sequences behind the newest received packet are dropped.
+static constexpr uint16_t ReceiveWindow = 1024;
+
+NetChannel::NetChannel(const uint32_t &protocolId) :
+	m_protocolId(protocolId),
+	m_sequence(0),
+	m_remoteSequence(0xFFFF),
+	m_receivedAny(false),
+	m_lastReceived(Clock::now()),
+	m_sendMessageId(0),
+	m_oldestUnackedMessageId(0),
+	m_receiveMessageId(0)
+{
+}
+
+uint16_t NetChannel::WritePacket(const BitWriter &payload, BitWriter &packet)
+{
+	auto now = Clock::now();
+	auto sequence = m_sequence++;
+
+	uint32_t ackBits = 0;
+
+	for (uint32_t i = 0; i < 32; i++)
+	{
+		if (m_receivedPackets.Exists(static_cast<uint16_t>(m_remoteSequence - 1 - i)))
+		{
+			ackBits |= 1u << i;
+		}
+	}
+
+	packet.Clear();
+	packet.Write(m_protocolId, 32);
+	packet.Write(sequence, 16);
+	packet.Write(m_remoteSequence, 16);
+	packet.Write(ackBits, 32);
+
+	auto &sent = m_sentPackets.Insert(sequence);
+	sent.m_time = now;
+	sent.m_acked = false;
+	sent.m_messageCount = 0;
+
+	// Picks the oldest messages that haven't been sent recently, within the packet budget.
+	std::size_t messageBytes = 0;
+
+	for (auto id = m_oldestUnackedMessageId; id != m_sendMessageId && sent.m_messageCount < MaxPacketMessages; id++)
+	{
+		auto message = m_sendMessages.Find(id);
+
+		if (message == nullptr || (message->m_sent && now - message->m_lastSent < MessageResendTime))
+		{
+			continue;
+		}
+
+		if (messageBytes + message->m_data.size() > MessageBudget)
+		{
+			break;
+		}
+
+		messageBytes += message->m_data.size();
+		sent.m_messageIds[sent.m_messageCount++] = id;
+	}
+
+	packet.WriteVarUint(sent.m_messageCount);
+
+	for (uint32_t i = 0; i < sent.m_messageCount; i++)
+	{
+		auto message = m_sendMessages.Find(sent.m_messageIds[i]);
+		packet.Write(sent.m_messageIds[i], 16);
+		packet.WriteVarUint(static_cast<uint32_t>(message->m_data.size()));
+		packet.WriteBytes(message->m_data.data(), message->m_data.size());
+		message->m_sent = true;
+		message->m_lastSent = now;
+	}
+
+	packet.AlignToByte();
+	packet.WriteBytes(payload.GetData(), payload.GetSize());
+
+	m_statistics.m_packetsSent++;
+	m_statistics.m_bytesSent += packet.GetSize();
+	return sequence;
+}
+
+bool NetChannel::ReadPacket(const void *data, const std::size_t &size, const uint8_t *&payload, std::size_t &payloadSize)
+{
+	BitReader reader(data, size);
+
+	if (reader.Read(32) != m_protocolId)
+	{
+		return false;
+	}
+
+	auto sequence = static_cast<uint16_t>(reader.Read(16));
+	auto ack = static_cast<uint16_t>(reader.Read(16));
+	auto ackBits = reader.Read(32);
+
+	if (reader.IsOverflow() || m_receivedPackets.Exists(sequence))
+	{
+		return false;
+	}
+
+	if (m_receivedAny && SequenceLess(sequence, static_cast<uint16_t>(m_remoteSequence - ReceiveWindow)))
+	{
+		return false;
+	}
+
+	auto messageCount = reader.ReadVarUint();
+
+	if (messageCount > MaxPacketMessages)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < messageCount; i++)
+	{
+		auto id = static_cast<uint16_t>(reader.Read(16));
+		auto messageSize = reader.ReadVarUint();
+
+		if (reader.IsOverflow() || messageSize > MaxMessageSize || reader.GetRemainingBits() < messageSize * 8)
+		{
+			return false;
+		}
+
+		// Messages already delivered, or too far ahead to buffer, are resent later and can be skipped.
+		auto ahead = static_cast<uint16_t>(id - m_receiveMessageId);
+
+		if (ahead >= m_receiveMessages.GetSize() || m_receiveMessages.Exists(id))
+		{
+			m_discard.resize(messageSize);
+			reader.ReadBytes(m_discard.data(), messageSize);
+			continue;
+		}
+
+		auto &message = m_receiveMessages.Insert(id);
+		message.resize(messageSize);
+		reader.ReadBytes(message.data(), messageSize);
+	}
+
+	reader.AlignToByte();
+
+	m_receivedPackets.Insert(sequence);
+
+	if (!m_receivedAny || SequenceGreater(sequence, m_remoteSequence))
+	{
+		m_remoteSequence = sequence;
+	}
+
+	m_receivedAny = true;
+	m_lastReceived = Clock::now();
+	m_statistics.m_packetsReceived++;
+	m_statistics.m_bytesReceived += size;
+
+	ProcessAcks(ack, ackBits);
+
+	payload = reader.GetRemainingData();
+	payloadSize = reader.GetRemainingBytes();
+	return true;
+}
+
+bool NetChannel::SendReliable(const void *data, const std::size_t &size)
+{
+	if (size > MaxMessageSize)
+	{
+		Log::Error("Reliable message of %i bytes is larger than the limit of %i bytes\n", static_cast<int32_t>(size), static_cast<int32_t>(MaxMessageSize));
+		return false;
+	}
+
+	if (static_cast<uint16_t>(m_sendMessageId - m_oldestUnackedMessageId) >= m_sendMessages.GetSize())
+	{
+		return false;
+	}
+
+	auto &message = m_sendMessages.Insert(m_sendMessageId++);
+	auto bytes = static_cast<const uint8_t *>(data);
+	message.m_data.assign(bytes, bytes + size);
+	message.m_sent = false;
+	return true;
+}
+
+bool NetChannel::ReceiveReliable(std::vector<uint8_t> &message)
+{
+	auto received = m_receiveMessages.Find(m_receiveMessageId);
+
+	if (received == nullptr)
+	{
+		return false;
+	}
+
+	message.assign(received->begin(), received->end());
+	m_receiveMessages.Remove(m_receiveMessageId++);
+	return true;
+}
+
+Time NetChannel::GetTimeSinceReceived() const
+{
+	return Time::Microseconds(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_lastReceived).count());
+}
+
+void NetChannel::ProcessAcks(const uint16_t &ack, const uint32_t &ackBits)
+{
+	auto now = Clock::now();
+
+	for (uint32_t i = 0; i <= 32; i++)
+	{
+		if (i != 0 && (ackBits & (1u << (i - 1))) == 0)
+		{
+			continue;
+		}
+
+		auto sequence = static_cast<uint16_t>(ack - i);
+		auto sent = m_sentPackets.Find(sequence);
+
+		if (sent == nullptr || sent->m_acked)
+		{
+			continue;
+		}
+
+		sent->m_acked = true;
+
+		for (uint32_t j = 0; j < sent->m_messageCount; j++)
+		{
+			m_sendMessages.Remove(sent->m_messageIds[j]);
+		}
+
+		auto roundTrip = Time::Microseconds(std::chrono::duration_cast<std::chrono::microseconds>(now - sent->m_time).count());
+		m_statistics.m_roundTrip = m_statistics.m_packetsAcked == 0 ? roundTrip : m_statistics.m_roundTrip + (roundTrip - m_statistics.m_roundTrip) * 0.1f;
+		m_statistics.m_packetsAcked++;
+		m_onPacketAcked(sequence);
+	}
+
+	while (m_oldestUnackedMessageId != m_sendMessageId && !m_sendMessages.Exists(m_oldestUnackedMessageId))
+	{
+		m_oldestUnackedMessageId++;
+	}
+}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <chrono>
+#include "Helpers/Delegate.hpp"
+#include "Maths/Time.hpp"
+#include "BitStream.hpp"
+#include "SequenceBuffer.hpp"
+
+namespace acid
+{
+/**
+ * @brief Traffic counters for one connection, used to measure bandwidth and CPU cost per client.
+ **/
+struct ACID_EXPORT NetStatistics
+{
+	uint64_t m_bytesSent = 0;
+	uint64_t m_bytesReceived = 0;
+	uint64_t m_packetsSent = 0;
+	uint64_t m_packetsReceived = 0;
+	uint64_t m_packetsAcked = 0;
+	/// Smoothed round trip time of acked packets.
+	Time m_roundTrip;
+	/// Time spent encoding the last packet payload, filled by the owner of the channel.
+	Time m_encodeTime;
+	/// Time spent encoding payloads since the channel was created.
+	Time m_encodeTimeTotal;
+};
+
+/**
+ * @brief A sequenced and acknowledged channel over an unreliable datagram transport.
+ *
+ * Every packet carries its own 16 bit sequence, the most recent sequence received from the peer,
+ * and a bitfield acknowledging the 32 sequences before that. So each packet is acked many times over
+ * and an ack is only lost if many packets in a row are lost. Acks are reported through OnPacketAcked,
+ * letting higher levels (snapshot baselines etc.) know what the peer has actually seen.
+ *
+ * Small ordered reliable messages can be queued with SendReliable, they are piggybacked on outgoing packets
+ * and resent every 100 milliseconds until a packet containing them is acked.
+ *
+ * The channel doesn't own a socket, WritePacket builds a datagram and ReadPacket parses one,
+ * so a server can route many channels through one socket and send them with UdpSocket::SendBatch.
+ **/
+class ACID_EXPORT NetChannel
+{
+public:
+	/// Maximum size of a single reliable message.
+	static constexpr std::size_t MaxMessageSize = 1024;
+	/// Reliable message bytes added to a single packet.
+	static constexpr std::size_t MessageBudget = 1024;
+
+	/**
+	 * Creates a new channel.
+	 * @param protocolId Identifier written to every packet, packets with another identifier are ignored.
+	 **/
+	explicit NetChannel(const uint32_t &protocolId);
+
+	/**
+	 * Builds the next packet, with acks, any reliable messages due to be sent and the payload.
+	 * @param payload The unreliable payload, may be empty.
+	 * @param packet Writer to build the packet into, it is cleared first.
+	 * @return The sequence of the packet.
+	 **/
+	uint16_t WritePacket(const BitWriter &payload, BitWriter &packet);
+
+	/**
+	 * Parses a packet received from the peer, processing its acks and reliable messages.
+	 * @param data The received data.
+	 * @param size The size of the data.
+	 * @param payload Filled with the start of the payload, pointing into data.
+	 * @param payloadSize Filled with the size of the payload.
+	 * @return If the packet was valid and not a duplicate.
+	 **/
+	bool ReadPacket(const void *data, const std::size_t &size, const uint8_t *&payload, std::size_t &payloadSize);
+
+	/**
+	 * Queues a reliable message, messages are delivered to the peer in the order they are queued.
+	 * @param data The message data.
+	 * @param size The size of the message, at most MaxMessageSize.
+	 * @return If the message was queued, false if it is too large or too many messages are waiting for acks.
+	 **/
+	bool SendReliable(const void *data, const std::size_t &size);
+
+	/**
+	 * Takes the next reliable message received from the peer, in order.
+	 * @param message Filled with the message.
+	 * @return If a message was available.
+	 **/
+	bool ReceiveReliable(std::vector<uint8_t> &message);
+
+	/**
+	 * Gets the time since a valid packet was last received from the peer.
+	 * @return The time since the last packet.
+	 **/
+	Time GetTimeSinceReceived() const;
+
+	const NetStatistics &GetStatistics() const { return m_statistics; }
+
+	NetStatistics &GetStatistics() { return m_statistics; }
+
+	/**
+	 * Called with the sequence of each sent packet the first time the peer acknowledges it.
+	 * @return The delegate.
+	 **/
+	Delegate<void(uint16_t)> &OnPacketAcked() { return m_onPacketAcked; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr uint32_t MaxPacketMessages = 32;
+
+	struct SentPacket
+	{
+		Clock::time_point m_time;
+		bool m_acked;
+		uint32_t m_messageCount;
+		std::array<uint16_t, MaxPacketMessages> m_messageIds;
+	};
+
+	struct ReceivedPacket
+	{
+	};
+
+	struct Message
+	{
+		std::vector<uint8_t> m_data;
+		Clock::time_point m_lastSent;
+		bool m_sent;
+	};
+
+	void ProcessAcks(const uint16_t &ack, const uint32_t &ackBits);
+
+	uint32_t m_protocolId;
+
+	uint16_t m_sequence;
+	uint16_t m_remoteSequence;
+	bool m_receivedAny;
+	Clock::time_point m_lastReceived;
+
+	SequenceBuffer<SentPacket, 1024> m_sentPackets;
+	SequenceBuffer<ReceivedPacket, 1024> m_receivedPackets;
+
+	uint16_t m_sendMessageId;
+	uint16_t m_oldestUnackedMessageId;
+	uint16_t m_receiveMessageId;
+	SequenceBuffer<Message, 256> m_sendMessages;
+	SequenceBuffer<std::vector<uint8_t>, 256> m_receiveMessages;
+	/// Holds duplicate messages while they are skipped.
+	std::vector<uint8_t> m_discard;
+
+	NetStatistics m_statistics;
+	Delegate<void(uint16_t)> m_onPacketAcked;
+};
+}
@@ -0,0 +1,136 @@
+#include "NetClient.hpp"
+
+#include "Replicated.hpp"
+
+namespace acid
+{
+NetClient::NetClient(const uint32_t &protocolId) :
+	m_protocolId(protocolId),
+	m_port(0),
+	m_timeout(Time::Seconds(5.0f)),
+	m_hasSnapshot(false),
+	m_latest(0),
+	m_buffer(65507)
+{
+}
+
+NetClient::~NetClient()
+{
+	Disconnect();
+}
+
+Socket::Status NetClient::Connect(const IpAddress &address, const uint16_t &port)
+{
+	Disconnect();
+	m_socket.SetBlocking(false);
+	auto status = m_socket.Bind(0);
+
+	if (status != Socket::Status::Done)
+	{
+		return status;
+	}
+
+	m_address = address;
+	m_port = port;
+	m_channel = std::make_unique<NetChannel>(m_protocolId);
+	return Socket::Status::Done;
+}
+
+void NetClient::Disconnect()
+{
+	m_socket.Unbind();
+	m_channel = nullptr;
+	m_hasSnapshot = false;
+	m_snapshots.Clear();
+}
+
+void NetClient::Update(SceneStructure &structure)
+{
+	if (Receive())
+	{
+		Replicated::Apply(*GetSnapshot(), structure, m_onEntityCreated);
+	}
+
+	Send();
+}
+
+bool NetClient::Receive()
+{
+	if (m_channel == nullptr)
+	{
+		return false;
+	}
+
+	auto updated = false;
+	std::size_t received;
+	IpAddress address;
+	uint16_t port;
+
+	while (m_socket.Receive(m_buffer.data(), m_buffer.size(), received, address, port) == Socket::Status::Done)
+	{
+		const uint8_t *payload;
+		std::size_t payloadSize;
+
+		if (address != m_address || port != m_port || !m_channel->ReadPacket(m_buffer.data(), received, payload, payloadSize))
+		{
+			continue;
+		}
+
+		BitReader reader(payload, payloadSize);
+		auto sequence = static_cast<uint16_t>(reader.Read(16));
+		auto hasBaseline = reader.ReadBool();
+		auto baselineSequence = hasBaseline ? static_cast<uint16_t>(reader.Read(16)) : 0;
+
+		// Snapshots older than the newest are never applied, and the server only uses the newest as a baseline.
+		if (reader.IsOverflow() || (m_hasSnapshot && !SequenceGreater(sequence, m_latest)))
+		{
+			continue;
+		}
+
+		auto baseline = hasBaseline ? m_snapshots.Find(baselineSequence) : nullptr;
+
+		if (hasBaseline && baseline == nullptr)
+		{
+			continue;
+		}
+
+		if (!m_decoding.ReadDelta(reader, baseline))
+		{
+			continue;
+		}
+
+		auto &snapshot = m_snapshots.Insert(sequence);
+		std::swap(snapshot, m_decoding);
+		snapshot.SetSequence(sequence);
+		m_hasSnapshot = true;
+		m_latest = sequence;
+		updated = true;
+	}
+
+	return updated;
+}
+
+void NetClient::Send()
+{
+	if (m_channel == nullptr)
+	{
+		return;
+	}
+
+	m_payload.Clear();
+	m_payload.WriteBool(m_hasSnapshot);
+
+	if (m_hasSnapshot)
+	{
+		m_payload.Write(m_latest, 16);
+	}
+
+	m_channel->WritePacket(m_payload, m_packet);
+	m_socket.Send(m_packet.GetData(), m_packet.GetSize(), m_address, m_port);
+}
+
+bool NetClient::IsConnected() const
+{
+	return m_channel != nullptr && m_channel->GetStatistics().m_packetsReceived > 0 && m_channel->GetTimeSinceReceived() < m_timeout;
+}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Network/Udp/UdpSocket.hpp"
+#include "NetChannel.hpp"
+#include "NetServer.hpp"
+#include "Snapshot.hpp"
+
+namespace acid
+{
+class Entity;
+class SceneStructure;
+
+/**
+ * @brief Receives a scene replicated by a acid::NetServer.
+ *
+ * Every update the client decodes the snapshots that arrived, keeping each as a possible baseline for later deltas,
+ * and sends the server a packet reporting the newest snapshot it has decoded. Only the newest snapshot is applied.
+ **/
+class ACID_EXPORT NetClient :
+	public NonCopyable
+{
+public:
+	/**
+	 * Creates a new client, call Connect to start receiving from a server.
+	 * @param protocolId Identifier written to every packet, must match the server.
+	 **/
+	explicit NetClient(const uint32_t &protocolId = NetServer::DefaultProtocolId);
+
+	~NetClient();
+
+	/**
+	 * Binds a local port and starts sending to a server, the server connects the client when the first packet arrives.
+	 * @param address The server address.
+	 * @param port The server port.
+	 * @return Status code.
+	 **/
+	Socket::Status Connect(const IpAddress &address, const uint16_t &port);
+
+	/**
+	 * Stops talking to the server and clears the received snapshots.
+	 **/
+	void Disconnect();
+
+	/**
+	 * Receives from the server, applies the newest snapshot to a structure and acknowledges it.
+	 * @param structure The structure to update.
+	 **/
+	void Update(SceneStructure &structure);
+
+	/**
+	 * Receives and decodes every waiting packet.
+	 * @return If a newer snapshot was decoded.
+	 **/
+	bool Receive();
+
+	/**
+	 * Sends a packet with acks, reliable messages and the newest decoded snapshot sequence.
+	 **/
+	void Send();
+
+	bool SendReliable(const void *data, const std::size_t &size) { return m_channel != nullptr && m_channel->SendReliable(data, size); }
+
+	bool ReceiveReliable(std::vector<uint8_t> &message) { return m_channel != nullptr && m_channel->ReceiveReliable(message); }
+
+	/**
+	 * Gets if the server has been heard from within the timeout.
+	 * @return If the client is connected.
+	 **/
+	bool IsConnected() const;
+
+	/**
+	 * Gets the newest decoded snapshot.
+	 * @return The snapshot, or nullptr if none has been received.
+	 **/
+	const Snapshot *GetSnapshot() const { return m_hasSnapshot ? m_snapshots.Find(m_latest) : nullptr; }
+
+	const NetStatistics *GetStatistics() const { return m_channel != nullptr ? &m_channel->GetStatistics() : nullptr; }
+
+	const Time &GetTimeout() const { return m_timeout; }
+
+	void SetTimeout(const Time &timeout) { m_timeout = timeout; }
+
+	/**
+	 * Called when a replicated entity is created, before its fields are read, so its components can be added.
+	 * @return The delegate.
+	 **/
+	Delegate<void(Entity *)> &OnEntityCreated() { return m_onEntityCreated; }
+
+private:
+	uint32_t m_protocolId;
+	UdpSocket m_socket;
+	IpAddress m_address;
+	uint16_t m_port;
+	Time m_timeout;
+	std::unique_ptr<NetChannel> m_channel;
+
+	bool m_hasSnapshot;
+	uint16_t m_latest;
+	SequenceBuffer<Snapshot, NetServer::HistorySize> m_snapshots;
+	Snapshot m_decoding;
+
+	std::vector<uint8_t> m_buffer;
+	BitWriter m_payload;
+	BitWriter m_packet;
+
+	Delegate<void(Entity *)> m_onEntityCreated;
+};
+}
@@ -0,0 +1,236 @@
+#include "NetServer.hpp"
+
+#include "Engine/Log.hpp"
+#include "Replicated.hpp"
+
+namespace acid
+{
+/// Number of datagrams taken from the socket by each receive call.
+static constexpr std::size_t ReceiveBatchSize = 32;
+/// Client packets only carry acks and reliable messages, this covers a full reliable message budget.
+static constexpr std::size_t ReceiveBufferSize = 2048;
+static constexpr std::size_t MaxDatagramSize = 65507;
+
+NetServer::NetServer(const uint16_t &port, const uint32_t &maxClients, const uint32_t &protocolId) :
+	m_protocolId(protocolId),
+	m_bound(false),
+	m_timeout(Time::Seconds(5.0f)),
+	m_clients(maxClients),
+	m_sequence(0),
+	m_hasSnapshot(false),
+	m_nextNetworkId(1),
+	m_receiveBuffers(ReceiveBatchSize, std::vector<uint8_t>(ReceiveBufferSize)),
+	m_received(ReceiveBatchSize)
+{
+	m_socket.SetBlocking(false);
+
+	if (m_socket.Bind(port) != Socket::Status::Done)
+	{
+		Log::Error("Net server failed to bind port %i\n", static_cast<int32_t>(port));
+		return;
+	}
+
+	m_bound = true;
+}
+
+NetServer::~NetServer()
+{
+	m_socket.Unbind();
+}
+
+void NetServer::Update(SceneStructure &structure)
+{
+	Receive();
+	Replicated::Capture(structure, CreateSnapshot(), m_nextNetworkId);
+	Send();
+}
+
+void NetServer::Receive()
+{
+	if (!m_bound)
+	{
+		return;
+	}
+
+	while (true)
+	{
+		for (std::size_t i = 0; i < m_received.size(); i++)
+		{
+			m_received[i].m_data = m_receiveBuffers[i].data();
+			m_received[i].m_size = m_receiveBuffers[i].size();
+		}
+
+		std::size_t received = 0;
+		auto status = m_socket.ReceiveBatch(m_received.data(), m_received.size(), received);
+
+		for (std::size_t i = 0; i < received; i++)
+		{
+			Process(m_received[i]);
+		}
+
+		if (status != Socket::Status::Done || received < m_received.size())
+		{
+			break;
+		}
+	}
+
+	for (uint32_t i = 0; i < m_clients.size(); i++)
+	{
+		auto &client = m_clients[i];
+
+		if (client != nullptr && client->m_channel.GetTimeSinceReceived() > m_timeout)
+		{
+			m_addresses.erase(AddressKey(client->m_address, client->m_port));
+			client = nullptr;
+			m_onClientDisconnected(i);
+		}
+	}
+}
+
+Snapshot &NetServer::CreateSnapshot()
+{
+	if (m_hasSnapshot)
+	{
+		m_sequence++;
+	}
+
+	m_hasSnapshot = true;
+	auto &snapshot = m_history.Insert(m_sequence);
+	snapshot.Clear();
+	snapshot.SetSequence(m_sequence);
+	return snapshot;
+}
+
+void NetServer::Send()
+{
+	auto snapshot = m_history.Find(m_sequence);
+
+	if (!m_bound || !m_hasSnapshot || snapshot == nullptr)
+	{
+		return;
+	}
+
+	m_sending.clear();
+
+	for (auto &client : m_clients)
+	{
+		if (client == nullptr)
+		{
+			continue;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		auto baseline = client->m_hasBaseline ? m_history.Find(client->m_baseline) : nullptr;
+
+		client->m_payload.Clear();
+		client->m_payload.Write(m_sequence, 16);
+		client->m_payload.WriteBool(baseline != nullptr);
+
+		if (baseline != nullptr)
+		{
+			client->m_payload.Write(client->m_baseline, 16);
+		}
+
+		snapshot->WriteDelta(client->m_payload, baseline);
+
+		auto &statistics = client->m_channel.GetStatistics();
+		statistics.m_encodeTime = Time::Microseconds(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+		statistics.m_encodeTimeTotal += statistics.m_encodeTime;
+
+		client->m_channel.WritePacket(client->m_payload, client->m_packet);
+
+		if (client->m_packet.GetSize() > MaxDatagramSize)
+		{
+			Log::Error("Net server snapshot of %i bytes is too large for a datagram\n", static_cast<int32_t>(client->m_packet.GetSize()));
+			continue;
+		}
+
+		m_sending.emplace_back(UdpDatagram{const_cast<uint8_t *>(client->m_packet.GetData()), client->m_packet.GetSize(), 0, client->m_address, client->m_port});
+	}
+
+	std::size_t sent = 0;
+	m_socket.SendBatch(m_sending.data(), m_sending.size(), sent);
+}
+
+bool NetServer::SendReliable(const uint32_t &client, const void *data, const std::size_t &size)
+{
+	return IsConnected(client) && m_clients[client]->m_channel.SendReliable(data, size);
+}
+
+bool NetServer::ReceiveReliable(const uint32_t &client, std::vector<uint8_t> &message)
+{
+	return IsConnected(client) && m_clients[client]->m_channel.ReceiveReliable(message);
+}
+
+uint32_t NetServer::GetClientCount() const
+{
+	return static_cast<uint32_t>(std::count_if(m_clients.begin(), m_clients.end(), [](const std::unique_ptr<Client> &client)
+	{
+		return client != nullptr;
+	}));
+}
+
+const NetStatistics *NetServer::GetStatistics(const uint32_t &client) const
+{
+	return IsConnected(client) ? &m_clients[client]->m_channel.GetStatistics() : nullptr;
+}
+
+void NetServer::Process(const UdpDatagram &datagram)
+{
+	auto key = AddressKey(datagram.m_address, datagram.m_port);
+	auto it = m_addresses.find(key);
+	auto connecting = it == m_addresses.end();
+	uint32_t index;
+
+	if (connecting)
+	{
+		auto slot = std::find(m_clients.begin(), m_clients.end(), nullptr);
+
+		if (slot == m_clients.end())
+		{
+			return;
+		}
+
+		index = static_cast<uint32_t>(slot - m_clients.begin());
+	}
+	else
+	{
+		index = it->second;
+	}
+
+	auto client = connecting ? std::make_unique<Client>(m_protocolId) : nullptr;
+	auto &channel = connecting ? client->m_channel : m_clients[index]->m_channel;
+
+	const uint8_t *payload;
+	std::size_t payloadSize;
+
+	if (!channel.ReadPacket(datagram.m_data, datagram.m_received, payload, payloadSize))
+	{
+		return;
+	}
+
+	if (connecting)
+	{
+		client->m_address = datagram.m_address;
+		client->m_port = datagram.m_port;
+		m_clients[index] = std::move(client);
+		m_addresses.emplace(key, index);
+		m_onClientConnected(index);
+	}
+
+	// The client reports the newest snapshot it has decoded, which becomes its delta baseline.
+	BitReader reader(payload, payloadSize);
+	auto &connected = *m_clients[index];
+
+	if (reader.ReadBool())
+	{
+		auto decoded = static_cast<uint16_t>(reader.Read(16));
+
+		if (!reader.IsOverflow() && (!connected.m_hasBaseline || SequenceGreater(decoded, connected.m_baseline)))
+		{
+			connected.m_hasBaseline = true;
+			connected.m_baseline = decoded;
+		}
+	}
+}
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Network/Udp/UdpSocket.hpp"
+#include "NetChannel.hpp"
+#include "Snapshot.hpp"
+
+namespace acid
+{
+class SceneStructure;
+
+/**
+ * @brief Replicates a scene to clients over UDP.
+ *
+ * Each update the replicated entities (see acid::Replicated) are captured into a snapshot, and every client is sent
+ * that snapshot delta compressed against the newest snapshot the client reported it has decoded. Clients that stop
+ * reporting fall back to larger deltas and, once their baseline leaves the history, full snapshots.
+ *
+ * Clients connect by sending any valid packet, and are dropped after the timeout passes without a packet from them.
+ * Per client traffic and encoding time are kept in the client's acid::NetStatistics.
+ **/
+class ACID_EXPORT NetServer :
+	public NonCopyable
+{
+public:
+	/// Default identifier written to every packet, the ASCII of "ACID".
+	static constexpr uint32_t DefaultProtocolId = 0x41434944;
+	/// Number of snapshots kept as possible baselines.
+	static constexpr std::size_t HistorySize = 64;
+
+	/**
+	 * Creates a new server and binds its socket.
+	 * @param port The port to listen on.
+	 * @param maxClients The maximum number of connected clients.
+	 * @param protocolId Identifier written to every packet, must match the clients.
+	 **/
+	explicit NetServer(const uint16_t &port, const uint32_t &maxClients = 32, const uint32_t &protocolId = DefaultProtocolId);
+
+	~NetServer();
+
+	/**
+	 * Receives from clients, captures the structure and sends the snapshot to every client.
+	 * @param structure The structure to replicate.
+	 **/
+	void Update(SceneStructure &structure);
+
+	/**
+	 * Receives and processes every waiting packet, connecting new clients and dropping timed out clients.
+	 **/
+	void Receive();
+
+	/**
+	 * Starts the next snapshot, to be filled and then sent with Send. Update does this from a structure.
+	 * @return The cleared snapshot.
+	 **/
+	Snapshot &CreateSnapshot();
+
+	/**
+	 * Sends the last created snapshot to every client.
+	 **/
+	void Send();
+
+	/**
+	 * Queues a reliable message to a client.
+	 * @param client The client index.
+	 * @param data The message data.
+	 * @param size The message size.
+	 * @return If the message was queued.
+	 **/
+	bool SendReliable(const uint32_t &client, const void *data, const std::size_t &size);
+
+	/**
+	 * Takes the next reliable message received from a client.
+	 * @param client The client index.
+	 * @param message Filled with the message.
+	 * @return If a message was available.
+	 **/
+	bool ReceiveReliable(const uint32_t &client, std::vector<uint8_t> &message);
+
+	bool IsBound() const { return m_bound; }
+
+	/**
+	 * Gets the port the server is bound to, so a server created on port 0 can be found.
+	 * @return The local port, or 0 if not bound.
+	 **/
+	uint16_t GetLocalPort() const { return m_socket.GetLocalPort(); }
+
+	uint32_t GetMaxClients() const { return static_cast<uint32_t>(m_clients.size()); }
+
+	uint32_t GetClientCount() const;
+
+	bool IsConnected(const uint32_t &client) const { return client < m_clients.size() && m_clients[client] != nullptr; }
+
+	/**
+	 * Gets the traffic statistics of a client.
+	 * @param client The client index.
+	 * @return The statistics, or nullptr if the client isn't connected.
+	 **/
+	const NetStatistics *GetStatistics(const uint32_t &client) const;
+
+	const Time &GetTimeout() const { return m_timeout; }
+
+	void SetTimeout(const Time &timeout) { m_timeout = timeout; }
+
+	/**
+	 * Called with the client index when a client connects.
+	 * @return The delegate.
+	 **/
+	Delegate<void(uint32_t)> &OnClientConnected() { return m_onClientConnected; }
+
+	/**
+	 * Called with the client index when a client times out.
+	 * @return The delegate.
+	 **/
+	Delegate<void(uint32_t)> &OnClientDisconnected() { return m_onClientDisconnected; }
+
+private:
+	struct Client
+	{
+		explicit Client(const uint32_t &protocolId) :
+			m_channel(protocolId)
+		{
+		}
+
+		NetChannel m_channel;
+		IpAddress m_address;
+		uint16_t m_port = 0;
+		bool m_hasBaseline = false;
+		uint16_t m_baseline = 0;
+		BitWriter m_payload;
+		BitWriter m_packet;
+	};
+
+	static uint64_t AddressKey(const IpAddress &address, const uint16_t &port) { return static_cast<uint64_t>(address.ToInteger()) << 16 | port; }
+
+	void Process(const UdpDatagram &datagram);
+
+	uint32_t m_protocolId;
+	UdpSocket m_socket;
+	bool m_bound;
+	Time m_timeout;
+
+	std::vector<std::unique_ptr<Client>> m_clients;
+	std::unordered_map<uint64_t, uint32_t> m_addresses;
+
+	uint16_t m_sequence;
+	bool m_hasSnapshot;
+	SequenceBuffer<Snapshot, HistorySize> m_history;
+	uint32_t m_nextNetworkId;
+
+	std::vector<std::vector<uint8_t>> m_receiveBuffers;
+	std::vector<UdpDatagram> m_received;
+	std::vector<UdpDatagram> m_sending;
+
+	Delegate<void(uint32_t)> m_onClientConnected;
+	Delegate<void(uint32_t)> m_onClientDisconnected;
+};
+}
@@ -0,0 +1,101 @@
+#include "Replicated.hpp"
+
+#include "Scenes/SceneStructure.hpp"
+#include "Snapshot.hpp"
+
+namespace acid
+{
+Replicated::Replicated(const uint32_t &networkId) :
+	m_networkId(networkId)
+{
+}
+
+void Replicated::Start()
+{
+}
+
+void Replicated::Update()
+{
+}
+
+void Replicated::Capture(SceneStructure &structure, Snapshot &snapshot, uint32_t &nextId)
+{
+	snapshot.Clear();
+	BitWriter fields;
+
+	for (auto &entity : structure.QueryAll())
+	{
+		auto replicated = entity->GetComponent<Replicated>(true);
+
+		if (replicated == nullptr)
+		{
+			continue;
+		}
+
+		if (replicated->m_networkId == 0)
+		{
+			replicated->m_networkId = nextId++;
+		}
+
+		fields.Clear();
+
+		for (auto serializable : entity->GetComponents<NetSerializable>())
+		{
+			serializable->WriteNet(fields);
+		}
+
+		auto &transform = entity->GetLocalTransform();
+		snapshot.Add(replicated->m_networkId, transform.GetPosition(), transform.GetRotation(), transform.GetScaling(), &fields);
+	}
+
+	snapshot.Sort();
+}
+
+void Replicated::Apply(const Snapshot &snapshot, SceneStructure &structure, Delegate<void(Entity *)> &onCreated)
+{
+	std::unordered_map<uint32_t, Entity *> existing;
+
+	for (const auto &replicated : structure.QueryComponents<Replicated>(true))
+	{
+		if (replicated->m_networkId != 0)
+		{
+			existing.emplace(replicated->m_networkId, replicated->GetParent());
+		}
+	}
+
+	for (const auto &state : snapshot.GetEntities())
+	{
+		Entity *entity;
+		auto it = existing.find(state.m_id);
+
+		if (it != existing.end())
+		{
+			entity = it->second;
+			existing.erase(it);
+		}
+		else
+		{
+			entity = structure.CreateEntity(Transform());
+			entity->AddComponent<Replicated>(state.m_id);
+			onCreated(entity);
+		}
+
+		auto &transform = entity->GetLocalTransform();
+		transform.SetPosition(state.GetPosition());
+		transform.SetRotation(state.GetRotation());
+		transform.SetScaling(state.GetScaling());
+
+		BitReader fields(snapshot.GetFieldData(state), state.m_fieldSize);
+
+		for (auto serializable : entity->GetComponents<NetSerializable>())
+		{
+			serializable->ReadNet(fields);
+		}
+	}
+
+	for (const auto &[id, entity] : existing)
+	{
+		entity->SetRemoved(true);
+	}
+}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Scenes/Component.hpp"
+#include "Helpers/Delegate.hpp"
+#include "BitStream.hpp"
+
+namespace acid
+{
+class Entity;
+class SceneStructure;
+class Snapshot;
+
+/**
+ * @brief Interface for components with fields replicated over the network.
+ * Fields are written bit packed every snapshot and delta compressed as a whole, so quantize them to the precision actually needed.
+ * The components must be attached in the same order on the server and clients, they are read back in component order.
+ **/
+class ACID_EXPORT NetSerializable
+{
+public:
+	virtual ~NetSerializable() = default;
+
+	/**
+	 * Writes the replicated fields of this component.
+	 * @param writer The writer to write into.
+	 **/
+	virtual void WriteNet(BitWriter &writer) const = 0;
+
+	/**
+	 * Reads the replicated fields written by WriteNet.
+	 * @param reader The reader to read from.
+	 **/
+	virtual void ReadNet(BitReader &reader) = 0;
+};
+
+/**
+ * @brief Component that marks an entity as replicated from a server to its clients, see acid::NetServer and acid::NetClient.
+ **/
+class ACID_EXPORT Replicated :
+	public Component
+{
+public:
+	/**
+	 * Creates a new replicated component.
+	 * @param networkId The network id, 0 lets the server assign one when the entity is first captured.
+	 **/
+	explicit Replicated(const uint32_t &networkId = 0);
+
+	void Start() override;
+
+	void Update() override;
+
+	const uint32_t &GetNetworkId() const { return m_networkId; }
+
+	void SetNetworkId(const uint32_t &networkId) { m_networkId = networkId; }
+
+	/**
+	 * Captures every replicated entity in a structure into a snapshot, assigning network ids to new entities.
+	 * @param structure The structure to capture.
+	 * @param snapshot The snapshot to fill, it is cleared first.
+	 * @param nextId The next network id to assign, incremented for every id assigned.
+	 **/
+	static void Capture(SceneStructure &structure, Snapshot &snapshot, uint32_t &nextId);
+
+	/**
+	 * Applies a snapshot to a structure. Replicated entities missing from the structure are created,
+	 * and those missing from the snapshot are removed.
+	 * @param snapshot The snapshot to apply.
+	 * @param structure The structure to update.
+	 * @param onCreated Called for each created entity before its fields are read, so components can be added to it.
+	 **/
+	static void Apply(const Snapshot &snapshot, SceneStructure &structure, Delegate<void(Entity *)> &onCreated);
+
+private:
+	uint32_t m_networkId;
+};
+}
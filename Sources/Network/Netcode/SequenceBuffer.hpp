@@ -0,0 +1,103 @@
+#pragma once
+
+#include "StdAfx.hpp"
+
+namespace acid
+{
+/**
+ * Gets if a 16 bit sequence number is newer than another, taking wrap around into account.
+ * @param a The first sequence.
+ * @param b The second sequence.
+ * @return If a is newer than b.
+ **/
+inline bool SequenceGreater(const uint16_t &a, const uint16_t &b)
+{
+	return (a > b && a - b <= 32768) || (a < b && b - a > 32768);
+}
+
+/**
+ * Gets if a 16 bit sequence number is older than another, taking wrap around into account.
+ * @param a The first sequence.
+ * @param b The second sequence.
+ * @return If a is older than b.
+ **/
+inline bool SequenceLess(const uint16_t &a, const uint16_t &b)
+{
+	return SequenceGreater(b, a);
+}
+
+/**
+ * @brief A fixed size ring of entries indexed by a 16 bit sequence number.
+ * Inserting a sequence evicts whatever was stored in its slot, so only the most recent Size sequences can be found.
+ * Entries are never allocated after construction, so entry storage (vectors etc.) is reused as the sequence wraps.
+ * @tparam T The entry type.
+ * @tparam Size The number of slots, must divide 65536.
+ **/
+template<typename T, std::size_t Size>
+class SequenceBuffer
+{
+	static_assert(65536 % Size == 0, "SequenceBuffer size must divide 65536");
+
+public:
+	SequenceBuffer() :
+		m_entries(Size),
+		m_sequences(Size, Empty)
+	{
+	}
+
+	/**
+	 * Stores a sequence, the returned entry keeps whatever state was left by the sequence it replaced.
+	 * @param sequence The sequence to store.
+	 * @return The entry for the sequence.
+	 **/
+	T &Insert(const uint16_t &sequence)
+	{
+		auto index = sequence % Size;
+		m_sequences[index] = sequence;
+		return m_entries[index];
+	}
+
+	/**
+	 * Removes a sequence, if it is still stored.
+	 * @param sequence The sequence to remove.
+	 **/
+	void Remove(const uint16_t &sequence)
+	{
+		auto index = sequence % Size;
+
+		if (m_sequences[index] == sequence)
+		{
+			m_sequences[index] = Empty;
+		}
+	}
+
+	/**
+	 * Finds a stored sequence.
+	 * @param sequence The sequence to find.
+	 * @return The entry, or nullptr if the sequence is not stored.
+	 **/
+	T *Find(const uint16_t &sequence)
+	{
+		auto index = sequence % Size;
+		return m_sequences[index] == sequence ? &m_entries[index] : nullptr;
+	}
+
+	const T *Find(const uint16_t &sequence) const
+	{
+		auto index = sequence % Size;
+		return m_sequences[index] == sequence ? &m_entries[index] : nullptr;
+	}
+
+	bool Exists(const uint16_t &sequence) const { return m_sequences[sequence % Size] == sequence; }
+
+	void Clear() { std::fill(m_sequences.begin(), m_sequences.end(), Empty); }
+
+	static constexpr std::size_t GetSize() { return Size; }
+
+private:
+	static constexpr uint32_t Empty = 0xFFFFFFFF;
+
+	std::vector<T> m_entries;
+	std::vector<uint32_t> m_sequences;
+};
+}
@@ -0,0 +1,330 @@
+#include "Snapshot.hpp"
+
+namespace acid
+{
+/// Deltas whose zig-zag value fits in this many bits are written as a delta instead of a full value.
+static constexpr uint32_t SmallDeltaBits = 10;
+
+static uint16_t QuantizeAngle(const float &degrees)
+{
+	auto wrapped = std::fmod(degrees, 360.0f);
+
+	if (wrapped < 0.0f)
+	{
+		wrapped += 360.0f;
+	}
+
+	return static_cast<uint16_t>(std::lround(wrapped / 360.0f * 65536.0f) & 0xFFFF);
+}
+
+static void WriteValue(BitWriter &writer, const uint32_t &value, const uint32_t &base, const uint32_t &bits)
+{
+	auto delta = static_cast<int64_t>(value) - static_cast<int64_t>(base);
+
+	if (bits == 16)
+	{
+		// Rotations wrap, so the shortest way around is the delta.
+		delta = static_cast<int16_t>(static_cast<uint16_t>(value - base));
+	}
+
+	auto zigzag = static_cast<uint64_t>((delta << 1) ^ (delta >> 63));
+
+	if (zigzag < (uint64_t(1) << SmallDeltaBits))
+	{
+		writer.WriteBool(true);
+		writer.Write(static_cast<uint32_t>(zigzag), SmallDeltaBits);
+		return;
+	}
+
+	writer.WriteBool(false);
+	writer.Write(value, bits);
+}
+
+static uint32_t ReadValue(BitReader &reader, const uint32_t &base, const uint32_t &bits)
+{
+	if (!reader.ReadBool())
+	{
+		return reader.Read(bits);
+	}
+
+	auto zigzag = static_cast<int64_t>(reader.Read(SmallDeltaBits));
+	auto delta = (zigzag >> 1) ^ -(zigzag & 1);
+	auto value = static_cast<uint32_t>(static_cast<int64_t>(base) + delta);
+	return bits == 16 ? value & 0xFFFF : value & ((uint32_t(1) << bits) - 1);
+}
+
+template<typename T>
+static void WriteVector(BitWriter &writer, const T &value, const T &base, const uint32_t &bits)
+{
+	auto changed = value != base;
+	writer.WriteBool(changed);
+
+	if (!changed)
+	{
+		return;
+	}
+
+	for (std::size_t i = 0; i < value.size(); i++)
+	{
+		auto axisChanged = value[i] != base[i];
+		writer.WriteBool(axisChanged);
+
+		if (axisChanged)
+		{
+			WriteValue(writer, value[i], base[i], bits);
+		}
+	}
+}
+
+template<typename T>
+static void ReadVector(BitReader &reader, T &value, const T &base, const uint32_t &bits)
+{
+	value = base;
+
+	if (!reader.ReadBool())
+	{
+		return;
+	}
+
+	for (std::size_t i = 0; i < value.size(); i++)
+	{
+		if (reader.ReadBool())
+		{
+			value[i] = static_cast<typename T::value_type>(ReadValue(reader, base[i], bits));
+		}
+	}
+}
+
+Vector3f EntityState::GetPosition() const
+{
+	return Vector3f(BitReader::Dequantize(m_position[0], -Snapshot::PositionRange, Snapshot::PositionRange, Snapshot::PositionBits),
+		BitReader::Dequantize(m_position[1], -Snapshot::PositionRange, Snapshot::PositionRange, Snapshot::PositionBits),
+		BitReader::Dequantize(m_position[2], -Snapshot::PositionRange, Snapshot::PositionRange, Snapshot::PositionBits));
+}
+
+Vector3f EntityState::GetRotation() const
+{
+	return Vector3f(m_rotation[0] / 65536.0f * 360.0f, m_rotation[1] / 65536.0f * 360.0f, m_rotation[2] / 65536.0f * 360.0f);
+}
+
+Vector3f EntityState::GetScaling() const
+{
+	return Vector3f(BitReader::Dequantize(m_scaling[0], 0.0f, Snapshot::ScalingRange, Snapshot::ScalingBits),
+		BitReader::Dequantize(m_scaling[1], 0.0f, Snapshot::ScalingRange, Snapshot::ScalingBits),
+		BitReader::Dequantize(m_scaling[2], 0.0f, Snapshot::ScalingRange, Snapshot::ScalingBits));
+}
+
+void Snapshot::Clear()
+{
+	m_entities.clear();
+	m_fieldData.clear();
+}
+
+void Snapshot::Add(const uint32_t &id, const Vector3f &position, const Vector3f &rotation, const Vector3f &scaling, const BitWriter *fields)
+{
+	auto &entity = m_entities.emplace_back();
+	entity.m_id = id;
+
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		entity.m_position[i] = BitWriter::Quantize(position[i], -PositionRange, PositionRange, PositionBits);
+		entity.m_rotation[i] = QuantizeAngle(rotation[i]);
+		entity.m_scaling[i] = static_cast<uint16_t>(BitWriter::Quantize(scaling[i], 0.0f, ScalingRange, ScalingBits));
+	}
+
+	entity.m_fieldOffset = static_cast<uint32_t>(m_fieldData.size());
+	entity.m_fieldSize = fields != nullptr ? static_cast<uint32_t>(fields->GetSize()) : 0;
+
+	if (fields != nullptr)
+	{
+		m_fieldData.insert(m_fieldData.end(), fields->GetData(), fields->GetData() + fields->GetSize());
+	}
+}
+
+void Snapshot::Sort()
+{
+	std::sort(m_entities.begin(), m_entities.end(), [](const EntityState &a, const EntityState &b)
+	{
+		return a.m_id < b.m_id;
+	});
+}
+
+void Snapshot::WriteDelta(BitWriter &writer, const Snapshot *baseline) const
+{
+	static const Snapshot Empty;
+	static const EntityState Zero;
+
+	if (baseline == nullptr)
+	{
+		baseline = &Empty;
+	}
+
+	auto fieldsEqual = [&](const EntityState &entity, const EntityState &base)
+	{
+		return entity.m_fieldSize == base.m_fieldSize &&
+			std::memcmp(GetFieldData(entity), baseline->GetFieldData(base), entity.m_fieldSize) == 0;
+	};
+
+	uint32_t previousId = 0;
+
+	auto writeEntity = [&](const EntityState &entity, const EntityState &base, const bool &removed)
+	{
+		writer.WriteBool(true);
+		writer.WriteVarUint(entity.m_id - previousId);
+		writer.WriteBool(removed);
+		previousId = entity.m_id;
+
+		if (removed)
+		{
+			return;
+		}
+
+		WriteVector(writer, entity.m_position, base.m_position, PositionBits);
+		WriteVector(writer, entity.m_rotation, base.m_rotation, RotationBits);
+		WriteVector(writer, entity.m_scaling, base.m_scaling, ScalingBits);
+
+		auto fieldsChanged = &base == &Zero ? entity.m_fieldSize != 0 : !fieldsEqual(entity, base);
+		writer.WriteBool(fieldsChanged);
+
+		if (fieldsChanged)
+		{
+			writer.WriteVarUint(entity.m_fieldSize);
+			writer.WriteBytes(GetFieldData(entity), entity.m_fieldSize);
+		}
+	};
+
+	auto &entities = m_entities;
+	auto &baseEntities = baseline->m_entities;
+	std::size_t i = 0;
+	std::size_t j = 0;
+
+	while (i < entities.size() || j < baseEntities.size())
+	{
+		if (j >= baseEntities.size() || (i < entities.size() && entities[i].m_id < baseEntities[j].m_id))
+		{
+			// New entities are always written, even if they match the zeroed state, so the receiver creates them.
+			writeEntity(entities[i++], Zero, false);
+		}
+		else if (i >= entities.size() || baseEntities[j].m_id < entities[i].m_id)
+		{
+			writeEntity(baseEntities[j++], Zero, true);
+		}
+		else
+		{
+			auto &entity = entities[i++];
+			auto &base = baseEntities[j++];
+
+			if (entity.m_position != base.m_position || entity.m_rotation != base.m_rotation || entity.m_scaling != base.m_scaling ||
+				!fieldsEqual(entity, base))
+			{
+				writeEntity(entity, base, false);
+			}
+		}
+	}
+
+	writer.WriteBool(false);
+}
+
+bool Snapshot::ReadDelta(BitReader &reader, const Snapshot *baseline)
+{
+	static const Snapshot Empty;
+	static const EntityState Zero;
+
+	if (baseline == this)
+	{
+		return false;
+	}
+
+	if (baseline == nullptr)
+	{
+		baseline = &Empty;
+	}
+
+	Clear();
+
+	auto &baseEntities = baseline->m_entities;
+	std::size_t j = 0;
+
+	auto copyBase = [&](const EntityState &base)
+	{
+		auto &entity = m_entities.emplace_back(base);
+		entity.m_fieldOffset = static_cast<uint32_t>(m_fieldData.size());
+		m_fieldData.insert(m_fieldData.end(), baseline->GetFieldData(base), baseline->GetFieldData(base) + base.m_fieldSize);
+	};
+
+	uint32_t previousId = 0;
+	auto first = true;
+
+	while (reader.ReadBool())
+	{
+		auto id = previousId + reader.ReadVarUint();
+		auto removed = reader.ReadBool();
+
+		if (reader.IsOverflow() || (!first && id <= previousId))
+		{
+			return false;
+		}
+
+		previousId = id;
+		first = false;
+
+		while (j < baseEntities.size() && baseEntities[j].m_id < id)
+		{
+			copyBase(baseEntities[j++]);
+		}
+
+		auto base = &Zero;
+
+		if (j < baseEntities.size() && baseEntities[j].m_id == id)
+		{
+			base = &baseEntities[j++];
+		}
+
+		if (removed)
+		{
+			continue;
+		}
+
+		auto &entity = m_entities.emplace_back();
+		entity.m_id = id;
+		ReadVector(reader, entity.m_position, base->m_position, PositionBits);
+		ReadVector(reader, entity.m_rotation, base->m_rotation, RotationBits);
+		ReadVector(reader, entity.m_scaling, base->m_scaling, ScalingBits);
+		entity.m_fieldOffset = static_cast<uint32_t>(m_fieldData.size());
+
+		if (reader.ReadBool())
+		{
+			entity.m_fieldSize = reader.ReadVarUint();
+
+			if (reader.IsOverflow() || reader.GetRemainingBits() < static_cast<std::size_t>(entity.m_fieldSize) * 8)
+			{
+				return false;
+			}
+
+			m_fieldData.resize(m_fieldData.size() + entity.m_fieldSize);
+			reader.ReadBytes(m_fieldData.data() + entity.m_fieldOffset, entity.m_fieldSize);
+		}
+		else
+		{
+			entity.m_fieldSize = base->m_fieldSize;
+			m_fieldData.insert(m_fieldData.end(), baseline->GetFieldData(*base), baseline->GetFieldData(*base) + base->m_fieldSize);
+		}
+	}
+
+	while (j < baseEntities.size())
+	{
+		copyBase(baseEntities[j++]);
+	}
+
+	return !reader.IsOverflow();
+}
+
+const EntityState *Snapshot::Find(const uint32_t &id) const
+{
+	auto it = std::lower_bound(m_entities.begin(), m_entities.end(), id, [](const EntityState &entity, const uint32_t &value)
+	{
+		return entity.m_id < value;
+	});
+	return it != m_entities.end() && it->m_id == id ? &*it : nullptr;
+}
+}
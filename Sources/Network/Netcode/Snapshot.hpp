@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Maths/Vector3.hpp"
+#include "BitStream.hpp"
+
+namespace acid
+{
+/**
+ * @brief The replicated state of one entity, with its transform quantized so states can be compared and delta encoded exactly.
+ **/
+struct ACID_EXPORT EntityState
+{
+	uint32_t m_id = 0;
+	std::array<uint32_t, 3> m_position = {};
+	std::array<uint16_t, 3> m_rotation = {};
+	std::array<uint16_t, 3> m_scaling = {};
+	/// Offset of the component field bytes in the owning snapshot.
+	uint32_t m_fieldOffset = 0;
+	/// Size of the component field bytes.
+	uint32_t m_fieldSize = 0;
+
+	Vector3f GetPosition() const;
+
+	Vector3f GetRotation() const;
+
+	Vector3f GetScaling() const;
+};
+
+/**
+ * @brief The replicated state of every entity at one simulation tick.
+ *
+ * Positions are quantized to PositionBits within +-PositionRange, rotations (degrees) to RotationBits over a full turn,
+ * and scales to ScalingBits within ScalingRange. Component fields are opaque bit packed bytes written by the components.
+ *
+ * A snapshot is sent as a delta against a baseline the receiver already has, normally the last snapshot it acknowledged:
+ * entities that didn't change aren't written at all, small movements are written as small deltas,
+ * and anything else as a full value. Without a baseline every entity is written against a zeroed state.
+ **/
+class ACID_EXPORT Snapshot
+{
+public:
+	static constexpr float PositionRange = 4096.0f;
+	static constexpr uint32_t PositionBits = 24;
+	static constexpr uint32_t RotationBits = 16;
+	static constexpr float ScalingRange = 256.0f;
+	static constexpr uint32_t ScalingBits = 16;
+
+	Snapshot() = default;
+
+	/**
+	 * Removes all entities, keeping the storage.
+	 **/
+	void Clear();
+
+	/**
+	 * Adds an entity, entities must be added in increasing id order or Sort must be called before encoding.
+	 * @param id The network id of the entity.
+	 * @param position The entity position.
+	 * @param rotation The entity rotation in degrees.
+	 * @param scaling The entity scale.
+	 * @param fields Bit packed component fields, may be null.
+	 **/
+	void Add(const uint32_t &id, const Vector3f &position, const Vector3f &rotation, const Vector3f &scaling, const BitWriter *fields = nullptr);
+
+	/**
+	 * Sorts the entities by id.
+	 **/
+	void Sort();
+
+	/**
+	 * Writes this snapshot as a delta against a baseline.
+	 * @param writer The writer to write into.
+	 * @param baseline The snapshot the receiver already has, or nullptr to write everything.
+	 **/
+	void WriteDelta(BitWriter &writer, const Snapshot *baseline) const;
+
+	/**
+	 * Reads this snapshot from a delta written by WriteDelta, replacing its contents.
+	 * @param reader The reader to read from.
+	 * @param baseline The baseline the delta was written against, or nullptr.
+	 * @return If the delta was valid.
+	 **/
+	bool ReadDelta(BitReader &reader, const Snapshot *baseline);
+
+	/**
+	 * Finds the state of an entity.
+	 * @param id The network id of the entity.
+	 * @return The state, or nullptr if the entity isn't in this snapshot.
+	 **/
+	const EntityState *Find(const uint32_t &id) const;
+
+	const uint8_t *GetFieldData(const EntityState &entity) const { return m_fieldData.data() + entity.m_fieldOffset; }
+
+	const std::vector<EntityState> &GetEntities() const { return m_entities; }
+
+	const uint16_t &GetSequence() const { return m_sequence; }
+
+	void SetSequence(const uint16_t &sequence) { m_sequence = sequence; }
+
+private:
+	uint16_t m_sequence = 0;
+	std::vector<EntityState> m_entities;
+	std::vector<uint8_t> m_fieldData;
+};
+}
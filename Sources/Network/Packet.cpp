@@ -9,10 +9,59 @@
 #endif
 
 #include <cwchar>
+#include <mutex>
 #include "Socket.hpp"
 
 namespace acid
 {
+/**
+ * Storage released by destroyed packets, reused by new packets before they allocate.
+ */
+class PacketPool
+{
+public:
+	static void Acquire(std::vector<char> &data, const std::size_t &sizeInBytes)
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		if (!Buffers.empty())
+		{
+			data.swap(Buffers.back());
+			Buffers.pop_back();
+		}
+
+		data.reserve(std::max(sizeInBytes, MinCapacity));
+	}
+
+	static void Release(std::vector<char> &data)
+	{
+		// Storage grown by very large packets isn't kept around.
+		if (data.capacity() == 0 || data.capacity() > MaxCapacity)
+		{
+			return;
+		}
+
+		data.clear();
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		if (Buffers.size() < MaxBuffers)
+		{
+			Buffers.emplace_back(std::move(data));
+		}
+	}
+
+private:
+	static constexpr std::size_t MinCapacity = 256;
+	static constexpr std::size_t MaxCapacity = 64 * 1024;
+	static constexpr std::size_t MaxBuffers = 1024;
+
+	static std::mutex Mutex;
+	static std::vector<std::vector<char>> Buffers;
+};
+
+std::mutex PacketPool::Mutex;
+std::vector<std::vector<char>> PacketPool::Buffers;
+
 Packet::Packet() :
 	m_readPos(0),
 	m_sendPos(0),
@@ -20,13 +69,22 @@ Packet::Packet() :
 {
 }
 
+Packet::~Packet()
+{
+	PacketPool::Release(m_data);
+}
+
 void Packet::Append(const void *data, const std::size_t &sizeInBytes)
 {
 	if (data && (sizeInBytes > 0))
 	{
-		auto start = m_data.size();
-		m_data.resize(start + sizeInBytes);
-		std::memcpy(&m_data[start], data, sizeInBytes);
+		if (m_data.capacity() == 0)
+		{
+			PacketPool::Acquire(m_data, sizeInBytes);
+		}
+
+		auto bytes = static_cast<const char *>(data);
+		m_data.insert(m_data.end(), bytes, bytes + sizeInBytes);
 	}
 }
 
@@ -37,6 +95,22 @@ void Packet::Clear()
 	m_isValid = true;
 }
 
+void Packet::Reserve(const std::size_t &sizeInBytes)
+{
+	if (m_data.capacity() == 0)
+	{
+		PacketPool::Acquire(m_data, sizeInBytes);
+		return;
+	}
+
+	m_data.reserve(sizeInBytes);
+}
+
+std::size_t Packet::GetCapacity() const
+{
+	return m_data.capacity();
+}
+
 const void *Packet::GetData() const
 {
 	return !m_data.empty() ? &m_data[0] : nullptr;
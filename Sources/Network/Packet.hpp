@@ -19,6 +19,9 @@ namespace acid
  * to avoid possible differences between the sender and the receiver.
  * Indeed, the native C++ types may have different sizes on two platforms and your data may be
  * corrupted if that happens.
+ * 
+ * Packet storage is taken from a shared pool when data is first appended, and given back when the packet
+ * is destroyed, so creating short lived packets doesn't allocate once the pool is warm.
  **/
 class ACID_EXPORT Packet
 {
@@ -31,7 +34,14 @@ public:
 	 **/
 	Packet();
 
-	virtual ~Packet() = default;
+	Packet(const Packet &other) = default;
+
+	Packet(Packet &&other) = default;
+
+	/**
+	 * Destructor, returns the packet storage to the pool.
+	 **/
+	virtual ~Packet();
 
 	/**
 	 * Append data to the end of the packet.
@@ -45,6 +55,18 @@ public:
 	 **/
 	void Clear();
 
+	/**
+	 * Reserve storage for at least a number of bytes, so appending up to that size won't reallocate.
+	 * @param sizeInBytes Number of bytes to reserve. 
+	 **/
+	void Reserve(const std::size_t &sizeInBytes);
+
+	/**
+	 * Get the number of bytes the packet can hold before it has to reallocate.
+	 * @return Capacity in bytes. 
+	 **/
+	std::size_t GetCapacity() const;
+
 	/**
 	 * Get a pointer to the data contained in the packet.
 	 * Warning: the returned pointer may become invalid after  you append data to the packet,
@@ -96,6 +118,10 @@ public:
 	 **/
 	operator BoolType() const;
 
+	Packet &operator=(const Packet &other) = default;
+
+	Packet &operator=(Packet &&other) = default;
+
 	// Overload of operator >> to read data from the data stream
 
 	Packet &operator>>(bool &data);
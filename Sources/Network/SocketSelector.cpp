@@ -4,6 +4,10 @@
 
 #include <WinSock2.h>
 
+#elif defined(ACID_BUILD_LINUX)
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <errno.h>
 #else
 #include <sys/types.h>
 #include <unistd.h>
@@ -18,6 +22,83 @@
 
 namespace acid
 {
+#if defined(ACID_BUILD_LINUX)
+struct SocketSelector::SocketSelectorImpl
+{
+	/// The epoll instance handle.
+	int epoll = -1;
+	/// Sockets registered with epoll, indexed by their handle.
+	std::vector<Socket *> sockets;
+	/// The wait generation each handle was last reported ready in, indexed by their handle.
+	std::vector<uint32_t> readyGeneration;
+	/// Current wait generation, a handle is ready when its generation matches.
+	uint32_t generation = 1;
+	/// Events filled by epoll_wait, grows with the number of sockets.
+	std::vector<epoll_event> events;
+	/// Sockets that are ready after the last wait.
+	std::vector<Socket *> ready;
+
+	SocketSelectorImpl() :
+		epoll(epoll_create1(EPOLL_CLOEXEC))
+	{
+		if (epoll == -1)
+		{
+			Log::Error("Failed to create epoll instance: %i\n", errno);
+		}
+	}
+
+	SocketSelectorImpl(const SocketSelectorImpl &copy) :
+		SocketSelectorImpl()
+	{
+		// A epoll instance can't be shared, so the copy registers every socket with its own.
+		for (auto socket : copy.sockets)
+		{
+			if (socket != nullptr)
+			{
+				Add(*socket);
+			}
+		}
+	}
+
+	~SocketSelectorImpl()
+	{
+		if (epoll != -1)
+		{
+			close(epoll);
+		}
+	}
+
+	void Add(Socket &socket)
+	{
+		auto handle = socket.GetHandle();
+
+		if (static_cast<std::size_t>(handle) >= sockets.size())
+		{
+			sockets.resize(handle + 1, nullptr);
+			readyGeneration.resize(handle + 1, 0);
+		}
+
+		if (sockets[handle] == &socket)
+		{
+			return;
+		}
+
+		// Level triggered, so a socket that still has data after a partial receive is reported again on the next wait.
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.fd = handle;
+
+		if (epoll_ctl(epoll, EPOLL_CTL_ADD, handle, &event) == -1 && (errno != EEXIST || epoll_ctl(epoll, EPOLL_CTL_MOD, handle, &event) == -1))
+		{
+			Log::Error("The socket can't be added to the selector: %i\n", errno);
+			return;
+		}
+
+		sockets[handle] = &socket;
+		readyGeneration[handle] = 0;
+	}
+};
+#else
 struct SocketSelector::SocketSelectorImpl
 {
 	/// Set containing all the sockets handles.
@@ -28,7 +109,12 @@ struct SocketSelector::SocketSelectorImpl
 	int maxSocket;
 	/// Number of socket handles.
 	int socketCount;
+	/// Sockets in the selector, used to build the ready list.
+	std::vector<Socket *> sockets;
+	/// Sockets that are ready after the last wait.
+	std::vector<Socket *> ready;
 };
+#endif
 
 SocketSelector::SocketSelector() :
 	m_impl(std::make_unique<SocketSelectorImpl>())
@@ -41,12 +127,19 @@ SocketSelector::SocketSelector(const SocketSelector &copy) :
 {
 }
 
+SocketSelector::~SocketSelector()
+{
+}
+
 void SocketSelector::Add(Socket &socket)
 {
 	SocketHandle handle = socket.GetHandle();
 
 	if (handle != Socket::InvalidSocketHandle())
 	{
+#if defined(ACID_BUILD_LINUX)
+		m_impl->Add(socket);
+#else
 #if defined(ACID_BUILD_WINDOWS)
 		if (m_impl->socketCount >= FD_SETSIZE)
 		{
@@ -67,11 +160,18 @@ void SocketSelector::Add(Socket &socket)
 			return;
 		}
 
+		if (FD_ISSET(handle, &m_impl->allSockets))
+		{
+			return;
+		}
+
 		// SocketHandle is an int in POSIX
 		m_impl->maxSocket = std::max(m_impl->maxSocket, handle);
 #endif
 
 		FD_SET(handle, &m_impl->allSockets);
+		m_impl->sockets.emplace_back(&socket);
+#endif
 	}
 }
 
@@ -81,6 +181,16 @@ void SocketSelector::Remove(Socket &socket)
 
 	if (handle != Socket::InvalidSocketHandle())
 	{
+#if defined(ACID_BUILD_LINUX)
+		if (static_cast<std::size_t>(handle) >= m_impl->sockets.size() || m_impl->sockets[handle] == nullptr)
+		{
+			return;
+		}
+
+		epoll_ctl(m_impl->epoll, EPOLL_CTL_DEL, handle, nullptr);
+		m_impl->sockets[handle] = nullptr;
+		m_impl->readyGeneration[handle] = 0;
+#else
 #if defined(ACID_BUILD_WINDOWS)
 		if (!FD_ISSET(handle, &m_impl->allSockets))
 		{
@@ -98,20 +208,83 @@ void SocketSelector::Remove(Socket &socket)
 
 		FD_CLR(handle, &m_impl->allSockets);
 		FD_CLR(handle, &m_impl->socketsReady);
+		m_impl->sockets.erase(std::remove(m_impl->sockets.begin(), m_impl->sockets.end(), &socket), m_impl->sockets.end());
+#endif
+
+		m_impl->ready.erase(std::remove(m_impl->ready.begin(), m_impl->ready.end(), &socket), m_impl->ready.end());
 	}
 }
 
 void SocketSelector::Clear()
 {
+#if defined(ACID_BUILD_LINUX)
+	for (std::size_t handle = 0; handle < m_impl->sockets.size(); handle++)
+	{
+		if (m_impl->sockets[handle] != nullptr)
+		{
+			epoll_ctl(m_impl->epoll, EPOLL_CTL_DEL, static_cast<int>(handle), nullptr);
+		}
+	}
+
+	m_impl->sockets.clear();
+	m_impl->readyGeneration.clear();
+#else
 	FD_ZERO(&m_impl->allSockets);
 	FD_ZERO(&m_impl->socketsReady);
 
 	m_impl->maxSocket = 0;
 	m_impl->socketCount = 0;
+	m_impl->sockets.clear();
+#endif
+
+	m_impl->ready.clear();
 }
 
 bool SocketSelector::Wait(const Time timeout)
 {
+	m_impl->ready.clear();
+
+#if defined(ACID_BUILD_LINUX)
+	// Every registered socket could be ready at once, the buffer only grows so waits don't allocate.
+	auto maxEvents = std::max<std::size_t>(m_impl->sockets.size(), 16);
+
+	if (m_impl->events.size() < maxEvents)
+	{
+		m_impl->events.resize(maxEvents);
+	}
+
+	// Bumping the generation invalidates every ready flag from the previous wait without touching them.
+	if (++m_impl->generation == 0)
+	{
+		std::fill(m_impl->readyGeneration.begin(), m_impl->readyGeneration.end(), 0);
+		m_impl->generation = 1;
+	}
+
+	// Round the timeout up, so a short timeout doesn't turn into a busy poll.
+	int timeoutMs = timeout != Time::Zero ? static_cast<int>((timeout.AsMicroseconds() + 999) / 1000) : -1;
+	int count;
+
+	do
+	{
+		count = epoll_wait(m_impl->epoll, m_impl->events.data(), static_cast<int>(m_impl->events.size()), timeoutMs);
+	}
+	while (count == -1 && errno == EINTR);
+
+	for (int i = 0; i < count; i++)
+	{
+		auto handle = m_impl->events[i].data.fd;
+
+		if (static_cast<std::size_t>(handle) >= m_impl->sockets.size() || m_impl->sockets[handle] == nullptr)
+		{
+			continue;
+		}
+
+		m_impl->readyGeneration[handle] = m_impl->generation;
+		m_impl->ready.emplace_back(m_impl->sockets[handle]);
+	}
+
+	return count > 0;
+#else
 	// Setup the timeout
 	timeval time = {};
 	time.tv_sec = static_cast<long>(timeout.AsMicroseconds() / 1000000);
@@ -124,7 +297,19 @@ bool SocketSelector::Wait(const Time timeout)
 	// The first parameter is ignored on Windows
 	int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, nullptr, nullptr, timeout != Time::Zero ? &time : nullptr);
 
+	if (count > 0)
+	{
+		for (auto socket : m_impl->sockets)
+		{
+			if (FD_ISSET(socket->GetHandle(), &m_impl->socketsReady))
+			{
+				m_impl->ready.emplace_back(socket);
+			}
+		}
+	}
+
 	return count > 0;
+#endif
 }
 
 bool SocketSelector::IsReady(const Socket &socket) const
@@ -133,6 +318,9 @@ bool SocketSelector::IsReady(const Socket &socket) const
 
 	if (handle != Socket::InvalidSocketHandle())
 	{
+#if defined(ACID_BUILD_LINUX)
+		return static_cast<std::size_t>(handle) < m_impl->readyGeneration.size() && m_impl->readyGeneration[handle] == m_impl->generation;
+#else
 #if !defined(ACID_BUILD_WINDOWS)
 		if (handle >= FD_SETSIZE)
 		{
@@ -141,11 +329,17 @@ bool SocketSelector::IsReady(const Socket &socket) const
 #endif
 
 		return FD_ISSET(handle, &m_impl->socketsReady) != 0;
+#endif
 	}
 
 	return false;
 }
 
+const std::vector<Socket *> &SocketSelector::GetReadySockets() const
+{
+	return m_impl->ready;
+}
+
 SocketSelector &SocketSelector::operator=(const SocketSelector &right)
 {
 	SocketSelector temp(right);
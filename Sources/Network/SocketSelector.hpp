@@ -26,7 +26,11 @@ class Socket;
  * Using a selector is simple:
  * \li populate the selector with all the sockets that you want to observe
  * \li make it wait until there is data available on any of the sockets
- * \li test each socket to find out which ones are ready
+ * \li test each socket to find out which ones are ready, or iterate the ready list
+ * 
+ * On Linux the selector is backed by epoll, so it isn't limited by FD_SETSIZE and waiting
+ * costs the number of ready sockets rather than the number of sockets in the selector.
+ * Other platforms use select.
  **/
 class ACID_EXPORT SocketSelector
 {
@@ -42,6 +46,11 @@ public:
 	 **/
 	SocketSelector(const SocketSelector &copy);
 
+	/**
+	 * Destructor.
+	 **/
+	~SocketSelector();
+
 	/**
 	 * Add a new socket to the selector.
 	 * 
@@ -87,6 +96,13 @@ public:
 	 **/
 	bool IsReady(const Socket &socket) const;
 
+	/**
+	 * Gets the sockets that are ready to receive data after the last call to Wait.
+	 * Iterating this list is cheaper than testing every socket with IsReady when most sockets are idle.
+	 * @return The ready sockets.
+	 **/
+	const std::vector<Socket *> &GetReadySockets() const;
+
 	/**
 	 * Overload of assignment operator.
 	 * @param right Instance to assign. 
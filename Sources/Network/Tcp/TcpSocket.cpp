@@ -6,6 +6,8 @@
 
 #else
 #include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #endif
 
@@ -20,14 +22,19 @@
 namespace acid
 {
 // Define the low-level send/receive flags, which depends on the OS.
-#if defined(ACID_PLATFORM_LINUX)
+#if defined(ACID_BUILD_LINUX)
 const int flags = MSG_NOSIGNAL;
 #else
 const int flags = 0;
 #endif
 
+// Size of the first receive buffer allocation, it grows as the data of larger packets arrives and shrinks back once they are taken.
+const std::size_t receiveBufferSize = 64 * 1024;
+
 TcpSocket::TcpSocket() :
-	Socket(Type::Tcp)
+	Socket(Type::Tcp),
+	m_receiveBegin(0),
+	m_receiveEnd(0)
 {
 }
 
@@ -178,13 +185,43 @@ Socket::Status TcpSocket::Connect(const IpAddress &remoteAddress, const uint16_t
 	return status;
 }
 
+Socket::Status TcpSocket::PollConnect()
+{
+	if (GetHandle() == InvalidSocketHandle())
+	{
+		return Status::Disconnected;
+	}
+
+	fd_set selector;
+	FD_ZERO(&selector);
+	FD_SET(GetHandle(), &selector);
+	timeval time = {};
+
+	// The socket becomes writable once the connection request has returned, either accepted or refused.
+	if (select(static_cast<int>(GetHandle() + 1), nullptr, &selector, nullptr, &time) <= 0)
+	{
+		return Status::NotReady;
+	}
+
+	int error = 0;
+	SocketAddrLength length = sizeof(error);
+
+	if (getsockopt(GetHandle(), SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&error), &length) == -1 || error != 0)
+	{
+		return Status::Disconnected;
+	}
+
+	return Status::Done;
+}
+
 void TcpSocket::Disconnect()
 {
 	// Close the socket.
 	Close();
 
-	// Reset the pending packet data.
-	m_pendingPacket = PendingPacket();
+	// Drop any partially received packet data, the buffer is kept for the next connection.
+	m_receiveBegin = 0;
+	m_receiveEnd = 0;
 }
 
 Socket::Status TcpSocket::Send(const void *data, const std::size_t &size)
@@ -268,43 +305,90 @@ Socket::Status TcpSocket::Send(Packet &packet)
 	// This means that we have to send the packet size first, so that the
 	// receiver knows the actual end of the packet in the data stream.
 
-	// We allocate an extra memory block so that the size can be sent
-	// together with the data in a single call. This may seem inefficient,
-	// but it is actually required to avoid partial send, which could cause
-	// data corruption on the receiving end.
+	// The size and the data are sent as two buffers in the same call (scatter/gather),
+	// this avoids copying the packet into a temporary block, and avoids a partial send
+	// splitting the size from the data, which could cause data corruption on the receiving end.
 
 	// Get the data to send from the packet.
 	auto dataSize = packet.OnSend();
 
+	if (dataSize.second > MaxPacketSize)
+	{
+		Log::Error("Cannot send a packet of %zu bytes, the limit is %u bytes\n", dataSize.second, MaxPacketSize);
+		return Status::Error;
+	}
+
 	// First convert the packet size to network byte order
 	uint32_t packetSize = htonl(static_cast<uint32_t>(dataSize.second));
+	auto totalSize = sizeof(packetSize) + dataSize.second;
 
-	// Allocate memory for the data block to send
-	std::vector<char> blockToSend(sizeof(packetSize) + dataSize.second);
-
-	// Copy the packet size and data into the block to send
-	std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
+	// Loop until every byte has been sent, resuming from the location of a previous partial send.
+	std::size_t sent = 0;
 
-	if (dataSize.second > 0)
+	while (packet.m_sendPos < totalSize)
 	{
-		std::memcpy(&blockToSend[0] + sizeof(packetSize), dataSize.first, dataSize.second);
-	}
+		auto sizeOffset = std::min(packet.m_sendPos, sizeof(packetSize));
+		auto dataOffset = packet.m_sendPos - sizeOffset;
 
-	// Send the data block.
-	std::size_t sent;
-	Status status = Send(&blockToSend[0] + packet.m_sendPos, blockToSend.size() - packet.m_sendPos, sent);
+#if defined(ACID_BUILD_WINDOWS)
+		WSABUF buffers[2];
+		DWORD bufferCount = 0;
 
-	// In the case of a partial send, record the location to resume from
-	if (status == Status::Partial)
-	{
-		packet.m_sendPos += sent;
-	}
-	else if (status == Status::Done)
-	{
-		packet.m_sendPos = 0;
+		if (sizeOffset < sizeof(packetSize))
+		{
+			buffers[bufferCount].buf = reinterpret_cast<char *>(&packetSize) + sizeOffset;
+			buffers[bufferCount++].len = static_cast<ULONG>(sizeof(packetSize) - sizeOffset);
+		}
+
+		if (dataOffset < dataSize.second)
+		{
+			buffers[bufferCount].buf = const_cast<char *>(static_cast<const char *>(dataSize.first)) + dataOffset;
+			buffers[bufferCount++].len = static_cast<ULONG>(dataSize.second - dataOffset);
+		}
+
+		DWORD bytesSent = 0;
+		int result = WSASend(GetHandle(), buffers, bufferCount, &bytesSent, 0, nullptr, nullptr) == 0 ? static_cast<int>(bytesSent) : -1;
+#else
+		iovec buffers[2];
+		std::size_t bufferCount = 0;
+
+		if (sizeOffset < sizeof(packetSize))
+		{
+			buffers[bufferCount].iov_base = reinterpret_cast<char *>(&packetSize) + sizeOffset;
+			buffers[bufferCount++].iov_len = sizeof(packetSize) - sizeOffset;
+		}
+
+		if (dataOffset < dataSize.second)
+		{
+			buffers[bufferCount].iov_base = const_cast<char *>(static_cast<const char *>(dataSize.first)) + dataOffset;
+			buffers[bufferCount++].iov_len = dataSize.second - dataOffset;
+		}
+
+		msghdr message = {};
+		message.msg_iov = buffers;
+		message.msg_iovlen = bufferCount;
+		auto result = sendmsg(GetHandle(), &message, flags);
+#endif
+
+		// Check for errors, in the case of a partial send the location to resume from is kept in the packet.
+		if (result < 0)
+		{
+			Status status = GetErrorStatus();
+
+			if ((status == Status::NotReady) && sent)
+			{
+				return Status::Partial;
+			}
+
+			return status;
+		}
+
+		packet.m_sendPos += static_cast<std::size_t>(result);
+		sent += static_cast<std::size_t>(result);
 	}
 
-	return status;
+	packet.m_sendPos = 0;
+	return Status::Done;
 }
 
 Socket::Status TcpSocket::Receive(Packet &packet)
@@ -312,65 +396,78 @@ Socket::Status TcpSocket::Receive(Packet &packet)
 	// First clear the variables to fill.
 	packet.Clear();
 
-	// We start by getting the size of the incoming packet.
-	uint32_t packetSize = 0;
-	std::size_t received = 0;
-
-	if (m_pendingPacket.m_sizeReceived < sizeof(m_pendingPacket.m_size))
+	while (true)
 	{
-		// Loop until we've received the entire size of the packet (even a 4 byte variable may be received in more than one call).
-		while (m_pendingPacket.m_sizeReceived < sizeof(m_pendingPacket.m_size))
+		// We start by getting the size of the incoming packet, even a 4 byte size may be received over more than one call.
+		auto available = m_receiveEnd - m_receiveBegin;
+		auto required = sizeof(uint32_t);
+
+		if (available >= sizeof(uint32_t))
 		{
-			char *data = reinterpret_cast<char *>(&m_pendingPacket.m_size) + m_pendingPacket.m_sizeReceived;
-			Status status = Receive(data, sizeof(m_pendingPacket.m_size) - m_pendingPacket.m_sizeReceived, received);
-			m_pendingPacket.m_sizeReceived += received;
+			uint32_t packetSize;
+			std::memcpy(&packetSize, &m_receiveBuffer[m_receiveBegin], sizeof(packetSize));
+			packetSize = ntohl(packetSize);
 
-			if (status != Status::Done)
+			// The size comes from the peer, it must not be able to make us allocate an arbitrary amount of memory.
+			if (packetSize > MaxPacketSize)
 			{
-				return status;
+				Log::Error("Received a packet size of %u bytes, the limit is %u bytes\n", packetSize, MaxPacketSize);
+				Disconnect();
+				return Status::Error;
 			}
-		}
-
-		// The packet size has been fully received.
-		packetSize = ntohl(m_pendingPacket.m_size);
-	}
-	else
-	{
-		// The packet size has already been received in a previous call.
-		packetSize = ntohl(m_pendingPacket.m_size);
-	}
 
-	// Loop until we receive all the packet data.
-	char buffer[1024];
+			required += packetSize;
 
-	while (m_pendingPacket.m_data.size() < packetSize)
-	{
-		// Receive a chunk of data.
-		std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.m_data.size()), sizeof(buffer));
-		Status status = Receive(buffer, sizeToGet, received);
+			// We have received all the packet data: the user packet decodes it directly from the receive buffer.
+			if (available >= required)
+			{
+				if (packetSize > 0)
+				{
+					packet.OnReceive(&m_receiveBuffer[m_receiveBegin + sizeof(packetSize)], packetSize);
+				}
+
+				m_receiveBegin += required;
+
+				if (m_receiveBegin == m_receiveEnd)
+				{
+					m_receiveBegin = 0;
+					m_receiveEnd = 0;
+
+					// Don't keep the memory of a large packet around for the rest of the connection.
+					if (m_receiveBuffer.size() > receiveBufferSize)
+					{
+						m_receiveBuffer.resize(receiveBufferSize);
+						m_receiveBuffer.shrink_to_fit();
+					}
+				}
+
+				return Status::Done;
+			}
+		}
 
-		if (status != Status::Done)
+		// Move the unread bytes to the front when the rest of the packet wouldn't fit after them.
+		if (m_receiveBegin > 0 && m_receiveBegin + required > m_receiveBuffer.size())
 		{
-			return status;
+			std::memmove(m_receiveBuffer.data(), &m_receiveBuffer[m_receiveBegin], available);
+			m_receiveBegin = 0;
+			m_receiveEnd = available;
 		}
 
-		// Append it into the packet.
-		if (received > 0)
+		// Grow only once the buffer is full, doubling up to the packet size, so the memory used follows the data received.
+		if (m_receiveEnd == m_receiveBuffer.size())
 		{
-			m_pendingPacket.m_data.resize(m_pendingPacket.m_data.size() + received);
-			char *begin = &m_pendingPacket.m_data[0] + m_pendingPacket.m_data.size() - received;
-			std::memcpy(begin, buffer, received);
+			m_receiveBuffer.resize(std::max(receiveBufferSize, std::min(required, 2 * m_receiveBuffer.size())));
 		}
-	}
 
-	// We have received all the packet data: we can copy it to the user packet.
-	if (!m_pendingPacket.m_data.empty())
-	{
-		packet.OnReceive(&m_pendingPacket.m_data[0], m_pendingPacket.m_data.size());
-	}
+		// Receive as many bytes as fit, this may hold the rest of this packet and any packets after it.
+		std::size_t received = 0;
+		Status status = Receive(&m_receiveBuffer[m_receiveEnd], m_receiveBuffer.size() - m_receiveEnd, received);
+		m_receiveEnd += received;
 
-	// Clear the pending packet data.
-	m_pendingPacket = PendingPacket();
-	return Status::Done;
+		if (status != Status::Done)
+		{
+			return status;
+		}
+	}
 }
 }
@@ -30,32 +30,18 @@ class Packet;
  * 
  * The socket is automatically disconnected when it is destroyed, but if you want to
  * explicitly close the connection while the socket instance is still alive, you can call disconnect.
- **/
-class ACID_EXPORT PendingPacket
-{
-public:
-	PendingPacket() :
-		m_size(0),
-		m_sizeReceived(0),
-		m_data(std::vector<char>())
-	{
-	}
-
-	/// Data of packet size.
-	uint32_t m_size;
-	/// Number of size bytes received so far.
-	std::size_t m_sizeReceived;
-	/// Data of the packet.
-	std::vector<char> m_data;
-};
-
-/**
- * @brief Specialized socket using the TCP protocol
+ * 
+ * Packets are sent with the size prefix and data gathered in a single system call, and received
+ * through a buffer that can hold many packets from one read, which they are decoded from in place.
+ * Don't mix the low-level Receive with packet receives, bytes already buffered for packets are not returned by it.
  **/
 class ACID_EXPORT TcpSocket :
 	public Socket
 {
 public:
+	/// Largest packet that will be sent or received, a larger size header is treated as a broken or hostile stream.
+	static constexpr uint32_t MaxPacketSize = 16 * 1024 * 1024;
+
 	/**
 	 * Default constructor.
 	 **/
@@ -93,6 +79,12 @@ public:
 	 **/
 	Status Connect(const IpAddress &remoteAddress, const uint16_t &remotePort, const Time &timeout = Time::Zero);
 
+	/**
+	 * Check on a connection started by Connect in non-blocking mode, without waiting.
+	 * @return Done once connected, NotReady while still connecting, otherwise the reason the connection failed. 
+	 **/
+	Status PollConnect();
+
 	/**
 	 * Disconnect the socket from its remote peer.
 	 * This function gracefully closes the connection. If the socket is not connected, this function has no effect.
@@ -134,7 +126,7 @@ public:
 	 * Send a formatted packet of data to the remote peer.
 	 * In non-blocking mode, if this function returns SOCKET_STATUS_PARTIAL, you \em must retry sending the same unmodified
 	 * packet before sending anything else in order to guarantee the packet arrives at the remote peer uncorrupted.
-	 * This function will fail if the socket is not connected.
+	 * This function will fail if the socket is not connected, or if the packet is larger than {@link TcpSocket#MaxPacketSize}.
 	 * @param packet Packet to send. 
 	 * @return Status code. 
 	 **/
@@ -144,6 +136,7 @@ public:
 	 * Receive a formatted packet of data from the remote peer.
 	 * In blocking mode, this function will wait until the whole packet has been received.
 	 * This function will fail if the socket is not connected.
+	 * A packet larger than {@link TcpSocket#MaxPacketSize} disconnects the socket and returns Error, the stream can't be resynchronized after it.
 	 * @param packet Packet to fill with the received data. 
 	 * @return Status code. 
 	 **/
@@ -152,7 +145,11 @@ public:
 private:
 	friend class TcpListener;
 
-	/// Temporary data of the packet currently being received.
-	PendingPacket m_pendingPacket;
+	/// Received bytes that have not been taken by a packet yet.
+	std::vector<char> m_receiveBuffer;
+	/// Offset of the first unread byte in the receive buffer.
+	std::size_t m_receiveBegin;
+	/// Offset after the last received byte in the receive buffer.
+	std::size_t m_receiveEnd;
 };
 }
@@ -6,6 +6,8 @@
 
 #else
 #include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #endif
 
 #include "Engine/Log.hpp"
@@ -16,12 +18,43 @@ namespace acid
 {
 static const uint32_t MAX_DATAGRAM_SIZE = 65507;
 
+#if defined(ACID_BUILD_LINUX)
+struct UdpSocket::UdpBatchImpl
+{
+	/// Maximum number of messages given to one sendmmsg or recvmmsg call.
+	static constexpr std::size_t MaxMessages = 1024;
+
+	std::vector<mmsghdr> messages;
+	std::vector<iovec> vectors;
+	std::vector<sockaddr_in> addresses;
+
+	void Prepare(const std::size_t &count)
+	{
+		if (messages.size() < count)
+		{
+			messages.resize(count);
+			vectors.resize(count);
+			addresses.resize(count);
+		}
+	}
+};
+#else
+struct UdpSocket::UdpBatchImpl
+{
+};
+#endif
+
 UdpSocket::UdpSocket() :
 	Socket(Type::Udp),
+	m_batch(std::make_unique<UdpBatchImpl>()),
 	m_buffer(MAX_DATAGRAM_SIZE)
 {
 }
 
+UdpSocket::~UdpSocket()
+{
+}
+
 uint16_t UdpSocket::GetLocalPort() const
 {
 	if (GetHandle() != InvalidSocketHandle())
@@ -169,4 +202,139 @@ Socket::Status UdpSocket::Receive(Packet &packet, IpAddress &remoteAddress, uint
 
 	return status;
 }
+
+Socket::Status UdpSocket::SendBatch(const UdpDatagram *datagrams, const std::size_t &count, std::size_t &sent)
+{
+	sent = 0;
+
+	// Create the internal socket if it doesn't exist.
+	Create();
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		// Make sure that all the data will fit in one datagram.
+		if (datagrams[i].m_size > MAX_DATAGRAM_SIZE)
+		{
+			Log::Error("Cannot send data over the network (the number of bytes to send is greater than UdpSocket::MAX_DATAGRAM_SIZE)\n");
+			return Status::Error;
+		}
+	}
+
+#if defined(ACID_BUILD_LINUX)
+	while (sent < count)
+	{
+		auto batchSize = std::min(count - sent, UdpBatchImpl::MaxMessages);
+		m_batch->Prepare(batchSize);
+
+		for (std::size_t i = 0; i < batchSize; i++)
+		{
+			auto &datagram = datagrams[sent + i];
+			m_batch->addresses[i] = CreateAddress(datagram.m_address.ToInteger(), datagram.m_port);
+			m_batch->vectors[i].iov_base = datagram.m_data;
+			m_batch->vectors[i].iov_len = datagram.m_size;
+
+			auto &header = m_batch->messages[i].msg_hdr;
+			header = {};
+			header.msg_name = &m_batch->addresses[i];
+			header.msg_namelen = sizeof(sockaddr_in);
+			header.msg_iov = &m_batch->vectors[i];
+			header.msg_iovlen = 1;
+		}
+
+		int result = sendmmsg(GetHandle(), m_batch->messages.data(), static_cast<unsigned int>(batchSize), 0);
+
+		// Check for errors.
+		if (result < 0)
+		{
+			Status status = GetErrorStatus();
+			return (status == Status::NotReady && sent > 0) ? Status::Partial : status;
+		}
+
+		sent += static_cast<std::size_t>(result);
+	}
+#else
+	for (; sent < count; sent++)
+	{
+		Status status = Send(datagrams[sent].m_data, datagrams[sent].m_size, datagrams[sent].m_address, datagrams[sent].m_port);
+
+		if (status != Status::Done)
+		{
+			return (status == Status::NotReady && sent > 0) ? Status::Partial : status;
+		}
+	}
+#endif
+
+	return Status::Done;
+}
+
+Socket::Status UdpSocket::ReceiveBatch(UdpDatagram *datagrams, const std::size_t &count, std::size_t &received)
+{
+	received = 0;
+
+	if (count == 0)
+	{
+		return Status::Done;
+	}
+
+#if defined(ACID_BUILD_LINUX)
+	auto batchSize = std::min(count, UdpBatchImpl::MaxMessages);
+	m_batch->Prepare(batchSize);
+
+	for (std::size_t i = 0; i < batchSize; i++)
+	{
+		m_batch->vectors[i].iov_base = datagrams[i].m_data;
+		m_batch->vectors[i].iov_len = datagrams[i].m_size;
+
+		auto &header = m_batch->messages[i].msg_hdr;
+		header = {};
+		header.msg_name = &m_batch->addresses[i];
+		header.msg_namelen = sizeof(sockaddr_in);
+		header.msg_iov = &m_batch->vectors[i];
+		header.msg_iovlen = 1;
+	}
+
+	// Only blocks until the first datagram arrives, the rest of the batch is filled with what is already queued.
+	int result = recvmmsg(GetHandle(), m_batch->messages.data(), static_cast<unsigned int>(batchSize), MSG_WAITFORONE, nullptr);
+
+	// Check for errors.
+	if (result < 0)
+	{
+		return GetErrorStatus();
+	}
+
+	// Fill the sender informations.
+	for (std::size_t i = 0; i < static_cast<std::size_t>(result); i++)
+	{
+		datagrams[i].m_received = m_batch->messages[i].msg_len;
+		datagrams[i].m_address = IpAddress(ntohl(m_batch->addresses[i].sin_addr.s_addr));
+		datagrams[i].m_port = ntohs(m_batch->addresses[i].sin_port);
+	}
+
+	received = static_cast<std::size_t>(result);
+	return Status::Done;
+#else
+	// The first receive follows the blocking mode, the others must not wait for datagrams that haven't arrived.
+	bool blocking = IsBlocking();
+
+	for (; received < count; received++)
+	{
+		auto &datagram = datagrams[received];
+		Status status = Receive(datagram.m_data, datagram.m_size, datagram.m_received, datagram.m_address, datagram.m_port);
+
+		if (received == 0 && blocking)
+		{
+			SetBlocking(false);
+		}
+
+		if (status != Status::Done)
+		{
+			SetBlocking(blocking);
+			return received > 0 ? Status::Done : status;
+		}
+	}
+
+	SetBlocking(blocking);
+	return Status::Done;
+#endif
+}
 }
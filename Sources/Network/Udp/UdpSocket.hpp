@@ -7,6 +7,23 @@ namespace acid
 {
 class Packet;
 
+/**
+ * @brief A datagram sent or received as part of a batch, see UdpSocket::SendBatch and UdpSocket::ReceiveBatch.
+ **/
+struct UdpDatagram
+{
+	/// Data to send, or the buffer to receive into.
+	void *m_data;
+	/// Number of bytes to send, or the size of the receive buffer.
+	std::size_t m_size;
+	/// Number of bytes received.
+	std::size_t m_received;
+	/// Address of the peer to send to, or that sent the data.
+	IpAddress m_address;
+	/// Port of the peer to send to, or that sent the data.
+	uint16_t m_port;
+};
+
 /**
  * @brief A UDP socket is a connectionless socket. Instead of connecting once to a remote host,
  * like TCP sockets, it can send to and receive from any host at any time.
@@ -46,6 +63,8 @@ public:
 	 **/
 	UdpSocket();
 
+	~UdpSocket();
+
 	/**
 	 * Get the port to which the socket is bound locally. If the socket is not bound to a port, this function returns 0.
 	 * @return Port to which the socket is bound. 
@@ -118,7 +137,35 @@ public:
 	 **/
 	Status Receive(Packet &packet, IpAddress &remoteAddress, uint16_t &remotePort);
 
+	/**
+	 * Send a batch of datagrams, each to its own remote peer.
+	 * On Linux the whole batch is handed to the system with as few sendmmsg calls as possible,
+	 * other platforms send the datagrams one by one.
+	 * In non-blocking mode Partial is returned if only some of the datagrams could be sent.
+	 * @param datagrams Datagrams to send. 
+	 * @param count Number of datagrams. 
+	 * @param sent This variable is filled with the number of datagrams sent. 
+	 * @return Status code. 
+	 **/
+	Status SendBatch(const UdpDatagram *datagrams, const std::size_t &count, std::size_t &sent);
+
+	/**
+	 * Receive a batch of datagrams from any remote peers.
+	 * In blocking mode, this function waits for the first datagram, then takes any others that are
+	 * already waiting without blocking again. On Linux this is a single recvmmsg call.
+	 * @param datagrams Datagrams to fill, each with a receive buffer set. 
+	 * @param count Number of datagrams. 
+	 * @param received This variable is filled with the number of datagrams received. 
+	 * @return Status code. 
+	 **/
+	Status ReceiveBatch(UdpDatagram *datagrams, const std::size_t &count, std::size_t &received);
+
 private:
+	struct UdpBatchImpl;
+
+	/// Message arrays reused by every batch, only grown when a larger batch is used.
+	std::unique_ptr<UdpBatchImpl> m_batch;
+
 	/// Temporary buffer holding the received data in Receive(Packet).
 	std::vector<char> m_buffer;
 };
@@ -51,6 +51,12 @@ void ParticleSystem::Update()
 	}
 }
 
+void ParticleSystem::OnClone()
+{
+	// The template's timer started when the prefab was compiled, emitting from it would burst every particle missed since.
+	m_emitTimer = Timer(m_emitTimer.GetInterval());
+}
+
 void ParticleSystem::Decode(const Metadata &metadata)
 {
 	auto typesNode = metadata.FindChild("Types");
@@ -29,6 +29,8 @@ public:
 
 	void Update() override;
 
+	void OnClone() override;
+
 	void Decode(const Metadata &metadata) override;
 
 	void Encode(Metadata &metadata) const override;
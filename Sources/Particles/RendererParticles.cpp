@@ -17,7 +17,7 @@ void RendererParticles::Render(const CommandBuffer &commandBuffer)
 {
 	auto camera = Scenes::Get()->GetCamera();
 	m_uniformScene.Push("projection", camera->GetProjectionMatrix());
-	m_uniformScene.Push("view", camera->GetViewMatrix());
+	m_uniformScene.Push("view", camera->GetRenderViewMatrix());
 
 	auto particles = Particles::Get()->GetParticles();
 
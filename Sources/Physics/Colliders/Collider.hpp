@@ -25,8 +25,12 @@ public:
 	 */
 	explicit Collider(const Transform &localTransform = Transform::Identity, const std::shared_ptr<GizmoType> &gizmoType = nullptr);
 
+	Collider(const Collider &) = delete;
+
 	virtual ~Collider();
 
+	Collider &operator=(const Collider &) = delete;
+
 	void Update() override;
 
 	/**
@@ -42,10 +42,10 @@ void RendererDeferred::Render(const CommandBuffer &commandBuffer)
 	}
 
 	// Updates uniforms.
-	std::vector<DeferredLight> deferredLights(MAX_LIGHTS);
+	FrameAllocator::Vector<DeferredLight> deferredLights(MAX_LIGHTS, FrameAllocator::Get());
 	uint32_t lightCount = 0;
 
-	auto sceneLights = Scenes::Get()->GetStructure()->QueryComponents<Light>();
+	auto sceneLights = Scenes::Get()->GetStructure()->QueryComponents<Light>(false, FrameAllocator::Get());
 
 	for (const auto &light : sceneLights)
 	{
@@ -71,9 +71,9 @@ void RendererDeferred::Render(const CommandBuffer &commandBuffer)
 	}
 
 	// Updates uniforms.
-	m_uniformScene.Push("view", camera->GetViewMatrix());
+	m_uniformScene.Push("view", camera->GetRenderViewMatrix());
 	m_uniformScene.Push("shadowSpace", Shadows::Get()->GetShadowBox().GetToShadowMapSpaceMatrix());
-	m_uniformScene.Push("cameraPosition", camera->GetPosition());
+	m_uniformScene.Push("cameraPosition", camera->GetRenderPosition());
 	m_uniformScene.Push("lightsCount", lightCount);
 	m_uniformScene.Push("fogColour", m_fog.GetColour());
 	m_uniformScene.Push("fogDensity", m_fog.GetDensity());
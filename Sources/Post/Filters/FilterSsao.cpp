@@ -34,8 +34,8 @@ void FilterSsao::Render(const CommandBuffer &commandBuffer)
 	auto camera = Scenes::Get()->GetCamera();
 	m_uniformScene.Push("kernel", *m_kernel.data(), sizeof(Vector3f) * SSAO_KERNEL_SIZE);
 	m_uniformScene.Push("projection", camera->GetProjectionMatrix());
-	m_uniformScene.Push("view", camera->GetViewMatrix());
-	m_uniformScene.Push("cameraPosition", camera->GetPosition());
+	m_uniformScene.Push("view", camera->GetRenderViewMatrix());
+	m_uniformScene.Push("cameraPosition", camera->GetRenderPosition());
 
 	// Updates descriptors.
 	m_descriptorSet.Push("UniformScene", m_uniformScene);
@@ -11,6 +11,18 @@ Buffer::Buffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage, const
 {
 	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 
+	if (logicalDevice == nullptr)
+	{
+		m_hostMemory = std::make_unique<uint8_t[]>(static_cast<std::size_t>(size));
+
+		if (data != nullptr)
+		{
+			std::memcpy(m_hostMemory.get(), data, static_cast<std::size_t>(size));
+		}
+
+		return;
+	}
+
 	auto graphicsFamily = logicalDevice->GetGraphicsFamily();
 	auto presentFamily = logicalDevice->GetPresentFamily();
 	auto computeFamily = logicalDevice->GetComputeFamily();
@@ -64,6 +76,11 @@ Buffer::Buffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage, const
 
 Buffer::~Buffer()
 {
+	if (m_hostMemory != nullptr)
+	{
+		return;
+	}
+
 	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 
 	vkDestroyBuffer(*logicalDevice, m_buffer, nullptr);
@@ -72,12 +89,23 @@ Buffer::~Buffer()
 
 void Buffer::MapMemory(void **data)
 {
+	if (m_hostMemory != nullptr)
+	{
+		*data = m_hostMemory.get();
+		return;
+	}
+
 	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 	Renderer::CheckVk(vkMapMemory(*logicalDevice, GetBufferMemory(), 0, m_size, 0, data));
 }
 
 void Buffer::UnmapMemory()
 {
+	if (m_hostMemory != nullptr)
+	{
+		return;
+	}
+
 	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 	vkUnmapMemory(*logicalDevice, GetBufferMemory());
 }
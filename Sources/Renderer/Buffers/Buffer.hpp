@@ -7,6 +7,7 @@ namespace acid
 {
 /**
  * @brief Interface that represents a buffer.
+ * When the engine is headless buffers are kept in host memory, so they can still be written without a device.
  */
 class ACID_EXPORT Buffer
 {
@@ -43,5 +44,6 @@ protected:
 	VkDeviceSize m_size;
 	VkBuffer m_buffer;
 	VkDeviceMemory m_bufferMemory;
+	std::unique_ptr<uint8_t[]> m_hostMemory;
 };
 }
@@ -0,0 +1,123 @@
+#include "TimestampQueries.hpp"
+
+#include "Engine/Profiler.hpp"
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+static const uint32_t NOT_TIMED = std::numeric_limits<uint32_t>::max();
+
+TimestampQueries::TimestampQueries(const uint32_t &track, const uint32_t &capacity) :
+	m_queryPool(VK_NULL_HANDLE),
+	m_track(track),
+	m_capacity(capacity),
+	m_count(0),
+	m_period(0.0f),
+	m_submitTime(0)
+{
+	auto physicalDevice = Renderer::Get()->GetPhysicalDevice();
+	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+
+	auto &limits = physicalDevice->GetProperties().limits;
+
+	// Without timestamps on every graphics queue the zones are never timed.
+	if (!limits.timestampComputeAndGraphics || limits.timestampPeriod == 0.0f)
+	{
+		return;
+	}
+
+	m_period = limits.timestampPeriod;
+	m_results.resize(2 * m_capacity);
+
+	VkQueryPoolCreateInfo queryPoolCreateInfo = {};
+	queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	queryPoolCreateInfo.queryCount = m_capacity;
+	Renderer::CheckVk(vkCreateQueryPool(*logicalDevice, &queryPoolCreateInfo, nullptr, &m_queryPool));
+}
+
+TimestampQueries::~TimestampQueries()
+{
+	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+
+	vkDestroyQueryPool(*logicalDevice, m_queryPool, nullptr);
+}
+
+void TimestampQueries::CmdReset(const CommandBuffer &commandBuffer)
+{
+	if (m_queryPool == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	if (m_count != 0)
+	{
+		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+
+		// Each result is followed by if it is available, so zones that were never written are skipped rather than waited on.
+		vkGetQueryPoolResults(*logicalDevice, m_queryPool, 0, m_count, 2 * m_count * sizeof(uint64_t), m_results.data(), 2 * sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+		if (m_results[1] != 0)
+		{
+			auto base = m_results[0];
+
+			for (const auto &query : m_queries)
+			{
+				if (query.m_end == NOT_TIMED || m_results[2 * query.m_begin + 1] == 0 || m_results[2 * query.m_end + 1] == 0)
+				{
+					continue;
+				}
+
+				auto start = m_submitTime + static_cast<int64_t>(static_cast<double>(m_results[2 * query.m_begin] - base) * m_period);
+				auto end = m_submitTime + static_cast<int64_t>(static_cast<double>(m_results[2 * query.m_end] - base) * m_period);
+				Profiler::Record(m_track, Profiler::Zone{query.m_name, start, end});
+			}
+		}
+	}
+
+	vkCmdResetQueryPool(commandBuffer, m_queryPool, 0, m_capacity);
+	m_count = 0;
+	m_queries.clear();
+	m_open.clear();
+}
+
+void TimestampQueries::CmdBegin(const CommandBuffer &commandBuffer, const char *name)
+{
+	if (m_queryPool == VK_NULL_HANDLE || name == nullptr || !Profiler::IsEnabled() || m_count + 2 > m_capacity)
+	{
+		m_open.emplace_back(NOT_TIMED);
+		return;
+	}
+
+	// The end timestamp is kept free so every started zone can end.
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, m_count);
+	m_open.emplace_back(static_cast<uint32_t>(m_queries.size()));
+	m_queries.emplace_back(Query{name, m_count, NOT_TIMED});
+	m_count += 2;
+}
+
+void TimestampQueries::CmdEnd(const CommandBuffer &commandBuffer)
+{
+	if (m_open.empty())
+	{
+		return;
+	}
+
+	auto query = m_open.back();
+	m_open.pop_back();
+
+	if (query == NOT_TIMED)
+	{
+		return;
+	}
+
+	m_queries[query].m_end = m_queries[query].m_begin + 1;
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, m_queries[query].m_end);
+}
+
+void TimestampQueries::Submitted()
+{
+	m_submitTime = Profiler::Now();
+}
+}
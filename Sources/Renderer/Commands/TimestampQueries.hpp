@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "CommandBuffer.hpp"
+
+namespace acid
+{
+/**
+ * @brief A pool of GPU timestamps written around zones in one command buffer.
+ * The times are read back when the command buffer is next recorded, and recorded as {@link Profiler} zones on a GPU track.
+ * GPU zones are placed on the profiler timeline from the time the command buffer was submitted, so they line up with CPU zones approximately.
+ */
+class ACID_EXPORT TimestampQueries :
+	public NonCopyable
+{
+public:
+	/**
+	 * Creates a new timestamp query pool.
+	 * @param track The profiler track zones are recorded into.
+	 * @param capacity The most timestamps written in a recording, zones past it are not timed.
+	 */
+	explicit TimestampQueries(const uint32_t &track, const uint32_t &capacity = 512);
+
+	~TimestampQueries();
+
+	/**
+	 * Records the zones from the last time the command buffer was recorded, then resets the pool.
+	 * Must be called after the command buffer begins and before a renderpass starts.
+	 * @param commandBuffer The command buffer.
+	 */
+	void CmdReset(const CommandBuffer &commandBuffer);
+
+	/**
+	 * Starts a zone, zones started before it ends are inside of it.
+	 * @param commandBuffer The command buffer.
+	 * @param name The zone name, not timed if null.
+	 */
+	void CmdBegin(const CommandBuffer &commandBuffer, const char *name);
+
+	/**
+	 * Ends the last started zone.
+	 * @param commandBuffer The command buffer.
+	 */
+	void CmdEnd(const CommandBuffer &commandBuffer);
+
+	/**
+	 * Marks when the command buffer was submitted.
+	 */
+	void Submitted();
+
+private:
+	struct Query
+	{
+		const char *m_name;
+		uint32_t m_begin;
+		uint32_t m_end;
+	};
+
+	VkQueryPool m_queryPool;
+	uint32_t m_track;
+	uint32_t m_capacity;
+	uint32_t m_count;
+	/// Nanoseconds per timestamp tick.
+	float m_period;
+
+	std::vector<Query> m_queries;
+	std::vector<uint32_t> m_open;
+	std::vector<uint64_t> m_results;
+	int64_t m_submitTime;
+};
+}
@@ -122,7 +122,7 @@ void Image::SetPixels(const uint8_t *pixels, const uint32_t &layerCount, const u
 
 std::unique_ptr<uint8_t[]> Image::LoadPixels(const std::string &filename, uint32_t &width, uint32_t &height, uint32_t &components, VkFormat &format)
 {
-	auto fileLoaded = Files::Read(filename);
+	auto fileLoaded = Files::ReadView(filename);
 
 	if (!fileLoaded)
 	{
@@ -131,7 +131,7 @@ std::unique_ptr<uint8_t[]> Image::LoadPixels(const std::string &filename, uint32
 	}
 
 	std::unique_ptr<uint8_t[]> pixels(
-		stbi_load_from_memory(reinterpret_cast<uint8_t *>(fileLoaded->data()), static_cast<uint32_t>(fileLoaded->size()), reinterpret_cast<int32_t *>(&width),
+		stbi_load_from_memory(reinterpret_cast<const uint8_t *>(fileLoaded->GetData()), static_cast<int32_t>(fileLoaded->GetSize()), reinterpret_cast<int32_t *>(&width),
 			reinterpret_cast<int32_t *>(&height), reinterpret_cast<int32_t *>(&components), STBI_rgb_alpha));
 
 	// STBI_rgb_alpha converts the loaded image to a 32 bit image, if another loader is used components and format may differ.
@@ -437,7 +437,8 @@ void Image::InsertImageMemoryBarrier(const CommandBuffer &commandBuffer, const V
 	vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
 }
 
-void Image::CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const VkExtent3D &extent, const uint32_t &layerCount, const uint32_t &baseArrayLayer)
+void Image::CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const VkExtent3D &extent, const uint32_t &layerCount, const uint32_t &baseArrayLayer,
+	const VkOffset3D &offset)
 {
 	CommandBuffer commandBuffer = CommandBuffer();
 
@@ -449,7 +450,7 @@ void Image::CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, cons
 	region.imageSubresource.mipLevel = 0;
 	region.imageSubresource.baseArrayLayer = baseArrayLayer;
 	region.imageSubresource.layerCount = layerCount;
-	region.imageOffset = { 0, 0, 0 };
+	region.imageOffset = offset;
 	region.imageExtent = extent;
 	vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
@@ -1,5 +1,6 @@
 #include "Image2d.hpp"
 
+#include "Engine/Profiler.hpp"
 #include "Renderer/Buffers/Buffer.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Resources/Resources.hpp"
@@ -87,6 +88,12 @@ Image2d::~Image2d()
 {
 	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 
+	// Headless images are never created on a device.
+	if (logicalDevice == nullptr)
+	{
+		return;
+	}
+
 	vkDestroySampler(*logicalDevice, m_sampler, nullptr);
 	vkDestroyImageView(*logicalDevice, m_view, nullptr);
 	vkFreeMemory(*logicalDevice, m_memory, nullptr);
@@ -125,6 +132,8 @@ WriteDescriptorSet Image2d::GetWriteDescriptor(const uint32_t &binding, const Vk
 
 void Image2d::Load()
 {
+	ACID_PROFILE_ZONE("Image2d::Load");
+
 	if (!m_filename.empty() && m_loadPixels == nullptr)
 	{
 #if defined(ACID_VERBOSE)
@@ -144,6 +153,12 @@ void Image2d::Load()
 
 	m_mipLevels = m_mipmap ? Image::GetMipLevels({ m_width, m_height, 1 }) : 1;
 
+	// Headless images keep their size and pixels, but nothing is created on a device.
+	if (Engine::Get()->IsHeadless())
+	{
+		return;
+	}
+
 	Image::CreateImage(m_image, m_memory, { m_width, m_height, 1 }, m_format, m_samples, VK_IMAGE_TILING_OPTIMAL, m_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_mipLevels, 1,
 		VK_IMAGE_TYPE_2D);
 	Image::CreateImageSampler(m_sampler, m_filter, m_addressMode, m_anisotropic, m_mipLevels);
@@ -249,4 +264,18 @@ void Image2d::SetPixels(const uint8_t *pixels, const uint32_t &layerCount, const
 
 	Image::CopyBufferToImage(bufferStaging.GetBuffer(), m_image, { m_width, m_height, 1 }, layerCount, baseArrayLayer);
 }
+
+void Image2d::SetPixels(const uint8_t *pixels, const VkDeviceSize &size, const VkOffset3D &offset, const VkExtent3D &extent)
+{
+	Buffer bufferStaging = Buffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	void *data;
+	bufferStaging.MapMemory(&data);
+	std::memcpy(data, pixels, static_cast<std::size_t>(size));
+	bufferStaging.UnmapMemory();
+
+	Image::TransitionImageLayout(m_image, m_format, m_layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, 1, 0);
+	Image::CopyBufferToImage(bufferStaging.GetBuffer(), m_image, extent, 1, 0, offset);
+	Image::TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, 1, 0);
+}
 }
@@ -94,6 +94,15 @@ public:
 	 */
 	void SetPixels(const uint8_t *pixels, const uint32_t &layerCount, const uint32_t &baseArrayLayer);
 
+	/**
+	 * Sets the pixels in a region of this image, leaving the rest untouched.
+	 * @param pixels The tightly packed pixels of the region to copy from.
+	 * @param size The size of the pixels in bytes.
+	 * @param offset The position of the region.
+	 * @param extent The size of the region.
+	 */
+	void SetPixels(const uint8_t *pixels, const VkDeviceSize &size, const VkOffset3D &offset, const VkExtent3D &extent);
+
 	const std::string &GetFilename() const { return m_filename; };
 
 	const VkFilter &GetFilter() const { return m_filter; }
@@ -1,5 +1,6 @@
 ﻿#include "ImageCube.hpp"
 
+#include "Engine/Profiler.hpp"
 #include "Renderer/Buffers/Buffer.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Resources/Resources.hpp"
@@ -91,6 +92,12 @@ ImageCube::~ImageCube()
 {
 	auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 
+	// Headless images are never created on a device.
+	if (logicalDevice == nullptr)
+	{
+		return;
+	}
+
 	vkDestroyImageView(*logicalDevice, m_view, nullptr);
 	vkDestroySampler(*logicalDevice, m_sampler, nullptr);
 	vkFreeMemory(*logicalDevice, m_memory, nullptr);
@@ -129,6 +136,8 @@ WriteDescriptorSet ImageCube::GetWriteDescriptor(const uint32_t &binding, const
 
 void ImageCube::Load()
 {
+	ACID_PROFILE_ZONE("ImageCube::Load");
+
 	if (!m_filename.empty() && m_loadPixels == nullptr)
 	{
 #if defined(ACID_VERBOSE)
@@ -148,6 +157,12 @@ void ImageCube::Load()
 
 	m_mipLevels = m_mipmap ? Image::GetMipLevels({ m_width, m_height, 1 }) : 1;
 
+	// Headless images keep their size and pixels, but nothing is created on a device.
+	if (Engine::Get()->IsHeadless())
+	{
+		return;
+	}
+
 	Image::CreateImage(m_image, m_memory, { m_width, m_height, 1 }, m_format, m_samples, VK_IMAGE_TILING_OPTIMAL, m_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_mipLevels, 6,
 		VK_IMAGE_TYPE_2D);
 	Image::CreateImageSampler(m_sampler, m_filter, m_addressMode, m_anisotropic, m_mipLevels);
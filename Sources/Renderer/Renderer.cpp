@@ -1,22 +1,50 @@
 #include "Renderer.hpp"
 
 #include <SPIRV/GlslangToSpv.h>
+#include "Engine/Profiler.hpp"
 #include "Files/FileSystem.hpp"
+#include "Helpers/String.hpp"
 #include "RenderPipeline.hpp"
 
 namespace acid
 {
+/**
+ * Gets the profiler zone name for a renderpass or subpass index, each name is only made once.
+ * @param names The names made so far.
+ * @param prefix The name before the index.
+ * @param index The index.
+ * @return The zone name.
+ */
+static const char *GetZoneName(std::vector<const char *> &names, const std::string &prefix, const uint32_t &index)
+{
+	while (names.size() <= index)
+	{
+		names.emplace_back(Profiler::Intern(prefix + " " + String::To(names.size())));
+	}
+
+	return names[index];
+}
+
 Renderer::Renderer() :
 	m_renderManager(nullptr),
 	m_swapchain(nullptr),
 	m_timerPurge(Time::Seconds(4.0f)),
 	m_pipelineCache(VK_NULL_HANDLE),
 	m_currentFrame(0),
-	m_instance(std::make_unique<Instance>()),
-	m_physicalDevice(std::make_unique<PhysicalDevice>(m_instance.get())),
-	m_surface(std::make_unique<Surface>(m_instance.get(), m_physicalDevice.get())),
-	m_logicalDevice(std::make_unique<LogicalDevice>(m_instance.get(), m_physicalDevice.get(), m_surface.get()))
+	m_gpuTrack(0)
 {
+	// A headless renderer has no device, its render manager is kept but never started.
+	if (Engine::Get()->IsHeadless())
+	{
+		return;
+	}
+
+	m_gpuTrack = Profiler::CreateTrack("GPU");
+	m_instance = std::make_unique<Instance>();
+	m_physicalDevice = std::make_unique<PhysicalDevice>(m_instance.get());
+	m_surface = std::make_unique<Surface>(m_instance.get(), m_physicalDevice.get());
+	m_logicalDevice = std::make_unique<LogicalDevice>(m_instance.get(), m_physicalDevice.get(), m_surface.get());
+
 	glslang::InitializeProcess();
 
 	CreatePipelineCache();
@@ -24,10 +52,17 @@ Renderer::Renderer() :
 
 Renderer::~Renderer()
 {
+	if (m_logicalDevice == nullptr)
+	{
+		return;
+	}
+
 	auto graphicsQueue = m_logicalDevice->GetGraphicsQueue();
 
 	CheckVk(vkQueueWaitIdle(graphicsQueue));
 
+	m_timestampQueries.clear();
+
 	glslang::FinalizeProcess();
 
 	vkDestroyPipelineCache(*m_logicalDevice, m_pipelineCache, nullptr);
@@ -42,7 +77,7 @@ Renderer::~Renderer()
 
 void Renderer::Update()
 {
-	if (m_renderManager == nullptr || Window::Get()->IsIconified())
+	if (m_logicalDevice == nullptr || m_renderManager == nullptr || Window::Get()->IsIconified())
 	{
 		return;
 	}
@@ -57,6 +92,9 @@ void Renderer::Update()
 
 	auto &stages = m_renderManager->GetRendererContainer().GetStages();
 
+	static std::vector<const char *> RenderpassNames;
+	static std::vector<const char *> SubpassNames;
+
 	std::optional<uint32_t> renderpass;
 	uint32_t subpass = 0;
 
@@ -72,6 +110,10 @@ void Renderer::Update()
 		return;
 	}
 
+	// GPU zones for every renderpass, subpass, and render pipeline.
+	auto &commandBuffer = *m_commandBuffers[m_swapchain->GetActiveImageIndex()];
+	auto &timestampQueries = *m_timestampQueries[m_swapchain->GetActiveImageIndex()];
+
 	for (auto &[key, renderPipelines] : stages)
 	{
 		if (renderpass != key.first)
@@ -79,6 +121,8 @@ void Renderer::Update()
 			// Ends the previous renderpass.
 			if (renderpass)
 			{
+				timestampQueries.CmdEnd(commandBuffer);
+				timestampQueries.CmdEnd(commandBuffer);
 				EndRenderpass(*GetRenderStage(*renderpass));
 			}
 
@@ -94,6 +138,9 @@ void Renderer::Update()
 			{
 				return;
 			}
+
+			timestampQueries.CmdBegin(commandBuffer, GetZoneName(RenderpassNames, "Renderpass", *renderpass));
+			timestampQueries.CmdBegin(commandBuffer, GetZoneName(SubpassNames, "Subpass", 0));
 		}
 
 		auto renderStage = GetRenderStage(*renderpass);
@@ -108,12 +155,15 @@ void Renderer::Update()
 				difference -= 1;
 			}
 
+			timestampQueries.CmdEnd(commandBuffer);
+
 			for (uint32_t d = 0; d < difference; d++)
 			{
 				vkCmdNextSubpass(*m_commandBuffers[m_swapchain->GetActiveImageIndex()], VK_SUBPASS_CONTENTS_INLINE);
 			}
 
 			subpass = key.second;
+			timestampQueries.CmdBegin(commandBuffer, GetZoneName(SubpassNames, "Subpass", subpass));
 		}
 
 		// Renders subpass render pipeline.
@@ -124,7 +174,12 @@ void Renderer::Update()
 				continue;
 			}
 
+			// Times the pipeline on the CPU while it records, and on the GPU while it runs.
+			auto zoneName = Profiler::IsEnabled() ? Profiler::GetTypeName(typeid(*renderPipeline)) : nullptr;
+			ACID_PROFILE_ZONE(zoneName);
+			timestampQueries.CmdBegin(commandBuffer, zoneName);
 			renderPipeline->Render(*m_commandBuffers[m_swapchain->GetActiveImageIndex()]);
+			timestampQueries.CmdEnd(commandBuffer);
 		}
 	}
 
@@ -135,6 +190,8 @@ void Renderer::Update()
 
 		if (renderStage != nullptr)
 		{
+			timestampQueries.CmdEnd(commandBuffer);
+			timestampQueries.CmdEnd(commandBuffer);
 			EndRenderpass(*renderStage);
 		}
 	}
@@ -230,11 +287,22 @@ void Renderer::CheckVk(const VkResult &result)
 
 void Renderer::UpdateSurfaceCapabilities()
 {
+	if (m_surface == nullptr)
+	{
+		return;
+	}
+
 	CheckVk(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(*m_physicalDevice, *m_surface, &m_surface->m_capabilities));
 }
 
 void Renderer::CaptureScreenshot(const std::string &filename)
 {
+	if (m_swapchain == nullptr)
+	{
+		Log::Error("Screenshot could not be captured, nothing has been rendered: '%s'\n", filename.c_str());
+		return;
+	}
+
 #if defined(ACID_VERBOSE)
 	auto debugStart = Engine::GetTime();
 #endif
@@ -306,6 +374,7 @@ void Renderer::SetRenderStages(std::vector<std::unique_ptr<RenderStage>> renderS
 		m_renderCompletes.resize(m_swapchain->GetImageCount());
 		m_flightFences.resize(m_swapchain->GetImageCount());
 		m_commandBuffers.resize(m_swapchain->GetImageCount());
+		m_timestampQueries.resize(m_swapchain->GetImageCount());
 
 		VkSemaphoreCreateInfo semaphoreCreateInfo = {};
 		semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -323,6 +392,7 @@ void Renderer::SetRenderStages(std::vector<std::unique_ptr<RenderStage>> renderS
 			CheckVk(vkCreateFence(*m_logicalDevice, &fenceCreateInfo, nullptr, &m_flightFences[i]));
 
 			m_commandBuffers[i] = std::make_unique<CommandBuffer>(false);
+			m_timestampQueries[i] = std::make_unique<TimestampQueries>(m_gpuTrack);
 		}
 	}
 
@@ -408,6 +478,7 @@ bool Renderer::StartRenderpass(RenderStage &renderStage)
 	{
 		CheckVk(vkWaitForFences(*m_logicalDevice, 1, &m_flightFences[m_currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max()));
 		m_commandBuffers[m_swapchain->GetActiveImageIndex()]->Begin(VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
+		m_timestampQueries[m_swapchain->GetActiveImageIndex()]->CmdReset(*m_commandBuffers[m_swapchain->GetActiveImageIndex()]);
 	}
 
 	VkRect2D renderArea = {};
@@ -455,6 +526,7 @@ void Renderer::EndRenderpass(RenderStage &renderStage)
 
 	m_commandBuffers[m_swapchain->GetActiveImageIndex()]->End();
 	m_commandBuffers[m_swapchain->GetActiveImageIndex()]->Submit(m_presentCompletes[m_currentFrame], m_renderCompletes[m_currentFrame], m_flightFences[m_currentFrame]);
+	m_timestampQueries[m_swapchain->GetActiveImageIndex()]->Submitted();
 	VkResult presentResult = m_swapchain->QueuePresent(presentQueue, m_renderCompletes[m_currentFrame]);
 
 	if (!(presentResult == VK_SUCCESS || presentResult == VK_SUBOPTIMAL_KHR))
@@ -5,6 +5,7 @@
 #include "Maths/Timer.hpp"
 #include "Commands/CommandBuffer.hpp"
 #include "Commands/CommandPool.hpp"
+#include "Commands/TimestampQueries.hpp"
 #include "Devices/Instance.hpp"
 #include "Devices/LogicalDevice.hpp"
 #include "Devices/PhysicalDevice.hpp"
@@ -102,6 +103,8 @@ private:
 	size_t m_currentFrame;
 
 	std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
+	uint32_t m_gpuTrack;
+	std::vector<std::unique_ptr<TimestampQueries>> m_timestampQueries;
 
 	std::unique_ptr<Instance> m_instance;
 	std::unique_ptr<PhysicalDevice> m_physicalDevice;
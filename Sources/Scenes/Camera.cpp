@@ -0,0 +1,58 @@
+#include "Camera.hpp"
+
+#include "Engine/Engine.hpp"
+
+namespace acid
+{
+void Camera::StoreSnapshot()
+{
+	m_snapshot ^= 1;
+	m_snapshotPositions[m_snapshot] = m_position;
+	m_snapshotRotations[m_snapshot] = m_rotation;
+
+	// The first update has no previous snapshot to blend from.
+	if (!m_snapshotted)
+	{
+		m_snapshotPositions[m_snapshot ^ 1] = m_position;
+		m_snapshotRotations[m_snapshot ^ 1] = m_rotation;
+		m_snapshotted = true;
+	}
+}
+
+Vector3f Camera::GetRenderPosition() const
+{
+	if (!m_snapshotted)
+	{
+		return m_position;
+	}
+
+	return m_snapshotPositions[m_snapshot ^ 1].Lerp(m_snapshotPositions[m_snapshot], Engine::Get()->GetAlpha());
+}
+
+Matrix4 Camera::GetRenderViewMatrix() const
+{
+	if (!m_snapshotted)
+	{
+		return m_viewMatrix;
+	}
+
+	const auto &previousRotation = m_snapshotRotations[m_snapshot ^ 1];
+	const auto &currentRotation = m_snapshotRotations[m_snapshot];
+	auto alpha = Engine::Get()->GetAlpha();
+
+	if (alpha >= 1.0f || (m_snapshotPositions[m_snapshot ^ 1] == m_snapshotPositions[m_snapshot] && previousRotation == currentRotation))
+	{
+		return m_viewMatrix;
+	}
+
+	// Rotations blend the short way around, the same as entities.
+	auto wrap = [](const float &angle)
+	{
+		return angle - 360.0f * std::round(angle / 360.0f);
+	};
+	auto rotation = currentRotation - previousRotation;
+	rotation = Vector3f(wrap(rotation.m_x), wrap(rotation.m_y), wrap(rotation.m_z));
+
+	return Matrix4::ViewMatrix(GetRenderPosition(), (previousRotation + rotation * alpha) * Maths::DegToRad);
+}
+}
@@ -19,7 +19,9 @@ public:
 		m_nearPlane(0.1f),
 		m_farPlane(1000.0f),
 		m_fieldOfView(45.0f),
-		m_viewRay(false, Vector2f(0.5f, 0.5f))
+		m_viewRay(false, Vector2f(0.5f, 0.5f)),
+		m_snapshot(0),
+		m_snapshotted(false)
 	{
 	}
 
@@ -79,6 +81,25 @@ public:
 	 */
 	const Ray &GetViewRay() const { return m_viewRay; }
 
+	/**
+	 * Stores the position and rotation as the current snapshot, the last current snapshot becomes the previous one.
+	 * Called after each update so renders can blend between the last two, as entities are.
+	 */
+	void StoreSnapshot();
+
+	/**
+	 * Gets the position to render from, blended between the previous and current snapshot by the engines alpha.
+	 * @return The interpolated position.
+	 */
+	Vector3f GetRenderPosition() const;
+
+	/**
+	 * Gets the view matrix to render with, built from the blended position and rotation (in degrees).
+	 * When the camera hasn't moved since the last update this is the view matrix.
+	 * @return The interpolated view matrix.
+	 */
+	Matrix4 GetRenderViewMatrix() const;
+
 protected:
 	float m_nearPlane;
 	float m_farPlane;
@@ -93,5 +114,11 @@ protected:
 
 	Frustum m_viewFrustum;
 	Ray m_viewRay;
+
+private:
+	Vector3f m_snapshotPositions[2];
+	Vector3f m_snapshotRotations[2];
+	uint32_t m_snapshot;
+	bool m_snapshotted;
 };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Helpers/ObjectPool.hpp"
 #include "Serialized/Metadata.hpp"
 
 namespace acid
@@ -22,6 +23,15 @@ public:
 
 	virtual ~Component() = default;
 
+	/**
+	 * Components are allocated from the object pool for their size, so they can be referenced with a {@link Handle}.
+	 * @param size The component size in bytes.
+	 * @return The components memory.
+	 */
+	static void *operator new(std::size_t size) { return ObjectPool::Get(size)->Allocate(); }
+
+	static void operator delete(void *component) { ObjectPool::Free(component); }
+
 	/**
 	 * Run when starting the component if {@link Component#m_started} is false.
 	 */
@@ -36,6 +46,13 @@ public:
 	{
 	}
 
+	/**
+	 * Run on a component copied from a prefab template, used to reset state that must start fresh for every instance, like timers.
+	 */
+	virtual void OnClone()
+	{
+	}
+
 	/**
 	 * Used to decode this component from a loaded data format.
 	 * @param metadata The metadata to decode from.
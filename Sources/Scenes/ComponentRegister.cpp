@@ -9,6 +9,7 @@
 #include "Materials/MaterialDefault.hpp"
 #include "Meshes/Mesh.hpp"
 #include "Meshes/MeshRender.hpp"
+#include "Network/Netcode/Replicated.hpp"
 #include "Particles/ParticleSystem.hpp"
 #include "Physics/Colliders/ColliderCapsule.hpp"
 #include "Physics/Colliders/ColliderCone.hpp"
@@ -45,6 +46,7 @@ ComponentRegister::ComponentRegister()
 	Add<MeshAnimated>("MeshAnimated");
 	Add<MeshRender>("MeshRender");
 	Add<ParticleSystem>("ParticleSystem");
+	Add<Replicated>("Replicated");
 	Add<Rigidbody>("Rigidbody");
 	Add<ShadowRender>("ShadowRender");
 }
@@ -54,7 +56,7 @@ void ComponentRegister::Remove(const std::string &name)
 	m_components.erase(name);
 }
 
-Component *ComponentRegister::Create(const std::string &name) const
+const ComponentRegister::ComponentCreate *ComponentRegister::Find(const std::string &name) const
 {
 	auto it = m_components.find(name);
 
@@ -64,7 +66,19 @@ Component *ComponentRegister::Create(const std::string &name) const
 		return nullptr;
 	}
 
-	return ((*it).second).m_create();
+	return &(*it).second;
+}
+
+Component *ComponentRegister::Create(const std::string &name) const
+{
+	auto componentCreate = Find(name);
+
+	if (componentCreate == nullptr)
+	{
+		return nullptr;
+	}
+
+	return componentCreate->m_create();
 }
 
 std::optional<std::string> ComponentRegister::FindName(Component *compare) const
@@ -27,6 +27,9 @@ public:
 			return;
 		}
 
+		// Creates the pool components of this type are allocated from.
+		ObjectPool::Get<T>();
+
 		ComponentCreate componentCreate;
 		componentCreate.m_create = []()
 		{
@@ -37,6 +40,17 @@ public:
 			return dynamic_cast<T *>(component) != nullptr; // TODO: Ignore type inheritance
 		};
 
+		// Types that own resources by raw pointer must delete their copy constructor, so prefabs decode them for every entity.
+		if constexpr (std::is_copy_constructible_v<T>)
+		{
+			componentCreate.m_clone = [](const Component *component)
+			{
+				auto clone = new T(*static_cast<const T *>(component));
+				clone->OnClone();
+				return clone;
+			};
+		}
+
 		m_components.emplace(name, componentCreate);
 	}
 
@@ -46,6 +60,24 @@ public:
 	 */
 	void Remove(const std::string &name);
 
+	/**
+	 * The functions registered for a component type.
+	 */
+	struct ComponentCreate
+	{
+		std::function<Component *()> m_create;
+		std::function<bool(Component *)> m_isSame;
+		/// Copies a component of this type, empty if the type can't be copied.
+		std::function<Component *(const Component *)> m_clone;
+	};
+
+	/**
+	 * Finds the functions registered to a component name.
+	 * @param name The component name to find.
+	 * @return The registered functions, or null if the name is not registered.
+	 */
+	const ComponentCreate *Find(const std::string &name) const;
+
 	/**
 	 * Creates a new component from the register.
 	 * @param name The component name to create.
@@ -61,12 +93,6 @@ public:
 	std::optional<std::string> FindName(Component *compare) const;
 
 private:
-	struct ComponentCreate
-	{
-		std::function<Component *()> m_create;
-		std::function<bool(Component *)> m_isSame;
-	};
-
 	std::map<std::string, ComponentCreate> m_components;
 };
 }
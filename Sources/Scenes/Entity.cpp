@@ -1,6 +1,6 @@
 #include "Entity.hpp"
 
-#include "Files/FileSystem.hpp"
+#include <mutex>
 #include "Scenes.hpp"
 #include "EntityPrefab.hpp"
 
@@ -9,6 +9,8 @@ namespace acid
 Entity::Entity(const Transform &transform) :
 	m_name(""),
 	m_localTransform(transform),
+	m_snapshot(0),
+	m_snapshotted(false),
 	m_parent(nullptr),
 	m_removed(false)
 {
@@ -17,27 +19,7 @@ Entity::Entity(const Transform &transform) :
 Entity::Entity(const std::string &filename, const Transform &transform) :
 	Entity(transform)
 {
-	auto prefabObject = EntityPrefab::Create(filename);
-
-	for (const auto &child : prefabObject->GetParent()->GetChildren())
-	{
-		if (child->GetName().empty())
-		{
-			continue;
-		}
-
-		auto component = Scenes::Get()->GetComponentRegister().Create(child->GetName());
-
-		if (component == nullptr)
-		{
-			continue;
-		}
-
-		component->Decode(*child);
-		AddComponent(component);
-	}
-
-	m_name = FileSystem::FileName(filename);
+	EntityPrefab::Create(filename)->Instantiate(*this);
 }
 
 Entity::~Entity()
@@ -55,6 +37,7 @@ void Entity::Update()
 		if ((*it)->IsRemoved())
 		{
 			it = m_components.erase(it);
+			ClearComponentCache();
 			continue;
 		}
 
@@ -87,6 +70,7 @@ Component *Entity::AddComponent(Component *component)
 
 	component->SetParent(this);
 	m_components.emplace_back(component);
+	ClearComponentCache();
 	return component;
 }
 
@@ -96,6 +80,7 @@ void Entity::RemoveComponent(Component *component)
 	{
 		return c.get() == component;
 	}), m_components.end());
+	ClearComponentCache();
 }
 
 void Entity::RemoveComponent(const std::string &name)
@@ -105,6 +90,7 @@ void Entity::RemoveComponent(const std::string &name)
 		auto componentName = Scenes::Get()->GetComponentRegister().FindName(c.get());
 		return componentName && name == *componentName;
 	}), m_components.end());
+	ClearComponentCache();
 }
 
 Transform Entity::GetWorldTransform() const
@@ -136,6 +122,67 @@ Matrix4 Entity::GetWorldMatrix() const
 	return GetWorldTransform().GetWorldMatrix();
 }
 
+void Entity::StoreSnapshot()
+{
+	m_snapshot ^= 1;
+	m_snapshots[m_snapshot] = GetWorldTransform();
+
+	// New entities have no previous snapshot to blend from.
+	if (!m_snapshotted)
+	{
+		m_snapshots[m_snapshot ^ 1] = m_snapshots[m_snapshot];
+		m_snapshotted = true;
+	}
+}
+
+Matrix4 Entity::GetRenderMatrix() const
+{
+	if (!m_snapshotted)
+	{
+		return GetWorldMatrix();
+	}
+
+	const auto &previous = m_snapshots[m_snapshot ^ 1];
+	const auto &current = m_snapshots[m_snapshot];
+	auto alpha = Engine::Get()->GetAlpha();
+
+	if (alpha >= 1.0f || previous == current)
+	{
+		return current.GetWorldMatrix();
+	}
+
+	// Rotations are in degrees, and blend the short way around.
+	auto wrap = [](const float &angle)
+	{
+		return angle - 360.0f * std::round(angle / 360.0f);
+	};
+	auto rotation = current.GetRotation() - previous.GetRotation();
+	rotation = Vector3f(wrap(rotation.m_x), wrap(rotation.m_y), wrap(rotation.m_z));
+
+	return Matrix4::TransformationMatrix(previous.GetPosition().Lerp(current.GetPosition(), alpha), (previous.GetRotation() + rotation * alpha) * Maths::DegToRad,
+		previous.GetScaling().Lerp(current.GetScaling(), alpha));
+}
+
+uint32_t Entity::RegisterType(const std::type_index &type)
+{
+	// Types are registered here rather than by a counter in the header, so each type has one index across shared libraries.
+	static std::mutex mutex;
+	static std::unordered_map<std::type_index, uint32_t> typeIds;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return typeIds.emplace(type, static_cast<uint32_t>(typeIds.size())).first->second;
+}
+
+void Entity::ClearComponentCache()
+{
+	// Keeps each types list allocated, components are usually found again with the same count.
+	for (auto &cache : m_componentCache)
+	{
+		cache.m_resolved = false;
+		cache.m_components.clear();
+	}
+}
+
 void Entity::SetParent(Entity *parent)
 {
 	if (m_parent != nullptr)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <typeindex>
 #include "Helpers/NonCopyable.hpp"
 #include "Maths/Transform.hpp"
 #include "Component.hpp"
@@ -13,6 +14,59 @@ class ACID_EXPORT Entity :
 	public NonCopyable
 {
 public:
+	/**
+	 * @brief A view of the components of one type attached to an entity, it does not allocate.
+	 * @tparam T The component type.
+	 */
+	template<typename T>
+	class ComponentRange
+	{
+	public:
+		class Iterator
+		{
+		public:
+			explicit Iterator(void *const *component) :
+				m_component(component)
+			{
+			}
+
+			T *operator*() const { return static_cast<T *>(*m_component); }
+
+			Iterator &operator++()
+			{
+				++m_component;
+				return *this;
+			}
+
+			bool operator==(const Iterator &other) const { return m_component == other.m_component; }
+
+			bool operator!=(const Iterator &other) const { return m_component != other.m_component; }
+
+		private:
+			void *const *m_component;
+		};
+
+		ComponentRange(void *const *components, const std::size_t &size) :
+			m_components(components),
+			m_size(size)
+		{
+		}
+
+		Iterator begin() const { return Iterator(m_components); }
+
+		Iterator end() const { return Iterator(m_components + m_size); }
+
+		const std::size_t &size() const { return m_size; }
+
+		bool empty() const { return m_size == 0; }
+
+		T *operator[](const std::size_t &index) const { return static_cast<T *>(m_components[index]); }
+
+	private:
+		void *const *m_components;
+		std::size_t m_size;
+	};
+
 	/**
 	 * Creates a new entity and stores it into a structure.
 	 * @param transform The objects initial world position, rotation, and scale.
@@ -28,6 +82,15 @@ public:
 
 	~Entity();
 
+	/**
+	 * Entities are allocated from an object pool, so they can be referenced with a {@link Handle}.
+	 * @param size The entity size in bytes.
+	 * @return The entities memory.
+	 */
+	static void *operator new(std::size_t size) { return ObjectPool::Get(size)->Allocate(); }
+
+	static void operator delete(void *entity) { ObjectPool::Free(entity); }
+
 	void Update();
 
 	/**
@@ -43,7 +106,7 @@ public:
 	uint32_t GetComponentCount() const { return static_cast<uint32_t>(m_components.size()); }
 
 	/**
-	 * Gets a component by type.
+	 * Gets a component by type, the components found for a type are cached until components are added or removed.
 	 * @tparam T The component type to find.
 	 * @param allowDisabled If disabled components will be returned.
 	 * @return The found component.
@@ -53,53 +116,51 @@ public:
 	{
 		T *alternative = nullptr;
 
-		for (const auto &component : m_components)
+		for (auto component : GetComponents<T>())
 		{
-			auto casted = dynamic_cast<T *>(component.get());
-
-			if (casted != nullptr)
+			if (allowDisabled && !component->IsEnabled())
 			{
-				if (allowDisabled && !casted->IsEnabled())
-				{
-					alternative = casted;
-					continue;
-				}
-
-				return casted;
+				alternative = component;
+				continue;
 			}
+
+			return component;
 		}
 
 		return alternative;
 	}
 
 	/**
-	 * Gets components by type.
-	 * @tparam T The component type to find.
-	 * @param allowDisabled If disabled components will be returned.
+	 * Gets components by type, enabled or not. The range is valid until components are added or removed.
+	 * @tparam T The component type to find, this may be a base or sibling class of the components.
 	 * @return The components.
 	 */
 	template<typename T>
-	std::vector<T *> GetComponents(const bool &allowDisabled = false) const
+	ComponentRange<T> GetComponents() const
 	{
-		std::vector<T *> components;
+		auto typeId = GetTypeId<T>();
 
-		for (const auto &component : m_components)
+		if (typeId >= m_componentCache.size())
 		{
-			auto casted = dynamic_cast<T *>(component.get());
+			m_componentCache.resize(typeId + 1);
+		}
 
-			if (casted != nullptr)
+		auto &cache = m_componentCache[typeId];
+
+		if (!cache.m_resolved)
+		{
+			for (const auto &component : m_components)
 			{
-				if (allowDisabled && !casted->IsEnabled())
+				if (auto casted = dynamic_cast<T *>(component.get()))
 				{
-					components.emplace_back(casted);
-					continue;
+					cache.m_components.emplace_back(casted);
 				}
-
-				components.emplace_back(casted);
 			}
+
+			cache.m_resolved = true;
 		}
 
-		return components;
+		return ComponentRange<T>(cache.m_components.data(), cache.m_components.size());
 	}
 
 	/**
@@ -143,16 +204,11 @@ public:
 	template<typename T>
 	void RemoveComponent()
 	{
-		for (auto it = m_components.begin(); it != m_components.end(); ++it)
+		m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [](std::unique_ptr<Component> &component)
 		{
-			auto casted = dynamic_cast<T *>((*it).get());
-
-			if (casted != nullptr)
-			{
-				(*it)->SetParent(nullptr);
-				m_components.erase(it);
-			}
-		}
+			return dynamic_cast<T *>(component.get()) != nullptr;
+		}), m_components.end());
+		ClearComponentCache();
 	}
 
 	const std::string GetName() const { return m_name; }
@@ -167,6 +223,18 @@ public:
 
 	Matrix4 GetWorldMatrix() const;
 
+	/**
+	 * Stores the world transform as the current snapshot, the last current snapshot becomes the previous one.
+	 * Called after each update so renders can blend between the last two.
+	 */
+	void StoreSnapshot();
+
+	/**
+	 * Gets the world matrix to render with, blended between the previous and current snapshot by the engines alpha.
+	 * @return The interpolated world matrix.
+	 */
+	Matrix4 GetRenderMatrix() const;
+
 	const bool &IsRemoved() const { return m_removed; }
 
 	void SetRemoved(const bool &removed) { m_removed = removed; }
@@ -182,10 +250,37 @@ public:
 	void RemoveChild(Entity *child);
 
 private:
+	struct ComponentCache
+	{
+		bool m_resolved = false;
+		std::vector<void *> m_components;
+	};
+
+	/**
+	 * Gets the index of a component type in the component cache, assigned the first time the type is looked up.
+	 * @tparam T The component type.
+	 * @return The type index.
+	 */
+	template<typename T>
+	static uint32_t GetTypeId()
+	{
+		static const auto typeId = RegisterType(typeid(T));
+		return typeId;
+	}
+
+	static uint32_t RegisterType(const std::type_index &type);
+
+	void ClearComponentCache();
+
 	std::string m_name;
 	Transform m_localTransform;
 	mutable Transform m_worldTransform;
+	Transform m_snapshots[2];
+	uint32_t m_snapshot;
+	bool m_snapshotted;
 	std::vector<std::unique_ptr<Component>> m_components;
+	/// The components found for each type looked up, indexed by {@link Entity#GetTypeId}.
+	mutable std::vector<ComponentCache> m_componentCache;
 	Entity *m_parent;
 	std::vector<Entity *> m_children;
 	bool m_removed;
@@ -1,5 +1,6 @@
 #include "EntityPrefab.hpp"
 
+#include "Engine/Profiler.hpp"
 #include "Files/File.hpp"
 #include "Serialized/Json/Json.hpp"
 #include "Serialized/Xml/Xml.hpp"
@@ -37,7 +38,8 @@ std::shared_ptr<EntityPrefab> EntityPrefab::Create(const std::string &filename)
 
 EntityPrefab::EntityPrefab(std::string filename, const bool &load) :
 	m_filename(std::move(filename)),
-	m_file(nullptr)
+	m_file(nullptr),
+	m_compiled(false)
 {
 	if (load)
 	{
@@ -47,6 +49,10 @@ EntityPrefab::EntityPrefab(std::string filename, const bool &load) :
 
 void EntityPrefab::Load()
 {
+	ACID_PROFILE_ZONE("EntityPrefab::Load");
+
+	ClearTemplates();
+
 	if (m_filename.empty())
 	{
 		return;
@@ -83,8 +89,43 @@ void EntityPrefab::Encode(Metadata &metadata) const
 	metadata.SetChild("Filename", m_filename);
 }
 
+void EntityPrefab::Compile(const ComponentRegister &componentRegister)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	CompileTemplates(componentRegister);
+}
+
+void EntityPrefab::Instantiate(Entity &entity)
+{
+	if (!m_compiled.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_compiled.load(std::memory_order_relaxed))
+		{
+			CompileTemplates(Scenes::Get()->GetComponentRegister());
+		}
+	}
+
+	for (const auto &componentTemplate : m_templates)
+	{
+		if (componentTemplate.m_prototype != nullptr)
+		{
+			entity.AddComponent(componentTemplate.m_create.m_clone(componentTemplate.m_prototype.get()));
+			continue;
+		}
+
+		auto component = componentTemplate.m_create.m_create();
+		component->Decode(*componentTemplate.m_metadata);
+		entity.AddComponent(component);
+	}
+
+	entity.SetName(m_name);
+}
+
 void EntityPrefab::Write(const Entity &entity)
 {
+	ClearTemplates();
 	m_file->GetMetadata()->ClearChildren();
 
 	for (const auto &component : entity.GetComponents())
@@ -106,4 +147,49 @@ void EntityPrefab::Save()
 {
 	m_file->Write();
 }
+
+void EntityPrefab::CompileTemplates(const ComponentRegister &componentRegister)
+{
+	ACID_PROFILE_ZONE("EntityPrefab::Compile");
+
+	m_templates.clear();
+	m_name = FileSystem::FileName(m_filename);
+
+	if (m_file != nullptr)
+	{
+		for (const auto &child : m_file->GetMetadata()->GetChildren())
+		{
+			if (child->GetName().empty())
+			{
+				continue;
+			}
+
+			auto componentCreate = componentRegister.Find(child->GetName());
+
+			if (componentCreate == nullptr)
+			{
+				continue;
+			}
+
+			ComponentTemplate componentTemplate = { *componentCreate, nullptr, child.get() };
+
+			if (componentCreate->m_clone)
+			{
+				componentTemplate.m_prototype.reset(componentCreate->m_create());
+				componentTemplate.m_prototype->Decode(*child);
+			}
+
+			m_templates.emplace_back(std::move(componentTemplate));
+		}
+	}
+
+	m_compiled.store(true, std::memory_order_release);
+}
+
+void EntityPrefab::ClearTemplates()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_templates.clear();
+	m_compiled.store(false, std::memory_order_release);
+}
 }
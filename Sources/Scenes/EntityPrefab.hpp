@@ -2,6 +2,7 @@
 
 #include "Files/File.hpp"
 #include "Resources/Resource.hpp"
+#include "ComponentRegister.hpp"
 
 namespace acid
 {
@@ -9,6 +10,9 @@ class Entity;
 
 /**
  * @brief Resource that represents a entity prefab.
+ *
+ * The prefab is compiled into component templates the first time it is instantiated.
+ * Components that can be copied are decoded once and copied into each entity, others are decoded from the metadata for each entity.
  */
 class ACID_EXPORT EntityPrefab :
 	public Resource
@@ -41,6 +45,19 @@ public:
 
 	void Encode(Metadata &metadata) const override;
 
+	/**
+	 * Compiles this prefab into component templates, replacing any compiled before.
+	 * Instantiating compiles with the scenes component register if this was not called, this must not be called while instantiating.
+	 * @param componentRegister The register to create components from.
+	 */
+	void Compile(const ComponentRegister &componentRegister);
+
+	/**
+	 * Adds this prefabs components to an entity and names it after the prefab file.
+	 * @param entity The entity to add components to.
+	 */
+	void Instantiate(Entity &entity);
+
 	void Write(const Entity &entity);
 
 	void Save();
@@ -50,7 +67,23 @@ public:
 	Metadata *GetParent() const { return m_file->GetMetadata(); }
 
 private:
+	struct ComponentTemplate
+	{
+		ComponentRegister::ComponentCreate m_create;
+		/// The component decoded once to be copied, null if the type can't be copied.
+		std::unique_ptr<Component> m_prototype;
+		const Metadata *m_metadata;
+	};
+
+	void CompileTemplates(const ComponentRegister &componentRegister);
+
+	void ClearTemplates();
+
 	std::string m_filename;
 	std::unique_ptr<File> m_file;
+	std::string m_name;
+	std::mutex m_mutex;
+	std::atomic<bool> m_compiled;
+	std::vector<ComponentTemplate> m_templates;
 };
 }
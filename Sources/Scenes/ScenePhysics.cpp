@@ -5,12 +5,15 @@
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
 #include <LinearMath/btAlignedObjectArray.h>
 #include "Engine/Engine.hpp"
+#include "Engine/Profiler.hpp"
+#include "Helpers/ThreadPool.hpp"
 #include "Physics/Colliders/Collider.hpp"
 #include "Physics/CollisionObject.hpp"
 
@@ -59,7 +62,13 @@ ScenePhysics::~ScenePhysics()
 
 void ScenePhysics::Update()
 {
-	m_dynamicsWorld->stepSimulation(Engine::Get()->GetDelta().AsSeconds());
+	ACID_PROFILE_ZONE("ScenePhysics::Update");
+
+	{
+		ACID_PROFILE_ZONE("stepSimulation");
+		m_dynamicsWorld->stepSimulation(Engine::Get()->GetDelta().AsSeconds());
+	}
+
 	CheckForCollisionEvents();
 }
 
@@ -74,6 +83,105 @@ Raycast ScenePhysics::Raytest(const Vector3f &start, const Vector3f &end)
 		result.m_collisionObject != nullptr ? static_cast<CollisionObject *>(result.m_collisionObject->getUserPointer()) : nullptr);
 }
 
+void ScenePhysics::RaytestBatch(const RayQuery *rays, Raycast *results, std::size_t count)
+{
+	auto collisionWorld = m_dynamicsWorld->getCollisionWorld();
+
+	// btDbvtBroadphase::rayTest uses a single traversal stack without BT_THREADSAFE, so rays can't be split across threads.
+	for (std::size_t i = 0; i < count; i++)
+	{
+		// Converts inline, this avoids a call per vector through Collider::Convert.
+		btVector3 startBt(rays[i].m_start.m_x, rays[i].m_start.m_y, rays[i].m_start.m_z);
+		btVector3 endBt(rays[i].m_end.m_x, rays[i].m_end.m_y, rays[i].m_end.m_z);
+		btCollisionWorld::ClosestRayResultCallback result(startBt, endBt);
+		collisionWorld->rayTest(startBt, endBt, result);
+
+		results[i] = Raycast(result.hasHit(), Vector3f(result.m_hitPointWorld.x(), result.m_hitPointWorld.y(), result.m_hitPointWorld.z()),
+			result.m_collisionObject != nullptr ? static_cast<CollisionObject *>(result.m_collisionObject->getUserPointer()) : nullptr);
+	}
+}
+
+void ScenePhysics::SweepTestBatch(const SweepQuery *sweeps, Raycast *results, std::size_t count)
+{
+	auto collisionWorld = m_dynamicsWorld->getCollisionWorld();
+
+	// Convex sweeps traverse the broadphase through rayTest, so they share its stack too.
+	for (std::size_t i = 0; i < count; i++)
+	{
+		btSphereShape shape(sweeps[i].m_radius);
+		btTransform from(btQuaternion::getIdentity(), btVector3(sweeps[i].m_start.m_x, sweeps[i].m_start.m_y, sweeps[i].m_start.m_z));
+		btTransform to(btQuaternion::getIdentity(), btVector3(sweeps[i].m_end.m_x, sweeps[i].m_end.m_y, sweeps[i].m_end.m_z));
+		btCollisionWorld::ClosestConvexResultCallback result(from.getOrigin(), to.getOrigin());
+		collisionWorld->convexSweepTest(&shape, from, to, result);
+
+		if (!result.hasHit())
+		{
+			results[i] = Raycast();
+			continue;
+		}
+
+		auto center = sweeps[i].m_start.Lerp(sweeps[i].m_end, result.m_closestHitFraction);
+		results[i] = Raycast(true, center, static_cast<CollisionObject *>(result.m_hitCollisionObject->getUserPointer()));
+	}
+}
+
+void ScenePhysics::OverlapTestBatch(const OverlapQuery *overlaps, CollisionObject **results, uint32_t *resultCounts, std::size_t count, uint32_t maxResults)
+{
+	class OverlapCallback :
+		public btBroadphaseAabbCallback
+	{
+	public:
+		OverlapCallback(const btVector3 &center, const btScalar &radius, CollisionObject **results, const uint32_t &maxResults) :
+			m_center(center),
+			m_radius2(radius * radius),
+			m_results(results),
+			m_maxResults(maxResults),
+			m_count(0)
+		{
+		}
+
+		bool process(const btBroadphaseProxy *proxy) override
+		{
+			// Closest point on the proxy bounds to the sphere center.
+			auto closest = m_center;
+			closest.setMax(proxy->m_aabbMin);
+			closest.setMin(proxy->m_aabbMax);
+
+			// The broadphase ignores the returned value and keeps visiting, so hits past the limit are dropped here.
+			if (m_count < m_maxResults && closest.distance2(m_center) <= m_radius2)
+			{
+				m_results[m_count++] = static_cast<CollisionObject *>(static_cast<btCollisionObject *>(proxy->m_clientObject)->getUserPointer());
+			}
+
+			return m_count < m_maxResults;
+		}
+
+		const uint32_t &GetCount() const { return m_count; }
+
+	private:
+		btVector3 m_center;
+		btScalar m_radius2;
+		CollisionObject **m_results;
+		uint32_t m_maxResults;
+		uint32_t m_count;
+	};
+
+	ParallelFor(count, [&](std::size_t i)
+	{
+		if (maxResults == 0)
+		{
+			resultCounts[i] = 0;
+			return;
+		}
+
+		btVector3 center(overlaps[i].m_position.m_x, overlaps[i].m_position.m_y, overlaps[i].m_position.m_z);
+		btVector3 extent(overlaps[i].m_radius, overlaps[i].m_radius, overlaps[i].m_radius);
+		OverlapCallback callback(center, overlaps[i].m_radius, results + i * maxResults, maxResults);
+		m_broadphase->aabbTest(center - extent, center + extent, callback);
+		resultCounts[i] = callback.GetCount();
+	});
+}
+
 void ScenePhysics::SetGravity(const Vector3f &gravity)
 {
 	m_gravity = gravity;
@@ -88,10 +196,63 @@ void ScenePhysics::SetAirDensity(const float &airDensity)
 	softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
 }
 
+template<typename F>
+void ScenePhysics::ParallelFor(const std::size_t &count, const F &function)
+{
+	// Small batches are cheaper to run on the calling thread than to hand off.
+	static const std::size_t MinBatchSize = 64;
+
+	if (count < 2 * MinBatchSize)
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			function(i);
+		}
+
+		return;
+	}
+
+	if (m_queryPool == nullptr)
+	{
+		m_queryPool = std::make_unique<ThreadPool>();
+	}
+
+	auto chunkCount = std::min(count / MinBatchSize, m_queryPool->GetWorkers().size() + 1);
+	auto chunkSize = (count + chunkCount - 1) / chunkCount;
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(chunkCount - 1);
+
+	for (std::size_t chunk = 1; chunk < chunkCount; chunk++)
+	{
+		futures.emplace_back(m_queryPool->Enqueue([&function, chunk, chunkSize, count]()
+		{
+			for (std::size_t i = chunk * chunkSize; i < std::min(count, (chunk + 1) * chunkSize); i++)
+			{
+				function(i);
+			}
+		}));
+	}
+
+	// The first chunk is run on the calling thread while the pool works on the rest.
+	for (std::size_t i = 0; i < std::min(count, chunkSize); i++)
+	{
+		function(i);
+	}
+
+	for (auto &future : futures)
+	{
+		future.get();
+	}
+}
+
 void ScenePhysics::CheckForCollisionEvents()
 {
-	// Keep a list of the collision pairs found during the current update.
-	CollisionPairs pairsThisUpdate;
+	// The pair and event lists are members that keep their capacity, so after the first few updates no allocations are made here.
+	m_pairsThisUpdate.clear();
+	m_eventsBegan.clear();
+	m_eventsStayed.clear();
+	m_eventsEnded.clear();
 
 	// Iterate through all of the manifolds in the dispatcher.
 	for (int32_t i = 0; i < m_dispatcher->getNumManifolds(); ++i)
@@ -111,44 +272,56 @@ void ScenePhysics::CheckForCollisionEvents()
 
 		// Always create the pair in a predictable order (use the pointer value..).
 		const bool swapped = body0 > body1;
-		const auto sortedBodyA = swapped ? body1 : body0;
-		const auto sortedBodyB = swapped ? body0 : body1;
+		m_pairsThisUpdate.emplace_back(swapped ? body1 : body0, swapped ? body0 : body1);
+	}
 
-		// Create the pair.
-		auto thisPair = std::make_pair(sortedBodyA, sortedBodyB);
+	// Sorts the pairs found this update, a pair of bodies may share more than one manifold so duplicates are removed.
+	std::sort(m_pairsThisUpdate.begin(), m_pairsThisUpdate.end());
+	m_pairsThisUpdate.erase(std::unique(m_pairsThisUpdate.begin(), m_pairsThisUpdate.end()), m_pairsThisUpdate.end());
 
-		// Insert the pair into the current list.
-		pairsThisUpdate.insert(thisPair);
+	auto toEvent = [](const CollisionPair &pair)
+	{
+		// Gets the user pointer (entity).
+		return std::make_pair(static_cast<CollisionObject *>(pair.first->getUserPointer()), static_cast<CollisionObject *>(pair.second->getUserPointer()));
+	};
 
-		// If this pair doesn't exist in the list from the previous update, it is a new pair and we must send a collision event.
-		if (m_pairsLastUpdate.find(thisPair) == m_pairsLastUpdate.end())
-		{
-			// Gets the user pointer (entity).
-			auto collisionObjectA = static_cast<CollisionObject *>(sortedBodyA->getUserPointer());
-			auto collisionObjectB = static_cast<CollisionObject *>(sortedBodyB->getUserPointer());
+	// Both lists are sorted, so a single merge walk splits the pairs into began, stayed and ended batches.
+	auto last = m_pairsLastUpdate.begin();
+	auto current = m_pairsThisUpdate.begin();
 
-			collisionObjectA->OnCollision()(collisionObjectB);
+	while (last != m_pairsLastUpdate.end() || current != m_pairsThisUpdate.end())
+	{
+		if (last == m_pairsLastUpdate.end() || (current != m_pairsThisUpdate.end() && *current < *last))
+		{
+			m_eventsBegan.emplace_back(toEvent(*current++));
+		}
+		else if (current == m_pairsThisUpdate.end() || *last < *current)
+		{
+			m_eventsEnded.emplace_back(toEvent(*last++));
+		}
+		else
+		{
+			m_eventsStayed.emplace_back(toEvent(*current));
+			++last;
+			++current;
 		}
 	}
 
-	// Creates another list for pairs that were removed this update.
-	CollisionPairs removedPairs;
+	// Delivers the batches to scene wide listeners with a single invocation.
+	m_onCollisionEvents(m_eventsBegan, m_eventsStayed, m_eventsEnded);
 
-	// This handy function gets the difference between two sets. It takes the difference between collision pairs from the last update,
-	// and this update and pushes them into the removed pairs list.
-	std::set_difference(m_pairsLastUpdate.begin(), m_pairsLastUpdate.end(), pairsThisUpdate.begin(), pairsThisUpdate.end(), std::inserter(removedPairs, removedPairs.begin()));
-
-	// Iterate through all of the removed pairs sending separation events for them.
-	for (const auto &removedPair : removedPairs)
+	// Only pairs that began or ended are sent to the per object delegates.
+	for (const auto &[collisionObjectA, collisionObjectB] : m_eventsBegan)
 	{
-		// Gets the user pointer (entity).
-		auto collisionObjectA = static_cast<CollisionObject *>(removedPair.first->getUserPointer());
-		auto collisionObjectB = static_cast<CollisionObject *>(removedPair.second->getUserPointer());
+		collisionObjectA->OnCollision()(collisionObjectB);
+	}
 
+	for (const auto &[collisionObjectA, collisionObjectB] : m_eventsEnded)
+	{
 		collisionObjectA->OnSeparation()(collisionObjectB);
 	}
 
-	// In the next iteration we'll want to compare against the pairs we found in this iteration.
-	m_pairsLastUpdate = pairsThisUpdate;
+	// In the next iteration we'll want to compare against the pairs we found in this iteration, swapping keeps both buffers allocated.
+	std::swap(m_pairsLastUpdate, m_pairsThisUpdate);
 }
 }
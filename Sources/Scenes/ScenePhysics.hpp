@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Helpers/Delegate.hpp"
 #include "Maths/Vector3.hpp"
 
 class btCollisionObject;
@@ -16,13 +17,21 @@ namespace acid
 {
 class Entity;
 class CollisionObject;
+class ThreadPool;
 
 using CollisionPair = std::pair<const btCollisionObject *, const btCollisionObject *>;
-using CollisionPairs = std::set<CollisionPair>;
+using CollisionPairs = std::vector<CollisionPair>;
+using CollisionEvents = std::vector<std::pair<CollisionObject *, CollisionObject *>>;
 
 class ACID_EXPORT Raycast
 {
 public:
+	Raycast() :
+		m_hasHit(false),
+		m_collisionObject(nullptr)
+	{
+	}
+
 	Raycast(bool m_hasHit, const Vector3f &m_pointWorld, CollisionObject *collisionObject) :
 		m_hasHit(m_hasHit),
 		m_pointWorld(m_pointWorld),
@@ -42,6 +51,34 @@ private:
 	CollisionObject *m_collisionObject;
 };
 
+/**
+ * @brief A ray from start to end, used in batched queries.
+ */
+struct RayQuery
+{
+	Vector3f m_start;
+	Vector3f m_end;
+};
+
+/**
+ * @brief A sphere swept from start to end, used in batched queries.
+ */
+struct SweepQuery
+{
+	Vector3f m_start;
+	Vector3f m_end;
+	float m_radius;
+};
+
+/**
+ * @brief A sphere tested for overlaps against the broadphase, used in batched queries.
+ */
+struct OverlapQuery
+{
+	Vector3f m_position;
+	float m_radius;
+};
+
 class ACID_EXPORT ScenePhysics
 {
 public:
@@ -51,8 +88,39 @@ public:
 
 	void Update();
 
+	/**
+	 * Compares the contacts found by the last step against the previous update and sends the collision events, called by update after stepping.
+	 */
+	void CheckForCollisionEvents();
+
 	Raycast Raytest(const Vector3f &start, const Vector3f &end);
 
+	/**
+	 * Casts a batch of rays on the calling thread, the broadphase ray traversal shares one stack unless Bullet is built thread safe.
+	 * @param rays The rays to cast.
+	 * @param results The caller provided results, must hold at least count elements.
+	 * @param count The number of rays.
+	 */
+	void RaytestBatch(const RayQuery *rays, Raycast *results, std::size_t count);
+
+	/**
+	 * Sweeps a batch of spheres on the calling thread, sweeps use the same broadphase traversal as rays.
+	 * @param sweeps The sweeps to test.
+	 * @param results The caller provided results, must hold at least count elements. The hit point is the sphere center at the first hit.
+	 * @param count The number of sweeps.
+	 */
+	void SweepTestBatch(const SweepQuery *sweeps, Raycast *results, std::size_t count);
+
+	/**
+	 * Tests a batch of spheres for overlapping objects in the broadphase, splitting large batches across the physics query threads.
+	 * @param overlaps The spheres to test.
+	 * @param results The caller provided results, query i writes its objects starting at results[i * maxResults].
+	 * @param resultCounts The caller provided number of objects found for each query, must hold at least count elements.
+	 * @param count The number of spheres.
+	 * @param maxResults The maximum number of objects written for each query.
+	 */
+	void OverlapTestBatch(const OverlapQuery *overlaps, CollisionObject **results, uint32_t *resultCounts, std::size_t count, uint32_t maxResults);
+
 	const Vector3f &GetGravity() const { return m_gravity; }
 
 	void SetGravity(const Vector3f &gravity);
@@ -61,6 +129,13 @@ public:
 
 	void SetAirDensity(const float &airDensity);
 
+	/**
+	 * Called once per update with the batches of collision pairs that began, stayed and ended during the update.
+	 * The batches are reused between updates, so they must be copied if they are needed after the call.
+	 * @return The delegate.
+	 */
+	Delegate<void(const CollisionEvents &, const CollisionEvents &, const CollisionEvents &)> &OnCollisionEvents() { return m_onCollisionEvents; }
+
 	btBroadphaseInterface *GetBroadphase() { return m_broadphase.get(); }
 
 	btDiscreteDynamicsWorld *GetDynamicsWorld() { return m_dynamicsWorld.get(); }
@@ -68,7 +143,8 @@ public:
 	btAlignedObjectArray<btCollisionShape *> *GetCollisionShapes() { return m_collisionShapes.get(); }
 
 private:
-	void CheckForCollisionEvents();
+	template<typename F>
+	void ParallelFor(const std::size_t &count, const F &function);
 
 	std::unique_ptr<btCollisionConfiguration> m_collisionConfiguration;
 	std::unique_ptr<btBroadphaseInterface> m_broadphase;
@@ -76,7 +152,14 @@ private:
 	std::unique_ptr<btConstraintSolver> m_solver;
 	std::unique_ptr<btDiscreteDynamicsWorld> m_dynamicsWorld;
 	std::unique_ptr<btAlignedObjectArray<btCollisionShape *>> m_collisionShapes;
+	std::unique_ptr<ThreadPool> m_queryPool;
+	CollisionPairs m_pairsThisUpdate;
 	CollisionPairs m_pairsLastUpdate;
+	CollisionEvents m_eventsBegan;
+	CollisionEvents m_eventsStayed;
+	CollisionEvents m_eventsEnded;
+
+	Delegate<void(const CollisionEvents &, const CollisionEvents &, const CollisionEvents &)> m_onCollisionEvents;
 
 	Vector3f m_gravity;
 	float m_airDensity;
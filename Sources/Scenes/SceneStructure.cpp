@@ -1,6 +1,7 @@
 ﻿#include "SceneStructure.hpp"
 
 #include "Physics/Rigidbody.hpp"
+#include "EntityPrefab.hpp"
 
 namespace acid
 {
@@ -22,6 +23,35 @@ Entity *SceneStructure::CreateEntity(const std::string &filename, const Transfor
 	return entity;
 }
 
+Entity *SceneStructure::Instantiate(EntityPrefab &prefab, const Transform &transform)
+{
+	auto entity = new Entity(transform);
+	m_objects.emplace_back(entity);
+	prefab.Instantiate(*entity);
+	return entity;
+}
+
+std::vector<Entity *> SceneStructure::Instantiate(EntityPrefab &prefab, const std::vector<Transform> &transforms)
+{
+	std::vector<Entity *> entities;
+	entities.reserve(transforms.size());
+	// Keep geometric growth, reserving the exact size would reallocate on every batch.
+	if (m_objects.size() + transforms.size() > m_objects.capacity())
+	{
+		m_objects.reserve(std::max(m_objects.size() + transforms.size(), 2 * m_objects.capacity()));
+	}
+
+	for (const auto &transform : transforms)
+	{
+		auto entity = new Entity(transform);
+		m_objects.emplace_back(entity);
+		prefab.Instantiate(*entity);
+		entities.emplace_back(entity);
+	}
+
+	return entities;
+}
+
 void SceneStructure::Add(Entity *object)
 {
 	m_objects.emplace_back(object);
@@ -74,6 +104,14 @@ void SceneStructure::Update()
 	}
 }
 
+void SceneStructure::StoreSnapshots()
+{
+	for (const auto &object : m_objects)
+	{
+		object->StoreSnapshot();
+	}
+}
+
 std::vector<Entity *> SceneStructure::QueryAll()
 {
 	std::vector<Entity *> entities;
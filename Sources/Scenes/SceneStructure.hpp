@@ -1,10 +1,13 @@
 ﻿#pragma once
 
+#include "Engine/FrameAllocator.hpp"
 #include "Physics/Rigidbody.hpp"
 #include "Entity.hpp"
 
 namespace acid
 {
+class EntityPrefab;
+
 /**
  * @brief Class that represents a  structure of spatial objects.
  */
@@ -29,6 +32,22 @@ public:
 	 */
 	Entity *CreateEntity(const std::string &filename, const Transform &transform);
 
+	/**
+	 * Creates a new entity from a compiled prefab that starts in this structure.
+	 * @param prefab The prefab to copy components from.
+	 * @param transform The objects initial world position, rotation, and scale.
+	 * @return The newly created entity.
+	 */
+	Entity *Instantiate(EntityPrefab &prefab, const Transform &transform);
+
+	/**
+	 * Creates a batch of entities from a compiled prefab that start in this structure, as when spawning a wave.
+	 * @param prefab The prefab to copy components from.
+	 * @param transforms The initial world transform of each entity.
+	 * @return The newly created entities, in the order of the transforms.
+	 */
+	std::vector<Entity *> Instantiate(EntityPrefab &prefab, const std::vector<Transform> &transforms);
+
 	/**
 	 * Adds a new object to the spatial structure.
 	 * @param object The object to add.
@@ -64,6 +83,11 @@ public:
 	 */
 	void Update();
 
+	/**
+	 * Stores a snapshot of every entities world transform, called after each update.
+	 */
+	void StoreSnapshots();
+
 	/**
 	 * Gets the size of this structure.
 	 * @return The structures size.
@@ -91,18 +115,19 @@ public:
 	 * Returns a set of all components of a type in the spatial structure.
 	 * @tparam T The components type to get.
 	 * @param allowDisabled If disabled components will be included in this query.
+	 * @param resource The memory the list is allocated from, {@link FrameAllocator#Get} for lists used only this frame.
 	 * @return The list specified by of all components that match the type.
 	 */
 	template<typename T>
-	std::vector<T *> QueryComponents(const bool &allowDisabled = false)
+	FrameAllocator::Vector<T *> QueryComponents(const bool &allowDisabled = false, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
 	{
-		std::vector<T *> components;
+		FrameAllocator::Vector<T *> components(resource);
 
-		for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+		for (const auto &object : m_objects)
 		{
-			for (const auto &component : (*it)->GetComponents<T>())
+			for (auto component : object->GetComponents<T>())
 			{
-				if (component != nullptr && (component->IsEnabled() || allowDisabled))
+				if (component->IsEnabled() || allowDisabled)
 				{
 					components.emplace_back(component);
 				}
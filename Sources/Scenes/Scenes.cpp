@@ -26,11 +26,13 @@ void Scenes::Update()
 	if (m_scene->GetStructure() != nullptr)
 	{
 		m_scene->GetStructure()->Update();
+		m_scene->GetStructure()->StoreSnapshots();
 	}
 
 	if (m_scene->GetCamera() != nullptr)
 	{
 		m_scene->GetCamera()->Update();
+		m_scene->GetCamera()->StoreSnapshot();
 	}
 }
 }
@@ -20,7 +20,7 @@ void RendererShadows::Render(const CommandBuffer &commandBuffer)
 
 	m_pipeline.BindPipeline(commandBuffer);
 
-	auto sceneShadowRenders = Scenes::Get()->GetStructure()->QueryComponents<ShadowRender>();
+	auto sceneShadowRenders = Scenes::Get()->GetStructure()->QueryComponents<ShadowRender>(false, FrameAllocator::Get());
 
 	for (const auto &shadowRender : sceneShadowRenders)
 	{
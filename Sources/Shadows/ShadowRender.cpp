@@ -29,7 +29,7 @@ void ShadowRender::Encode(Metadata &metadata) const
 bool ShadowRender::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline)
 {
 	// Update push constants.
-	m_pushObject.Push("mvp", Shadows::Get()->GetShadowBox().GetProjectionViewMatrix() * GetParent()->GetWorldMatrix());
+	m_pushObject.Push("mvp", Shadows::Get()->GetShadowBox().GetProjectionViewMatrix() * GetParent()->GetRenderMatrix());
 
 	// Gets required components.
 	auto mesh = GetParent()->GetComponent<Mesh>();
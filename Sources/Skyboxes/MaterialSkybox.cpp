@@ -38,7 +38,7 @@ void MaterialSkybox::Encode(Metadata &metadata) const
 
 void MaterialSkybox::PushUniforms(UniformHandler &uniformObject)
 {
-	uniformObject.Push("transform", GetParent()->GetWorldMatrix());
+	uniformObject.Push("transform", GetParent()->GetRenderMatrix());
 	uniformObject.Push("skyColour", m_skyColour);
 	uniformObject.Push("fogColour", m_fogColour);
 	uniformObject.Push("fogLimits", GetParent()->GetLocalTransform().GetScaling().m_y * m_fogLimits);
@@ -10,6 +10,7 @@ UiObject::UiObject(UiObject *parent, const UiBound &rectangle) :
 	m_parent(parent),
 	m_enabled(true),
 	m_rectangle(rectangle),
+	m_layoutRectangle(rectangle),
 	m_scissor(0.0f, 0.0f, 1.0f, 1.0f),
 	m_height(0.0f),
 	m_lockRotation(true),
@@ -20,7 +21,11 @@ UiObject::UiObject(UiObject *parent, const UiBound &rectangle) :
 	m_screenDepth(0.0f),
 	m_screenAlpha(1.0f),
 	m_screenScale(1.0f),
-	m_selected(false)
+	m_selected(false),
+	m_dirty(true),
+	m_moved(true),
+	m_visible(false),
+	m_structureDirty(true)
 {
 	if (m_parent != nullptr)
 	{
@@ -41,24 +46,35 @@ UiObject::~UiObject()
 	}
 }
 
-void UiObject::Update(std::vector<UiObject *> &list)
+void UiObject::Update(Uis &uis, const bool &parentDirty)
 {
-	bool selected = IsEnabled() && Mouse::Get()->IsWindowSelected() && Window::Get()->IsFocused();
-
-	if (selected)
+	// The cursor is only tested against this object when either of them has moved.
+	if (m_moved || uis.IsCursorMoved())
 	{
-		auto distance = Mouse::Get()->GetPosition() - m_screenPosition;
-		selected = distance.m_x >= 0.0f && distance.m_y >= 0.0f && distance.m_x <= m_screenSize.m_x && distance.m_y <= m_screenSize.m_y;
-	}
+		m_moved = false;
+		bool selected = uis.IsCursorSelected() && IsEnabled();
 
-	if (selected != m_selected)
-	{
-		m_selected = selected;
-		m_onSelected(m_selected);
+		if (selected)
+		{
+			auto distance = uis.GetCursorPosition() - m_screenPosition;
+			selected = distance.m_x >= 0.0f && distance.m_y >= 0.0f && distance.m_x <= m_screenSize.m_x && distance.m_y <= m_screenSize.m_y;
+		}
+
+		if (selected != m_selected)
+		{
+			m_selected = selected;
+			m_onSelected(m_selected);
+		}
 	}
 
 	if (!m_enabled)
 	{
+		if (parentDirty || m_dirty)
+		{
+			m_dirty = false;
+			Hide();
+		}
+
 		return;
 	}
 
@@ -66,60 +82,115 @@ void UiObject::Update(std::vector<UiObject *> &list)
 	{
 		for (auto button : EnumIterator<MouseButton>())
 		{
-			if (Uis::Get()->WasDown(button))
+			if (uis.WasDown(button))
 			{
 				m_onClick(button);
 			}
 		}
 	}
 
-	// Alpha and scale updates.
-	m_alpha = m_alphaDriver->Update(Engine::Get()->GetDelta());
-	m_scale = m_scaleDriver->Update(Engine::Get()->GetDelta());
+	// Alpha and scale updates, drivers are only evaluated until they finish.
+	if (!m_alphaDriver->IsFinished())
+	{
+		auto alpha = m_alphaDriver->Update(Engine::Get()->GetDelta());
 
-	UpdateObject();
+		if (alpha != m_alpha)
+		{
+			m_alpha = alpha;
+			m_dirty = true;
+		}
+	}
 
-	// Transform updates.
-	float aspectRatio = m_worldTransform ? 1.0f : Window::Get()->GetAspectRatio();
+	if (!m_scaleDriver->IsFinished())
+	{
+		auto scale = m_scaleDriver->Update(Engine::Get()->GetDelta());
 
-	m_screenSize = m_rectangle.GetScreenSize(aspectRatio) * m_scale;
-	m_screenDepth = 0.01f * m_height;
-	m_screenScale = m_scale;
-	m_screenAlpha = m_alpha;
+		if (scale != m_scale)
+		{
+			m_scale = scale;
+			m_dirty = true;
+		}
+	}
 
-	if (m_parent != nullptr)
+	UpdateObject();
+
+	// The rectangle may have been changed through its reference.
+	bool dirty = parentDirty || m_dirty || m_rectangle != m_layoutRectangle;
+	m_dirty = false;
+
+	if (dirty)
 	{
-		if (m_rectangle.GetAspect() & UiAspect::Scale)
+		// Transform updates.
+		float aspectRatio = m_worldTransform ? 1.0f : uis.GetAspectRatio();
+		m_layoutRectangle = m_rectangle;
+
+		m_screenSize = m_rectangle.GetScreenSize(aspectRatio) * m_scale;
+		m_screenDepth = 0.01f * m_height;
+		m_screenScale = m_scale;
+		m_screenAlpha = m_alpha;
+
+		if (m_parent != nullptr)
 		{
-			m_screenSize *= m_parent->m_screenSize;
-			m_screenScale *= m_parent->m_screenScale;
+			if (m_rectangle.GetAspect() & UiAspect::Scale)
+			{
+				m_screenSize *= m_parent->m_screenSize;
+				m_screenScale *= m_parent->m_screenScale;
+			}
+
+			m_screenPosition = (m_rectangle.GetScreenPosition(aspectRatio) * m_parent->m_screenSize) - (m_screenSize * m_rectangle.GetReference()) + m_parent->m_screenPosition;
+			m_screenAlpha *= m_parent->m_screenAlpha;
+		}
+		else
+		{
+			m_screenPosition = m_rectangle.GetScreenPosition(aspectRatio) - (m_screenSize * m_rectangle.GetReference());
 		}
 
-		m_screenPosition = (m_rectangle.GetScreenPosition(aspectRatio) * m_parent->m_screenSize) - (m_screenSize * m_rectangle.GetReference()) + m_parent->m_screenPosition;
-		m_screenAlpha *= m_parent->m_screenAlpha;
+		m_moved = true;
+
+		// Objects are only in the flattened list while visible.
+		bool visible = m_screenAlpha > 0.0f;
+
+		if (visible != m_visible)
+		{
+			m_visible = visible;
+			MarkStructureDirty();
+		}
+
+		UpdateLayout();
+	}
+
+	// Update all children objects, they are recalculated if this layout changed.
+	for (auto &child : m_children)
+	{
+		child->Update(uis, dirty);
 	}
-	else
+}
+
+void UiObject::UpdateObject()
+{
+}
+
+void UiObject::Flatten(std::vector<UiObject *> &list)
+{
+	m_structureDirty = false;
+
+	if (!m_enabled)
 	{
-		m_screenPosition = m_rectangle.GetScreenPosition(aspectRatio) - (m_screenSize * m_rectangle.GetReference());
+		return;
 	}
 
 	// Adds this object to the list if it is visible.
-	if (m_screenAlpha > 0.0f)
+	if (m_visible)
 	{
 		list.emplace_back(this);
 	}
 
-	// Update all children objects.
 	for (auto &child : m_children)
 	{
-		child->Update(list);
+		child->Flatten(list);
 	}
 }
 
-void UiObject::UpdateObject()
-{
-}
-
 void UiObject::SetParent(UiObject *parent)
 {
 	if (m_parent != nullptr)
@@ -133,16 +204,25 @@ void UiObject::SetParent(UiObject *parent)
 	}
 
 	m_parent = parent;
+	m_dirty = true;
 }
 
 void UiObject::AddChild(UiObject *child)
 {
 	m_children.emplace_back(child);
+	MarkStructureDirty();
 }
 
 void UiObject::RemoveChild(UiObject *child)
 {
 	m_children.erase(std::remove(m_children.begin(), m_children.end(), child), m_children.end());
+	MarkStructureDirty();
+}
+
+void UiObject::ClearChildren()
+{
+	m_children.clear();
+	MarkStructureDirty();
 }
 
 bool UiObject::IsEnabled() const
@@ -156,6 +236,63 @@ bool UiObject::IsEnabled() const
 	return m_enabled;
 }
 
+void UiObject::SetEnabled(const bool &enabled)
+{
+	if (m_enabled == enabled)
+	{
+		return;
+	}
+
+	m_enabled = enabled;
+	m_dirty = true;
+	m_moved = true;
+	MarkStructureDirty();
+}
+
+void UiObject::SetScissor(const Vector4f &scissor)
+{
+	if (m_scissor != scissor)
+	{
+		m_scissor = scissor;
+		m_dirty = true;
+	}
+}
+
+void UiObject::SetHeight(const float &height)
+{
+	if (m_height != height)
+	{
+		m_height = height;
+		m_dirty = true;
+	}
+}
+
+void UiObject::SetLockRotation(const bool &lockRotation)
+{
+	m_lockRotation = lockRotation;
+	m_dirty = true;
+}
+
+void UiObject::SetWorldTransform(const std::optional<Transform> &transform)
+{
+	m_worldTransform = transform;
+	m_dirty = true;
+}
+
+void UiObject::SetAlphaDriver(Driver<float> *alphaDriver)
+{
+	m_alphaDriver.reset(alphaDriver);
+	m_alpha = m_alphaDriver->Update(Time::Zero);
+	m_dirty = true;
+}
+
+void UiObject::SetScaleDriver(Driver<Vector2f> *scaleDriver)
+{
+	m_scaleDriver.reset(scaleDriver);
+	m_scale = m_scaleDriver->Update(Time::Zero);
+	m_dirty = true;
+}
+
 Matrix4 UiObject::GetModelMatrix() const
 {
 	if (m_worldTransform)
@@ -187,4 +324,36 @@ void UiObject::CancelEvent(const MouseButton &button) const
 {
 	Uis::Get()->CancelWasEvent(button);
 }
+
+void UiObject::UpdateLayout()
+{
+}
+
+void UiObject::Hide()
+{
+	if (m_visible)
+	{
+		m_visible = false;
+		MarkStructureDirty();
+	}
+
+	UpdateLayout();
+
+	for (auto &child : m_children)
+	{
+		child->Hide();
+	}
+}
+
+void UiObject::MarkStructureDirty()
+{
+	auto root = this;
+
+	while (root->m_parent != nullptr)
+	{
+		root = root->m_parent;
+	}
+
+	root->m_structureDirty = true;
+}
 }
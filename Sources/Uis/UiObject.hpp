@@ -10,10 +10,15 @@
 
 namespace acid
 {
+class Uis;
+
 /**
  * @brief A representation of a object this is rendered to a screen. This object is contained in a parent and has children.
  * The screen object has a few values that allow for it to be positioned and scaled, along with other variables that are used when rendering.
  * This class can be extended to create a representation for GUI textures, fonts, etc.
+ *
+ * The screen layout of an object is kept between frames and only recalculated when the object is marked dirty,
+ * its rectangle is changed, its drivers change value, or its parent's layout changes.
  */
 class ACID_EXPORT UiObject
 {
@@ -29,15 +34,33 @@ public:
 
 	/**
 	 * Updates this screen object and the extended object.
-	 * @param list The list to add to.
+	 * @param uis The module updating the objects, which holds the cursor state.
+	 * @param parentDirty If the parent layout changed, forcing this layout to be recalculated.
 	 */
-	void Update(std::vector<UiObject *> &list);
+	void Update(Uis &uis, const bool &parentDirty = false);
 
 	/**
 	 * Updates the ui object.
 	 */
 	virtual void UpdateObject();
 
+	/**
+	 * Adds this object and its children to a list if they are enabled and visible, and clears the structure changed flag.
+	 * @param list The list to add to.
+	 */
+	void Flatten(std::vector<UiObject *> &list);
+
+	/**
+	 * Marks the layout of this object to be recalculated on the next update, its children are recalculated with it.
+	 */
+	void MarkDirty() { m_dirty = true; }
+
+	/**
+	 * Gets if an object below this one has been added, removed, enabled, disabled, shown or hidden since the last {@link UiObject#Flatten}.
+	 * @return If the flattened list of objects is out of date.
+	 */
+	const bool &IsStructureDirty() const { return m_structureDirty; }
+
 	UiObject *GetParent() const { return m_parent; }
 
 	/**
@@ -60,27 +83,31 @@ public:
 	 */
 	void RemoveChild(UiObject *child);
 
-	void ClearChildren() { m_children.clear(); }
+	void ClearChildren();
 
 	bool IsEnabled() const;
 
-	void SetEnabled(const bool &enabled) { m_enabled = enabled; }
+	void SetEnabled(const bool &enabled);
 
+	/**
+	 * Gets the rectangle of this object, changes made through the reference are picked up on the next update.
+	 * @return The rectangle.
+	 */
 	UiBound &GetRectangle() { return m_rectangle; }
 
 	void SetRectangle(const UiBound &rectangle) { m_rectangle = rectangle; }
 
 	const Vector4f &GetScissor() const { return m_scissor; }
 
-	void SetScissor(const Vector4f &scissor) { m_scissor = scissor; }
+	void SetScissor(const Vector4f &scissor);
 
 	const float &GetHeight() const { return m_height; }
 
-	void SetHeight(const float &height) { m_height = height; }
+	void SetHeight(const float &height);
 
 	const bool &IsLockRotation() const { return m_lockRotation; }
 
-	void SetLockRotation(const bool &lockRotation) { m_lockRotation = lockRotation; }
+	void SetLockRotation(const bool &lockRotation);
 
 	/**
 	 * Gets the world transform applied to the object, if has value.
@@ -92,19 +119,19 @@ public:
 	 * Sets the world transform applied to the object.
 	 * @param transform The new world space transform.
 	 */
-	void SetWorldTransform(const std::optional<Transform> &transform) { m_worldTransform = transform; }
+	void SetWorldTransform(const std::optional<Transform> &transform);
 
 	Matrix4 GetModelMatrix() const;
 
 	Driver<float> *GetAlphaDriver() const { return m_alphaDriver.get(); }
 
-	void SetAlphaDriver(Driver<float> *alphaDriver) { m_alphaDriver.reset(alphaDriver); }
+	void SetAlphaDriver(Driver<float> *alphaDriver);
 
 	const float &GetAlpha() const { return m_alpha; }
 
 	Driver<Vector2f> *GetScaleDriver() const { return m_scaleDriver.get(); }
 
-	void SetScaleDriver(Driver<Vector2f> *scaleDriver) { m_scaleDriver.reset(scaleDriver); }
+	void SetScaleDriver(Driver<Vector2f> *scaleDriver);
 
 	const Vector2f &GetScale() const { return m_scale; }
 
@@ -138,12 +165,30 @@ public:
 
 	void CancelEvent(const MouseButton &button) const;
 
+protected:
+	/**
+	 * Called after the screen layout of this object has been recalculated, or when it has been hidden by being disabled.
+	 */
+	virtual void UpdateLayout();
+
 private:
+	/**
+	 * Hides this object and its children after it was disabled.
+	 */
+	void Hide();
+
+	/**
+	 * Flags the root of this object as needing the flattened list rebuilt.
+	 */
+	void MarkStructureDirty();
+
 	UiObject *m_parent;
 	std::vector<UiObject *> m_children;
 
 	bool m_enabled;
 	UiBound m_rectangle;
+	/// The rectangle the current layout was calculated from.
+	UiBound m_layoutRectangle;
 	Vector4f m_scissor; // TODO: Convert to UiBound.
 	float m_height;
 
@@ -163,6 +208,11 @@ private:
 	Vector2f m_screenScale;
 	bool m_selected;
 
+	bool m_dirty;
+	bool m_moved;
+	bool m_visible;
+	bool m_structureDirty;
+
 	Delegate<void(MouseButton)> m_onClick;
 	Delegate<void(bool)> m_onSelected;
 };
@@ -1,8 +1,14 @@
 #include "Uis.hpp"
 
+#include "Fonts/FontType.hpp"
+#include "Guis/GuiBatch.hpp"
+
 namespace acid
 {
 Uis::Uis() :
+	m_cursorSelected(false),
+	m_cursorMoved(true),
+	m_aspectRatio(0.0f),
 	m_container(nullptr, UiBound::Screen)
 {
 	for (auto button : EnumIterator<MouseButton>())
@@ -11,6 +17,10 @@ Uis::Uis() :
 	}
 }
 
+Uis::~Uis()
+{
+}
+
 void Uis::Update()
 {
 	for (auto &[button, selector] : m_selectors)
@@ -20,8 +30,43 @@ void Uis::Update()
 		selector.m_isDown = isDown;
 	}
 
-	m_objects.clear();
-	m_container.Update(m_objects);
+	auto cursorPosition = Mouse::Get()->GetPosition();
+	auto cursorSelected = Mouse::Get()->IsWindowSelected() && Window::Get()->IsFocused();
+	m_cursorMoved = cursorPosition != m_cursorPosition || cursorSelected != m_cursorSelected;
+	m_cursorPosition = cursorPosition;
+	m_cursorSelected = cursorSelected;
+
+	// Glyphs rasterized since the last frame are packed and uploaded before texts are laid out and before rendering starts recording,
+	// so texts see atlas pages cleared for new glyphs in the same frame.
+	for (auto &fontType : m_fontTypes)
+	{
+		fontType->UpdateAtlas();
+	}
+
+	// Batches left without guis release their texture once no frame in flight can be drawing them.
+	for (auto it = m_guiBatches.begin(); it != m_guiBatches.end();)
+	{
+		if ((*it)->IsUnused())
+		{
+			m_guiBatchTextures.erase((*it)->GetTexture().get());
+			it = m_guiBatches.erase(it);
+			continue;
+		}
+
+		it++;
+	}
+
+	// Every layout depends on the aspect ratio, only objects marked dirty are recalculated otherwise.
+	auto aspectRatio = Window::Get()->GetAspectRatio();
+	auto aspectChanged = aspectRatio != m_aspectRatio;
+	m_aspectRatio = aspectRatio;
+	m_container.Update(*this, aspectChanged);
+
+	if (m_container.IsStructureDirty())
+	{
+		m_objects.clear();
+		m_container.Flatten(m_objects);
+	}
 }
 
 void Uis::CancelWasEvent(const MouseButton &button)
@@ -38,4 +83,26 @@ bool Uis::WasDown(const MouseButton &button)
 {
 	return m_selectors[button].m_wasDown;
 }
+
+GuiBatch &Uis::GetGuiBatch(const std::shared_ptr<Image2d> &texture)
+{
+	auto it = m_guiBatchTextures.find(texture.get());
+
+	if (it != m_guiBatchTextures.end())
+	{
+		return *it->second;
+	}
+
+	auto &batch = m_guiBatches.emplace_back(std::make_unique<GuiBatch>(texture));
+	m_guiBatchTextures.emplace(texture.get(), batch.get());
+	return *batch;
+}
+
+void Uis::AddFontType(const std::shared_ptr<FontType> &fontType)
+{
+	if (std::find(m_fontTypes.begin(), m_fontTypes.end(), fontType) == m_fontTypes.end())
+	{
+		m_fontTypes.emplace_back(fontType);
+	}
+}
 }
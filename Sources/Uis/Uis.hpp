@@ -6,6 +6,10 @@
 
 namespace acid
 {
+class FontType;
+class GuiBatch;
+class Image2d;
+
 /**
  * @brief Module used for that manages gui textures in a container.
  */
@@ -21,6 +25,8 @@ public:
 
 	Uis();
 
+	~Uis();
+
 	void Update() override;
 
 	void CancelWasEvent(const MouseButton &button);
@@ -29,6 +35,26 @@ public:
 
 	bool WasDown(const MouseButton &button);
 
+	const Vector2f &GetCursorPosition() const { return m_cursorPosition; }
+
+	/**
+	 * Gets if the cursor is over the window and the window is focused, so objects can be selected.
+	 * @return If the cursor can select objects.
+	 */
+	const bool &IsCursorSelected() const { return m_cursorSelected; }
+
+	/**
+	 * Gets if the cursor has moved, or the window selection or focus has changed, since the last update.
+	 * @return If objects need to test if they are selected.
+	 */
+	const bool &IsCursorMoved() const { return m_cursorMoved; }
+
+	/**
+	 * Gets the window aspect ratio the objects were laid out with.
+	 * @return The aspect ratio.
+	 */
+	const float &GetAspectRatio() const { return m_aspectRatio; }
+
 	/**
 	 * Gets the screen container.
 	 * @return The screen container.
@@ -40,6 +66,32 @@ public:
 	 * @return The objects.
 	 */
 	const std::vector<UiObject *> &GetObjects() const { return m_objects; };
+
+	/**
+	 * Gets the batch that draws every gui using a texture, creating it if needed.
+	 * @param texture The gui texture.
+	 * @return The batch for the texture.
+	 */
+	GuiBatch &GetGuiBatch(const std::shared_ptr<Image2d> &texture);
+
+	/**
+	 * Gets the gui batches, in the order their textures were first used.
+	 * @return The gui batches.
+	 */
+	const std::vector<std::unique_ptr<GuiBatch>> &GetGuiBatches() const { return m_guiBatches; }
+
+	/**
+	 * Adds a font type to be drawn, if it is not already.
+	 * @param fontType The font type used by a text.
+	 */
+	void AddFontType(const std::shared_ptr<FontType> &fontType);
+
+	/**
+	 * Gets the font types used by texts, each font draws its texts in one batch.
+	 * @return The font types.
+	 */
+	const std::vector<std::shared_ptr<FontType>> &GetFontTypes() const { return m_fontTypes; }
+
 private:
 	struct SelectorMouse
 	{
@@ -48,7 +100,17 @@ private:
 	};
 
 	std::map<MouseButton, SelectorMouse> m_selectors;
+	Vector2f m_cursorPosition;
+	bool m_cursorSelected;
+	bool m_cursorMoved;
+	float m_aspectRatio;
+
 	UiObject m_container;
 	std::vector<UiObject *> m_objects;
+
+	/// Batches keep their texture loaded until they are released, so a texture pointer maps to the same image while its batch exists.
+	std::vector<std::unique_ptr<GuiBatch>> m_guiBatches;
+	std::unordered_map<const Image2d *, GuiBatch *> m_guiBatchTextures;
+	std::vector<std::shared_ptr<FontType>> m_fontTypes;
 };
 }
@@ -5,6 +5,7 @@
 #include <Files/FileSystem.hpp>
 #include <Inputs/ButtonKeyboard.hpp>
 #include <Devices/Mouse.hpp>
+#include <Engine/Profiler.hpp>
 #include <Renderer/Renderer.hpp>
 #include <Scenes/Scenes.hpp>
 #include "Behaviours/HeightDespawn.hpp"
@@ -42,6 +43,7 @@ MainGame::MainGame() :
 	m_configs(nullptr),
 	m_buttonFullscreen(Key::F11),
 	m_buttonScreenshot(Key::F9),
+	m_buttonProfile(Key::F10),
 	m_buttonExit(Key::Delete)
 {
 	// Registers file search paths.
@@ -76,6 +78,24 @@ MainGame::MainGame() :
 			});
 		}
 	};
+	m_buttonProfile.OnButton() += [this](InputAction action, BitMask<InputMod> mods)
+	{
+		if (action == InputAction::Press)
+		{
+			// The first press starts a capture, the second writes it as a Chrome trace.
+			static bool capturing = false;
+			capturing = !capturing;
+
+			if (capturing)
+			{
+				Profiler::StartCapture();
+			}
+			else
+			{
+				Profiler::WriteCapture("Profiles/" + Engine::GetDateTime() + ".json");
+			}
+		}
+	};
 	m_buttonExit.OnButton() += [this](InputAction action, BitMask<InputMod> mods)
 	{
 		if (action == InputAction::Press)
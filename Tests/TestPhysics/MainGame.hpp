@@ -25,6 +25,7 @@ private:
 
 	ButtonKeyboard m_buttonFullscreen;
 	ButtonKeyboard m_buttonScreenshot;
+	ButtonKeyboard m_buttonProfile;
 	ButtonKeyboard m_buttonExit;
 };
 }
@@ -1,5 +1,6 @@
 ﻿#include "OverlayDebug.hpp"
 
+#include <Engine/Profiler.hpp>
 #include <Maths/Visual/DriverConstant.hpp>
 #include <Scenes/Scenes.hpp>
 #include <Guis/Gui.hpp>
@@ -17,6 +18,8 @@ OverlayDebug::OverlayDebug(UiObject *parent) :
 		Colour::White),
 	m_textTime(this, UiBound(Vector2f(0.002f, 0.938f), UiReference::BottomLeft), 1.1f, "", FontType::Create("Fonts/ProximaNova", "Regular"), Text::Justify::Left, 1.0f,
 		Colour::White),
+	m_textProfiler(this, UiBound(Vector2f(0.002f, 0.002f), UiReference::TopLeft), 0.9f, "", FontType::Create("Fonts/ProximaNova", "Regular"), Text::Justify::Left, 1.0f,
+		Colour::White),
 	m_timerUpdate(Time::Seconds(0.5f))
 {
 }
@@ -44,6 +47,30 @@ void OverlayDebug::UpdateObject()
 
 			m_textTime.SetString("Time: " + String::To(hour) + ":" + String::To(minute));
 		}
+
+		// Shows the top of the zone tree from the last frame on every track.
+		std::string profile;
+		std::optional<uint32_t> track;
+		char line[128];
+
+		for (const auto &zone : Profiler::GetFrame())
+		{
+			if (zone.m_depth > 2)
+			{
+				continue;
+			}
+
+			if (track != zone.m_track)
+			{
+				track = zone.m_track;
+				profile += Profiler::GetTrackName(zone.m_track) + "\n";
+			}
+
+			std::snprintf(line, sizeof(line), "%*s%s: %.2fms (%u)\n", 2 * (zone.m_depth + 1), "", zone.m_name, zone.m_time.AsMilliseconds<float>(), zone.m_calls);
+			profile += line;
+		}
+
+		m_textProfiler.SetString(profile);
 	}
 }
 }
@@ -21,6 +21,7 @@ private:
 	Text m_textFps;
 	Text m_textUps;
 	Text m_textTime;
+	Text m_textProfiler;
 	Timer m_timerUpdate;
 };
 }